@@ -18,6 +18,7 @@
 #include <ulmk/microkernel.h>
 #include <ulmk/config.h>
 #include <ulmk_arch.h>
+#include <kernel/include/ulmk_cycles.h>
 
 /* SysTick reload: board may override; default derives from CPU clock / tick. */
 #ifndef BOARD_CPU_HZ
@@ -43,8 +44,6 @@ void *g_arm_first_launch;
  * CPU control
  * ========================================================================= */
 
-#define ULMK_IRQ_KEY_SKIP	(1u << 31)
-
 ulmk_arch_irq_key_t ulmk_arch_cpu_irq_save(void)
 {
 	uint32_t primask;
@@ -98,7 +97,7 @@ uint32_t ulmk_arch_cpu_clz(uint32_t val)
 	return (uint32_t)__builtin_clz(val);
 }
 
-#if ULMK_CONFIG_SYSCALL_WCET
+#if UL_CYCLE_COUNTER
 #define DEMCR		0xE000EDFCu
 #define DWT_CTRL	0xE0001000u
 #define DWT_CYCCNT	0xE0001004u
@@ -350,6 +349,25 @@ static void arm_test_semihost_reissue(uint32_t r0, uint32_t r1)
 }
 #endif
 
+/*
+ * Address a MemManage fault was taken on: MMFAR for a data access, the
+ * stacked PC for an instruction fetch.  False when neither is known.
+ */
+static bool arm_memmanage_addr(const uint32_t *frame, uintptr_t *addr)
+{
+	uint32_t cfsr = REG32(ULMK_ARCH_SCB_CFSR);
+
+	if (cfsr & ULMK_ARCH_MMFSR_MMARVALID) {
+		*addr = REG32(ULMK_ARCH_SCB_MMFAR);
+		return true;
+	}
+	if (cfsr & ULMK_ARCH_MMFSR_IACCVIOL) {
+		*addr = frame[6];
+		return true;
+	}
+	return false;
+}
+
 /*
  * @exc         IPSR exception number (3=HardFault, 4=MemManage, 5=BusFault,
  *              6=UsageFault, 2=NMI).
@@ -381,6 +399,18 @@ void _arm_fault_dispatch(uint32_t exc, uint32_t *frame, uint32_t exc_return)
 	if (frame && (exc_return & 0x4u) && (frame[7] & 0x1FFu) == 0u &&
 	    (exc == 4u || exc == 5u || exc == 6u)) {
 		extern void ulmk_user_thread_entry(void (*)(void *), void *);
+		uintptr_t addr;
+
+		/*
+		 * A region the kernel left unloaded: load it and return, which
+		 * re-executes the faulting instruction.
+		 */
+		if (exc == 4u && arm_memmanage_addr(frame, &addr) &&
+		    ulmk_kern_trap_mpu_fault(addr)) {
+			REG32(ULMK_ARCH_SCB_CFSR) = REG32(ULMK_ARCH_SCB_CFSR);
+			ulmk_kern_trap_mpu_restore();
+			return;
+		}
 
 		/*
 		 * Redirect the offending thread into the shared user-text entry
@@ -60,6 +60,9 @@
 #define ULMK_ARCH_MPU_URAM	3	/* user pool (RW)                  */
 #define ULMK_ARCH_MPU_MMIO	4	/* peripherals + flash read        */
 #define ULMK_ARCH_MPU_USER_BASE	5	/* first dynamic per-thread region */
+#define ULMK_ARCH_MPU_DYN_SLOTS	(ULMK_ARCH_MPU_REGIONS - ULMK_ARCH_MPU_USER_BASE)
+/* MMFAR carries the faulting address — lazy region loads are possible. */
+#define ULMK_ARCH_HAVE_MPU_FAULT_ADDR	1
 
 /* Kept for API symmetry with the other ports (no hardware PRS on Cortex-M). */
 #define ULMK_ARCH_PRS_KERNEL	0u
@@ -138,6 +141,9 @@
 #define ULMK_ARCH_SHCSR_MEMFAULTENA	(1u << 16)
 #define ULMK_ARCH_SHCSR_BUSFAULTENA	(1u << 17)
 #define ULMK_ARCH_SHCSR_USGFAULTENA	(1u << 18)
+/* CFSR.MMFSR (bits 7:0) */
+#define ULMK_ARCH_MMFSR_IACCVIOL	(1u << 0)
+#define ULMK_ARCH_MMFSR_MMARVALID	(1u << 7)
 
 /* MPU (PMSAv7 / PMSAv8 register file) */
 #define ULMK_ARCH_MPU_TYPE	0xE000ED90u
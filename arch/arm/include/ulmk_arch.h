@@ -42,6 +42,9 @@ typedef struct {
 
 typedef uint32_t ulmk_arch_irq_key_t;
 
+/* Set in a key when PRIMASK was already 1; the restore is then a no-op. */
+#define ULMK_IRQ_KEY_SKIP	(1u << 31)
+
 typedef struct {
 	uintptr_t base;
 	size_t    size;
@@ -118,11 +121,14 @@ void ulmk_arch_mpu_configure(uint8_t prs, const ulmk_arch_region_t *regions,
 			   uint8_t count);
 void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 			uint8_t prs);
+void ulmk_arch_mpu_stats(uint32_t cpu, ulmk_mpu_stats_t *out);
 bool ulmk_arch_mpu_addr_permitted(uintptr_t addr, size_t size, uint32_t perms);
 
 void ulmk_arch_irq_vectors_init(uintptr_t btv, uintptr_t biv, uintptr_t isp_top);
 void ulmk_arch_irq_src_configure(uint8_t srpn, uint8_t priority, uint8_t cpu_id);
 void ulmk_arch_irq_src_register(uint8_t srpn, uint32_t src_reg_addr);
+void ulmk_arch_irq_src_priority(uint8_t srpn, uint8_t priority);
+void ulmk_arch_irq_src_route(uint8_t srpn, uint8_t cpu_id);
 void ulmk_arch_irq_src_enable(uint8_t srpn);
 void ulmk_arch_irq_src_disable(uint8_t srpn);
 void ulmk_arch_irq_src_ack(uint8_t srpn);
@@ -137,6 +143,21 @@ uint32_t ulmk_arch_atomic_cas(volatile uint32_t *ptr,
 			    uint32_t expected, uint32_t desired);
 uint32_t ulmk_arch_atomic_add(volatile uint32_t *ptr, uint32_t val);
 
+/*
+ * Order earlier stores before later ones as seen by other observers — for
+ * data published to lock-free readers (ISRs).
+ */
+static inline void ulmk_arch_wmb(void)
+{
+	__asm__ volatile("dmb" ::: "memory");
+}
+
+/* Order earlier loads before later ones — pairs with ulmk_arch_wmb(). */
+static inline void ulmk_arch_rmb(void)
+{
+	__asm__ volatile("dmb" ::: "memory");
+}
+
 /*
  * ulmk_kern_start - common C runtime bring-up (kernel/init/init.c); no return.
  * Entered from startup.S after the CPU prologue (stack) with interrupts off;
@@ -172,6 +193,7 @@ void ulmk_kern_trap_recoverable(void);
 void ulmk_kern_trap_panic(void);
 bool ulmk_irq_in_attach(void);
 void ulmk_kern_trap_mpu_restore(void);
+bool ulmk_kern_trap_mpu_fault(uintptr_t addr);
 void ulmk_kern_main(const ulmk_boot_info_t *info);
 
 #endif /* ULMK_ARCH_H */
@@ -57,6 +57,20 @@ void ulmk_arch_irq_src_configure(uint8_t srpn, uint8_t priority, uint8_t cpu_id)
 	REG8(ULMK_ARCH_NVIC_IPR + line) = NVIC_EXC_PRIO;
 }
 
+/* Uniform NVIC priority (see above): the binding's priority is not used. */
+void ulmk_arch_irq_src_priority(uint8_t srpn, uint8_t priority)
+{
+	(void)srpn;
+	(void)priority;
+}
+
+/* One NVIC per core and no SMP on this port: nothing to retarget. */
+void ulmk_arch_irq_src_route(uint8_t srpn, uint8_t cpu_id)
+{
+	(void)srpn;
+	(void)cpu_id;
+}
+
 void ulmk_arch_irq_src_register(uint8_t srpn, uint32_t src_reg_addr)
 {
 	uint32_t line;
@@ -20,6 +20,7 @@
 #include <stdbool.h>
 #include <ulmk/microkernel.h>
 #include <ulmk_arch.h>
+#include <kernel/include/ulmk_mpu_shadow.h>
 
 #define REG32(a)	(*(volatile uint32_t *)(uintptr_t)(a))
 
@@ -59,29 +60,35 @@ static uint32_t log2_cover(uintptr_t base, uintptr_t size, uintptr_t *out_base)
 	return l;
 }
 
-static void region_disable(uint8_t slot)
+/* RBAR/RASR pair per region slot; rbar = rasr = 0 is a disabled slot. */
+struct mpu_image {
+	uint32_t rbar[ULMK_ARCH_MPU_REGIONS];
+	uint32_t rasr[ULMK_ARCH_MPU_REGIONS];
+};
+
+static void mpu_image_clear(struct mpu_image *img)
 {
-	REG32(ULMK_ARCH_MPU_RNR)  = slot;
-	REG32(ULMK_ARCH_MPU_RBAR) = 0u;
-	REG32(ULMK_ARCH_MPU_RASR) = 0u;
+	uint8_t slot;
+
+	for (slot = 0u; slot < ULMK_ARCH_MPU_REGIONS; slot++) {
+		img->rbar[slot] = 0u;
+		img->rasr[slot] = 0u;
+	}
 }
 
-static void region_program(uint8_t slot, uintptr_t base, uintptr_t size,
-			   uint32_t attr)
+static void region_program(struct mpu_image *img, uint8_t slot, uintptr_t base,
+			   uintptr_t size, uint32_t attr)
 {
 	uint32_t l;
 	uintptr_t rbase;
 
-	if (size == 0u) {
-		region_disable(slot);
+	if (slot >= ULMK_ARCH_MPU_REGIONS || size == 0u)
 		return;
-	}
 
 	l = log2_cover(base, size, &rbase);
 
-	REG32(ULMK_ARCH_MPU_RNR)  = slot;
-	REG32(ULMK_ARCH_MPU_RBAR) = (uint32_t)rbase | RBAR_VALID | slot;
-	REG32(ULMK_ARCH_MPU_RASR) = RASR_ENABLE | ((l - 1u) << 1) | attr;
+	img->rbar[slot] = (uint32_t)rbase | RBAR_VALID | slot;
+	img->rasr[slot] = RASR_ENABLE | ((l - 1u) << 1) | attr;
 }
 
 static uint32_t perm_to_attr(uint32_t perms, bool device)
@@ -95,7 +102,7 @@ static uint32_t perm_to_attr(uint32_t perms, bool device)
 	return attr;
 }
 
-static void program_static_user(void)
+static void program_static_user(struct mpu_image *img)
 {
 	extern uint8_t _ulmk_user_text_start[];
 	extern uint8_t _ulmk_user_text_end[];
@@ -112,42 +119,87 @@ static void program_static_user(void)
 	uintptr_t mmio_hi  = (uintptr_t)_ulmk_mem_periph_end;
 
 	if (utext_hi > utext_lo)
-		region_program(ULMK_ARCH_MPU_UTEXT, utext_lo, utext_hi - utext_lo,
+		region_program(img, ULMK_ARCH_MPU_UTEXT, utext_lo,
+			       utext_hi - utext_lo,
 			       RASR_AP_RO_ANY | RASR_MEM_NORMAL);
-	else
-		region_disable(ULMK_ARCH_MPU_UTEXT);
 
 	/* Shared user data/bss + heap pool: RW, no-execute, all user threads. */
 	if (uram_hi > uram_lo)
-		region_program(ULMK_ARCH_MPU_URAM, uram_lo, uram_hi - uram_lo,
+		region_program(img, ULMK_ARCH_MPU_URAM, uram_lo,
+			       uram_hi - uram_lo,
 			       RASR_AP_RW_ANY | RASR_XN | RASR_MEM_NORMAL);
-	else
-		region_disable(ULMK_ARCH_MPU_URAM);
 
 	if (mmio_hi > mmio_lo)
-		region_program(ULMK_ARCH_MPU_MMIO, mmio_lo, mmio_hi - mmio_lo,
+		region_program(img, ULMK_ARCH_MPU_MMIO, mmio_lo,
+			       mmio_hi - mmio_lo,
 			       RASR_AP_RW_ANY | RASR_XN | RASR_MEM_DEVICE);
-	else
-		region_disable(ULMK_ARCH_MPU_MMIO);
 }
 
-void ulmk_arch_mpu_init(void)
+/*
+ * Last programmed layout.  @hw shadows the region registers and is trusted
+ * only once @valid is set; indexed by CPU like the other ports even though
+ * the M-profile boards are single-core.
+ */
+struct mpu_cpu_cache {
+	const ulmk_arch_region_t *regions;
+	uint8_t count;
+	uint8_t prs;
+	uint8_t dyn;	/* non-STACK dynamic slots last programmed */
+	bool    valid;
+	struct mpu_image hw;
+	ulmk_mpu_stats_t stats;
+};
+
+static struct mpu_cpu_cache g_mpu_cache[ULMK_ARCH_NUM_CPU] = {
+	[0 ... ULMK_ARCH_NUM_CPU - 1] = { .prs = 0xFFu },
+};
+
+static struct mpu_cpu_cache *mpu_this_cpu(void)
 {
-	uint8_t slot;
+	uint32_t cpu = ulmk_arch_cpu_id();
 
-	/*
-	 * Reconfigure with the MPU off: mpu_init runs a second time from
-	 * kernel_main after arch_init already enabled it, and reprogramming
-	 * live regions from privileged code is not architecturally safe.
-	 */
-	__asm__ volatile("dsb" ::: "memory");
-	REG32(ULMK_ARCH_MPU_CTRL) = 0u;
-	__asm__ volatile("dsb\n\tisb" ::: "memory");
+	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		cpu = 0u;
+	return &g_mpu_cache[cpu];
+}
 
-	for (slot = 0u; slot < ULMK_ARCH_MPU_REGIONS; slot++)
-		region_disable(slot);
+/*
+ * Write only the slots of @want that differ from the shadow.  The MPU is
+ * turned off around the update, and only when at least one slot changes: a
+ * per-thread region's power-of-two round-up (log2_cover) can transiently
+ * over-cover the kernel .text this code executes from, and with the MPU live
+ * that raises an IACCVIOL mid-switch.
+ */
+static void mpu_commit(struct mpu_cpu_cache *c, const struct mpu_image *want)
+{
+	uint32_t writes = 0u;
+	uint8_t  slot;
+
+	for (slot = 0u; slot < ULMK_ARCH_MPU_REGIONS; slot++) {
+		if (c->valid && want->rbar[slot] == c->hw.rbar[slot] &&
+		    want->rasr[slot] == c->hw.rasr[slot])
+			continue;
+
+		if (writes == 0u) {
+			__asm__ volatile("dsb" ::: "memory");
+			REG32(ULMK_ARCH_MPU_CTRL) = 0u;
+			__asm__ volatile("dsb\n\tisb" ::: "memory");
+		}
+		REG32(ULMK_ARCH_MPU_RNR)  = slot;
+		REG32(ULMK_ARCH_MPU_RBAR) = want->rbar[slot];
+		REG32(ULMK_ARCH_MPU_RASR) = want->rasr[slot];
+		c->hw.rbar[slot] = want->rbar[slot];
+		c->hw.rasr[slot] = want->rasr[slot];
+		writes++;
+	}
+	c->valid = true;
 
-	program_static_user();
+	c->stats.slot_writes += writes;
+	c->stats.slot_skips  += ULMK_ARCH_MPU_REGIONS - writes;
+	if (writes == 0u) {
+		c->stats.unchanged++;
+		return;
+	}
 
 	__asm__ volatile("dsb" ::: "memory");
 	REG32(ULMK_ARCH_MPU_CTRL) = ULMK_ARCH_MPU_CTRL_ENABLE |
@@ -155,6 +207,26 @@ void ulmk_arch_mpu_init(void)
 	__asm__ volatile("dsb\n\tisb" ::: "memory");
 }
 
+void ulmk_arch_mpu_init(void)
+{
+	struct mpu_cpu_cache *c = mpu_this_cpu();
+	struct mpu_image      img;
+
+	/*
+	 * Reconfigure with the MPU off: mpu_init runs a second time from
+	 * kernel_main after arch_init already enabled it, and reprogramming
+	 * live regions from privileged code is not architecturally safe.
+	 * An invalid shadow makes mpu_commit() rewrite (and so first disable)
+	 * every slot.
+	 */
+	mpu_image_clear(&img);
+	program_static_user(&img);
+
+	c->valid = false;
+	mpu_commit(c, &img);
+	c->prs   = 0xFFu;
+}
+
 void ulmk_arch_mpu_enable(void)
 {
 	REG32(ULMK_ARCH_MPU_CTRL) |= ULMK_ARCH_MPU_CTRL_ENABLE;
@@ -176,11 +248,6 @@ void ulmk_arch_mpu_configure(uint8_t prs, const ulmk_arch_region_t *regions,
 	(void)count;
 }
 
-static const ulmk_arch_region_t *g_mpu_regions;
-static uint8_t g_mpu_count;
-static uint8_t g_mpu_prs = 0xFFu;
-static uint8_t g_mpu_dyn; /* non-STACK dynamic slots last programmed */
-
 static uint8_t mpu_dyn_count(const ulmk_arch_region_t *regions, uint8_t count)
 {
 	uint8_t n = 0u;
@@ -198,12 +265,19 @@ static uint8_t mpu_dyn_count(const ulmk_arch_region_t *regions, uint8_t count)
 void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 			  uint8_t prs)
 {
-	uint8_t slot;
-	uint8_t i;
-	uint8_t eff;
+	struct mpu_cpu_cache *c = mpu_this_cpu();
+	ulmk_arch_region_t    dyn[ULMK_ARCH_MAX_REGIONS];
+	struct mpu_image      img;
+	uint8_t               n = 0u;
+	uint8_t               i;
+	uint8_t               eff;
+
+	c->stats.switches++;
 
-	if (prs == g_mpu_prs && regions == g_mpu_regions && count == g_mpu_count)
+	if (prs == c->prs && regions == c->regions && count == c->count) {
+		c->stats.unchanged++;
 		return;
+	}
 
 	eff = (prs != ULMK_ARCH_PRS_KERNEL) ? mpu_dyn_count(regions, count) : 0u;
 
@@ -211,49 +285,40 @@ void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 	 * STACK is inside the static URAM window.  Stack-only address spaces
 	 * share that window — avoid tear-down/reprogram on every IPC switch.
 	 */
-	if (prs == g_mpu_prs && eff == 0u && g_mpu_dyn == 0u &&
+	if (prs == c->prs && eff == 0u && c->dyn == 0u &&
 	    prs != ULMK_ARCH_PRS_KERNEL) {
-		g_mpu_regions = regions;
-		g_mpu_count   = count;
+		c->regions = regions;
+		c->count   = count;
+		c->stats.unchanged++;
 		return;
 	}
 
-	/*
-	 * Reprogram with the MPU off.  A per-thread region's power-of-two
-	 * round-up (log2_cover) can transiently over-cover the kernel .text
-	 * that this very code executes from; with the MPU live that raises an
-	 * IACCVIOL mid-switch.  Disabling first makes the update atomic w.r.t.
-	 * the running privileged code.
-	 */
-	__asm__ volatile("dsb" ::: "memory");
-	REG32(ULMK_ARCH_MPU_CTRL) = 0u;
-	__asm__ volatile("dsb\n\tisb" ::: "memory");
-
-	program_static_user();
-
-	slot = ULMK_ARCH_MPU_USER_BASE;
-	if (prs != ULMK_ARCH_PRS_KERNEL && regions) {
-		for (i = 0u; i < count && slot < ULMK_ARCH_MPU_REGIONS; i++) {
-			if (regions[i].type == ULMK_REGION_STACK)
-				continue;
-			region_program(slot, regions[i].base, regions[i].size,
-				       perm_to_attr(regions[i].perms, false));
-			slot++;
-		}
-	}
-	eff = (uint8_t)(slot - ULMK_ARCH_MPU_USER_BASE);
-	for (; slot < ULMK_ARCH_MPU_REGIONS; slot++)
-		region_disable(slot);
-
-	__asm__ volatile("dsb" ::: "memory");
-	REG32(ULMK_ARCH_MPU_CTRL) = ULMK_ARCH_MPU_CTRL_ENABLE |
-				    ULMK_ARCH_MPU_CTRL_PRIVDEFENA;
-	__asm__ volatile("dsb\n\tisb" ::: "memory");
+	mpu_image_clear(&img);
+	program_static_user(&img);
+
+	/* Merge only into exact power-of-two blocks so coverage never grows. */
+	if (prs != ULMK_ARCH_PRS_KERNEL)
+		n = ulmk_mpu_compact(regions, count, dyn,
+				     (uint8_t)ULMK_ARCH_MPU_DYN_SLOTS,
+				     ULMK_MPU_MERGE_POW2, &c->stats.merged);
+	for (i = 0u; i < n; i++)
+		region_program(&img, (uint8_t)(ULMK_ARCH_MPU_USER_BASE + i),
+			       dyn[i].base, dyn[i].size,
+			       perm_to_attr(dyn[i].perms, false));
+
+	mpu_commit(c, &img);
+
+	c->prs     = prs;
+	c->regions = regions;
+	c->count   = count;
+	c->dyn     = n;
+}
 
-	g_mpu_prs     = prs;
-	g_mpu_regions = regions;
-	g_mpu_count   = count;
-	g_mpu_dyn     = eff;
+void ulmk_arch_mpu_stats(uint32_t cpu, ulmk_mpu_stats_t *out)
+{
+	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		cpu = 0u;
+	*out = g_mpu_cache[cpu].stats;
 }
 
 bool ulmk_arch_mpu_addr_permitted(uintptr_t addr, size_t size, uint32_t perms)
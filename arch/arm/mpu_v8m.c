@@ -20,6 +20,7 @@
 #include <stdbool.h>
 #include <ulmk/microkernel.h>
 #include <ulmk_arch.h>
+#include <kernel/include/ulmk_mpu_shadow.h>
 
 #define REG32(a)	(*(volatile uint32_t *)(uintptr_t)(a))
 
@@ -37,29 +38,35 @@
 #define MAIR0_NORMAL_WB	0xFFu	/* attr0: normal, WB non-transient RW alloc */
 #define MAIR0_DEVICE	0x00u	/* attr1: device nGnRnE */
 
-static void region_disable(uint8_t slot)
+/* RBAR/RLAR pair per region slot; rbar = rlar = 0 is a disabled slot. */
+struct mpu_image {
+	uint32_t rbar[ULMK_ARCH_MPU_REGIONS];
+	uint32_t rlar[ULMK_ARCH_MPU_REGIONS];
+};
+
+static void mpu_image_clear(struct mpu_image *img)
 {
-	REG32(ULMK_ARCH_MPU_RNR)  = slot;
-	REG32(ULMK_ARCH_MPU_RBAR) = 0u;
-	REG32(ULMK_ARCH_MPU_RLAR) = 0u;
+	uint8_t slot;
+
+	for (slot = 0u; slot < ULMK_ARCH_MPU_REGIONS; slot++) {
+		img->rbar[slot] = 0u;
+		img->rlar[slot] = 0u;
+	}
 }
 
-static void region_program(uint8_t slot, uintptr_t base, uintptr_t size,
-			   uint32_t rbar_attr, uint32_t rlar_attr)
+static void region_program(struct mpu_image *img, uint8_t slot, uintptr_t base,
+			   uintptr_t size, uint32_t rbar_attr, uint32_t rlar_attr)
 {
 	uintptr_t limit;
 
-	if (size == 0u) {
-		region_disable(slot);
+	if (slot >= ULMK_ARCH_MPU_REGIONS || size == 0u)
 		return;
-	}
 
 	base  &= ~0x1Fu;
 	limit  = (base + size - 1u) & ~0x1Fu;
 
-	REG32(ULMK_ARCH_MPU_RNR)  = slot;
-	REG32(ULMK_ARCH_MPU_RBAR) = (uint32_t)base | rbar_attr;
-	REG32(ULMK_ARCH_MPU_RLAR) = ((uint32_t)limit & ~0x1Fu) | rlar_attr | RLAR_EN;
+	img->rbar[slot] = (uint32_t)base | rbar_attr;
+	img->rlar[slot] = ((uint32_t)limit & ~0x1Fu) | rlar_attr | RLAR_EN;
 }
 
 static uint32_t perm_to_rbar(uint32_t perms)
@@ -73,7 +80,7 @@ static uint32_t perm_to_rbar(uint32_t perms)
 	return attr;
 }
 
-static void program_static_user(void)
+static void program_static_user(struct mpu_image *img)
 {
 	extern uint8_t _ulmk_user_text_start[];
 	extern uint8_t _ulmk_user_text_end[];
@@ -90,29 +97,97 @@ static void program_static_user(void)
 	uintptr_t mmio_hi  = (uintptr_t)_ulmk_mem_periph_end;
 
 	if (utext_hi > utext_lo)
-		region_program(ULMK_ARCH_MPU_UTEXT, utext_lo, utext_hi - utext_lo,
+		region_program(img, ULMK_ARCH_MPU_UTEXT, utext_lo,
+			       utext_hi - utext_lo,
 			       RBAR_AP_RO_ANY | RBAR_SH_OUTER, RLAR_ATTR_NORMAL);
-	else
-		region_disable(ULMK_ARCH_MPU_UTEXT);
 
 	/* Shared user data/bss + heap pool: RW, no-execute, all user threads. */
 	if (uram_hi > uram_lo)
-		region_program(ULMK_ARCH_MPU_URAM, uram_lo, uram_hi - uram_lo,
+		region_program(img, ULMK_ARCH_MPU_URAM, uram_lo,
+			       uram_hi - uram_lo,
 			       RBAR_AP_RW_ANY | RBAR_XN | RBAR_SH_OUTER,
 			       RLAR_ATTR_NORMAL);
-	else
-		region_disable(ULMK_ARCH_MPU_URAM);
 
 	if (mmio_hi > mmio_lo)
-		region_program(ULMK_ARCH_MPU_MMIO, mmio_lo, mmio_hi - mmio_lo,
+		region_program(img, ULMK_ARCH_MPU_MMIO, mmio_lo,
+			       mmio_hi - mmio_lo,
 			       RBAR_AP_RW_ANY | RBAR_XN, RLAR_ATTR_DEVICE);
-	else
-		region_disable(ULMK_ARCH_MPU_MMIO);
+}
+
+/*
+ * Last programmed layout.  @hw shadows the region registers and is trusted
+ * only once @valid is set; indexed by CPU like the other ports even though
+ * the M-profile boards are single-core.
+ */
+struct mpu_cpu_cache {
+	const ulmk_arch_region_t *regions;
+	uint8_t count;
+	uint8_t prs;
+	uint8_t dyn;	/* dynamic slots last programmed */
+	bool    valid;
+	struct mpu_image hw;
+	ulmk_mpu_stats_t stats;
+};
+
+static struct mpu_cpu_cache g_mpu_cache[ULMK_ARCH_NUM_CPU] = {
+	[0 ... ULMK_ARCH_NUM_CPU - 1] = { .prs = 0xFFu },
+};
+
+static struct mpu_cpu_cache *mpu_this_cpu(void)
+{
+	uint32_t cpu = ulmk_arch_cpu_id();
+
+	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		cpu = 0u;
+	return &g_mpu_cache[cpu];
+}
+
+/*
+ * Write only the slots of @want that differ from the shadow, with the MPU
+ * off so the update is atomic w.r.t. running code.  Nothing is touched —
+ * not even MPU_CTRL — when the shadow already matches.
+ */
+static void mpu_commit(struct mpu_cpu_cache *c, const struct mpu_image *want)
+{
+	uint32_t writes = 0u;
+	uint8_t  slot;
+
+	for (slot = 0u; slot < ULMK_ARCH_MPU_REGIONS; slot++) {
+		if (c->valid && want->rbar[slot] == c->hw.rbar[slot] &&
+		    want->rlar[slot] == c->hw.rlar[slot])
+			continue;
+
+		if (writes == 0u) {
+			__asm__ volatile("dsb" ::: "memory");
+			REG32(ULMK_ARCH_MPU_CTRL) = 0u;
+			__asm__ volatile("dsb\n\tisb" ::: "memory");
+		}
+		REG32(ULMK_ARCH_MPU_RNR)  = slot;
+		REG32(ULMK_ARCH_MPU_RBAR) = want->rbar[slot];
+		REG32(ULMK_ARCH_MPU_RLAR) = want->rlar[slot];
+		c->hw.rbar[slot] = want->rbar[slot];
+		c->hw.rlar[slot] = want->rlar[slot];
+		writes++;
+	}
+	c->valid = true;
+
+	c->stats.slot_writes += writes;
+	c->stats.slot_skips  += ULMK_ARCH_MPU_REGIONS - writes;
+	if (writes == 0u) {
+		c->stats.unchanged++;
+		return;
+	}
+
+	__asm__ volatile("dsb" ::: "memory");
+	REG32(ULMK_ARCH_MPU_CTRL) = ULMK_ARCH_MPU_CTRL_ENABLE |
+				    ULMK_ARCH_MPU_CTRL_PRIVDEFENA;
+	__asm__ volatile("dsb\n\tisb" ::: "memory");
 }
 
 void ulmk_arch_mpu_init(void)
 {
-	uint8_t slot;
+	struct mpu_cpu_cache *c = mpu_this_cpu();
+	struct mpu_image      img;
 
 	/* Reconfigure with the MPU off (mpu_init runs again from kernel_main). */
 	__asm__ volatile("dsb" ::: "memory");
@@ -123,15 +198,13 @@ void ulmk_arch_mpu_init(void)
 				     (uint32_t)MAIR0_NORMAL_WB;
 	REG32(ULMK_ARCH_MPU_MAIR1) = 0u;
 
-	for (slot = 0u; slot < ULMK_ARCH_MPU_REGIONS; slot++)
-		region_disable(slot);
-
-	program_static_user();
+	/* An invalid shadow makes mpu_commit() rewrite every slot. */
+	mpu_image_clear(&img);
+	program_static_user(&img);
 
-	__asm__ volatile("dsb" ::: "memory");
-	REG32(ULMK_ARCH_MPU_CTRL) = ULMK_ARCH_MPU_CTRL_ENABLE |
-				    ULMK_ARCH_MPU_CTRL_PRIVDEFENA;
-	__asm__ volatile("dsb\n\tisb" ::: "memory");
+	c->valid = false;
+	mpu_commit(c, &img);
+	c->prs   = 0xFFu;
 }
 
 void ulmk_arch_mpu_enable(void)
@@ -181,25 +254,26 @@ static bool covered_by_static(uintptr_t base, uintptr_t size)
 	return false;
 }
 
-static const ulmk_arch_region_t *g_mpu_regions;
-static uint8_t g_mpu_count;
-static uint8_t g_mpu_prs = 0xFFu;
-static uint8_t g_mpu_dyn; /* dynamic slots last programmed */
-
-static uint8_t mpu_dyn_needed(const ulmk_arch_region_t *regions, uint8_t count)
+/*
+ * Copy the regions that need their own slot into @out.  The static-window
+ * filter runs before merging: a union that straddles a window edge would
+ * otherwise overlap it.
+ */
+static uint8_t mpu_dyn_needed(const ulmk_arch_region_t *regions, uint8_t count,
+			      ulmk_arch_region_t *out)
 {
 	uint8_t n = 0u;
 	uint8_t i;
 
 	if (!regions)
 		return 0u;
-	for (i = 0u; i < count; i++) {
+	for (i = 0u; i < count && n < ULMK_ARCH_MAX_REGIONS; i++) {
 		if (regions[i].type == ULMK_REGION_STACK)
 			continue;
 		if (regions[i].size == 0u ||
 		    covered_by_static(regions[i].base, regions[i].size))
 			continue;
-		n++;
+		out[n++] = regions[i];
 	}
 	return n;
 }
@@ -207,57 +281,55 @@ static uint8_t mpu_dyn_needed(const ulmk_arch_region_t *regions, uint8_t count)
 void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 			  uint8_t prs)
 {
-	uint8_t slot;
-	uint8_t i;
-	uint8_t eff;
+	struct mpu_cpu_cache *c = mpu_this_cpu();
+	ulmk_arch_region_t    dyn[ULMK_ARCH_MAX_REGIONS];
+	struct mpu_image      img;
+	uint8_t               n;
+	uint8_t               i;
+
+	c->stats.switches++;
 
-	if (prs == g_mpu_prs && regions == g_mpu_regions && count == g_mpu_count)
+	if (prs == c->prs && regions == c->regions && count == c->count) {
+		c->stats.unchanged++;
 		return;
+	}
 
-	eff = (prs != ULMK_ARCH_PRS_KERNEL) ? mpu_dyn_needed(regions, count) : 0u;
+	n = (prs != ULMK_ARCH_PRS_KERNEL) ?
+		mpu_dyn_needed(regions, count, dyn) : 0u;
 
 	/* No unique dynamic regions — static windows already grant access. */
-	if (prs == g_mpu_prs && eff == 0u && g_mpu_dyn == 0u &&
+	if (prs == c->prs && n == 0u && c->dyn == 0u &&
 	    prs != ULMK_ARCH_PRS_KERNEL) {
-		g_mpu_regions = regions;
-		g_mpu_count   = count;
+		c->regions = regions;
+		c->count   = count;
+		c->stats.unchanged++;
 		return;
 	}
 
-	/* Reprogram with the MPU off so the update is atomic w.r.t. running code. */
-	__asm__ volatile("dsb" ::: "memory");
-	REG32(ULMK_ARCH_MPU_CTRL) = 0u;
-	__asm__ volatile("dsb\n\tisb" ::: "memory");
+	mpu_image_clear(&img);
+	program_static_user(&img);
 
-	program_static_user();
-
-	slot = ULMK_ARCH_MPU_USER_BASE;
-	if (prs != ULMK_ARCH_PRS_KERNEL && regions) {
-		for (i = 0u; i < count && slot < ULMK_ARCH_MPU_REGIONS; i++) {
-			if (regions[i].type == ULMK_REGION_STACK)
-				continue;
-			if (regions[i].size == 0u ||
-			    covered_by_static(regions[i].base, regions[i].size))
-				continue;
-			region_program(slot, regions[i].base, regions[i].size,
-				       perm_to_rbar(regions[i].perms),
-				       RLAR_ATTR_NORMAL);
-			slot++;
-		}
-	}
-	eff = (uint8_t)(slot - ULMK_ARCH_MPU_USER_BASE);
-	for (; slot < ULMK_ARCH_MPU_REGIONS; slot++)
-		region_disable(slot);
+	n = ulmk_mpu_compact(dyn, n, dyn,
+			     (uint8_t)ULMK_ARCH_MPU_DYN_SLOTS,
+			     ULMK_MPU_MERGE_ANY, &c->stats.merged);
+	for (i = 0u; i < n; i++)
+		region_program(&img, (uint8_t)(ULMK_ARCH_MPU_USER_BASE + i),
+			       dyn[i].base, dyn[i].size,
+			       perm_to_rbar(dyn[i].perms), RLAR_ATTR_NORMAL);
 
-	__asm__ volatile("dsb" ::: "memory");
-	REG32(ULMK_ARCH_MPU_CTRL) = ULMK_ARCH_MPU_CTRL_ENABLE |
-				    ULMK_ARCH_MPU_CTRL_PRIVDEFENA;
-	__asm__ volatile("dsb\n\tisb" ::: "memory");
+	mpu_commit(c, &img);
 
-	g_mpu_prs     = prs;
-	g_mpu_regions = regions;
-	g_mpu_count   = count;
-	g_mpu_dyn     = eff;
+	c->prs     = prs;
+	c->regions = regions;
+	c->count   = count;
+	c->dyn     = n;
+}
+
+void ulmk_arch_mpu_stats(uint32_t cpu, ulmk_mpu_stats_t *out)
+{
+	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		cpu = 0u;
+	*out = g_mpu_cache[cpu].stats;
 }
 
 bool ulmk_arch_mpu_addr_permitted(uintptr_t addr, size_t size, uint32_t perms)
@@ -9,6 +9,8 @@
 #include <ulmk/microkernel.h>
 #include <ulmk/config.h>
 #include <ulmk_arch.h>
+#include <kernel/include/ulmk_cycles.h>
+#include <kernel/include/ulmk_mpu_shadow.h>
 #include "irq_internal.h"
 
 #define TF_SIZE		144u
@@ -24,7 +26,11 @@
 #define TF_MSTATUS	112u
 
 #define MCAUSE_INT_BIT	(1u << 31)
+#if ULMK_ARCH_HAVE_CLIC
+#define MCAUSE_EC_MASK	MCAUSE_CLIC_CODE
+#else
 #define MCAUSE_EC_MASK	0x7FFFFFFFu
+#endif
 
 #define MCAUSE_ECALL_U	8u
 #define MCAUSE_ECALL_M	11u
@@ -66,6 +72,14 @@ static inline uint32_t read_mcause(void)
 	return val;
 }
 
+static inline uint32_t read_mtval(void)
+{
+	uint32_t val;
+
+	__asm__ volatile("csrr %0, mtval" : "=r"(val));
+	return val;
+}
+
 static inline void clear_mstatus_mie(void)
 {
 	__asm__ volatile("csrc mstatus, %0" :: "r"(MSTATUS_MIE_BIT));
@@ -76,27 +90,11 @@ static inline void set_mstatus_mie(void)
 	__asm__ volatile("csrs mstatus, %0" :: "r"(MSTATUS_MIE_BIT));
 }
 
-static inline uint32_t read_pmpcfg0(void)
-{
-	uint32_t val;
-
-	__asm__ volatile("csrr %0, pmpcfg0" : "=r"(val));
-	return val;
-}
-
 static inline void write_pmpcfg0(uint32_t val)
 {
 	__asm__ volatile("csrw pmpcfg0, %0" :: "r"(val));
 }
 
-static inline uint32_t read_pmpcfg1(void)
-{
-	uint32_t val;
-
-	__asm__ volatile("csrr %0, pmpcfg1" : "=r"(val));
-	return val;
-}
-
 static inline void write_pmpcfg1(uint32_t val)
 {
 	__asm__ volatile("csrw pmpcfg1, %0" :: "r"(val));
@@ -122,34 +120,15 @@ static inline uint32_t pmp_addr_encode(uintptr_t addr)
 	return (uint32_t)(addr >> 2);
 }
 
-static void pmp_write_cfg(uint8_t idx, uint8_t cfg)
-{
-	uint32_t v;
-
-	if (idx >= ULMK_ARCH_PMP_NUM)
-		return;
-
-	if (idx < 4u) {
-		v = read_pmpcfg0();
-		v = (v & ~(0xFFu << (idx * 8u))) | ((uint32_t)cfg << (idx * 8u));
-		write_pmpcfg0(v);
-		return;
-	}
-
-	v = read_pmpcfg1();
-	idx -= 4u;
-	v = (v & ~(0xFFu << (idx * 8u))) | ((uint32_t)cfg << (idx * 8u));
-	write_pmpcfg1(v);
-}
-
 static void pmp_clear_all(void)
 {
 	uint8_t i;
 
-	for (i = 0u; i < ULMK_ARCH_PMP_NUM; i++) {
+	write_pmpcfg0(0u);
+	if (ULMK_ARCH_PMP_NUM > 4u)
+		write_pmpcfg1(0u);
+	for (i = 0u; i < ULMK_ARCH_PMP_NUM; i++)
 		pmp_write_addr(i, 0u);
-		pmp_write_cfg(i, 0u);
-	}
 }
 
 static uintptr_t napot_round_size(uintptr_t size)
@@ -163,29 +142,43 @@ static uintptr_t napot_round_size(uintptr_t size)
 	return s;
 }
 
-static void pmp_set_napot(uint8_t idx, uintptr_t base, uintptr_t size, uint8_t perm)
+/*
+ * PMP image: pmpaddrN plus the two packed pmpcfg words.  Layouts are composed
+ * into an image first and pmp_commit() writes only what differs from the
+ * hart's shadow.
+ */
+struct pmp_image {
+	uint32_t addr[ULMK_ARCH_PMP_NUM];
+	uint32_t cfg[2];
+};
+
+static void pmp_image_clear(struct pmp_image *img)
+{
+	uint8_t i;
+
+	for (i = 0u; i < ULMK_ARCH_PMP_NUM; i++)
+		img->addr[i] = 0u;
+	img->cfg[0] = 0u;
+	img->cfg[1] = 0u;
+}
+
+static inline uint8_t pmp_image_cfg(const struct pmp_image *img, uint8_t idx)
+{
+	return (uint8_t)(img->cfg[idx / 4u] >> ((idx % 4u) * 8u));
+}
+
+static void pmp_set_napot(struct pmp_image *img, uint8_t idx, uintptr_t base,
+			  uintptr_t size, uint8_t perm)
 {
 	uintptr_t napot;
-	uint32_t  addr;
 
 	if (idx >= ULMK_ARCH_PMP_NUM || size == 0u)
 		return;
 
 	napot = napot_round_size(size);
 	base &= ~(napot - 1u);
-	addr = pmp_addr_encode(base) | (pmp_addr_encode(napot) - 1u);
-	pmp_write_addr(idx, addr);
-	pmp_write_cfg(idx, perm | PMP_A_NAPOT);
-}
-
-static void pmp_set_tor(uint8_t idx, uintptr_t lo, uintptr_t hi, uint8_t perm)
-{
-	uintptr_t size;
-
-	if (hi <= lo)
-		return;
-	size = hi - lo;
-	pmp_set_napot(idx, lo, size, perm);
+	img->addr[idx] = pmp_addr_encode(base) | (pmp_addr_encode(napot) - 1u);
+	img->cfg[idx / 4u] |= (uint32_t)(perm | PMP_A_NAPOT) << ((idx % 4u) * 8u);
 }
 
 static uint32_t user_mstatus_init(void)
@@ -197,8 +190,6 @@ static uint32_t user_mstatus_init(void)
  * CPU control
  * ========================================================================= */
 
-#define ULMK_IRQ_KEY_SKIP	(1u << 31)
-
 ulmk_arch_irq_key_t ulmk_arch_cpu_irq_save(void)
 {
 	uint32_t mstatus = read_mstatus();
@@ -251,7 +242,7 @@ uint32_t ulmk_arch_cpu_clz(uint32_t val)
 	return (uint32_t)__builtin_clz(val);
 }
 
-#if ULMK_CONFIG_SYSCALL_WCET
+#if UL_CYCLE_COUNTER
 void ulmk_arch_cycle_enable(void)
 {
 	/* mcycle is free-running from reset; nothing to unlock in M-mode. */
@@ -332,7 +323,7 @@ void ulmk_arch_sched_switch(ulmk_arch_ctx_t *from, const ulmk_arch_ctx_t *to,
  * PMP (ulmk_arch_mpu_* API)
  * ========================================================================= */
 
-static void pmp_kernel_layout(void)
+static void pmp_kernel_layout(struct pmp_image *img)
 {
 	uintptr_t kexec_lo;
 	uintptr_t kexec_hi;
@@ -367,40 +358,41 @@ static void pmp_kernel_layout(void)
 	mmio_lo  = (uintptr_t)_ulmk_mem_periph_base;
 	mmio_hi  = (uintptr_t)_ulmk_mem_periph_end;
 
-	pmp_clear_all();
+	pmp_image_clear(img);
 
 	if (kexec_hi > kexec_lo)
-		pmp_set_napot(ULMK_ARCH_PMP_KERNEL, kexec_lo, kexec_hi - kexec_lo,
-			      PMP_R | PMP_X);
+		pmp_set_napot(img, ULMK_ARCH_PMP_KERNEL, kexec_lo,
+			      kexec_hi - kexec_lo, PMP_R | PMP_X);
 
 	if (kram_hi > kram_lo)
-		pmp_set_napot(ULMK_ARCH_PMP_KRAM, kram_lo, kram_hi - kram_lo,
-			      PMP_R | PMP_W);
+		pmp_set_napot(img, ULMK_ARCH_PMP_KRAM, kram_lo,
+			      kram_hi - kram_lo, PMP_R | PMP_W);
 
 	if (utext_hi > utext_lo)
-		pmp_set_napot(ULMK_ARCH_PMP_UTEXT, utext_lo, utext_hi - utext_lo,
-			      PMP_R | PMP_X);
+		pmp_set_napot(img, ULMK_ARCH_PMP_UTEXT, utext_lo,
+			      utext_hi - utext_lo, PMP_R | PMP_X);
 
 	if (uram_hi > uram_lo)
-		pmp_set_napot(ULMK_ARCH_PMP_URAM, uram_lo, uram_hi - uram_lo,
-			      PMP_R | PMP_W);
+		pmp_set_napot(img, ULMK_ARCH_PMP_URAM, uram_lo,
+			      uram_hi - uram_lo, PMP_R | PMP_W);
 
 	if (mmio_hi > mmio_lo)
-		pmp_set_napot(ULMK_ARCH_PMP_MMIO, mmio_lo, mmio_hi - mmio_lo,
-			      PMP_R | PMP_W);
-
-	(void)kexec_lo;
+		pmp_set_napot(img, ULMK_ARCH_PMP_MMIO, mmio_lo,
+			      mmio_hi - mmio_lo, PMP_R | PMP_W);
 }
 
-static void pmp_user_layout(const ulmk_arch_region_t *regions, uint8_t count)
+static void pmp_user_layout(struct pmp_image *img,
+			    const ulmk_arch_region_t *regions, uint8_t count,
+			    uint32_t *merged)
 {
+	ulmk_arch_region_t dyn[ULMK_ARCH_MAX_REGIONS];
 	uintptr_t utext_lo;
 	uintptr_t utext_hi;
 	uintptr_t uram_lo;
 	uintptr_t uram_hi;
 	uintptr_t mmio_lo;
 	uintptr_t mmio_hi;
-	uint8_t   slot;
+	uint8_t   n;
 	uint8_t   i;
 
 	extern uint8_t _ulmk_user_text_start[];
@@ -417,49 +409,123 @@ static void pmp_user_layout(const ulmk_arch_region_t *regions, uint8_t count)
 	mmio_lo  = (uintptr_t)_ulmk_mem_periph_base;
 	mmio_hi  = (uintptr_t)_ulmk_mem_periph_end;
 
-	pmp_clear_all();
+	pmp_image_clear(img);
 
 	if (utext_hi > utext_lo)
-		pmp_set_napot(ULMK_ARCH_PMP_UTEXT, utext_lo, utext_hi - utext_lo,
-			      PMP_R | PMP_X);
+		pmp_set_napot(img, ULMK_ARCH_PMP_UTEXT, utext_lo,
+			      utext_hi - utext_lo, PMP_R | PMP_X);
 
 	if (uram_hi > uram_lo)
-		pmp_set_napot(ULMK_ARCH_PMP_URAM, uram_lo, uram_hi - uram_lo,
-			      PMP_R | PMP_W);
+		pmp_set_napot(img, ULMK_ARCH_PMP_URAM, uram_lo,
+			      uram_hi - uram_lo, PMP_R | PMP_W);
 
 	if (mmio_hi > mmio_lo)
-		pmp_set_napot(ULMK_ARCH_PMP_MMIO, mmio_lo, mmio_hi - mmio_lo,
-			      PMP_R | PMP_W);
+		pmp_set_napot(img, ULMK_ARCH_PMP_MMIO, mmio_lo,
+			      mmio_hi - mmio_lo, PMP_R | PMP_W);
 
 	/*
-	 * STACK sits inside the static URAM NAPOT window — skip it.  Remaining
-	 * dynamic entries (heap / shared / spare) use TOR slots.
+	 * STACK sits inside the static URAM NAPOT window — compaction drops
+	 * it.  Adjacent heap / shared entries are merged only when the union
+	 * is itself a NAPOT range, so coverage never grows.
 	 */
-	slot = ULMK_ARCH_PMP_USER_BASE;
-	if (regions && count > 0u) {
-		for (i = 0u; i < count && slot < ULMK_ARCH_PMP_NUM; i++) {
-			uint8_t perm = 0u;
-
-			if (regions[i].type == ULMK_REGION_STACK)
-				continue;
-
-			if (regions[i].perms & ULMK_PERM_READ)
-				perm |= PMP_R;
-			if (regions[i].perms & ULMK_PERM_WRITE)
-				perm |= PMP_W;
-			if (regions[i].perms & ULMK_PERM_EXEC)
-				perm |= PMP_X;
-
-			pmp_set_tor(slot, regions[i].base,
-				    regions[i].base + regions[i].size, perm);
-			slot++;
+	n = ulmk_mpu_compact(regions, count, dyn,
+			     (uint8_t)ULMK_ARCH_MPU_DYN_SLOTS,
+			     ULMK_MPU_MERGE_POW2, merged);
+	for (i = 0u; i < n; i++) {
+		uint8_t perm = 0u;
+
+		if (dyn[i].perms & ULMK_PERM_READ)
+			perm |= PMP_R;
+		if (dyn[i].perms & ULMK_PERM_WRITE)
+			perm |= PMP_W;
+		if (dyn[i].perms & ULMK_PERM_EXEC)
+			perm |= PMP_X;
+
+		pmp_set_napot(img, (uint8_t)(ULMK_ARCH_PMP_USER_BASE + i),
+			      dyn[i].base, dyn[i].size, perm);
+	}
+}
+
+/*
+ * PMP CSRs are per-hart.  The "last programmed" cache must not be global or
+ * one CPU's switch causes another's mpu_switch to skip a real rewrite.
+ * @hw shadows what this hart's PMP CSRs currently hold; it is only trusted
+ * once @valid is set by a full commit.
+ */
+struct pmp_cpu_cache {
+	const ulmk_arch_region_t *regions;
+	uint8_t count;
+	uint8_t prs;
+	uint8_t dyn;
+	bool    valid;
+	struct pmp_image hw;
+	ulmk_mpu_stats_t stats;
+};
+
+/*
+ * prs=0xFF forces the first mpu_switch on every hart to program PMP.
+ * Zero-init would equal ULMK_ARCH_PRS_KERNEL and skip the first rewrite
+ * on CPU2+ when NUM_CPU > 2.
+ */
+static struct pmp_cpu_cache g_pmp_cache[ULMK_ARCH_NUM_CPU] = {
+	[0 ... ULMK_ARCH_NUM_CPU - 1] = { .prs = 0xFFu },
+};
+
+static struct pmp_cpu_cache *pmp_this_cpu(void)
+{
+	uint32_t cpu = ulmk_arch_cpu_id();
+
+	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		cpu = 0u;
+	return &g_pmp_cache[cpu];
+}
+
+/*
+ * Write only the entries of @want that differ from the shadow.  An OFF entry
+ * ignores its pmpaddr (no TOR users here), so a stale address is left alone;
+ * each pmpcfg word is written at most once.
+ */
+static void pmp_commit(struct pmp_cpu_cache *c, const struct pmp_image *want)
+{
+	uint32_t writes = 0u;
+	uint8_t  i;
+
+	for (i = 0u; i < ULMK_ARCH_PMP_NUM; i++) {
+		uint8_t cfg   = pmp_image_cfg(want, i);
+		bool    dirty = !c->valid || cfg != pmp_image_cfg(&c->hw, i);
+
+		if (cfg != 0u && (!c->valid || want->addr[i] != c->hw.addr[i])) {
+			pmp_write_addr(i, want->addr[i]);
+			c->hw.addr[i] = want->addr[i];
+			dirty = true;
 		}
+		if (dirty)
+			writes++;
 	}
+
+	if (!c->valid || want->cfg[0] != c->hw.cfg[0])
+		write_pmpcfg0(want->cfg[0]);
+	if (ULMK_ARCH_PMP_NUM > 4u &&
+	    (!c->valid || want->cfg[1] != c->hw.cfg[1]))
+		write_pmpcfg1(want->cfg[1]);
+	c->hw.cfg[0] = want->cfg[0];
+	c->hw.cfg[1] = want->cfg[1];
+	c->valid     = true;
+
+	c->stats.slot_writes += writes;
+	c->stats.slot_skips  += ULMK_ARCH_PMP_NUM - writes;
+	if (writes == 0u)
+		c->stats.unchanged++;
 }
 
 void ulmk_arch_mpu_init(void)
 {
-	pmp_kernel_layout();
+	struct pmp_cpu_cache *c = pmp_this_cpu();
+	struct pmp_image      img;
+
+	pmp_kernel_layout(&img);
+	c->valid = false;
+	pmp_commit(c, &img);
 }
 
 void ulmk_arch_mpu_enable(void)
@@ -469,6 +535,7 @@ void ulmk_arch_mpu_enable(void)
 void ulmk_arch_mpu_disable(void)
 {
 	pmp_clear_all();
+	pmp_this_cpu()->valid = false;
 }
 
 void ulmk_arch_mpu_configure(uint8_t prs, const ulmk_arch_region_t *regions,
@@ -479,26 +546,6 @@ void ulmk_arch_mpu_configure(uint8_t prs, const ulmk_arch_region_t *regions,
 	(void)count;
 }
 
-/*
- * PMP CSRs are per-hart.  The "last programmed" cache must not be global or
- * one CPU's switch causes another's mpu_switch to skip a real rewrite.
- */
-struct pmp_cpu_cache {
-	const ulmk_arch_region_t *regions;
-	uint8_t count;
-	uint8_t prs;
-	uint8_t dyn;
-};
-
-/*
- * prs=0xFF forces the first mpu_switch on every hart to program PMP.
- * Zero-init would equal ULMK_ARCH_PRS_KERNEL and skip the first rewrite
- * on CPU2+ when NUM_CPU > 2.
- */
-static struct pmp_cpu_cache g_pmp_cache[ULMK_ARCH_NUM_CPU] = {
-	[0 ... ULMK_ARCH_NUM_CPU - 1] = { .prs = 0xFFu },
-};
-
 static uint8_t pmp_dyn_count(const ulmk_arch_region_t *regions, uint8_t count)
 {
 	uint8_t n = 0u;
@@ -516,22 +563,21 @@ static uint8_t pmp_dyn_count(const ulmk_arch_region_t *regions, uint8_t count)
 void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 			uint8_t prs)
 {
-	struct pmp_cpu_cache *c;
-	uint32_t              cpu;
+	struct pmp_cpu_cache *c = pmp_this_cpu();
+	struct pmp_image      img;
 	uint8_t               eff;
 
-	cpu = ulmk_arch_cpu_id();
-	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
-		cpu = 0u;
-	c = &g_pmp_cache[cpu];
+	c->stats.switches++;
 
 	/*
 	 * On SMP only skip when this hart already has the exact same layout.
 	 * The stack-only fast path was UP-friendly but races badly when another
 	 * hart's view of "already programmed" is assumed.
 	 */
-	if (prs == c->prs && regions == c->regions && count == c->count)
+	if (prs == c->prs && regions == c->regions && count == c->count) {
+		c->stats.unchanged++;
 		return;
+	}
 
 	eff = (prs == ULMK_ARCH_PRS_KERNEL) ? 0u : pmp_dyn_count(regions, count);
 
@@ -541,14 +587,21 @@ void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 	    prs != ULMK_ARCH_PRS_KERNEL) {
 		c->regions = regions;
 		c->count   = count;
+		c->stats.unchanged++;
 		return;
 	}
 #endif
 
+	/*
+	 * Kernel <-> user round trips on every trap differ only in the
+	 * KERNEL/KRAM and dynamic cfg bytes, so the commit usually lands as
+	 * one or two pmpcfg writes instead of a full clear-and-reprogram.
+	 */
 	if (prs == ULMK_ARCH_PRS_KERNEL)
-		pmp_kernel_layout();
+		pmp_kernel_layout(&img);
 	else
-		pmp_user_layout(regions, count);
+		pmp_user_layout(&img, regions, count, &c->stats.merged);
+	pmp_commit(c, &img);
 
 	c->prs     = prs;
 	c->regions = regions;
@@ -556,6 +609,13 @@ void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 	c->dyn     = eff;
 }
 
+void ulmk_arch_mpu_stats(uint32_t cpu, ulmk_mpu_stats_t *out)
+{
+	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		cpu = 0u;
+	*out = g_pmp_cache[cpu].stats;
+}
+
 bool ulmk_arch_mpu_addr_permitted(uintptr_t addr, size_t size, uint32_t perms)
 {
 	(void)addr;
@@ -593,7 +653,8 @@ void _ulmk_trap_dispatch(struct riscv_trap_frame *frame)
 
 	if (mcause & MCAUSE_INT_BIT) {
 		riscv_irq_handle_interrupt(mcause);
-		ulmk_kern_trap_mpu_restore();
+		if (!riscv_irq_nested())
+			ulmk_kern_trap_mpu_restore();
 		return;
 	}
 
@@ -627,9 +688,18 @@ void _ulmk_trap_dispatch(struct riscv_trap_frame *frame)
 	 * U-mode fetch of kernel text may raise INST_FAULT (PMP deny) or,
 	 * when a NAPOT user RX window overlaps and the first insn is a
 	 * privileged CSR (-O1+), ILLEGAL_INST.  Userspace load/store/fetch
-	 * faults are recoverable (kill thread).  M-mode faults panic.
+	 * faults are recoverable (kill thread) unless mtval lies in a region
+	 * the kernel left unloaded; mepc is untouched, so returning retries
+	 * the access.  M-mode faults panic.
 	 */
 	mstatus = frame->regs[TF_MSTATUS / 4u];
+	if (((mstatus >> MSTATUS_MPP_SHIFT) & 3u) == 0u &&
+	    (code == MCAUSE_LOAD_FAULT || code == MCAUSE_STORE_FAULT ||
+	     code == MCAUSE_INST_FAULT) &&
+	    ulmk_kern_trap_mpu_fault((uintptr_t)read_mtval())) {
+		ulmk_kern_trap_mpu_restore();
+		return;
+	}
 	if (((mstatus >> MSTATUS_MPP_SHIFT) & 3u) == 0u &&
 	    (code == MCAUSE_LOAD_FAULT || code == MCAUSE_STORE_FAULT ||
 	     code == MCAUSE_INST_FAULT || code == MCAUSE_ILLEGAL_INST))
@@ -638,6 +708,17 @@ void _ulmk_trap_dispatch(struct riscv_trap_frame *frame)
 		ulmk_arch_trap_entry(mcause_to_trap_class(mcause), (uint8_t)code);
 }
 
+/* CLIC shv vector for @srpn (trap.S); the frame is saved as above. */
+void _ulmk_clic_vector(struct riscv_trap_frame *frame, uint32_t srpn)
+{
+	(void)frame;
+
+	ulmk_arch_mpu_switch(NULL, 0, ULMK_ARCH_PRS_KERNEL);
+	riscv_clic_vector((uint8_t)srpn);
+	if (!riscv_irq_nested())
+		ulmk_kern_trap_mpu_restore();
+}
+
 void ulmk_arch_syscall_entry(void)
 {
 }
@@ -716,15 +797,12 @@ void ulmk_arch_trap_entry(uint8_t trap_class, uint8_t tin)
 	dump_puts(" mcause=");
 	dump_hex8(mcause);
 	dump_puts(" mtval=");
-	{
-		uint32_t mtval;
-
-		__asm__ volatile("csrr %0, mtval" : "=r"(mtval));
-		dump_hex8(mtval);
-	}
+	dump_hex8(read_mtval());
 	dump_puts("\n");
 	ulmk_arch_trap_dump(trap_class, tin);
 
+	if (ulmk_irq_in_attach())
+		riscv_irq_nest_abort();
 	if (trap_class == 0u || ulmk_irq_in_attach())
 		ulmk_kern_trap_recoverable();
 	else
@@ -34,6 +34,11 @@
 #define ULMK_ARCH_PMP_MMIO	4
 #define ULMK_ARCH_PMP_USER_BASE	5
 
+/* Per-thread entries left after the static windows. */
+#define ULMK_ARCH_MPU_DYN_SLOTS	(ULMK_ARCH_PMP_NUM - ULMK_ARCH_PMP_USER_BASE)
+/* mtval carries the faulting address — lazy region loads are possible. */
+#define ULMK_ARCH_HAVE_MPU_FAULT_ADDR	1
+
 #if ULMK_ARCH_PMP_NUM <= 5
 #define ULMK_ARCH_PMP_DYNAMIC_BASE	ULMK_ARCH_PMP_NUM
 #else
@@ -104,6 +109,23 @@
 #define ULMK_ARCH_PLIC_ENABLE_STRIDE	0x80u
 #define ULMK_ARCH_PLIC_CONTEXT_BASE	(ULMK_BOARD_PLIC_BASE + 0x200000u)
 #define ULMK_ARCH_PLIC_CONTEXT_STRIDE	0x1000u
+
+/*
+ * Source ids 1..ULMK_ARCH_PLIC_NUM_SRC-1 are bindable (spec limit 1024) and
+ * priorities 1..ULMK_ARCH_PLIC_MAX_PRIO exist (virt / SiFive: 7).
+ */
+#ifndef ULMK_ARCH_PLIC_NUM_SRC
+#define ULMK_ARCH_PLIC_NUM_SRC		1024u
+#endif
+#ifndef ULMK_ARCH_PLIC_MAX_PRIO
+#define ULMK_ARCH_PLIC_MAX_PRIO		7u
+#endif
+#define ULMK_ARCH_PLIC_ID_MASK		0x3FFu
+
+/* PLIC context of a hart's M-mode interrupts (virt / SiFive: M, S per hart). */
+#ifndef ULMK_ARCH_PLIC_HART_CTX
+#define ULMK_ARCH_PLIC_HART_CTX(hart)	((uint32_t)(hart) * 2u)
+#endif
 #endif /* ULMK_ARCH_HAVE_PLIC */
 
 #define ULMK_ARCH_CTX_FRAME_SIZE	64u
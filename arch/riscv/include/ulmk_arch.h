@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <ulmk/microkernel.h>
+#include <ulmk/config.h>
 #include <arch_config.h>
 
 typedef struct {
@@ -19,11 +20,32 @@ typedef struct {
 
 typedef uint32_t ulmk_arch_irq_key_t;
 
+/* Set in a key when IRQs were already masked; the restore is then a no-op. */
+#define ULMK_IRQ_KEY_SKIP	(1u << 31)
+
+/*
+ * Ticket spinlock: a locker takes @next with an atomic add on @word and
+ * spins until @owner (low half, little-endian) reaches it; unlock advances
+ * @owner.  CPUs are served in arrival order.  With ULMK_CONFIG_SPINLOCK_STATS
+ * the holder also counts acquisitions, contended ones and cycles spun.
+ */
 typedef struct {
-	volatile uint32_t locked;
+	union {
+		volatile uint32_t word;
+		struct {
+			volatile uint16_t owner;
+			volatile uint16_t next;
+		} t;
+	} u;
+#if ULMK_CONFIG_SPINLOCK_STATS
+	uint32_t acquires;
+	uint32_t contended;
+	uint64_t spin_cycles;
+#endif
 } ulmk_spinlock_t;
 
-#define ULMK_SPINLOCK_INIT	{ 0u }
+#define ULMK_SPINLOCK_INIT	{ .u = { .word = 0u } }
+#define ULMK_ARCH_HAVE_SPINLOCK_STATS	1
 
 typedef struct {
 	uintptr_t base;
@@ -90,11 +112,14 @@ void ulmk_arch_mpu_configure(uint8_t prs, const ulmk_arch_region_t *regions,
 			   uint8_t count);
 void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 			uint8_t prs);
+void ulmk_arch_mpu_stats(uint32_t cpu, ulmk_mpu_stats_t *out);
 bool ulmk_arch_mpu_addr_permitted(uintptr_t addr, size_t size, uint32_t perms);
 
 void ulmk_arch_irq_vectors_init(uintptr_t btv, uintptr_t biv, uintptr_t isp_top);
 void ulmk_arch_irq_src_configure(uint8_t srpn, uint8_t priority, uint8_t cpu_id);
 void ulmk_arch_irq_src_register(uint8_t srpn, uint32_t src_reg_addr);
+void ulmk_arch_irq_src_priority(uint8_t srpn, uint8_t priority);
+void ulmk_arch_irq_src_route(uint8_t srpn, uint8_t cpu_id);
 void ulmk_arch_irq_src_enable(uint8_t srpn);
 void ulmk_arch_irq_src_disable(uint8_t srpn);
 void ulmk_arch_irq_src_ack(uint8_t srpn);
@@ -109,6 +134,21 @@ uint32_t ulmk_arch_atomic_cas(volatile uint32_t *ptr,
 			    uint32_t expected, uint32_t desired);
 uint32_t ulmk_arch_atomic_add(volatile uint32_t *ptr, uint32_t val);
 
+/*
+ * Order earlier stores before later ones as seen by other harts — for data
+ * published to lock-free readers (which rely on the address dependency).
+ */
+static inline void ulmk_arch_wmb(void)
+{
+	__asm__ volatile("fence rw, w" ::: "memory");
+}
+
+/* Order earlier loads before later ones — pairs with ulmk_arch_wmb(). */
+static inline void ulmk_arch_rmb(void)
+{
+	__asm__ volatile("fence r, r" ::: "memory");
+}
+
 /*
  * ulmk_kern_start - common C runtime bring-up (kernel/init/init.c); no return.
  * Entered from startup.S after the CPU prologue (stack) with interrupts off;
@@ -149,6 +189,7 @@ void ulmk_kern_trap_recoverable(void);
 void ulmk_kern_trap_panic(void);
 bool ulmk_irq_in_attach(void);
 void ulmk_kern_trap_mpu_restore(void);
+bool ulmk_kern_trap_mpu_fault(uintptr_t addr);
 void ulmk_kern_main(const ulmk_boot_info_t *info);
 
 #endif /* ULMK_ARCH_H */
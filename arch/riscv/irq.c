@@ -6,14 +6,18 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <ulmk/microkernel.h>
+#include <ulmk/config.h>
 #include <ulmk_arch.h>
 #include "irq_internal.h"
 
 uint32_t g_src_addr[256];
 uint8_t  g_src_type[256];
 uint32_t g_src_plic_id[256];
-uint8_t  g_plic_to_srpn[64];
-uint8_t  g_next_plic_id = 2u;
+uint8_t  g_src_plic_hart[256];
+#if ULMK_ARCH_HAVE_PLIC
+uint8_t  g_plic_to_srpn[ULMK_ARCH_PLIC_NUM_SRC];
+#endif
+uint16_t g_next_plic_id = 2u;
 uint16_t g_src_clic_irq[256];
 
 #if ULMK_ARCH_HAVE_CLINT
@@ -35,6 +39,7 @@ extern void riscv_clic_enable(uint8_t srpn);
 extern void riscv_clic_disable(uint8_t srpn);
 extern void riscv_clic_ack(uint8_t srpn);
 extern void riscv_clic_dispatch(uint32_t mcause);
+extern void riscv_clic_set_level(uint8_t srpn, uint8_t priority);
 extern bool riscv_clic_is_binding(uint8_t srpn);
 #else
 static inline bool riscv_clic_is_binding(uint8_t srpn) { (void)srpn; return false; }
@@ -44,6 +49,7 @@ static inline bool riscv_clic_is_binding(uint8_t srpn) { (void)srpn; return fals
 extern void riscv_plic_init(void);
 extern void riscv_plic_configure(uint8_t srpn, uint8_t p, uint8_t c);
 extern void riscv_plic_register(uint8_t srpn, uint32_t addr);
+extern void riscv_plic_route(uint8_t srpn, uint8_t hart);
 extern void riscv_plic_enable(uint8_t srpn);
 extern void riscv_plic_disable(uint8_t srpn);
 extern void riscv_plic_ack(uint8_t srpn);
@@ -52,8 +58,58 @@ extern void riscv_plic_trigger(uint8_t srpn);
 extern void riscv_plic_dispatch(void);
 #endif
 
+#if ULMK_CONFIG_IRQ_NESTING
+/* Attach callbacks open to more urgent lines on each hart (see below). */
+static volatile uint8_t g_irq_nest[ULMK_ARCH_NUM_CPU];
+static uint32_t         g_irq_nest_mie[ULMK_ARCH_NUM_CPU];
+
+/*
+ * mie bits left on in a window.  The CLIC gates by level and ignores mie;
+ * a PLIC hart keeps MEIE and gates by its context threshold instead.
+ */
+#if ULMK_ARCH_HAVE_PLIC && !ULMK_ARCH_HAVE_CLIC
+#define IRQ_NEST_MIE_KEEP	(1u << 11)	/* MEIE */
+#else
+#define IRQ_NEST_MIE_KEEP	0u
+#endif
+
+bool riscv_irq_nested(void)
+{
+	return g_irq_nest[ulmk_arch_cpu_id()] != 0u;
+}
+
+/* A callback faulted: its windows never close, the kill path unwinds. */
+void riscv_irq_nest_abort(void)
+{
+	uint32_t hart = ulmk_arch_cpu_id();
+
+#if ULMK_ARCH_HAVE_PLIC && !ULMK_ARCH_HAVE_CLIC
+	riscv_plic_nest_reset();
+#endif
+	if (!g_irq_nest[hart])
+		return;
+	g_irq_nest[hart] = 0u;
+	__asm__ volatile("csrs mie, %0" :: "r"(g_irq_nest_mie[hart]));
+}
+#else
+bool riscv_irq_nested(void)
+{
+	return false;
+}
+
+void riscv_irq_nest_abort(void)
+{
+}
+#endif
+
+/*
+ * A nested ISR leaves the switch to the one it preempted: that one is
+ * still inside the kernel's IRQ path.
+ */
 void _arch_generic_isr_handler(void)
 {
+	if (riscv_irq_nested())
+		return;
 	ulmk_kern_sched_dispatch(true);
 }
 
@@ -74,6 +130,9 @@ void riscv_irq_handle_interrupt(uint32_t mcause)
 {
 	if (!(mcause & MCAUSE_INT_BIT))
 		return;
+#if ULMK_ARCH_HAVE_CLIC
+	mcause &= MCAUSE_INT_BIT | MCAUSE_CLIC_CODE;
+#endif
 
 #if ULMK_ARCH_HAVE_PLIC
 	if (mcause == MCAUSE_MEXT) {
@@ -92,12 +151,24 @@ void riscv_irq_handle_interrupt(uint32_t mcause)
 #endif
 }
 
+/* Point this hart's traps at @base; also run by each secondary hart. */
+void riscv_irq_trap_vector_init(uintptr_t base)
+{
+#if ULMK_ARCH_HAVE_CLIC
+	/* CLIC mode (mtvec[1:0] = 3); shv lines vector through mtvt. */
+	__asm__ volatile("csrw 0x307, %0" :: "r"((uint32_t)riscv_clic_vtable()));
+	__asm__ volatile("csrw mtvec, %0" :: "r"(((uint32_t)base & ~63u) | 3u));
+#else
+	__asm__ volatile("csrw mtvec, %0" :: "r"((uint32_t)base));
+#endif
+}
+
 void ulmk_arch_irq_vectors_init(uintptr_t btv, uintptr_t biv, uintptr_t isp_top)
 {
 	(void)biv;
 	(void)isp_top;
 
-	__asm__ volatile("csrw mtvec, %0" :: "r"((uint32_t)btv));
+	riscv_irq_trap_vector_init(btv);
 	riscv_irq_init();
 }
 
@@ -136,6 +207,31 @@ void ulmk_arch_irq_src_register(uint8_t srpn, uint32_t src_reg_addr)
 #endif
 }
 
+/* Binding priority on the SRPN scale: CLIC level or PLIC source priority. */
+void ulmk_arch_irq_src_priority(uint8_t srpn, uint8_t priority)
+{
+#if ULMK_ARCH_HAVE_CLIC
+	riscv_clic_set_level(srpn, priority);
+#endif
+#if ULMK_ARCH_HAVE_PLIC
+	riscv_plic_set_priority(srpn, priority);
+#endif
+	(void)srpn;
+	(void)priority;
+}
+
+/* CLINT and CLIC lines are hart-local; only PLIC sources can move. */
+void ulmk_arch_irq_src_route(uint8_t srpn, uint8_t cpu_id)
+{
+#if ULMK_ARCH_HAVE_PLIC
+	if (g_src_type[srpn] == IRQ_SRC_PLIC)
+		riscv_plic_route(srpn, cpu_id);
+#else
+	(void)srpn;
+	(void)cpu_id;
+#endif
+}
+
 void ulmk_arch_irq_src_enable(uint8_t srpn)
 {
 	if (riscv_clint_is_binding(srpn)) {
@@ -212,6 +308,43 @@ void ulmk_arch_irq_src_trigger(uint8_t srpn)
 	(void)srpn;
 }
 
+#if ULMK_CONFIG_IRQ_NESTING
+/*
+ * Run @fn with MIE set.  The CLIC keeps mintstatus.mil at the level of the
+ * line being served, so only a more urgent line can preempt it; the CLINT
+ * lines sit below every binding.  With a PLIC the hart's threshold is
+ * raised to the priority of the source in service and only MEIE stays on
+ * (external interrupts outrank the CLINT ones).  A nested ISR runs the
+ * kernel IRQ path on this stack and leaves the context switch to this one.
+ */
+static bool irq_attach_call_open(ulmk_irq_attach_fn_t fn, void *data)
+{
+	uint32_t hart = ulmk_arch_cpu_id();
+	uint32_t mie;
+	uint32_t thr = 0u;
+	bool     ret;
+
+	__asm__ volatile("csrrc %0, mie, %1"
+			 : "=r"(mie) : "r"(~IRQ_NEST_MIE_KEEP));
+	if (!g_irq_nest[hart])
+		g_irq_nest_mie[hart] = mie;
+	g_irq_nest[hart]++;
+#if ULMK_ARCH_HAVE_PLIC && !ULMK_ARCH_HAVE_CLIC
+	thr = riscv_plic_threshold_raise();
+#endif
+	__asm__ volatile("csrs mstatus, %0" :: "r"(MSTATUS_MIE_BIT) : "memory");
+	ret = fn(data);
+	__asm__ volatile("csrc mstatus, %0" :: "r"(MSTATUS_MIE_BIT) : "memory");
+#if ULMK_ARCH_HAVE_PLIC && !ULMK_ARCH_HAVE_CLIC
+	riscv_plic_threshold_set(thr);
+#endif
+	(void)thr;
+	g_irq_nest[hart]--;
+	__asm__ volatile("csrs mie, %0" :: "r"(mie));
+	return ret;
+}
+#endif
+
 bool ulmk_arch_irq_attach_call(ulmk_irq_attach_fn_t fn, void *data,
 			       const ulmk_arch_region_t *regions,
 			       uint8_t count)
@@ -226,5 +359,9 @@ bool ulmk_arch_irq_attach_call(ulmk_irq_attach_fn_t fn, void *data,
 
 	if (!fn)
 		return false;
+#if ULMK_CONFIG_IRQ_NESTING
+	return irq_attach_call_open(fn, data);
+#else
 	return fn(data);
+#endif
 }
@@ -4,6 +4,22 @@
  *
  * Core-local interrupts via MMIO (CLIC v0.9 layout).  Enabled when
  * ULMK_ARCH_HAVE_CLIC=1 in arch_config.h / board.cmake.
+ *
+ * The CLIC runs in CLIC mode with selective hardware vectoring: a bound
+ * line gets clicintattr.shv and mtvt[line] points at the vector of its
+ * SRPN (trap.S), which saves the full frame and enters the kernel with the
+ * SRPN in hand.  Exceptions and the CLINT-compatible local lines (msip,
+ * mtip) still enter at the mtvec base and decode mcause.
+ *
+ * cliccfg.nlbits = 8 makes all of clicintctl the interrupt level, and the
+ * level is the binding's priority on the SRPN scale (the SRPN, or the
+ * handler thread's priority for thread bindings — see
+ * ulmk_arch_irq_src_priority()), so as on TriCore a more urgent line wins
+ * arbitration (the CLIC keeps only the upper CLICINTCTLBITS bits).  The
+ * local lines sit at level 1, below every binding.  mintstatus.mil holds
+ * the running line's level until mret; with ULMK_CONFIG_IRQ_NESTING a more
+ * urgent line preempts an attach callback (see irq.c).  The rest of the
+ * kernel path runs with MIE clear.
  */
 
 #include <stdint.h>
@@ -20,6 +36,29 @@ extern uint8_t  g_src_type[256];
 extern uint16_t g_src_clic_irq[256];
 
 #define CLIC_INT_REGION_SIZE	0x1000u
+#define CLIC_NUM_INT		(CLIC_INT_REGION_SIZE / 4u)
+
+#define CLICCFG_NLBITS_8	(8u << 1)
+#define CLICINTATTR_SHV		0x01u
+#define CLICINTATTR_MODE_M	0xC0u
+#define CLIC_LEVEL_LOCAL	1u
+#define CLIC_LINE_MSIP		3u
+#define CLIC_LINE_MTIP		7u
+
+/* Vectors in trap.S, 16 bytes per SRPN. */
+#define CLIC_VEC_STRIDE		16u
+extern void _ulmk_clic_vectors(void);
+
+/* CLIC id → SRPN (0 = unbound); written at bind, read by the ISR. */
+static uint8_t g_clic_to_srpn[CLIC_NUM_INT];
+
+/* mtvt: per-line vector, read by the hart on every shv interrupt. */
+static uint32_t g_clic_mtvt[CLIC_NUM_INT] __attribute__((aligned(64)));
+
+static inline volatile uint8_t *clic_cfg(void)
+{
+	return (volatile uint8_t *)(uintptr_t)ULMK_BOARD_CLIC_BASE;
+}
 
 static inline volatile uint8_t *clic_intip(uint32_t irq)
 {
@@ -32,6 +71,33 @@ static inline volatile uint8_t *clic_intie(uint32_t irq)
 	return clic_intip(irq) + 1u;
 }
 
+static inline volatile uint8_t *clic_intattr(uint32_t irq)
+{
+	return clic_intip(irq) + 2u;
+}
+
+static inline volatile uint8_t *clic_intctl(uint32_t irq)
+{
+	return clic_intip(irq) + 3u;
+}
+
+/* Level 0 is thread level and never taken. */
+static inline uint8_t clic_level(uint8_t priority)
+{
+	return priority ? priority : 1u;
+}
+
+/* M-mode line at @level; @shv selects its mtvt vector.  Keeps trig. */
+static void clic_line_setup(uint32_t irq, uint8_t level, bool shv)
+{
+	uint8_t attr = *clic_intattr(irq);
+
+	attr &= (uint8_t)~CLICINTATTR_SHV;
+	attr |= CLICINTATTR_MODE_M | (shv ? CLICINTATTR_SHV : 0u);
+	*clic_intattr(irq) = attr;
+	*clic_intctl(irq)  = level;
+}
+
 static inline bool clic_src_is_int_reg(uint32_t addr, uint32_t *irq_out)
 {
 	uint32_t off;
@@ -45,8 +111,31 @@ static inline bool clic_src_is_int_reg(uint32_t addr, uint32_t *irq_out)
 	return true;
 }
 
+uintptr_t riscv_clic_vtable(void)
+{
+	return (uintptr_t)g_clic_mtvt;
+}
+
 void riscv_clic_init(void)
 {
+	riscv_clic_hart_init();
+}
+
+/*
+ * Per-hart part of the bring-up.  mie is hardwired to zero in CLIC mode,
+ * so the CLINT lines are enabled here for good; mtimecmp and msip gate
+ * them as before.
+ */
+void riscv_clic_hart_init(void)
+{
+	*clic_cfg() = CLICCFG_NLBITS_8;
+	__asm__ volatile("csrw 0x347, zero");	/* mintthresh */
+#if ULMK_ARCH_HAVE_CLINT
+	clic_line_setup(CLIC_LINE_MSIP, CLIC_LEVEL_LOCAL, false);
+	clic_line_setup(CLIC_LINE_MTIP, CLIC_LEVEL_LOCAL, false);
+	*clic_intie(CLIC_LINE_MSIP) = 1u;
+	*clic_intie(CLIC_LINE_MTIP) = 1u;
+#endif
 }
 
 bool riscv_clic_is_binding(uint8_t srpn)
@@ -61,9 +150,28 @@ void riscv_clic_register(uint8_t srpn, uint32_t src_reg_addr)
 	if (!clic_src_is_int_reg(src_reg_addr, &irq))
 		return;
 
+	/* Re-registered on another line: the old one no longer maps here. */
+	if (g_src_type[srpn] == IRQ_SRC_CLIC && g_src_clic_irq[srpn] != irq &&
+	    g_clic_to_srpn[g_src_clic_irq[srpn]] == srpn) {
+		*clic_intie(g_src_clic_irq[srpn]) = 0u;
+		g_clic_to_srpn[g_src_clic_irq[srpn]] = 0u;
+	}
+
 	g_src_type[srpn]     = IRQ_SRC_CLIC;
 	g_src_clic_irq[srpn] = (uint16_t)irq;
 	g_src_addr[srpn]     = src_reg_addr;
+	g_clic_to_srpn[irq]  = srpn;
+	g_clic_mtvt[irq]     = (uint32_t)(uintptr_t)_ulmk_clic_vectors +
+			       (uint32_t)srpn * CLIC_VEC_STRIDE;
+	__asm__ volatile("fence" ::: "memory");
+	clic_line_setup(irq, clic_level(srpn), true);
+}
+
+void riscv_clic_set_level(uint8_t srpn, uint8_t priority)
+{
+	if (g_src_type[srpn] != IRQ_SRC_CLIC)
+		return;
+	*clic_intctl(g_src_clic_irq[srpn]) = clic_level(priority);
 }
 
 void riscv_clic_ack(uint8_t srpn)
@@ -84,7 +192,6 @@ void riscv_clic_enable(uint8_t srpn)
 		return;
 	irq = g_src_clic_irq[srpn];
 	*clic_intie(irq) = 1u;
-	__asm__ volatile("csrs mstatus, %0" :: "r"(MSTATUS_MIE_BIT));
 }
 
 void riscv_clic_disable(uint8_t srpn)
@@ -97,22 +204,27 @@ void riscv_clic_disable(uint8_t srpn)
 	*clic_intie(irq) = 0u;
 }
 
-void riscv_clic_dispatch(uint32_t mcause)
+/* Vectored entry: the line's vector already knows its SRPN. */
+void riscv_clic_vector(uint8_t srpn)
 {
-	uint32_t     irq;
-	uint16_t     srpn;
-	uint16_t     bound;
-
-	irq = mcause & 0xFFFu;
-	for (srpn = 1u; srpn < 256u; srpn++) {
-		if (g_src_type[srpn] != IRQ_SRC_CLIC)
-			continue;
-		bound = g_src_clic_irq[srpn];
-		if (bound != irq)
-			continue;
+	if (g_src_type[srpn] == IRQ_SRC_CLIC) {
+		ulmk_kern_irq_dispatch(srpn);
+		riscv_clic_ack(srpn);
+	}
+	_arch_generic_isr_handler();
+}
 
-		ulmk_kern_irq_dispatch((uint8_t)srpn);
-		riscv_clic_ack((uint8_t)srpn);
+/* A line without shv, taken at the mtvec base. */
+void riscv_clic_dispatch(uint32_t mcause)
+{
+	uint32_t irq = mcause & MCAUSE_CLIC_CODE;
+	uint8_t  srpn;
+
+	srpn = irq < CLIC_NUM_INT ? g_clic_to_srpn[irq] : 0u;
+	if (srpn && g_src_type[srpn] == IRQ_SRC_CLIC &&
+	    g_src_clic_irq[srpn] == irq) {
+		ulmk_kern_irq_dispatch(srpn);
+		riscv_clic_ack(srpn);
 	}
 	_arch_generic_isr_handler();
 }
@@ -120,8 +232,12 @@ void riscv_clic_dispatch(uint32_t mcause)
 #else /* !ULMK_ARCH_HAVE_CLIC */
 
 void riscv_clic_init(void) { }
+void riscv_clic_hart_init(void) { }
+uintptr_t riscv_clic_vtable(void) { return 0u; }
 bool riscv_clic_is_binding(uint8_t srpn) { (void)srpn; return false; }
 void riscv_clic_register(uint8_t srpn, uint32_t a) { (void)srpn; (void)a; }
+void riscv_clic_set_level(uint8_t srpn, uint8_t p) { (void)srpn; (void)p; }
+void riscv_clic_vector(uint8_t srpn) { (void)srpn; }
 void riscv_clic_enable(uint8_t srpn) { (void)srpn; }
 void riscv_clic_disable(uint8_t srpn) { (void)srpn; }
 void riscv_clic_ack(uint8_t srpn) { (void)srpn; }
@@ -17,8 +17,21 @@
 #define MCAUSE_MSOFT	(0x80000003u)
 #define MCAUSE_MTIMER	(0x80000007u)
 #define MCAUSE_MEXT	(0x8000000Bu)
+/* CLIC mode: exccode is mcause[11:0]; mpil/mpp/mpie sit above it. */
+#define MCAUSE_CLIC_CODE	0xFFFu
 
 void riscv_irq_init(void);
+void riscv_irq_trap_vector_init(uintptr_t base);
+void riscv_plic_hart_init(void);
+void riscv_plic_set_priority(uint8_t srpn, uint8_t priority);
+uint32_t riscv_plic_threshold_raise(void);
+void riscv_plic_threshold_set(uint32_t threshold);
+void riscv_plic_nest_reset(void);
+void riscv_clic_hart_init(void);
+uintptr_t riscv_clic_vtable(void);
+void riscv_clic_vector(uint8_t srpn);
+bool riscv_irq_nested(void);
+void riscv_irq_nest_abort(void);
 
 void riscv_irq_handle_interrupt(uint32_t mcause);
 
@@ -4,6 +4,14 @@
  *
  * Machine external interrupt (MEIP / mcause=0x8000000B).
  * Enabled when ULMK_ARCH_HAVE_PLIC=1 in arch_config.h / board.cmake.
+ *
+ * Source priority follows the binding priority on the SRPN scale (higher =
+ * more urgent, as on TriCore): the SRPN itself, or the handler thread's
+ * priority for a thread binding.  It is scaled onto
+ * 1..ULMK_ARCH_PLIC_MAX_PRIO, so a claim always returns the most urgent
+ * pending source.  Contexts run at threshold 0 except inside an attach
+ * callback opened by ULMK_CONFIG_IRQ_NESTING, where the hart's threshold is
+ * the priority of the source in service and only a more urgent one nests.
  */
 
 #include <stdint.h>
@@ -17,17 +25,62 @@
 extern uint32_t g_src_addr[256];
 extern uint8_t  g_src_type[256];
 extern uint32_t g_src_plic_id[256];
-extern uint8_t  g_plic_to_srpn[64];
-extern uint8_t  g_next_plic_id;
+extern uint8_t  g_src_plic_hart[256];
+extern uint8_t  g_plic_to_srpn[ULMK_ARCH_PLIC_NUM_SRC];
+extern uint16_t g_next_plic_id;
+
+/* PLIC priority of the source each hart is serving (0: none). */
+static volatile uint8_t g_plic_serving[ULMK_ARCH_NUM_CPU];
+
+/* Each hart claims and completes through its own M-mode context. */
+static inline uintptr_t plic_context(uint32_t hart)
+{
+	return ULMK_ARCH_PLIC_CONTEXT_BASE +
+	       ULMK_ARCH_PLIC_HART_CTX(hart) * ULMK_ARCH_PLIC_CONTEXT_STRIDE;
+}
+
+static inline volatile uint32_t *plic_threshold_reg(void)
+{
+	return (volatile uint32_t *)plic_context(ulmk_arch_cpu_id());
+}
 
 static inline volatile uint32_t *plic_claim_reg(void)
 {
-	return (volatile uint32_t *)(ULMK_ARCH_PLIC_CONTEXT_BASE + 4u);
+	return (volatile uint32_t *)(plic_context(ulmk_arch_cpu_id()) + 4u);
+}
+
+static inline volatile uint32_t *plic_complete_reg(uint32_t hart)
+{
+	return (volatile uint32_t *)(plic_context(hart) + 4u);
+}
+
+/* Enable word holding @id in @hart's context. */
+static inline uint32_t plic_enable_reg(uint32_t hart, uint32_t id)
+{
+	return ULMK_ARCH_PLIC_ENABLE_BASE +
+	       ULMK_ARCH_PLIC_HART_CTX(hart) * ULMK_ARCH_PLIC_ENABLE_STRIDE +
+	       (id / 32u) * 4u;
 }
 
-static inline volatile uint32_t *plic_complete_reg(void)
+/* Priority 1..255 (SRPN scale) → PLIC 1..ULMK_ARCH_PLIC_MAX_PRIO, order kept. */
+static inline uint32_t plic_prio(uint8_t priority)
 {
-	return (volatile uint32_t *)(ULMK_ARCH_PLIC_CONTEXT_BASE + 4u);
+	return 1u + ((uint32_t)priority * (ULMK_ARCH_PLIC_MAX_PRIO - 1u)) / 255u;
+}
+
+/* Record @id as @srpn's source, routed to hart 0, at @priority. */
+static void plic_bind(uint8_t srpn, uint32_t id, uint32_t enable_reg,
+		      uint8_t priority)
+{
+	volatile uint32_t *prio =
+		(volatile uint32_t *)ULMK_ARCH_PLIC_PRIORITY_BASE;
+
+	g_src_type[srpn]      = IRQ_SRC_PLIC;
+	g_src_plic_id[srpn]   = id;
+	g_src_plic_hart[srpn] = 0u;
+	g_plic_to_srpn[id]    = srpn;
+	g_src_addr[srpn]      = enable_reg;
+	prio[id]              = plic_prio(priority);
 }
 
 static inline void set_mie_meip(void)
@@ -37,14 +90,20 @@ static inline void set_mie_meip(void)
 	__asm__ volatile("csrs mie, %0" :: "r"(bit));
 }
 
+/* Unbound sources keep their reset priority 0 (never delivered). */
 void riscv_plic_init(void)
 {
-	volatile uint32_t *prio;
-	uint32_t          i;
+	riscv_plic_hart_init();
+}
 
-	prio = (volatile uint32_t *)ULMK_ARCH_PLIC_PRIORITY_BASE;
-	for (i = 1u; i < 64u; i++)
-		prio[i] = 1u;
+/*
+ * Per-hart part of the bring-up: open this hart's context to every priority
+ * and take external interrupts, so sources routed here are delivered.
+ */
+void riscv_plic_hart_init(void)
+{
+	*plic_threshold_reg() = 0u;
+	set_mie_meip();
 }
 
 void riscv_plic_configure(uint8_t srpn, uint8_t priority, uint8_t cpu_id)
@@ -52,14 +111,11 @@ void riscv_plic_configure(uint8_t srpn, uint8_t priority, uint8_t cpu_id)
 	uint32_t id;
 
 	(void)cpu_id;
-	(void)priority;
 
+	if (g_next_plic_id >= ULMK_ARCH_PLIC_NUM_SRC)
+		return;
 	id = g_next_plic_id++;
-	g_src_type[srpn] = IRQ_SRC_PLIC;
-	g_src_plic_id[srpn] = id;
-	g_plic_to_srpn[id] = srpn;
-	g_src_addr[srpn] = ULMK_ARCH_PLIC_ENABLE_BASE +
-			   (id / 32u) * ULMK_ARCH_PLIC_ENABLE_STRIDE;
+	plic_bind(srpn, id, plic_enable_reg(0u, id), priority);
 }
 
 void riscv_plic_register(uint8_t srpn, uint32_t src_reg_addr)
@@ -70,26 +126,76 @@ void riscv_plic_register(uint8_t srpn, uint32_t src_reg_addr)
 	    src_reg_addr == ULMK_ARCH_CLINT_MSIP0)
 		return;
 
-	if (src_reg_addr < 0x00100000u) {
-		id = (src_reg_addr >> 2) & 0x3Fu;
-		if (id == 0u)
-			id = g_next_plic_id++;
-		g_src_type[srpn] = IRQ_SRC_PLIC;
-		g_src_plic_id[srpn] = id;
-		g_plic_to_srpn[id] = srpn;
-		g_src_addr[srpn] = ULMK_ARCH_PLIC_ENABLE_BASE +
-				   (id / 32u) * ULMK_ARCH_PLIC_ENABLE_STRIDE;
-		return;
-	}
-
-	id = (src_reg_addr >> 2) & 0x3Fu;
+	id = (src_reg_addr >> 2) & ULMK_ARCH_PLIC_ID_MASK;
 	if (id == 0u)
 		id = g_next_plic_id++;
+	if (id >= ULMK_ARCH_PLIC_NUM_SRC)
+		return;
 
-	g_src_type[srpn] = IRQ_SRC_PLIC;
-	g_src_plic_id[srpn] = id;
-	g_plic_to_srpn[id] = srpn;
-	g_src_addr[srpn] = src_reg_addr;
+	if (src_reg_addr < 0x00100000u)
+		plic_bind(srpn, id, plic_enable_reg(0u, id), srpn);
+	else
+		plic_bind(srpn, id, src_reg_addr, srpn);
+}
+
+/* Re-rank a bound source, e.g. at its handler thread's priority. */
+void riscv_plic_set_priority(uint8_t srpn, uint8_t priority)
+{
+	volatile uint32_t *prio =
+		(volatile uint32_t *)ULMK_ARCH_PLIC_PRIORITY_BASE;
+
+	if (g_src_type[srpn] != IRQ_SRC_PLIC || !g_src_plic_id[srpn])
+		return;
+	prio[g_src_plic_id[srpn]] = plic_prio(priority);
+}
+
+/*
+ * Nesting window: raise this hart's threshold to the source in service so
+ * only a more urgent one is claimed.  Returns the threshold to restore.
+ */
+uint32_t riscv_plic_threshold_raise(void)
+{
+	volatile uint32_t *th  = plic_threshold_reg();
+	uint32_t           old = *th;
+
+	*th = g_plic_serving[ulmk_arch_cpu_id()];
+	return old;
+}
+
+void riscv_plic_threshold_set(uint32_t threshold)
+{
+	*plic_threshold_reg() = threshold;
+}
+
+/* An attach callback faulted: its dispatch never unwinds. */
+void riscv_plic_nest_reset(void)
+{
+	g_plic_serving[ulmk_arch_cpu_id()] = 0u;
+	*plic_threshold_reg() = 0u;
+}
+
+/*
+ * Move @srpn's enable bit to @hart's context.  A source is enabled in one
+ * context at a time, so exactly one hart claims it.
+ */
+void riscv_plic_route(uint8_t srpn, uint8_t hart)
+{
+	volatile uint32_t *old;
+	uint32_t           id  = g_src_plic_id[srpn];
+	uint32_t           bit = 1u << (id & 31u);
+	bool               on;
+
+	if (!id || g_src_plic_hart[srpn] == hart)
+		return;
+
+	old = (volatile uint32_t *)(uintptr_t)g_src_addr[srpn];
+	on  = old && (*old & bit);
+	if (on)
+		*old &= ~bit;
+	g_src_addr[srpn]      = plic_enable_reg(hart, id);
+	g_src_plic_hart[srpn] = hart;
+	if (on)
+		*(volatile uint32_t *)(uintptr_t)g_src_addr[srpn] |= bit;
 }
 
 void riscv_plic_enable(uint8_t srpn)
@@ -129,7 +235,7 @@ void riscv_plic_ack(uint8_t srpn)
 
 	id = g_src_plic_id[srpn];
 	if (id)
-		*plic_complete_reg() = id;
+		*plic_complete_reg(g_src_plic_hart[srpn]) = id;
 }
 
 bool riscv_plic_is_pending(uint8_t srpn)
@@ -151,19 +257,31 @@ void riscv_plic_trigger(uint8_t srpn)
 
 void riscv_plic_dispatch(void)
 {
+	volatile uint32_t *prio =
+		(volatile uint32_t *)ULMK_ARCH_PLIC_PRIORITY_BASE;
+	uint32_t hart = ulmk_arch_cpu_id();
 	uint32_t id;
+	uint8_t  outer;
 	uint8_t  srpn;
 
 	id = *plic_claim_reg();
-	if (id == 0u || id >= 64u)
+	if (id == 0u)
+		return;
+	if (id >= ULMK_ARCH_PLIC_NUM_SRC) {
+		*plic_complete_reg(ulmk_arch_cpu_id()) = id;
 		return;
+	}
 
 	srpn = g_plic_to_srpn[id];
-	if (srpn == 0u)
+	if (srpn == 0u && id < 256u)
 		srpn = (uint8_t)id;
 
+	/* Kept for riscv_plic_threshold_raise(); a nested claim stacks it. */
+	outer = g_plic_serving[hart];
+	g_plic_serving[hart] = (uint8_t)prio[id];
 	ulmk_kern_irq_dispatch(srpn);
-	*plic_complete_reg() = id;
+	*plic_complete_reg(hart) = id;
+	g_plic_serving[hart] = outer;
 	_arch_generic_isr_handler();
 }
 
@@ -173,6 +291,12 @@ void riscv_plic_init(void) { }
 void riscv_plic_configure(uint8_t s, uint8_t p, uint8_t c)
 	{ (void)s; (void)p; (void)c; }
 void riscv_plic_register(uint8_t s, uint32_t a) { (void)s; (void)a; }
+void riscv_plic_set_priority(uint8_t s, uint8_t p) { (void)s; (void)p; }
+uint32_t riscv_plic_threshold_raise(void) { return 0u; }
+void riscv_plic_threshold_set(uint32_t t) { (void)t; }
+void riscv_plic_nest_reset(void) { }
+void riscv_plic_route(uint8_t s, uint8_t h) { (void)s; (void)h; }
+void riscv_plic_hart_init(void) { }
 void riscv_plic_enable(uint8_t s) { (void)s; }
 void riscv_plic_disable(uint8_t s) { (void)s; }
 void riscv_plic_ack(uint8_t s) { (void)s; }
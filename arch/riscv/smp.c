@@ -9,6 +9,7 @@
 #include <ulmk/config.h>
 #include <ulmk_arch.h>
 #include <arch_config.h>
+#include "irq_internal.h"
 
 #if ULMK_CONFIG_ENABLE_SMP
 #define SMP_MAX_HARTS	ULMK_ARCH_NUM_CPU
@@ -55,27 +56,44 @@ uint32_t ulmk_arch_cpu_id(void)
 	return id;
 }
 
+#define SPIN_TICKET_ONE	(1u << 16)	/* +1 on ulmk_spinlock_t.u.t.next */
+
+/*
+ * Ticket lock (see ulmk_spinlock_t).  One amoadd.w per acquisition instead
+ * of an LR/SC retry loop; waiters then only load @owner, so the line stays
+ * shared until the holder's unlock store, and harts are served FIFO.
+ */
 void ulmk_arch_spin_lock(ulmk_spinlock_t *lock)
 {
 #if ULMK_CONFIG_ENABLE_SMP
-	uint32_t tmp;
-	uint32_t status;
-
-	for (;;) {
-		__asm__ volatile(
-			"1: lr.w %0, (%2)\n"
-			"   bnez %0, 1b\n"
-			"   li %1, 1\n"
-			"   sc.w %1, %1, (%2)\n"
-			"   bnez %1, 1b\n"
-			: "=&r"(tmp), "=&r"(status)
-			: "r"(&lock->locked)
-			: "memory");
-		__asm__ volatile("fence rw, rw" ::: "memory");
-		return;
+	uint32_t old;
+	uint16_t me;
+#if ULMK_CONFIG_SPINLOCK_STATS
+	uint32_t t0;
+#endif
+
+	__asm__ volatile("amoadd.w %0, %2, (%1)"
+			 : "=r"(old)
+			 : "r"(&lock->u.word), "r"(SPIN_TICKET_ONE)
+			 : "memory");
+	me = (uint16_t)(old >> 16);
+	if ((uint16_t)old != me) {
+#if ULMK_CONFIG_SPINLOCK_STATS
+		t0 = ulmk_arch_cycle_read();
+#endif
+		while (lock->u.t.owner != me)
+			;
+#if ULMK_CONFIG_SPINLOCK_STATS
+		lock->contended++;
+		lock->spin_cycles += ulmk_arch_cycle_read() - t0;
+#endif
 	}
+	__asm__ volatile("fence rw, rw" ::: "memory");
+#endif
+#if ULMK_CONFIG_SPINLOCK_STATS
+	/* UP: irq_save at the irqsave wrapper is the lock; count only. */
+	lock->acquires++;
 #else
-	/* UP: irq_save at irqsave wrapper is sufficient — no LR/SC. */
 	(void)lock;
 #endif
 }
@@ -84,7 +102,7 @@ void ulmk_arch_spin_unlock(ulmk_spinlock_t *lock)
 {
 #if ULMK_CONFIG_ENABLE_SMP
 	__asm__ volatile("fence rw, rw" ::: "memory");
-	lock->locked = 0u;
+	lock->u.t.owner = (uint16_t)(lock->u.t.owner + 1u);
 #else
 	(void)lock;
 #endif
@@ -159,9 +177,15 @@ void ulmk_arch_secondary_init(void)
 {
 	extern void _trap_handler(void);
 
-	__asm__ volatile("csrw mtvec, %0" :: "r"((uint32_t)_trap_handler));
+	riscv_irq_trap_vector_init((uintptr_t)_trap_handler);
 #if ULMK_CONFIG_ENABLE_SMP
 	__asm__ volatile("csrs mie, %0" :: "r"(1u << 3));
+#endif
+#if ULMK_ARCH_HAVE_CLIC
+	riscv_clic_hart_init();
+#endif
+#if ULMK_ARCH_HAVE_PLIC
+	riscv_plic_hart_init();	/* PLIC sources may be routed here */
 #endif
 	ulmk_arch_mpu_init();
 }
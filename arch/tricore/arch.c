@@ -13,18 +13,13 @@
 #include <ulmk/microkernel.h>
 #include <ulmk/config.h>
 #include <ulmk_arch.h>
+#include <kernel/include/ulmk_mpu_shadow.h>
 #include <kernel/include/ulmk_printk.h>
+#include <kernel/include/ulmk_cycles.h>
 /* =========================================================================
  * CPU control
  * ========================================================================= */
 
-/*
- * Bit 31 tags a no-op save: CCPN is already 255 (syscall gateway), so maskable
- * IRQs cannot preempt.  Skipping disable/mtcr/isync removes nested critical-
- * section cost on the hot syscall path.
- */
-#define ULMK_IRQ_KEY_SKIP	(1u << 31)
-
 ulmk_arch_irq_key_t ulmk_arch_cpu_irq_save(void)
 {
 	uint32_t icr;
@@ -93,7 +88,7 @@ uint32_t ulmk_arch_cpu_clz(uint32_t val)
 	return result;
 }
 
-#if ULMK_CONFIG_SYSCALL_WCET
+#if UL_CYCLE_COUNTER
 /* CCTRL: CM=bit0, CE=bit1 (TC1.6 Vol1 §12.11). Normal free-run: CE=1. */
 #define CCTRL_CE	(1u << 1)
 
@@ -307,6 +302,23 @@ static uint32_t csa_chain_tail_link(uint32_t head_link)
 	return 0u;
 }
 
+/*
+ * Count the frames of a saved (not live) CSA chain: 2 for a fresh thread,
+ * plus one per call level and interrupt nesting it was switched out at.
+ * O(chain depth) — sampled at switch-in when ULMK_CONFIG_STACK_WATERMARK=1.
+ */
+uint32_t ulmk_arch_ctx_depth(const ulmk_arch_ctx_t *ctx)
+{
+	uint32_t link = ctx->pcxi & 0x7FFFFu;
+	uint32_t n    = 0u;
+
+	while (link != 0u) {
+		n++;
+		link = csa_link_to_addr(link)[0] & 0x7FFFFu;
+	}
+	return n;
+}
+
 /*
  * Return the saved CSA chain to FCX (cold path — thread kill/exit).
  *
@@ -521,13 +533,45 @@ static void mpu_write_enables(uint8_t prs, uint32_t dpre, uint32_t dpwe,
  */
 
 /*
- * Last programmed userspace DPR layout — skips redundant CSFR traffic on
- * self-resched / unchanged domain, and only clears slots that were live.
+ * DPRE/DPWE/CPXE enable triple of one PRS, as written by mpu_write_enables().
  */
-static const ulmk_arch_region_t *g_mpu_regions;
-static uint8_t g_mpu_count;
-static uint8_t g_mpu_prs = 0xFFu;
-static uint8_t g_mpu_live;
+struct mpu_enables {
+	uint32_t dpre;
+	uint32_t dpwe;
+	uint32_t cpxe;
+};
+
+/*
+ * Per-core MPU shadow (the DPR/enable CSFRs are core-local).  regions/count/
+ * prs/live describe the last programmed userspace layout, so self-resched and
+ * unchanged domains skip all CSFR traffic; dpr_*[] and en[] mirror the
+ * dynamic DPR bounds and enable sets so a real change rewrites only what
+ * differs.  Nothing is trusted until @valid is set.
+ */
+struct mpu_cpu_cache {
+	const ulmk_arch_region_t *regions;
+	uint8_t  count;
+	uint8_t  prs;
+	uint8_t  live;
+	bool     valid;
+	uint32_t dpr_lo[ULMK_ARCH_MPU_NUM_DPR];
+	uint32_t dpr_hi[ULMK_ARCH_MPU_NUM_DPR];
+	struct mpu_enables en[ULMK_ARCH_NUM_PRS];
+	ulmk_mpu_stats_t stats;
+};
+
+static struct mpu_cpu_cache g_mpu_cache[ULMK_ARCH_NUM_CPU] = {
+	[0 ... ULMK_ARCH_NUM_CPU - 1] = { .prs = 0xFFu },
+};
+
+static struct mpu_cpu_cache *mpu_this_cpu(void)
+{
+	uint32_t cpu = ulmk_arch_cpu_id();
+
+	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		cpu = 0u;
+	return &g_mpu_cache[cpu];
+}
 
 /*
  * AURIX CPR/DPR: address belongs to the range iff
@@ -542,6 +586,7 @@ static uint32_t mpu_range_upper(uintptr_t end)
 
 void ulmk_arch_mpu_init(void)
 {
+	struct mpu_cpu_cache *c = mpu_this_cpu();
 	uint32_t syscon;
 	uint8_t  i;
 	uintptr_t kexec_lo;
@@ -571,14 +616,18 @@ void ulmk_arch_mpu_init(void)
 	__asm__ volatile("isync" ::: "memory");
 	ulmk_board_cpu_endinit_set();
 
-	g_mpu_regions = NULL;
-	g_mpu_count   = 0u;
-	g_mpu_prs     = 0xFFu;
-	g_mpu_live    = 0u;
+	c->regions = NULL;
+	c->count   = 0u;
+	c->prs     = 0xFFu;
+	c->live    = 0u;
+	c->valid   = false;
 
-	/* Zero implemented DPR/CPR ranges */
-	for (i = 0u; i < ULMK_ARCH_MPU_NUM_DPR; i++)
+	/* Zero implemented DPR/CPR ranges (and their shadow) */
+	for (i = 0u; i < ULMK_ARCH_MPU_NUM_DPR; i++) {
 		mpu_write_dpr(i, 0u, 0u);
+		c->dpr_lo[i] = 0u;
+		c->dpr_hi[i] = 0u;
+	}
 	for (i = 0u; i < ULMK_ARCH_MPU_NUM_CPR; i++)
 		mpu_write_cpr(i, 0u, 0u);
 
@@ -706,21 +755,51 @@ static void mpu_prs1_static_enables(uint32_t *dpre, uint32_t *dpwe,
 		*cpxe = (1u << ULMK_ARCH_MPU_CPR_USER);
 }
 
-static void mpu_write_user_slot(uint8_t idx, const ulmk_arch_region_t *r,
-				uint32_t *dpre, uint32_t *dpwe)
+/* Write a PRS enable set unless the shadow already holds it. */
+static uint32_t mpu_commit_enables(struct mpu_cpu_cache *c, uint8_t prs,
+				   const struct mpu_enables *want)
 {
-	uint8_t d_slot = (uint8_t)(ULMK_ARCH_MPU_USER_DPR_BASE + idx);
+	struct mpu_enables *sh = &c->en[prs];
 
-	if (d_slot >= ULMK_ARCH_MPU_NUM_DPR)
-		return;
+	if (c->valid && sh->dpre == want->dpre && sh->dpwe == want->dpwe &&
+	    sh->cpxe == want->cpxe)
+		return 0u;
+
+	mpu_write_enables(prs, want->dpre, want->dpwe, want->cpxe);
+	*sh = *want;
+	return 1u;
+}
+
+/* Write a dynamic DPR's bounds unless the shadow already holds them. */
+static uint32_t mpu_commit_dpr(struct mpu_cpu_cache *c, uint8_t d_slot,
+			       uint32_t lower, uint32_t upper)
+{
+	if (c->valid && c->dpr_lo[d_slot] == lower &&
+	    c->dpr_hi[d_slot] == upper)
+		return 0u;
+
+	mpu_write_dpr(d_slot, lower, upper);
+	c->dpr_lo[d_slot] = lower;
+	c->dpr_hi[d_slot] = upper;
+	return 1u;
+}
+
+static void mpu_prs0_enables(struct mpu_enables *en)
+{
+	uintptr_t utext_lo;
+	uintptr_t utext_hi;
+
+	extern uint8_t _ulmk_user_text_start[];
+	extern uint8_t _ulmk_user_text_end[];
+
+	utext_lo = (uintptr_t)_ulmk_user_text_start;
+	utext_hi = (uintptr_t)_ulmk_user_text_end;
 
-	mpu_write_dpr(d_slot,
-		      (uint32_t)r->base,
-		      (uint32_t)(r->base + r->size - 8u));
-	if (r->perms & ULMK_PERM_READ)
-		*dpre |= (1u << d_slot);
-	if (r->perms & ULMK_PERM_WRITE)
-		*dpwe |= (1u << d_slot);
+	en->dpre = (1u << ULMK_ARCH_MPU_NUM_DPR) - 1u;
+	en->dpwe = (1u << ULMK_ARCH_MPU_NUM_DPR) - 1u;
+	en->cpxe = (1u << ULMK_ARCH_MPU_CPR_KERNEL);
+	if (utext_hi > utext_lo)
+		en->cpxe |= (1u << ULMK_ARCH_MPU_CPR_USER);
 }
 
 /*
@@ -748,40 +827,33 @@ static uint8_t mpu_dyn_count(const ulmk_arch_region_t *regions, uint8_t count,
 static void mpu_program_regions(uint8_t prs, const ulmk_arch_region_t *regions,
 				uint8_t count)
 {
-	uint32_t dpre;
-	uint32_t dpwe;
-	uint32_t cpxe;
-	uint8_t  i;
-	uint8_t  prog;
-	uint8_t  max_dyn;
-	uint8_t  eff;
-	uintptr_t utext_lo;
-	uintptr_t utext_hi;
+	struct mpu_cpu_cache *c = mpu_this_cpu();
+	ulmk_arch_region_t    dyn[ULMK_ARCH_MAX_REGIONS];
+	struct mpu_enables    want;
+	uint32_t              writes;
+	uint8_t               i;
+	uint8_t               n;
+	uint8_t               max_dyn;
+	uint8_t               eff;
 
-	extern uint8_t _ulmk_user_text_start[];
-	extern uint8_t _ulmk_user_text_end[];
-
-	utext_lo = (uintptr_t)_ulmk_user_text_start;
-	utext_hi = (uintptr_t)_ulmk_user_text_end;
+	c->stats.switches++;
 
+	/*
+	 * PRS 0 only needs its (constant) enable set; the PRS 1 DPRs stay as
+	 * they are, so the cached userspace layout remains valid across the
+	 * kernel entry and the return switch is usually free.
+	 */
 	if (prs == 0u) {
-		uint32_t prs0_cpr = (1u << ULMK_ARCH_MPU_CPR_KERNEL);
-
-		if (utext_hi > utext_lo)
-			prs0_cpr |= (1u << ULMK_ARCH_MPU_CPR_USER);
-
-		mpu_write_enables(0u,
-				  (1u << ULMK_ARCH_MPU_NUM_DPR) - 1u,
-				  (1u << ULMK_ARCH_MPU_NUM_DPR) - 1u,
-				  prs0_cpr);
-		g_mpu_prs     = 0u;
-		g_mpu_regions = NULL;
-		g_mpu_count   = 0u;
-		g_mpu_live    = 0u;
+		mpu_prs0_enables(&want);
+		writes = mpu_commit_enables(c, 0u, &want);
+		c->stats.slot_writes += writes;
+		c->stats.slot_skips  += 1u - writes;
+		if (writes == 0u)
+			c->stats.unchanged++;
 		return;
 	}
 
-	max_dyn = (uint8_t)(ULMK_ARCH_MPU_NUM_DPR - ULMK_ARCH_MPU_USER_DPR_BASE);
+	max_dyn = (uint8_t)ULMK_ARCH_MPU_DYN_SLOTS;
 	if (!regions)
 		count = 0u;
 	eff = mpu_dyn_count(regions, count, max_dyn);
@@ -789,77 +861,66 @@ static void mpu_program_regions(uint8_t prs, const ulmk_arch_region_t *regions,
 	/*
 	 * Unchanged domain (typical self-yield / same thread): no CSFR writes.
 	 */
-	if (prs == g_mpu_prs && regions == g_mpu_regions && count == g_mpu_count)
+	if (prs == c->prs && regions == c->regions && count == c->count) {
+		c->stats.unchanged++;
 		return;
+	}
 
 	/*
 	 * IPC hot path: both sides stack-only → static URAM already covers
 	 * stacks; no dynamic slots live and none requested.
 	 */
-	if (prs == g_mpu_prs && eff == 0u && g_mpu_live == 0u) {
-		g_mpu_regions = regions;
-		g_mpu_count   = count;
+	if (prs == c->prs && eff == 0u && c->live == 0u) {
+		c->regions = regions;
+		c->count   = count;
+		c->stats.unchanged++;
 		return;
 	}
 
-	mpu_prs1_static_enables(&dpre, &dpwe, &cpxe);
-
 	/*
-	 * Fast append: mem_map grew the table by one non-STACK region and the
-	 * prior layout had no STACK holes (dense slot == region index).
+	 * Rewrite only the dynamic DPRs whose bounds changed (this subsumes
+	 * the old mem_map append path).  Slots that fall out of use are just
+	 * dropped from the enable set: a DPR no PRS 1 enable bit selects
+	 * grants nothing beyond PRS 0's full-range DPR 0.
 	 */
-	if (prs == g_mpu_prs && regions == g_mpu_regions &&
-	    count == (uint8_t)(g_mpu_count + 1u) && count > 0u &&
-	    regions[count - 1u].type != ULMK_REGION_STACK &&
-	    mpu_dyn_count(regions, (uint8_t)(count - 1u), max_dyn) ==
-		    (uint8_t)(count - 1u)) {
-		mpu_write_user_slot((uint8_t)(count - 1u), &regions[count - 1u],
-				    &dpre, &dpwe);
-		for (i = 0u; i < (uint8_t)(count - 1u); i++) {
-			uint8_t d_slot =
-				(uint8_t)(ULMK_ARCH_MPU_USER_DPR_BASE + i);
-
-			if (regions[i].perms & ULMK_PERM_READ)
-				dpre |= (1u << d_slot);
-			if (regions[i].perms & ULMK_PERM_WRITE)
-				dpwe |= (1u << d_slot);
-		}
-		mpu_write_enables(prs, dpre, dpwe, cpxe);
-		g_mpu_count = count;
-		g_mpu_live  = count;
-		return;
-	}
-
-	prog = 0u;
-	for (i = 0u; i < count && prog < max_dyn; i++) {
-		if (regions[i].type == ULMK_REGION_STACK)
-			continue;
-		mpu_write_user_slot(prog, &regions[i], &dpre, &dpwe);
-		prog++;
-	}
-
-	/* Clear only previously live dynamic slots that are no longer used. */
-	for (i = prog; i < g_mpu_live; i++) {
+	mpu_prs1_static_enables(&want.dpre, &want.dpwe, &want.cpxe);
+	n = ulmk_mpu_compact(regions, count, dyn, max_dyn, ULMK_MPU_MERGE_ANY,
+			     &c->stats.merged);
+	writes = 0u;
+	for (i = 0u; i < n; i++) {
 		uint8_t d_slot = (uint8_t)(ULMK_ARCH_MPU_USER_DPR_BASE + i);
 
-		if (d_slot < ULMK_ARCH_MPU_NUM_DPR)
-			mpu_write_dpr(d_slot, 0u, 0u);
+		writes += mpu_commit_dpr(c, d_slot, (uint32_t)dyn[i].base,
+					 (uint32_t)(dyn[i].base +
+						    dyn[i].size - 8u));
+		if (dyn[i].perms & ULMK_PERM_READ)
+			want.dpre |= (1u << d_slot);
+		if (dyn[i].perms & ULMK_PERM_WRITE)
+			want.dpwe |= (1u << d_slot);
 	}
+	writes += mpu_commit_enables(c, prs, &want);
+	c->valid = true;
 
-	mpu_write_enables(prs, dpre, dpwe, cpxe);
+	c->stats.slot_writes += writes;
+	c->stats.slot_skips  += (uint32_t)n + 1u - writes;
+	if (writes == 0u)
+		c->stats.unchanged++;
 
-	g_mpu_prs     = prs;
-	g_mpu_regions = regions;
-	g_mpu_count   = count;
-	g_mpu_live    = prog;
+	c->prs     = prs;
+	c->regions = regions;
+	c->count   = count;
+	c->live    = n;
 }
 
 void ulmk_arch_mpu_configure(uint8_t prs, const ulmk_arch_region_t *regions,
 			   uint8_t count)
 {
-	/* Force a full reprogram (ignore identity cache). */
-	g_mpu_regions = NULL;
-	g_mpu_count   = 0xFFu;
+	struct mpu_cpu_cache *c = mpu_this_cpu();
+
+	/* Force a full reprogram (ignore identity cache and shadow). */
+	c->regions = NULL;
+	c->count   = 0xFFu;
+	c->valid   = false;
 	mpu_program_regions(prs, regions, count);
 }
 
@@ -869,6 +930,13 @@ void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 	mpu_program_regions(prs, regions, count);
 }
 
+void ulmk_arch_mpu_stats(uint32_t cpu, ulmk_mpu_stats_t *out)
+{
+	if (cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		cpu = 0u;
+	*out = g_mpu_cache[cpu].stats;
+}
+
 bool ulmk_arch_mpu_addr_permitted(uintptr_t addr, size_t size, uint32_t perms)
 {
 	uint32_t dpre;
@@ -993,6 +1061,27 @@ void ulmk_arch_irq_src_register(uint8_t srpn, uint32_t src_reg_addr)
 	*src = v;
 }
 
+/* SRC.SRPN is both the priority and the vector: it stays what was bound. */
+void ulmk_arch_irq_src_priority(uint8_t srpn, uint8_t priority)
+{
+	(void)srpn;
+	(void)priority;
+}
+
+static uint32_t tick_tos(uint32_t cpu);
+
+void ulmk_arch_irq_src_route(uint8_t srpn, uint8_t cpu_id)
+{
+	volatile uint32_t *src = (volatile uint32_t *)(uintptr_t)g_src_addr[srpn];
+	uint32_t           v;
+
+	if (!src)
+		return;
+	/* SRR/SETR/CLRR read back 0, so the write-back raises nothing. */
+	v    = *src & ~(3u << SRC_TOS_SHIFT);
+	*src = v | (tick_tos(cpu_id) << SRC_TOS_SHIFT);
+}
+
 void ulmk_arch_irq_src_enable(uint8_t srpn)
 {
 	uint32_t addr = g_src_addr[srpn];
@@ -1359,6 +1448,8 @@ void ulmk_arch_trap_entry(uint8_t trap_class, uint8_t tin)
 		  trap_class < 8u ? trap_class_names[trap_class] : "?",
 		  (unsigned)tin,
 		  from_kernel ? "[kernel/ISR]" : "[thread]");
+	/* The dump below bypasses the printk ring; keep the order. */
+	ulmk_printk_flush();
 
 	ulmk_arch_trap_dump(trap_class, tin);
 
@@ -1604,14 +1695,37 @@ uint32_t ulmk_arch_cpu_id(void)
 	return id & 0x7u;
 }
 
+/*
+ * Ticket lock (see ulmk_spinlock_t): one CMPSWAP-based add takes a ticket,
+ * then cores wait their turn reading @owner instead of all retrying
+ * CMPSWAP on the same word.
+ */
 void ulmk_arch_spin_lock(ulmk_spinlock_t *lock)
 {
 #if ULMK_CONFIG_ENABLE_SMP
 	uint32_t old;
+	uint16_t me;
+#if ULMK_CONFIG_SPINLOCK_STATS
+	uint32_t t0;
+#endif
 
-	do {
-		old = ulmk_arch_atomic_cas(&lock->locked, 0u, 1u);
-	} while (old != 0u);
+	old = ulmk_arch_atomic_add(&lock->u.word, 1u << 16);
+	me  = (uint16_t)(old >> 16);
+	if ((uint16_t)old != me) {
+#if ULMK_CONFIG_SPINLOCK_STATS
+		t0 = ulmk_arch_cycle_read();
+#endif
+		while (lock->u.t.owner != me)
+			;
+#if ULMK_CONFIG_SPINLOCK_STATS
+		lock->contended++;
+		lock->spin_cycles += ulmk_arch_cycle_read() - t0;
+#endif
+	}
+	__asm__ volatile("" ::: "memory");
+#endif
+#if ULMK_CONFIG_SPINLOCK_STATS
+	lock->acquires++;
 #else
 	(void)lock;
 #endif
@@ -1620,7 +1734,8 @@ void ulmk_arch_spin_lock(ulmk_spinlock_t *lock)
 void ulmk_arch_spin_unlock(ulmk_spinlock_t *lock)
 {
 #if ULMK_CONFIG_ENABLE_SMP
-	lock->locked = 0u;
+	__asm__ volatile("" ::: "memory");
+	lock->u.t.owner = (uint16_t)(lock->u.t.owner + 1u);
 #else
 	(void)lock;
 #endif
@@ -81,6 +81,14 @@
 #else
 #define ULMK_ARCH_MPU_USER_DPR_BASE	6
 #endif
+#define ULMK_ARCH_MPU_DYN_SLOTS	\
+	(ULMK_ARCH_MPU_NUM_DPR - ULMK_ARCH_MPU_USER_DPR_BASE)
+/*
+ * MPR/MPW traps report no data address and the class 0 vector does not
+ * return, so regions cannot be loaded on demand (ULMK_CONFIG_MPU_LAZY_SLOTS
+ * is ignored here).
+ */
+#define ULMK_ARCH_HAVE_MPU_FAULT_ADDR	0
 
 #define ULMK_ARCH_MAX_REGIONS	12
 #define ULMK_ARCH_REGION_ALIGN	64
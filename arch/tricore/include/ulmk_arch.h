@@ -17,6 +17,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <ulmk/microkernel.h>
+#include <ulmk/config.h>
 #include <arch_config.h>
 
 /* =========================================================================
@@ -44,11 +45,36 @@ typedef struct {
 /* Saved interrupt state (ICR register value on TriCore). */
 typedef uint32_t ulmk_arch_irq_key_t;
 
+/*
+ * Bit 31 tags a no-op save: CCPN is already 255 (syscall gateway), so maskable
+ * IRQs cannot preempt.  Skipping disable/mtcr/isync removes nested critical-
+ * section cost on the hot syscall path.
+ */
+#define ULMK_IRQ_KEY_SKIP	(1u << 31)
+
+/*
+ * Ticket spinlock: a locker takes @next with an atomic add on @word and
+ * spins until @owner (low half, little-endian) reaches it; unlock advances
+ * @owner.  CPUs are served in arrival order.  With ULMK_CONFIG_SPINLOCK_STATS
+ * the holder also counts acquisitions, contended ones and cycles spun.
+ */
 typedef struct {
-	volatile uint32_t locked;
+	union {
+		volatile uint32_t word;
+		struct {
+			volatile uint16_t owner;
+			volatile uint16_t next;
+		} t;
+	} u;
+#if ULMK_CONFIG_SPINLOCK_STATS
+	uint32_t acquires;
+	uint32_t contended;
+	uint64_t spin_cycles;
+#endif
 } ulmk_spinlock_t;
 
-#define ULMK_SPINLOCK_INIT	{ 0u }
+#define ULMK_SPINLOCK_INIT	{ .u = { .word = 0u } }
+#define ULMK_ARCH_HAVE_SPINLOCK_STATS	1
 
 /* Single MPU region descriptor. */
 typedef struct {
@@ -112,6 +138,10 @@ void ulmk_arch_ctx_switch(ulmk_arch_ctx_t *from, const ulmk_arch_ctx_t *to);
 
 void ulmk_arch_ctx_free(ulmk_arch_ctx_t *ctx);
 
+/* Frames in the saved CSA chain of @ctx (stack watermark sampling). */
+uint32_t ulmk_arch_ctx_depth(const ulmk_arch_ctx_t *ctx);
+#define ULMK_ARCH_HAVE_CTX_DEPTH	1
+
 #define ULMK_SCHED_SWITCH_COOP		0u
 #define ULMK_SCHED_SWITCH_PREEMPT_ISR	1u
 
@@ -133,6 +163,7 @@ void ulmk_arch_mpu_configure(uint8_t prs, const ulmk_arch_region_t *regions,
 
 void ulmk_arch_mpu_switch(const ulmk_arch_region_t *regions, uint8_t count,
 			uint8_t prs);
+void ulmk_arch_mpu_stats(uint32_t cpu, ulmk_mpu_stats_t *out);
 
 bool ulmk_arch_mpu_addr_permitted(uintptr_t addr, size_t size,
 				uint32_t perms);
@@ -153,6 +184,18 @@ void ulmk_arch_irq_src_configure(uint8_t srpn, uint8_t priority,
  */
 void ulmk_arch_irq_src_register(uint8_t srpn, uint32_t src_reg_addr);
 
+/*
+ * ulmk_arch_irq_src_priority — arbitration priority of @srpn (SRPN scale,
+ * higher is more urgent).  A no-op here: the SRPN is the priority.
+ */
+void ulmk_arch_irq_src_priority(uint8_t srpn, uint8_t priority);
+
+/*
+ * ulmk_arch_irq_src_route — retarget @srpn to @cpu_id (SRC.TOS) without
+ * touching its priority or enable state.
+ */
+void ulmk_arch_irq_src_route(uint8_t srpn, uint8_t cpu_id);
+
 void ulmk_arch_irq_src_enable(uint8_t srpn);
 void ulmk_arch_irq_src_disable(uint8_t srpn);
 void ulmk_arch_irq_src_ack(uint8_t srpn);
@@ -183,6 +226,21 @@ uint32_t ulmk_arch_atomic_cas(volatile uint32_t *ptr,
 
 uint32_t ulmk_arch_atomic_add(volatile uint32_t *ptr, uint32_t val);
 
+/*
+ * Order earlier stores before later ones as seen by other cores — for data
+ * published to lock-free readers (ISRs).
+ */
+static inline void ulmk_arch_wmb(void)
+{
+	__asm__ volatile("dsync" ::: "memory");
+}
+
+/* Order earlier loads before later ones — pairs with ulmk_arch_wmb(). */
+static inline void ulmk_arch_rmb(void)
+{
+	__asm__ volatile("dsync" ::: "memory");
+}
+
 /* =========================================================================
  * Physical memory allocator (arch_api_spec.md §11 — support)
  * ========================================================================= */
@@ -4,16 +4,36 @@
 # generator used by both this build and the integration-test Makefiles).
 # Full specification: docs/build_system_spec.md §10
 
-set(ULMK_CONFIG_MAX_IRQ_BINDINGS 16 CACHE STRING "Max IRQ-to-notification bindings")
+set(ULMK_CONFIG_MAX_IRQ_BINDINGS 16 CACHE STRING "Max live IRQ bindings (heap objects)")
 set(ULMK_CONFIG_DEBUG_PRINTK     1  CACHE STRING "Enable kernel printk (0 = production no-op)")
 set(ULMK_CONFIG_SYSCALL_WCET     0  CACHE STRING
-	"Syscall cycle-counter slot (0=off, 1=WCET HIL / silicon_wcet)")
+	"Syscall cycle-counter slot + per-syscall histograms (0=off, 1=WCET HIL / silicon_wcet)")
 set(ULMK_CONFIG_ENABLE_SMP       0  CACHE STRING
 	"Enable SMP (0=UP, 1=multi-CPU; requires ULMK_ARCH_NUM_CPU>1)")
 set(ULMK_CONFIG_TICK_HZ          1000 CACHE STRING
 	"Kernel timing-wheel tick rate in Hz (default 1000)")
 set(ULMK_CONFIG_IRQ_ATTACH       0  CACHE STRING
 	"Enable ulmk_irq_attach (0=off/ENOTSUP, 1=DANGEROUS ISR userspace callbacks)")
+set(ULMK_CONFIG_IRQ_NESTING      0  CACHE STRING
+	"More urgent interrupts preempt a running attach callback (RISC-V; 0=off)")
+set(ULMK_CONFIG_MPU_LAZY_SLOTS   0  CACHE STRING
+	"Dynamic MPU regions pinned per thread; the rest load on fault (0=off)")
+set(ULMK_CONFIG_TRACE_ENTRIES    0  CACHE STRING
+	"Kernel event trace records per CPU, power of two (0=compiled out)")
+set(ULMK_CONFIG_PRINTK_BUF_SIZE  0  CACHE STRING
+	"printk log ring bytes per CPU, power of two, drained by idle (0=synchronous)")
+set(ULMK_CONFIG_THREAD_STATS     0  CACHE STRING
+	"Per-thread CPU time / switch / IPC counters for ulmk_thread_stats (0=off)")
+set(ULMK_CONFIG_SCHED_LATENCY    0  CACHE STRING
+	"Wake-up-to-run latency histograms for ulmk_sched_lat_stats (0=off)")
+set(ULMK_CONFIG_IRQOFF_STATS     0  CACHE STRING
+	"IRQ-off windows and kernel lock wait/hold times for ulmk_irqoff_stats (0=off)")
+set(ULMK_CONFIG_SPINLOCK_STATS   0  CACHE STRING
+	"Per-lock acquire/contended/spin-cycle counters for ulmk_spinlock_stats (0=off)")
+set(ULMK_CONFIG_USER_CYCLES      0  CACHE STRING
+	"ulmk_cycle_read syscall for userspace benchmarks (0=ENOTSUP)")
+set(ULMK_CONFIG_STACK_WATERMARK  0  CACHE STRING
+	"Stack painting and per-thread high-water marks for ulmk_thread_stack_stats (0=off)")
 
 if("${ULMK_CONFIG_ENABLE_SMP}" STREQUAL "1")
 	if("${ULMK_ARCH}" STREQUAL "arm")
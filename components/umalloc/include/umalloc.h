@@ -0,0 +1,75 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * umalloc component public API — components/umalloc/include/umalloc.h
+ *
+ * Userspace malloc over the calling thread's private heap (slabAO model).
+ * The arena control block lives at the start of the heap returned by
+ * ulmk_get_thread_heap(), so each thread owns its arena and no locking is
+ * done: an arena must only be used by the thread that created it.
+ *
+ * Small blocks are recycled through per-size-class lists without any
+ * syscall; everything else goes through a TLSF-style fallback.
+ */
+
+#ifndef UMALLOC_H
+#define UMALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <ulmk/microkernel.h>
+
+/* Grow the heap with ulmk_heap_extend() when the arena runs dry. */
+#define UMALLOC_F_EXTEND	(1u << 0)
+
+/* Minimum bytes requested from the kernel per heap extension. */
+#ifndef UMALLOC_EXTEND_MIN
+#define UMALLOC_EXTEND_MIN	1024u
+#endif
+
+/* Largest payload served by the size-class fast path (multiple of 8). */
+#ifndef UMALLOC_QUICK_MAX
+#define UMALLOC_QUICK_MAX	128u
+#endif
+
+/* Blocks parked per size class before frees fall through to the fallback. */
+#ifndef UMALLOC_QUICK_DEPTH
+#define UMALLOC_QUICK_DEPTH	16u
+#endif
+
+typedef struct umalloc_arena umalloc_arena_t;
+
+typedef struct {
+	uint32_t fast_hits;	/* allocations served by a size-class list */
+	uint32_t slow_allocs;	/* allocations served by the TLSF fallback */
+	uint32_t failures;	/* allocations that returned NULL */
+	uint32_t extends;	/* successful ulmk_heap_extend() calls */
+	size_t   free_bytes;	/* payload bytes free in the fallback */
+	size_t   quick_bytes;	/* payload bytes parked on size-class lists */
+} umalloc_stats_t;
+
+/**
+ * @brief Create an arena over the calling thread's heap.
+ * @param flags @c UMALLOC_F_EXTEND or 0.  Extension requires the thread to
+ *              run at @c ULMK_PRIV_DRIVER; otherwise allocations simply fail
+ *              once the initial heap is exhausted.
+ * @return Arena handle, or NULL if the thread has no (or too small a) heap.
+ */
+umalloc_arena_t *umalloc_init(uint32_t flags);
+
+/**
+ * @brief Allocate @p size bytes from @p a.
+ * @return Pointer aligned to 8 bytes, or NULL when out of memory.
+ */
+void *umalloc(umalloc_arena_t *a, size_t size);
+
+/**
+ * @brief Return @p ptr (from umalloc()) to @p a.  NULL is ignored.
+ */
+void ufree(umalloc_arena_t *a, void *ptr);
+
+/**
+ * @brief Snapshot the allocator counters of @p a into @p out.
+ */
+void umalloc_stats(const umalloc_arena_t *a, umalloc_stats_t *out);
+
+#endif /* UMALLOC_H */
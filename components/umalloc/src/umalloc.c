@@ -0,0 +1,411 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * umalloc — userspace malloc over the thread's private heap.
+ *
+ * Two tiers, both private to the owning thread (no locks, no syscalls on
+ * the hot path):
+ *
+ *   fast path  — size-class lists.  Freed blocks with a payload of at most
+ *                UMALLOC_QUICK_MAX bytes are parked LIFO on the list for
+ *                their exact size (8-byte steps) and handed straight back
+ *                by the next umalloc() of that class.  Parked blocks stay
+ *                marked in use, so they are never coalesced; each list is
+ *                capped at UMALLOC_QUICK_DEPTH entries.
+ *
+ *   fallback   — a TLSF-style segregated fit (FL = log2 class, 4 SL
+ *                sub-classes, bitmap search) with immediate coalescing via
+ *                physical-predecessor links, same scheme as kernel/mem/tlsf.c
+ *                scaled down to 8-byte granularity.
+ *
+ * Block layout (header = UM_HDR bytes, payload follows):
+ *
+ *   prev_phys  — physical predecessor in the segment (NULL = first)
+ *   size       — payload bytes | UM_F_FREE
+ *   next_free, prev_free — free-list links, overlaid on the payload
+ *
+ * Each segment ends with a header-only sentinel (size 0, in use).  When the
+ * fallback has no fit and UMALLOC_F_EXTEND is set, the size-class lists are
+ * flushed back first; only then is the kernel asked for more heap with
+ * ulmk_heap_extend_info().  In-place growth starts exactly at the primary
+ * segment's sentinel, which is turned into the header of the new free block;
+ * a discontiguous block becomes a segment of its own.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <ulmk/microkernel.h>
+#include <umalloc.h>
+
+/* ─── constants ──────────────────────────────────────────────────────────── */
+
+#define UM_ALIGN_SHIFT	3u
+#define UM_ALIGN	(1u << UM_ALIGN_SHIFT)
+#define UM_ROUND(x)	(((x) + UM_ALIGN - 1u) & ~(size_t)(UM_ALIGN - 1u))
+
+#define UM_SL_BITS	2u
+#define UM_SL_COUNT	(1u << UM_SL_BITS)
+#define UM_FL_SHIFT	(UM_SL_BITS + UM_ALIGN_SHIFT)
+#define UM_SMALL	(1u << UM_FL_SHIFT)	/* sizes below map linearly */
+#define UM_FL_COUNT	18u			/* blocks up to 8 MiB */
+
+#define UM_F_FREE	1u
+#define UM_F_MASK	(UM_ALIGN - 1u)
+
+#define UM_QUICK_COUNT	(UMALLOC_QUICK_MAX / UM_ALIGN)
+
+/* FLS / CTZ on 32-bit values — x must be > 0 */
+#define UM_FLS(x)	((uint32_t)(31u - __builtin_clz((uint32_t)(x))))
+#define UM_CTZ(x)	((uint32_t)__builtin_ctz((uint32_t)(x)))
+
+/* ─── block header ───────────────────────────────────────────────────────── */
+
+typedef struct um_blk {
+	struct um_blk *prev_phys;
+	size_t         size;
+	struct um_blk *next_free;	/* free or parked blocks only */
+	struct um_blk *prev_free;	/* free blocks only */
+} um_blk_t;
+
+#define UM_HDR		offsetof(um_blk_t, next_free)
+#define UM_MIN		(sizeof(um_blk_t) - UM_HDR)	/* min payload */
+
+/* ─── arena (lives at the start of the thread heap) ──────────────────────── */
+
+struct umalloc_arena {
+	uint32_t  fl_bitmap;
+	uint8_t   sl_bitmap[UM_FL_COUNT];
+	um_blk_t *free_lists[UM_FL_COUNT][UM_SL_COUNT];
+	um_blk_t *quick[UM_QUICK_COUNT];
+	uint8_t   quick_len[UM_QUICK_COUNT];
+	um_blk_t *tail;		/* sentinel of the primary (slabAO) segment */
+	uint32_t  flags;
+	umalloc_stats_t stats;
+};
+
+#define UM_ARENA_SZ	UM_ROUND(sizeof(struct umalloc_arena))
+
+/* ─── block helpers ──────────────────────────────────────────────────────── */
+
+static inline size_t blk_size(const um_blk_t *b)
+{
+	return b->size & ~(size_t)UM_F_MASK;
+}
+
+static inline int blk_is_free(const um_blk_t *b)
+{
+	return (b->size & UM_F_FREE) != 0u;
+}
+
+static inline void *blk_payload(um_blk_t *b)
+{
+	return (uint8_t *)b + UM_HDR;
+}
+
+static inline um_blk_t *blk_from_payload(void *p)
+{
+	return (um_blk_t *)((uint8_t *)p - UM_HDR);
+}
+
+static inline um_blk_t *blk_next(const um_blk_t *b)
+{
+	return (um_blk_t *)((uint8_t *)b + UM_HDR + blk_size(b));
+}
+
+/* ─── TLSF mapping ───────────────────────────────────────────────────────── */
+
+static void mapping_insert(size_t size, uint32_t *fl, uint32_t *sl)
+{
+	uint32_t f;
+
+	if (size < UM_SMALL) {
+		*fl = 0u;
+		*sl = (uint32_t)size / (UM_SMALL / UM_SL_COUNT);
+		return;
+	}
+	f   = UM_FLS(size);
+	*fl = f - UM_FL_SHIFT + 1u;
+	*sl = (uint32_t)(size >> (f - UM_SL_BITS)) ^ UM_SL_COUNT;
+	if (*fl >= UM_FL_COUNT) {
+		*fl = UM_FL_COUNT - 1u;
+		*sl = UM_SL_COUNT - 1u;
+	}
+}
+
+/*
+ * Round @size up to the next list boundary so any block found fits.
+ * Returns 0 if the rounded size is beyond the largest class.
+ */
+static int mapping_search(size_t size, uint32_t *fl, uint32_t *sl)
+{
+	if (size >= UM_SMALL) {
+		size += ((size_t)1u << (UM_FLS(size) - UM_SL_BITS)) - 1u;
+		if (UM_FLS(size) - UM_FL_SHIFT + 1u >= UM_FL_COUNT)
+			return 0;
+	}
+	mapping_insert(size, fl, sl);
+	return 1;
+}
+
+static void insert_free(umalloc_arena_t *a, um_blk_t *b)
+{
+	uint32_t fl, sl;
+
+	mapping_insert(blk_size(b), &fl, &sl);
+	b->size     |= UM_F_FREE;
+	b->prev_free = NULL;
+	b->next_free = a->free_lists[fl][sl];
+	if (b->next_free)
+		b->next_free->prev_free = b;
+	a->free_lists[fl][sl] = b;
+	a->fl_bitmap     |= 1u << fl;
+	a->sl_bitmap[fl] |= (uint8_t)(1u << sl);
+	a->stats.free_bytes += blk_size(b);
+}
+
+static void remove_free(umalloc_arena_t *a, um_blk_t *b)
+{
+	uint32_t fl, sl;
+
+	mapping_insert(blk_size(b), &fl, &sl);
+	if (b->prev_free)
+		b->prev_free->next_free = b->next_free;
+	else
+		a->free_lists[fl][sl] = b->next_free;
+	if (b->next_free)
+		b->next_free->prev_free = b->prev_free;
+	if (!a->free_lists[fl][sl]) {
+		a->sl_bitmap[fl] &= (uint8_t)~(1u << sl);
+		if (!a->sl_bitmap[fl])
+			a->fl_bitmap &= ~(1u << fl);
+	}
+	b->size &= ~(size_t)UM_F_FREE;
+	a->stats.free_bytes -= blk_size(b);
+}
+
+static um_blk_t *find_free(umalloc_arena_t *a, size_t size)
+{
+	uint32_t fl, sl;
+	uint32_t sl_map;
+	uint32_t fl_map;
+
+	if (!mapping_search(size, &fl, &sl))
+		return NULL;
+
+	sl_map = a->sl_bitmap[fl] & (~0u << sl);
+	if (!sl_map) {
+		fl_map = a->fl_bitmap & (~0u << (fl + 1u));
+		if (!fl_map)
+			return NULL;
+		fl     = UM_CTZ(fl_map);
+		sl_map = a->sl_bitmap[fl];
+	}
+	return a->free_lists[fl][UM_CTZ(sl_map)];
+}
+
+/* Release @b to the fallback, merging with free physical neighbours. */
+static void tlsf_release(umalloc_arena_t *a, um_blk_t *b)
+{
+	um_blk_t *n = blk_next(b);
+	um_blk_t *p = b->prev_phys;
+
+	if (blk_is_free(n)) {
+		remove_free(a, n);
+		b->size += UM_HDR + blk_size(n);
+		blk_next(b)->prev_phys = b;
+	}
+	if (p && blk_is_free(p)) {
+		remove_free(a, p);
+		p->size += UM_HDR + blk_size(b);
+		blk_next(p)->prev_phys = p;
+		b = p;
+	}
+	insert_free(a, b);
+}
+
+static um_blk_t *tlsf_take(umalloc_arena_t *a, size_t need)
+{
+	um_blk_t *b = find_free(a, need);
+	um_blk_t *r;
+
+	if (!b)
+		return NULL;
+
+	remove_free(a, b);
+	if (blk_size(b) >= need + UM_HDR + UM_MIN) {
+		r            = (um_blk_t *)((uint8_t *)blk_payload(b) + need);
+		r->prev_phys = b;
+		r->size      = blk_size(b) - need - UM_HDR;
+		blk_next(r)->prev_phys = r;
+		b->size      = need;
+		insert_free(a, r);
+	}
+	return b;
+}
+
+/*
+ * Hand [base, base+size) to the fallback.  Returns the new segment's
+ * sentinel, or NULL if the range was merged into the primary segment or
+ * is too small to use.
+ */
+static um_blk_t *add_range(umalloc_arena_t *a, uintptr_t base, size_t size)
+{
+	uintptr_t start = (base + UM_ALIGN - 1u) & ~(uintptr_t)(UM_ALIGN - 1u);
+	um_blk_t *b;
+	um_blk_t *s;
+
+	if (base + size < start + 2u * UM_HDR + UM_MIN)
+		return NULL;
+	size = (size - (start - base)) & ~(size_t)(UM_ALIGN - 1u);
+
+	if (a->tail && start == (uintptr_t)blk_payload(a->tail)) {
+		/* In-place growth: the old sentinel heads the new block. */
+		b       = a->tail;
+		b->size = size - UM_HDR;
+		s       = blk_next(b);
+		s->prev_phys = b;
+		s->size      = 0u;
+		a->tail      = s;
+		tlsf_release(a, b);
+		return NULL;
+	}
+
+	b            = (um_blk_t *)start;
+	b->prev_phys = NULL;
+	b->size      = size - 2u * UM_HDR;
+	s            = blk_next(b);
+	s->prev_phys = b;
+	s->size      = 0u;
+	insert_free(a, b);
+	return s;
+}
+
+/* Return every parked size-class block to the fallback so it can merge. */
+static void quick_flush(umalloc_arena_t *a)
+{
+	um_blk_t *b;
+	uint32_t  i;
+
+	for (i = 0u; i < UM_QUICK_COUNT; i++) {
+		while ((b = a->quick[i]) != NULL) {
+			a->quick[i] = b->next_free;
+			a->stats.quick_bytes -= blk_size(b);
+			tlsf_release(a, b);
+		}
+		a->quick_len[i] = 0u;
+	}
+}
+
+static int arena_extend(umalloc_arena_t *a, size_t need)
+{
+	ulmk_heap_info_t added;
+	size_t           ext = need + 2u * UM_HDR;
+
+	if (ext < UMALLOC_EXTEND_MIN)
+		ext = UMALLOC_EXTEND_MIN;
+	if (ulmk_heap_extend_info(ext, &added) != ULMK_OK)
+		return 0;
+
+	a->stats.extends++;
+	(void)add_range(a, added.base, added.size);
+	return 1;
+}
+
+/* ─── public API ─────────────────────────────────────────────────────────── */
+
+umalloc_arena_t *umalloc_init(uint32_t flags)
+{
+	ulmk_heap_info_t info;
+	umalloc_arena_t *a;
+	uint8_t         *p;
+	size_t           i;
+
+	if (ulmk_get_thread_heap(&info) != ULMK_OK)
+		return NULL;
+	if (info.size < UM_ARENA_SZ + 2u * UM_HDR + UM_MIN)
+		return NULL;
+
+	a = (umalloc_arena_t *)info.base;
+	p = (uint8_t *)a;
+	for (i = 0u; i < sizeof(*a); i++)
+		p[i] = 0u;
+	a->flags = flags;
+	a->tail  = add_range(a, info.base + UM_ARENA_SZ,
+			     info.size - UM_ARENA_SZ);
+	return a;
+}
+
+void *umalloc(umalloc_arena_t *a, size_t size)
+{
+	um_blk_t *b;
+	size_t    need;
+	uint32_t  cls;
+
+	if (!a || size == 0u)
+		return NULL;
+	/* Keep UM_ROUND() and arena_extend()'s header slack from wrapping. */
+	if (size > SIZE_MAX - UM_ALIGN - 2u * UM_HDR) {
+		a->stats.failures++;
+		return NULL;
+	}
+
+	need = UM_ROUND(size);
+	if (need < UM_MIN)
+		need = UM_MIN;
+
+	if (need <= UMALLOC_QUICK_MAX) {
+		cls = (uint32_t)(need >> UM_ALIGN_SHIFT) - 1u;
+		b   = a->quick[cls];
+		if (b) {
+			a->quick[cls] = b->next_free;
+			a->quick_len[cls]--;
+			a->stats.quick_bytes -= blk_size(b);
+			a->stats.fast_hits++;
+			return blk_payload(b);
+		}
+	}
+
+	b = tlsf_take(a, need);
+	if (!b && a->stats.quick_bytes) {
+		quick_flush(a);
+		b = tlsf_take(a, need);
+	}
+	if (!b && (a->flags & UMALLOC_F_EXTEND) && arena_extend(a, need))
+		b = tlsf_take(a, need);
+	if (!b) {
+		a->stats.failures++;
+		return NULL;
+	}
+
+	a->stats.slow_allocs++;
+	return blk_payload(b);
+}
+
+void ufree(umalloc_arena_t *a, void *ptr)
+{
+	um_blk_t *b;
+	size_t    sz;
+	uint32_t  cls;
+
+	if (!a || !ptr)
+		return;
+
+	b  = blk_from_payload(ptr);
+	sz = blk_size(b);
+	if (sz <= UMALLOC_QUICK_MAX) {
+		cls = (uint32_t)(sz >> UM_ALIGN_SHIFT) - 1u;
+		if (a->quick_len[cls] < UMALLOC_QUICK_DEPTH) {
+			b->next_free  = a->quick[cls];
+			a->quick[cls] = b;
+			a->quick_len[cls]++;
+			a->stats.quick_bytes += sz;
+			return;
+		}
+	}
+	tlsf_release(a, b);
+}
+
+void umalloc_stats(const umalloc_arena_t *a, umalloc_stats_t *out)
+{
+	if (a && out)
+		*out = a->stats;
+}
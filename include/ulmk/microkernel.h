@@ -24,6 +24,7 @@
 #include <stdbool.h>
 #include <ulmk/syscall_nr.h>
 #include <ulmk/syscall_wcet.h>
+#include <ulmk/trace.h>
 
 /* =========================================================================
  * Privilege levels (TriCore PSW.IO field)
@@ -57,10 +58,20 @@ typedef enum {
 typedef uintptr_t ulmk_tid_t;
 typedef uintptr_t ulmk_ep_t;
 typedef uintptr_t ulmk_notif_t;
+typedef uintptr_t ulmk_domain_t;
+typedef uintptr_t ulmk_waitset_t;
 
 #define ULMK_TID_INVALID		((ulmk_tid_t)0)
 #define ULMK_EP_INVALID		((ulmk_ep_t)0)
 #define ULMK_NOTIF_INVALID	((ulmk_notif_t)0)
+#define ULMK_DOMAIN_INVALID	((ulmk_domain_t)0)
+#define ULMK_WAITSET_INVALID	((ulmk_waitset_t)0)
+
+/* ulmk_irq_affinity(): route the source to whichever CPU its driver runs on. */
+#define ULMK_IRQ_CPU_AUTO	0xFFu
+
+/* ulmk_irq_coalesce(): OR into max_events for a level-triggered source. */
+#define ULMK_IRQ_COALESCE_LEVEL	(1u << 31)
 
 /* =========================================================================
  * IPC message
@@ -86,8 +97,23 @@ typedef struct {
 	ulmk_privilege_t	 privilege;
 	size_t		 heap_size;	/* 0 = no per-thread heap; last for compat */
 	uint8_t		 cpu;		/* permanent affinity; 0 = CPU0 */
+	ulmk_domain_t	 domain;	/* shared protection domain; 0 = own table */
 } ulmk_thread_attr_t;
 
+/*
+ * Wait set sources and the event returned by ulmk_wait_any().  A set holds
+ * up to ULMK_WAITSET_MAX_SOURCES endpoints and notifications.
+ */
+#define ULMK_WAITSET_MAX_SOURCES	16u
+#define ULMK_WAITSET_EP			1u	/* a caller is queued on the endpoint */
+#define ULMK_WAITSET_NOTIF		2u	/* bits in the source mask are set */
+
+typedef struct ulmk_waitset_event {
+	uint32_t  kind;		/* ULMK_WAITSET_EP or ULMK_WAITSET_NOTIF */
+	uintptr_t handle;	/* the ready endpoint or notification */
+	uint32_t  bits;		/* NOTIF: matched bits, already consumed */
+} ulmk_waitset_event_t;
+
 /*
  * Per-thread heap descriptor — returned by ulmk_get_thread_heap().
  * Describes the heap area within the thread's slabAO allocation.
@@ -97,6 +123,148 @@ typedef struct {
 	size_t    size;	/* size of the heap region in bytes */
 } ulmk_heap_info_t;
 
+/*
+ * MPU switch counters — returned by ulmk_mpu_stats().  Per CPU, monotonic
+ * since boot.  A "slot" is one PMP entry, MPU region or TriCore DPR.
+ */
+typedef struct {
+	uint32_t switches;	/* ulmk_arch_mpu_switch() calls */
+	uint32_t unchanged;	/* switches that wrote no protection register */
+	uint32_t slot_writes;	/* slots rewritten */
+	uint32_t slot_skips;	/* slots left alone: shadow already matched */
+	uint32_t merged;	/* slots saved by merging adjacent regions */
+	uint32_t faults;	/* faults served by a lazy region load */
+} ulmk_mpu_stats_t;
+
+/*
+ * IRQ dispatch counters — returned by ulmk_irq_stats().  Per CPU, monotonic
+ * since boot.  Latencies are cycles from kernel dispatch entry to the
+ * notification signal; they stay 0 unless an option that runs the cycle
+ * counter is enabled (syscall WCET, trace, thread, scheduler, IRQ-off,
+ * spinlock or user cycle statistics).
+ */
+typedef struct {
+	uint32_t dispatches;	/* ulmk_kern_irq_dispatch() calls */
+	uint32_t signals;	/* dispatches that signalled a notification */
+	uint32_t lat_last;	/* latency of the last signal */
+	uint32_t lat_max;	/* worst latency seen */
+	uint32_t lat_total;	/* sum of latencies (wraps) */
+	uint32_t coal_events;	/* interrupts delivered in coalesced batches */
+	uint32_t coal_batches;	/* signals that closed a coalesced batch */
+	uint32_t ipis;		/* reschedule IPIs sent to other CPUs */
+} ulmk_irq_stats_t;
+
+/*
+ * Per-thread run-time counters — returned by ulmk_thread_stats().
+ * Monotonic since the thread was created (ULMK_CONFIG_THREAD_STATS=1).
+ * Cycles are ulmk_arch_cycle_read() units of the thread's CPU.
+ */
+typedef struct {
+	uint64_t cycles;	/* time on the CPU */
+	uint64_t ready_cycles;	/* time READY in the run queue, not running */
+	uint32_t runs;		/* times switched in */
+	uint32_t voluntary;	/* switched out blocking, sleeping or yielding */
+	uint32_t involuntary;	/* switched out by preemption */
+	uint32_t ipc_calls;	/* ulmk_ep_call*() made */
+	uint32_t ipc_recvs;	/* requests received as a server */
+	uint32_t notif_signals;	/* ulmk_notif_signal/broadcast() made */
+	uint32_t notif_wakes;	/* wake-ups by notification bits */
+	uint32_t cpu;		/* affinity CPU */
+} ulmk_thread_stats_t;
+
+/*
+ * Stack usage — returned by ulmk_thread_stack_stats() (kernel built with
+ * ULMK_CONFIG_STACK_WATERMARK=1).  Byte counts are high-water marks from
+ * the paint laid down at thread creation.  kstack_* is the per-thread
+ * exception-frame reserve carved from the top of the stack on ports that
+ * have one (ARM); csa_used counts TriCore CSA frames.  Other ports report 0.
+ */
+typedef struct {
+	uint32_t size;		/* user stack bytes */
+	uint32_t used;		/* deepest user stack use */
+	uint32_t kstack_size;	/* exception-frame reserve (ULMK_ARCH_KSTACK_SIZE) */
+	uint32_t kstack_used;	/* deepest use of that reserve */
+	uint32_t csa_used;	/* most CSA frames held when switched in */
+	uint32_t overflow;	/* 1 = lowest stack word was overwritten */
+} ulmk_stack_stats_t;
+
+/*
+ * Wake-up latency — returned by ulmk_sched_lat_stats() (kernel built with
+ * ULMK_CONFIG_SCHED_LATENCY=1).  Cycles from a thread's wake-up enqueue to
+ * its switch-in, per CPU and per band of 32 priorities (band = prio / 32).
+ * hist[i] counts samples in [2^i, 2^(i+1)); hist[0] also holds 0, the last
+ * bucket is open-ended.  min/max are 0 while count is 0.
+ */
+#define ULMK_SCHED_LAT_BANDS	8u
+#define ULMK_SCHED_LAT_BUCKETS	24u
+
+typedef struct {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	uint32_t hist[ULMK_SCHED_LAT_BUCKETS];
+} ulmk_sched_lat_stats_t;
+
+/*
+ * IRQ-off profile — returned by ulmk_irqoff_stats() (kernel built with
+ * ULMK_CONFIG_IRQOFF_STATS=1).  All times are cycles of that CPU.
+ *
+ * worst[] holds the longest IRQ-masked windows of distinct sites, longest
+ * first.  A site is the return address of the ulmk_klock_irqsave() call that
+ * masked IRQs, or one of the ULMK_IRQOFF_SITE_* gateway tags below.
+ *
+ * lock[] is indexed by ULMK_LOCK_*: acquisitions on this CPU, time spent
+ * spinning before the lock was taken and time it was held (max + sum), and
+ * the acquiring call site of the longest hold.
+ */
+#define ULMK_IRQOFF_TOP			4u
+
+#define ULMK_IRQOFF_SITE_SYSCALL(nr)	(0xFFFF0000u | ((nr) & 0xFFu))
+#define ULMK_IRQOFF_SITE_IRQ(srpn)	(0xFFFF0100u | ((srpn) & 0xFFu))
+#define ULMK_IRQOFF_SITE_TICK		0xFFFF0200u
+#define ULMK_IRQOFF_SITE_IPI		0xFFFF0300u
+#define ULMK_IRQOFF_SITE_IS_GATEWAY(s)	(((s) & 0xFFFF0000u) == 0xFFFF0000u)
+
+#define ULMK_LOCK_THREAD		0u
+#define ULMK_LOCK_IPC			1u
+#define ULMK_LOCK_RQ			2u
+#define ULMK_LOCK_IRQ			3u
+#define ULMK_LOCK_TIMER			4u
+#define ULMK_LOCK_MEM			5u
+#define ULMK_LOCK_NR			6u
+
+typedef struct {
+	uint32_t cycles;
+	uint32_t site;
+} ulmk_irqoff_site_t;
+
+typedef struct {
+	uint32_t acquires;
+	uint32_t wait_max;
+	uint32_t hold_max;
+	uint32_t hold_max_site;
+	uint64_t wait_sum;
+	uint64_t hold_sum;
+} ulmk_lock_stats_t;
+
+typedef struct {
+	uint32_t           windows;	/* IRQ-off windows measured */
+	ulmk_irqoff_site_t worst[ULMK_IRQOFF_TOP];
+	ulmk_lock_stats_t  lock[ULMK_LOCK_NR];
+} ulmk_irqoff_stats_t;
+
+/*
+ * Spinlock contention counters of one global kernel lock (ULMK_LOCK_*) —
+ * returned by ulmk_spinlock_stats() (kernel built with
+ * ULMK_CONFIG_SPINLOCK_STATS=1).  Summed over all CPUs since boot.
+ */
+typedef struct {
+	uint32_t acquires;	/* times the lock was taken */
+	uint32_t contended;	/* ... of which had to wait for another CPU */
+	uint64_t spin_cycles;	/* cycles spent waiting, waiter's counter */
+} ulmk_spinlock_stats_t;
+
 /* =========================================================================
  * Boot information — passed to ulmk_root_thread()
  * ========================================================================= */
@@ -141,6 +309,7 @@ typedef struct {
 #define ULMK_CAP_IRQ		(1u << 2)  /* may bind/enable hardware IRQs */
 #define ULMK_CAP_MAP_PERIPH	(1u << 3)  /* may map peripheral MMIO regions */
 #define ULMK_CAP_GRANT_CAP	(1u << 4)  /* may grant capabilities to others */
+#define ULMK_CAP_STATS		(1u << 5)  /* may read other threads' stats, IRQ-off profile */
 #define ULMK_CAP_ALL		0xFFu	   /* all capabilities; root thread initial */
 
 /* =========================================================================
@@ -231,6 +400,172 @@ static inline int ulmk_wcet_bind(volatile struct ulmk_syscall_wcet_slot *slot)
 	return (int)r;
 }
 
+/**
+ * @brief Read the MPU switch counters of one CPU.
+ *
+ * Reports how many protection-register slots context switches rewrote versus
+ * left alone because the per-CPU shadow already matched.
+ *
+ * @param cpu CPU index (< ULMK_ARCH_NUM_CPU).
+ * @param out Filled on success.
+ * @return @c ULMK_OK, or @c ULMK_EINVAL for a bad CPU index or NULL @p out.
+ */
+static inline int ulmk_mpu_stats(uint32_t cpu, ulmk_mpu_stats_t *out)
+{
+	uint32_t r;
+
+	ULMK_SYSCALL_2(ULMK_SYS_MPU_STATS, cpu, out, r);
+	return (int)r;
+}
+
+/**
+ * @brief Read the IRQ dispatch counters of one CPU.
+ *
+ * @param cpu CPU index (< ULMK_ARCH_NUM_CPU).
+ * @param out Filled on success.
+ * @return @c ULMK_OK, or @c ULMK_EINVAL for a bad CPU index or NULL @p out.
+ */
+static inline int ulmk_irq_stats(uint32_t cpu, ulmk_irq_stats_t *out)
+{
+	uint32_t r;
+
+	ULMK_SYSCALL_2(ULMK_SYS_IRQ_STATS, cpu, out, r);
+	return (int)r;
+}
+
+/**
+ * @brief Read the cycle histogram of one syscall number on one CPU.
+ *
+ * Every syscall made on @p cpu since boot is folded in, whatever thread
+ * made it, so worst cases between two reads are never lost.  Sum the CPUs
+ * for a system-wide view.
+ *
+ * @param cpu CPU index (< ULMK_ARCH_NUM_CPU).
+ * @param nr  Syscall number (< ULMK_SYS_MAX).
+ * @param out Filled on success.
+ * @return @c ULMK_OK, or @c ULMK_EINVAL for a bad CPU index or syscall
+ *         number, NULL @p out, or if WCET is not enabled in this build.
+ */
+static inline int ulmk_wcet_stats(uint32_t cpu, uint32_t nr,
+				  ulmk_wcet_stats_t *out)
+{
+	uint32_t r;
+
+	ULMK_SYSCALL_3(ULMK_SYS_WCET_STATS, cpu, nr, out, r);
+	return (int)r;
+}
+
+/**
+ * @brief Read the run-time counters of a thread.
+ *
+ * CPU time is charged at every context switch and timer tick, so a thread
+ * running on another CPU may be reported up to one tick behind.  Wait time
+ * is counted from a wake-up on the thread's own CPU or a preemption; a
+ * wake-up sent from another CPU starts no wait interval.
+ *
+ * @param tid Thread to query; @c 0 for the caller.
+ * @param out Filled on success.
+ * @return @c ULMK_OK; @c ULMK_EINVAL for NULL @p out; @c ULMK_ESRCH for an
+ *         unknown or dead thread; @c ULMK_ENOTSUP if thread statistics are
+ *         not enabled in this build.
+ * @pre Reading a thread other than the caller requires @c ULMK_CAP_STATS.
+ */
+static inline int ulmk_thread_stats(ulmk_tid_t tid, ulmk_thread_stats_t *out)
+{
+	uint32_t r;
+
+	ULMK_SYSCALL_2(ULMK_SYS_THREAD_STATS, tid, out, r);
+	return (int)r;
+}
+
+/**
+ * @brief Read a thread's stack high-water marks.
+ *
+ * Every thread stack is filled with a known pattern when it is created;
+ * the deepest word no longer holding it gives @c used.  The scan runs at
+ * this call, so its cost grows with the stack size.  The lowest stack word
+ * is checked at every switch-out and @c overflow latches once it changes.
+ * The same figures are printed by the kernel when the thread is freed.
+ *
+ * @param tid Thread to query; @c 0 for the caller.
+ * @param out Filled on success.
+ * @return @c ULMK_OK; @c ULMK_EINVAL for NULL @p out; @c ULMK_ESRCH for an
+ *         unknown or dead thread; @c ULMK_ENOTSUP if stack watermarks are
+ *         not enabled in this build.
+ * @pre Reading a thread other than the caller requires @c ULMK_CAP_STATS.
+ */
+static inline int ulmk_thread_stack_stats(ulmk_tid_t tid,
+					  ulmk_stack_stats_t *out)
+{
+	uint32_t r;
+
+	ULMK_SYSCALL_2(ULMK_SYS_THREAD_STACK_STATS, tid, out, r);
+	return (int)r;
+}
+
+/**
+ * @brief Read the wake-up latency histogram of one priority band on one CPU.
+ *
+ * A sample is taken each time a thread woken on its own CPU (IPC, notif,
+ * timer, IRQ, create, resume) is switched in; preempted threads going back
+ * to the run queue are not sampled.
+ *
+ * @param cpu  CPU index (< ULMK_ARCH_NUM_CPU).
+ * @param band Priority band (< ULMK_SCHED_LAT_BANDS); band = priority / 32.
+ * @param out  Filled on success.
+ * @return @c ULMK_OK; @c ULMK_EINVAL for a bad CPU or band or NULL @p out;
+ *         @c ULMK_ENOTSUP if latency measurement is not enabled in this
+ *         build.
+ */
+static inline int ulmk_sched_lat_stats(uint32_t cpu, uint32_t band,
+				       ulmk_sched_lat_stats_t *out)
+{
+	uint32_t r;
+
+	ULMK_SYSCALL_3(ULMK_SYS_SCHED_LAT_STATS, cpu, band, out, r);
+	return (int)r;
+}
+
+/**
+ * @brief Read the IRQ-off and kernel lock profile of one CPU.
+ *
+ * Worst IRQ-masked windows with their call sites, and per-lock wait and
+ * hold times for the global kernel locks.
+ *
+ * @pre Caller holds @c ULMK_CAP_STATS (sites are kernel code addresses).
+ * @param cpu CPU index (< ULMK_ARCH_NUM_CPU).
+ * @param out Filled on success.
+ * @return @c ULMK_OK; @c ULMK_EINVAL for a bad CPU or NULL @p out;
+ *         @c ULMK_EPERM without the capability; @c ULMK_ENOTSUP if the
+ *         profiler is not enabled in this build.
+ */
+static inline int ulmk_irqoff_stats(uint32_t cpu, ulmk_irqoff_stats_t *out)
+{
+	uint32_t r;
+
+	ULMK_SYSCALL_2(ULMK_SYS_IRQOFF_STATS, cpu, out, r);
+	return (int)r;
+}
+
+/**
+ * @brief Read the contention counters of one global kernel spinlock.
+ *
+ * Callable at any privilege.  The read itself takes the lock once.
+ *
+ * @param lock @c ULMK_LOCK_* index.
+ * @param out  Filled on success.
+ * @return @c ULMK_OK; @c ULMK_EINVAL for a bad index or NULL @p out;
+ *         @c ULMK_ENOTSUP if the counters are not enabled in this build
+ *         or the arch lock has none (ARM, single-CPU only).
+ */
+static inline int ulmk_spinlock_stats(uint32_t lock, ulmk_spinlock_stats_t *out)
+{
+	uint32_t r;
+
+	ULMK_SYSCALL_2(ULMK_SYS_SPINLOCK_STATS, lock, out, r);
+	return (int)r;
+}
+
 /**
  * @brief Yield the CPU to the next runnable thread at the same priority.
  *
@@ -286,6 +621,24 @@ static inline void ulmk_tick_start(void)
 	(void)r;
 }
 
+/**
+ * @brief Read the cycle counter of the calling thread's CPU.
+ *
+ * For benchmarks: the value is ulmk_arch_cycle_read(), taken in the kernel,
+ * so two reads differ by at least one syscall round trip.  Counters of
+ * different CPUs are not synchronised.
+ *
+ * @param out Filled with the counter on success.
+ * @return @c ULMK_OK; @c ULMK_EINVAL for NULL @p out; @c ULMK_ENOTSUP
+ *         unless the kernel is built with ULMK_CONFIG_USER_CYCLES=1.
+ */
+static inline int ulmk_cycle_read(uint32_t *out)
+{
+	uint32_t r;
+	ULMK_SYSCALL_1(ULMK_SYS_CYCLE_READ, out, r);
+	return (int)r;
+}
+
 /**
  * @brief Create a runnable thread.
  * @param attr Thread attributes: entry, arg, stack_size, priority, privilege
@@ -549,10 +902,46 @@ static inline ulmk_notif_t ulmk_notif_create(void)
 }
 
 /**
- * @brief Atomically OR bits into a notification, waking any waiter.
+ * @brief Create a notification whose pending bits the caller can read
+ *        without a syscall.
+ *
+ * The kernel maps one MPU granule read-only into the caller and mirrors the
+ * pending bits into it on every signal, wait and poll.  A polling loop tests
+ * the word with ulmk_notif_peek() and only traps to consume
+ * (ulmk_notif_poll()) or to block (ulmk_notif_wait()).
+ *
+ * @param[out] word Receives the address of the mirrored bits word.
+ * @return New notification, or @c ULMK_NOTIF_INVALID if the kernel heap or
+ *         the caller's MPU region table is exhausted.
+ * @note The mapping is removed when the notification is destroyed.
+ */
+static inline ulmk_notif_t
+ulmk_notif_create_shared(const volatile uint32_t **word)
+{
+	uint32_t r;
+	ULMK_SYSCALL_1(ULMK_SYS_NOTIF_CREATE_SHARED, word, r);
+	return (ulmk_notif_t)r;
+}
+
+/**
+ * @brief Test pending bits of a shared notification with a plain load.
+ * @param word Word returned by ulmk_notif_create_shared().
+ * @param mask Bits of interest.
+ * @return The pending bits matching @p mask; nothing is cleared.
+ */
+static inline uint32_t ulmk_notif_peek(const volatile uint32_t *word,
+				       uint32_t mask)
+{
+	return *word & mask;
+}
+
+/**
+ * @brief Atomically OR bits into a notification, waking matching waiters.
  * @param notif Target notification.
  * @param bits  Bits to set.
  * @return @c ULMK_OK or an error code.
+ * @note Waiters are served in FIFO order and each pending bit wakes at most
+ *       one of them (the first whose mask covers it).
  * @note Safe to reach from IRQ-delivery context (the kernel signals from the ISR).
  */
 static inline int ulmk_notif_signal(ulmk_notif_t notif, uint32_t bits)
@@ -562,6 +951,21 @@ static inline int ulmk_notif_signal(ulmk_notif_t notif, uint32_t bits)
 	return (int)r;
 }
 
+/**
+ * @brief OR bits into a notification and wake every waiter whose mask matches.
+ * @param notif Target notification.
+ * @param bits  Bits to set.
+ * @return @c ULMK_OK or an error code.
+ * @note Each matching waiter receives (pending & its mask); bits delivered to
+ *       at least one waiter are then cleared, the rest stay pending.
+ */
+static inline int ulmk_notif_broadcast(ulmk_notif_t notif, uint32_t bits)
+{
+	uint32_t r;
+	ULMK_SYSCALL_2(ULMK_SYS_NOTIF_BROADCAST, notif, bits, r);
+	return (int)r;
+}
+
 /**
  * @brief Non-blocking check of notification bits.
  * @param notif Target notification.
@@ -616,6 +1020,83 @@ static inline int ulmk_notif_destroy(ulmk_notif_t notif)
 	return (int)r;
 }
 
+/* =========================================================================
+ * Wait set API — docs/api_spec.md §8
+ * ========================================================================= */
+
+/**
+ * @brief Create an empty wait set.
+ * @return New wait set, or @c ULMK_WAITSET_INVALID if out of memory.
+ */
+static inline ulmk_waitset_t ulmk_waitset_create(void)
+{
+	uint32_t r;
+	ULMK_SYSCALL_0(ULMK_SYS_WAITSET_CREATE, r);
+	return (ulmk_waitset_t)r;
+}
+
+/**
+ * @brief Register an endpoint or notification with a wait set.
+ * @param ws     Target wait set.
+ * @param kind   @c ULMK_WAITSET_EP or @c ULMK_WAITSET_NOTIF.
+ * @param handle Endpoint or notification handle.
+ * @param mask   Notification bits of interest (ignored for endpoints).
+ * @return @c ULMK_OK, @c ULMK_EINVAL (bad handle, already in a set, zero
+ *         mask) or @c ULMK_ENOSPC (set full).
+ * @note A source belongs to at most one wait set at a time.
+ */
+static inline int ulmk_waitset_add(ulmk_waitset_t ws, uint32_t kind,
+				   uintptr_t handle, uint32_t mask)
+{
+	uint32_t r;
+	ULMK_SYSCALL_4(ULMK_SYS_WAITSET_ADD, ws, kind, handle, mask, r);
+	return (int)r;
+}
+
+/**
+ * @brief Remove a source registered with ulmk_waitset_add().
+ * @return @c ULMK_OK or @c ULMK_EINVAL if @p handle is not in @p ws.
+ */
+static inline int ulmk_waitset_del(ulmk_waitset_t ws, uint32_t kind,
+				   uintptr_t handle)
+{
+	uint32_t r;
+	ULMK_SYSCALL_3(ULMK_SYS_WAITSET_DEL, ws, kind, handle, r);
+	return (int)r;
+}
+
+/**
+ * @brief Block until any source in @p ws is ready.
+ *
+ * Endpoints are level-triggered: the event only says a caller is queued;
+ * collect it with ulmk_ep_recv(), which then does not block.  Notification
+ * bits are consumed and returned in @p ev->bits.
+ *
+ * @param ws Wait set.
+ * @param[out] ev The ready source.
+ * @return @c ULMK_OK, or @c ULMK_EINVAL (bad set, another thread already
+ *         waiting on it, or the set was destroyed while blocked).
+ */
+static inline int ulmk_wait_any(ulmk_waitset_t ws, ulmk_waitset_event_t *ev)
+{
+	uint32_t r;
+	ULMK_SYSCALL_2(ULMK_SYS_WAIT_ANY, ws, ev, r);
+	return (int)r;
+}
+
+/**
+ * @brief Free a wait set; its sources are left untouched.
+ * @return @c ULMK_OK or an error code.
+ * @note A thread blocked in ulmk_wait_any() on @p ws is woken with
+ *       @c ULMK_EINVAL.
+ */
+static inline int ulmk_waitset_destroy(ulmk_waitset_t ws)
+{
+	uint32_t r;
+	ULMK_SYSCALL_1(ULMK_SYS_WAITSET_DESTROY, ws, r);
+	return (int)r;
+}
+
 /* =========================================================================
  * Memory API — docs/api_spec.md §9
  *
@@ -626,7 +1107,8 @@ static inline int ulmk_notif_destroy(ulmk_notif_t notif)
  *   single MPU DPR.  The TCB lives in a separate allocation.
  *
  *   ulmk_get_thread_heap() — query heap base and size for the calling thread.
- *   ulmk_heap_extend()     — grow heap by allocating an additional slab from
+ *   ulmk_heap_extend()     — grow heap in place when the neighbouring pool
+ *                            block is free, else by an additional slab from
  *                            the kernel pool; requires ULMK_PRIV_DRIVER.
  * ========================================================================= */
 
@@ -645,8 +1127,10 @@ static inline int ulmk_get_thread_heap(ulmk_heap_info_t *info)
 
 /**
  * @brief Grow the calling thread's heap.
- * @param size Additional bytes to allocate from the global user pool, covered
- *             by an extra MPU region.
+ * @param size Additional bytes (rounded up to the MPU region granule).  The
+ *             kernel first grows the slabAO in place by absorbing the
+ *             adjacent free block of the user pool; only if that fails is a
+ *             separate block allocated and covered by an extra MPU region.
  * @return @c ULMK_OK, @c ULMK_ENOMEM, @c ULMK_EPERM or @c ULMK_ENOSPC (MPU
  *         region limit reached).
  * @pre Caller runs at @c ULMK_PRIV_DRIVER.
@@ -654,7 +1138,24 @@ static inline int ulmk_get_thread_heap(ulmk_heap_info_t *info)
 static inline int ulmk_heap_extend(size_t size)
 {
 	uint32_t r;
-	ULMK_SYSCALL_1(ULMK_SYS_HEAP_EXTEND, size, r);
+	ULMK_SYSCALL_2(ULMK_SYS_HEAP_EXTEND, size, 0u, r);
+	return (int)r;
+}
+
+/**
+ * @brief Grow the calling thread's heap and report the added range.
+ * @param size       As for ulmk_heap_extend().
+ * @param[out] added Filled with the range that was added.  For in-place
+ *                   growth @c added->base equals the previous heap end, so
+ *                   the heap returned by ulmk_get_thread_heap() is simply
+ *                   longer; otherwise it is a new, discontiguous block.
+ * @return As for ulmk_heap_extend().
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER.
+ */
+static inline int ulmk_heap_extend_info(size_t size, ulmk_heap_info_t *added)
+{
+	uint32_t r;
+	ULMK_SYSCALL_2(ULMK_SYS_HEAP_EXTEND, size, added, r);
 	return (int)r;
 }
 
@@ -710,6 +1211,58 @@ static inline int ulmk_mem_grant(void *addr, size_t size,
 	return (int)r;
 }
 
+/**
+ * @brief Create a shared protection domain.
+ *
+ * Threads spawned with @c attr.domain set to the returned handle share one
+ * MPU region table: switching between them reprograms nothing, and a map or
+ * grant made by or to any member covers all of them.
+ *
+ * @return New domain, or @c ULMK_DOMAIN_INVALID if the kernel heap is
+ *         exhausted.
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER.
+ */
+static inline ulmk_domain_t ulmk_domain_create(void)
+{
+	uint32_t r;
+	ULMK_SYSCALL_0(ULMK_SYS_PROC_CREATE, r);
+	return (ulmk_domain_t)r;
+}
+
+/**
+ * @brief Destroy a domain; no new thread may join it afterwards.
+ *
+ * Current members keep their mappings.  The domain and its anonymous
+ * mappings are freed when the last member exits.
+ *
+ * @return @c ULMK_OK or @c ULMK_EINVAL (unknown or destroyed domain).
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER.
+ */
+static inline int ulmk_domain_destroy(ulmk_domain_t dom)
+{
+	uint32_t r;
+	ULMK_SYSCALL_1(ULMK_SYS_PROC_DESTROY, dom, r);
+	return (int)r;
+}
+
+/**
+ * @brief Share a region the caller owns with every member of a domain.
+ * @param dom   Target domain.
+ * @param addr  Base address of a region in the caller's map.
+ * @param size  Region size in bytes.
+ * @param perms Permission mask; clipped to what the caller holds.
+ * @return @c ULMK_OK, @c ULMK_EPERM (caller does not own @p addr),
+ *         @c ULMK_EINVAL (unknown domain) or @c ULMK_ENOSPC (table full).
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER.
+ */
+static inline int ulmk_domain_grant(ulmk_domain_t dom, void *addr,
+				    size_t size, uint32_t perms)
+{
+	uint32_t r;
+	ULMK_SYSCALL_4(ULMK_SYS_PROC_ADD_REGION, dom, addr, size, perms, r);
+	return (int)r;
+}
+
 /* =========================================================================
  * IRQ API — docs/api_spec.md §10  (requires ULMK_PRIV_DRIVER)
  * ========================================================================= */
@@ -834,12 +1387,19 @@ static inline ulmk_notif_t ulmk_irq_attach_hw(uint8_t srpn,
 }
 
 /**
- * @brief Tear down an attach (or leave bind-only bindings untouched).
+ * @brief Tear down an attach or IRQ thread binding (or leave bind-only
+ *        bindings untouched).
  *
  * Disables the source, destroys an attach-owned notification, and frees the
- * binding slot when it was created by attach/attach_hw.
+ * binding slot when it was created by attach/attach_hw or
+ * ulmk_irq_thread_bind().  A handler blocked in ulmk_irq_thread_wait() is
+ * woken with @c ULMK_EINVAL.
  *
- * @return @c ULMK_OK, @c ULMK_EINVAL, or @c ULMK_ENOTSUP when
+ * A thread binding may only be removed by its handler thread or by a
+ * caller holding @c ULMK_CAP_KILL.
+ *
+ * @return @c ULMK_OK, @c ULMK_EINVAL, @c ULMK_EPERM (someone else's thread
+ *         binding), or @c ULMK_ENOTSUP for attach bindings when
  *         @c ULMK_CONFIG_IRQ_ATTACH=0.
  */
 static inline int ulmk_irq_detach(uint8_t srpn)
@@ -849,6 +1409,152 @@ static inline int ulmk_irq_detach(uint8_t srpn)
 	return (int)r;
 }
 
+/**
+ * @brief Make the calling thread the handler thread for an interrupt.
+ *
+ * Middle ground between ulmk_irq_bind() (notification wake) and
+ * ulmk_irq_attach() (callback in ISR context): the ISR masks the source and
+ * readies the caller directly — no notification, no IPC lock — and the
+ * handler runs in its own protection context.  Loop on
+ * ulmk_irq_thread_wait() to serve it.
+ *
+ * @param srpn    Service request priority number (1–255).
+ * @param src_reg Hardware SRC address as for ulmk_irq_bind_hw(), or 0 to
+ *                route @p srpn as ulmk_irq_bind() does.
+ * @param prio    Priority the handler runs at for each interrupt, if higher
+ *                than its own (lower value); dropped again at the next wait.
+ *                On RISC-V it is also the source's CLIC level or PLIC
+ *                priority.
+ * @return @c ULMK_OK, @c ULMK_EINVAL (bad @p srpn or already bound) or
+ *         @c ULMK_ENOSPC (binding table full).
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER and holds @c ULMK_CAP_IRQ.
+ * @note ulmk_irq_detach() unbinds; the binding also goes when the thread
+ *       exits or is killed.
+ */
+static inline int ulmk_irq_thread_bind(uint8_t srpn, uintptr_t src_reg,
+				       uint8_t prio)
+{
+	uint32_t r;
+	ULMK_SYSCALL_3(ULMK_SYS_IRQ_THREAD_BIND, srpn, src_reg, prio, r);
+	return (int)r;
+}
+
+/**
+ * @brief Finish the current interrupt and block until the next one.
+ *
+ * Restores the caller's own priority, then acks and unmasks the source and
+ * blocks.  An interrupt that fired while the handler ran returns at once.
+ * The first call arms the binding; ulmk_irq_enable() is not needed.
+ *
+ * @param srpn SRPN bound with ulmk_irq_thread_bind() by the caller.
+ * @return @c ULMK_OK when an interrupt is pending, or @c ULMK_EINVAL if
+ *         @p srpn is not bound to the caller or was detached while waiting.
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER.
+ */
+static inline int ulmk_irq_thread_wait(uint8_t srpn)
+{
+	uint32_t r;
+	ULMK_SYSCALL_1(ULMK_SYS_IRQ_THREAD_WAIT, srpn, r);
+	return (int)r;
+}
+
+/**
+ * @brief Coalesce a high-rate interrupt into one notification per batch.
+ *
+ * While coalescing, the kernel counts each interrupt of @p srpn and re-arms
+ * the source itself instead of signalling.  The bound notification bit is
+ * signalled once when @p max_events interrupts have been counted, or
+ * @p max_ticks timer ticks after the first interrupt of the batch, whichever
+ * comes first.  Ack the source as usual after each wake.
+ *
+ * @param srpn       Source bound with ulmk_irq_bind() / ulmk_irq_bind_hw().
+ * @param max_events Interrupts per batch; 0 or 1 turns coalescing off and
+ *                   signals any open batch at once.  OR in
+ *                   @c ULMK_IRQ_COALESCE_LEVEL for a level-triggered source:
+ *                   the first interrupt masks it, the deadline delivers the
+ *                   batch and the ack after the wake unmasks it.
+ * @param max_ticks  Batch deadline in ticks (1 … wheel range); ignored when
+ *                   coalescing is turned off.
+ * @return @c ULMK_OK, @c ULMK_EINVAL (unbound @p srpn, attach or thread
+ *         binding, bad @p max_ticks) or @c ULMK_EPERM.
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER and holds @c ULMK_CAP_IRQ.
+ * @note Batch sizes show up in ulmk_irq_stats() as @c coal_events /
+ *       @c coal_batches.
+ */
+static inline int ulmk_irq_coalesce(uint8_t srpn, uint32_t max_events,
+				    uint32_t max_ticks)
+{
+	uint32_t r;
+	ULMK_SYSCALL_3(ULMK_SYS_IRQ_COALESCE, srpn, max_events, max_ticks, r);
+	return (int)r;
+}
+
+/**
+ * @brief Route an interrupt source to a CPU.
+ *
+ * With a CPU index the source is pinned there.  With @c ULMK_IRQ_CPU_AUTO it
+ * goes to the caller's CPU now and then follows the driver: each
+ * ulmk_irq_enable(), ulmk_irq_ack() or ulmk_irq_thread_wait() re-routes it
+ * to the CPU that call runs on, so the wake needs no cross-CPU IPI.
+ *
+ * @param srpn Bound source (1–255).
+ * @param cpu  Online CPU index, or @c ULMK_IRQ_CPU_AUTO.
+ * @return @c ULMK_OK, @c ULMK_EINVAL (unbound @p srpn, bad @p cpu) or
+ *         @c ULMK_EPERM.
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER and holds @c ULMK_CAP_IRQ.
+ * @note Hart-local RISC-V sources (CLINT, CLIC) and single-core ports
+ *       accept the call and keep their routing.
+ */
+static inline int ulmk_irq_affinity(uint8_t srpn, uint32_t cpu)
+{
+	uint32_t r;
+	ULMK_SYSCALL_2(ULMK_SYS_IRQ_AFFINITY, srpn, cpu, r);
+	return (int)r;
+}
+
+/* =========================================================================
+ * Kernel trace API — docs/api_spec.md §15
+ * ========================================================================= */
+
+/**
+ * @brief Select which kernel events are recorded.
+ *
+ * @param mask OR of @c ULMK_TRACE_BIT(ev); @c ULMK_TRACE_ALL (the boot
+ *             value) records everything, 0 stops recording.
+ * @return Previous mask, or @c ULMK_ENOTSUP if the kernel was built with
+ *         @c ULMK_CONFIG_TRACE_ENTRIES=0.
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER.
+ */
+static inline int ulmk_trace_mask(uint32_t mask)
+{
+	uint32_t r;
+	ULMK_SYSCALL_1(ULMK_SYS_TRACE_MASK, mask, r);
+	return (int)r;
+}
+
+/**
+ * @brief Drain records from one CPU's trace ring.
+ *
+ * Copies records from number @p *pos on and advances @p *pos past them;
+ * start at 0 and pass the same cursor back to read incrementally.  Records
+ * overwritten before they were read show up as gaps in @c seq.
+ *
+ * @param cpu CPU index (< ULMK_ARCH_NUM_CPU).
+ * @param pos Cursor, updated on return.
+ * @param buf Destination for up to @p max records.
+ * @param max Capacity of @p buf in records.
+ * @return Records copied (0 when caught up), @c ULMK_EINVAL for a bad CPU
+ *         or NULL pointer, or @c ULMK_ENOTSUP if tracing is compiled out.
+ * @pre Caller runs at @c ULMK_PRIV_DRIVER.
+ */
+static inline int ulmk_trace_read(uint32_t cpu, uint32_t *pos,
+				  ulmk_trace_rec_t *buf, uint32_t max)
+{
+	uint32_t r;
+	ULMK_SYSCALL_4(ULMK_SYS_TRACE_READ, cpu, pos, buf, max, r);
+	return (int)r;
+}
+
 /* =========================================================================
  * Capability API — docs/api_spec.md §13
  * Requires ULMK_CAP_GRANT_CAP.
@@ -12,9 +12,11 @@
  *   20–29 Thread query (unprivileged)
  *   30–39 IPC endpoints
  *   40–49 Notifications
+ *   50–59 Wait sets
  *   60–69 IRQ (IO >= 1)
  *   70–79 Thread management (IO >= 1)
  *   80–89 Process management (IO >= 1)
+ *   90–99 IRQ, continued (IO >= 1)
  */
 
 #ifndef ULMK_SYSCALL_NR_H
@@ -25,7 +27,7 @@
 #define ULMK_SYS_MUNMAP               2  /* int   ulmk_mem_unmap(addr, sz)            */
 #define ULMK_SYS_MEM_GRANT            3  /* int   ulmk_mem_grant(addr, sz, tid, perms)*/
 /* slots 4-6 reserved (ulmk_malloc/free/aligned_alloc removed in slabAO model) */
-#define ULMK_SYS_HEAP_EXTEND          7  /* int ulmk_heap_extend(size)                */
+#define ULMK_SYS_HEAP_EXTEND          7  /* int ulmk_heap_extend(size, info)          */
 #define ULMK_SYS_GET_THREAD_HEAP      8  /* int ulmk_get_thread_heap(info*)           */
 
 /* ── Scheduling / exit ───────────────────────────────────────────── */
@@ -35,11 +37,19 @@
 #define ULMK_SYS_SLEEP_CANCEL        13  /* int   ulmk_sleep_cancel(tid)              */
 #define ULMK_SYS_EP_CALL_TIMEOUT     14  /* int   ulmk_ep_call_timeout(ep,msg*,ms)    */
 #define ULMK_SYS_TICK_START          15  /* void  ulmk_tick_start(void) — board init  */
+#define ULMK_SYS_CYCLE_READ          16  /* int   ulmk_cycle_read(cycles*)            */
 
 /* ── Thread query (any privilege) ───────────────────────────────── */
 #define ULMK_SYS_THREAD_SELF         20  /* ulmk_tid_t ulmk_thread_self(void)           */
 #define ULMK_SYS_CPU_ID              21  /* uint32_t ulmk_cpu_id(void)                */
 #define ULMK_SYS_WCET_BIND           22  /* int ulmk_wcet_bind(slot*)                 */
+#define ULMK_SYS_MPU_STATS           23  /* int ulmk_mpu_stats(cpu, stats*)           */
+#define ULMK_SYS_IRQ_STATS           24  /* int ulmk_irq_stats(cpu, stats*)           */
+#define ULMK_SYS_WCET_STATS          25  /* int ulmk_wcet_stats(cpu, nr, stats*)      */
+#define ULMK_SYS_THREAD_STATS        26  /* int ulmk_thread_stats(tid, stats*)        */
+#define ULMK_SYS_SCHED_LAT_STATS     27  /* int ulmk_sched_lat_stats(cpu,band,stats*) */
+#define ULMK_SYS_IRQOFF_STATS        28  /* int ulmk_irqoff_stats(cpu, stats*)        */
+#define ULMK_SYS_SPINLOCK_STATS      29  /* int ulmk_spinlock_stats(lock, stats*)     */
 
 /* ── IPC endpoints ───────────────────────────────────────────────── */
 #define ULMK_SYS_EP_CREATE           30  /* ulmk_ep_t ulmk_ep_create(void)              */
@@ -58,6 +68,15 @@
 #define ULMK_SYS_NOTIF_POLL          43  /* uint32_t   ulmk_notif_poll(notif, mask)   */
 #define ULMK_SYS_NOTIF_DESTROY       44  /* int        ulmk_notif_destroy(notif)      */
 #define ULMK_SYS_NOTIF_WAIT_TIMEOUT  45  /* int ulmk_notif_wait_timeout(n,mask,bits*,ms) */
+#define ULMK_SYS_NOTIF_BROADCAST     46  /* int        ulmk_notif_broadcast(notif, bits) */
+#define ULMK_SYS_NOTIF_CREATE_SHARED 47  /* ulmk_notif_t ulmk_notif_create_shared(word**) */
+
+/* ── Wait sets ───────────────────────────────────────────────────── */
+#define ULMK_SYS_WAITSET_CREATE      50  /* ulmk_waitset_t ulmk_waitset_create(void)  */
+#define ULMK_SYS_WAITSET_ADD         51  /* int ulmk_waitset_add(ws,kind,h,mask)      */
+#define ULMK_SYS_WAITSET_DEL         52  /* int ulmk_waitset_del(ws, kind, h)         */
+#define ULMK_SYS_WAIT_ANY            53  /* int ulmk_wait_any(ws, ev*)                */
+#define ULMK_SYS_WAITSET_DESTROY     54  /* int ulmk_waitset_destroy(ws)              */
 
 /* ── IRQ (requires IO >= 1 / ULMK_PRIV_DRIVER) ────────────────────── */
 #define ULMK_SYS_IRQ_BIND            60  /* int ulmk_irq_bind(srpn, notif, bit)       */
@@ -68,6 +87,8 @@
 #define ULMK_SYS_IRQ_ATTACH          65  /* ulmk_notif_t ulmk_irq_attach(srpn,fn,data) */
 #define ULMK_SYS_IRQ_ATTACH_HW       66  /* ulmk_notif_t ulmk_irq_attach_hw(...)      */
 #define ULMK_SYS_IRQ_DETACH          67  /* int ulmk_irq_detach(srpn)                 */
+#define ULMK_SYS_IRQ_THREAD_BIND     68  /* int ulmk_irq_thread_bind(srpn,src,prio)  */
+#define ULMK_SYS_IRQ_THREAD_WAIT     69  /* int ulmk_irq_thread_wait(srpn)            */
 
 /* ── Thread management (requires IO >= 1 / ULMK_PRIV_DRIVER) ─────── */
 #define ULMK_SYS_THREAD_SPAWN        70  /* ulmk_tid_t ulmk_thread_create(attr*)        */
@@ -76,14 +97,27 @@
 #define ULMK_SYS_THREAD_RESUME       73  /* int      ulmk_thread_resume(tid)          */
 #define ULMK_SYS_THREAD_SET_PRIO     74  /* int      ulmk_thread_priority_set(tid,p)  */
 #define ULMK_SYS_THREAD_GET_PRIO     75  /* int      ulmk_thread_priority_get(tid)    */
+/* Any privilege (20–29 are full); other threads need ULMK_CAP_STATS. */
+#define ULMK_SYS_THREAD_STACK_STATS  76  /* int ulmk_thread_stack_stats(tid, stats*) */
 
 /* ── Process management (requires IO >= 1 / ULMK_PRIV_DRIVER) ─────── */
-#define ULMK_SYS_PROC_CREATE         80
-#define ULMK_SYS_PROC_DESTROY        81
-#define ULMK_SYS_PROC_ADD_REGION     82
+#define ULMK_SYS_PROC_CREATE         80  /* ulmk_domain_t ulmk_domain_create(void)    */
+#define ULMK_SYS_PROC_DESTROY        81  /* int ulmk_domain_destroy(dom)              */
+#define ULMK_SYS_PROC_ADD_REGION     82  /* int ulmk_domain_grant(dom,addr,sz,perms)  */
 #define ULMK_SYS_PROC_GRANT_CAP      83
 #define ULMK_SYS_PROC_GRANT_IRQ      84
 
+/* ── IRQ, continued (requires IO >= 1 / ULMK_PRIV_DRIVER) ─────────── */
+#define ULMK_SYS_IRQ_COALESCE        90  /* int ulmk_irq_coalesce(srpn,events,ticks) */
+#define ULMK_SYS_IRQ_AFFINITY        91  /* int ulmk_irq_affinity(srpn, cpu)          */
+
+/* ── Kernel trace (requires IO >= 1 / ULMK_PRIV_DRIVER) ───────────── */
+#define ULMK_SYS_TRACE_MASK         100  /* int ulmk_trace_mask(mask)                 */
+#define ULMK_SYS_TRACE_READ         101  /* int ulmk_trace_read(cpu,pos*,buf*,max)    */
+
+/* Highest assigned number; per-syscall kernel tables hold ULMK_SYS_LAST + 1. */
+#define ULMK_SYS_LAST               ULMK_SYS_TRACE_READ
+
 /* Upper bound used by the router for range validation. */
 #define ULMK_SYS_MAX                128
 
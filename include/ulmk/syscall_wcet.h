@@ -6,6 +6,9 @@
  * For correct measurement when more than one thread runs on a CPU (IPC),
  * bind a private slot with ulmk_wcet_bind() — the kernel then also writes
  * that thread's samples there, without peer overwrite.
+ *
+ * Every sample also lands in a per-CPU, per-syscall-number histogram that
+ * ulmk_wcet_stats() reads back, so no sample is lost between reads.
  */
 
 #ifndef ULMK_SYSCALL_WCET_H
@@ -36,4 +39,21 @@ struct ulmk_syscall_wcet_slot {
 extern volatile struct ulmk_syscall_wcet_slot
 	g_ulmk_syscall_wcet[ULMK_SYSCALL_WCET_MAX_CPUS];
 
+/* Log2 buckets: up to 2^19 cycles, the last one open-ended. */
+#define ULMK_SYSCALL_WCET_BUCKETS	20u
+
+/*
+ * Cycle distribution of one syscall number on one CPU since boot, in the
+ * units of ulmk_syscall_wcet_slot.delta.  hist[i] counts samples in
+ * [2^i, 2^(i+1)); hist[0] also holds 0-cycle samples.  min/max are 0 while
+ * count is 0.
+ */
+typedef struct {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	uint32_t hist[ULMK_SYSCALL_WCET_BUCKETS];
+} ulmk_wcet_stats_t;
+
 #endif /* ULMK_SYSCALL_WCET_H */
@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Kernel event trace — record format shared by the kernel, readers of
+ * ulmk_trace_read() and tools/trace_decode.py.
+ *
+ * Built in when ULMK_CONFIG_TRACE_ENTRIES > 0: each CPU then owns a ring of
+ * that many records, overwritten oldest-first.  Timestamps are raw
+ * ulmk_arch_cycle_read() values of the recording CPU.
+ */
+
+#ifndef ULMK_TRACE_H
+#define ULMK_TRACE_H
+
+#include <stdint.h>
+
+/* Event ids (ev) and their arguments. */
+#define ULMK_TRACE_SWITCH	 1u	/* a = prev tid (0 = none), b = next tid */
+#define ULMK_TRACE_ENQUEUE	 2u	/* a = tid, b = priority */
+#define ULMK_TRACE_DEQUEUE	 3u	/* a = tid, b = priority */
+#define ULMK_TRACE_IPC_CALL	 4u	/* a = ep, b = server tid woken (0 = queued) */
+#define ULMK_TRACE_IPC_RECV	 5u	/* a = ep, b = caller tid taken (0 = blocks) */
+#define ULMK_TRACE_IPC_REPLY	 6u	/* a = caller tid */
+#define ULMK_TRACE_NOTIF_SIGNAL	 7u	/* a = notif, b = bits */
+#define ULMK_TRACE_NOTIF_WAKE	 8u	/* a = tid, b = bits delivered */
+#define ULMK_TRACE_IRQ_ENTER	 9u	/* a = srpn */
+#define ULMK_TRACE_IRQ_EXIT	10u	/* a = srpn */
+#define ULMK_TRACE_TIMER_EXPIRE	11u	/* a = timeout object, b = callback */
+#define ULMK_TRACE_NR_EVENTS	12u
+
+/* Runtime mask bits for ulmk_trace_mask(). */
+#define ULMK_TRACE_BIT(ev)	(1u << (ev))
+#define ULMK_TRACE_ALL		(((1u << ULMK_TRACE_NR_EVENTS) - 1u) & ~1u)
+
+typedef struct {
+	uint32_t seq;	/* per-CPU record number, gaps = records lost */
+	uint32_t ts;	/* cycle counter of @cpu */
+	uint16_t ev;	/* ULMK_TRACE_* */
+	uint8_t  cpu;
+	uint8_t  rsvd;
+	uint32_t a;
+	uint32_t b;
+} ulmk_trace_rec_t;
+
+#endif /* ULMK_TRACE_H */
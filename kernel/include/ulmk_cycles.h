@@ -0,0 +1,23 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Cycle counter users — kernel/include/ulmk_cycles.h
+ *
+ * ulmk_arch_cycle_read() is a stub returning 0 unless some option below
+ * timestamps with it; the arch layer and kernel_main.c test UL_CYCLE_COUNTER
+ * to compile in the real counter and enable it on every CPU.
+ */
+
+#ifndef UL_CYCLES_H
+#define UL_CYCLES_H
+
+#include <ulmk/config.h>
+
+#define UL_CYCLE_COUNTER	(ULMK_CONFIG_SYSCALL_WCET || \
+				 ULMK_CONFIG_TRACE_ENTRIES > 0 || \
+				 ULMK_CONFIG_THREAD_STATS || \
+				 ULMK_CONFIG_SCHED_LATENCY || \
+				 ULMK_CONFIG_IRQOFF_STATS || \
+				 ULMK_CONFIG_SPINLOCK_STATS || \
+				 ULMK_CONFIG_USER_CYCLES)
+
+#endif /* UL_CYCLES_H */
@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Copyright (c) 2024-2026 Felipe Neves
+ *
+ * Internal protection domain management.
+ *
+ * A domain owns one MPU region table shared by every thread spawned into it.
+ * Member threads hand the domain table to ulmk_arch_mpu_switch(), so the
+ * per-CPU identity check in each port sees the same (regions, count, prs)
+ * triple across sibling switches and writes no protection register.  Maps,
+ * unmaps and grants made by or to a member land in the domain table once.
+ */
+
+#ifndef UL_DOMAIN_INTERNAL_H
+#define UL_DOMAIN_INTERNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ulmk/microkernel.h>
+#include <kernel/include/ulmk_thread_internal.h>
+
+typedef struct ulmk_domain_obj {
+	ulmk_domain_t      id;
+	bool               active;	/* false after destroy; freed at refs == 0 */
+	uint16_t           refs;	/* member threads still alive */
+	uint8_t            region_count;
+	/*
+	 * Set for every other CPU when an entry is removed: a later insert can
+	 * restore the old count and fool the ports' (regions, count, prs)
+	 * identity check, so the next dispatch there must reprogram.
+	 */
+	volatile uint8_t   stale[ULMK_ARCH_NUM_CPU];
+	ulmk_arch_region_t regions[ULMK_ARCH_MAX_REGIONS];
+} ulmk_domain_obj_t;
+
+void               ulmk_domain_obj_init(ulmk_domain_obj_t *d, ulmk_domain_t id);
+ulmk_domain_obj_t *ulmk_domain_by_id(ulmk_domain_t id);
+int                ulmk_domain_attach(ulmk_thread_t *th, ulmk_domain_t id);
+void               ulmk_domain_detach(ulmk_thread_t *th);
+
+/*
+ * MPU view of @th: its domain's table when it belongs to one, else its own.
+ * Every ulmk_arch_mpu_switch() caller goes through these.
+ */
+static inline const ulmk_arch_region_t *
+ulmk_thread_mpu_regions(const ulmk_thread_t *th)
+{
+	return th->domain ? th->domain->regions : th->regions;
+}
+
+static inline uint8_t ulmk_thread_mpu_count(const ulmk_thread_t *th)
+{
+	return th->domain ? th->domain->region_count : th->region_count;
+}
+
+/* Program the MPU for @th at @prs through its view (see above). */
+static inline void ulmk_thread_mpu_switch(ulmk_thread_t *th, uint8_t prs)
+{
+	struct ulmk_domain_obj *d   = th->domain;
+	uint32_t                cpu = ulmk_arch_cpu_id();
+
+	if (d && d->stale[cpu]) {
+		d->stale[cpu] = 0u;
+		ulmk_arch_mpu_switch(NULL, 0u, 0u);	/* drop the cached identity */
+	}
+#if UL_MPU_LAZY
+	if (th->lazy_stale[cpu]) {
+		th->lazy_stale[cpu] = 0u;
+		ulmk_arch_mpu_switch(NULL, 0u, 0u);
+	}
+#endif
+#if ULMK_CONFIG_ENABLE_SMP
+	if (th->mpu_stale) {
+		th->mpu_stale = 0u;
+		ulmk_arch_mpu_switch(NULL, 0u, 0u);
+	}
+#endif
+	ulmk_arch_mpu_switch(ulmk_thread_mpu_regions(th),
+			     ulmk_thread_mpu_count(th), prs);
+}
+
+#endif /* UL_DOMAIN_INTERNAL_H */
@@ -13,11 +13,14 @@
 #include <kernel/include/list.h>
 #include <kernel/include/ulmk_thread_internal.h>
 
+struct ulmk_waitset_src;
+
 typedef struct ulmk_endpoint {
 	ulmk_ep_t      id;
 	bool         active;
 	sys_dlist_t  send_queue;	/* callers blocked (BLOCKED_IPC_CALL) */
 	sys_dlist_t  recv_queue;	/* servers blocked (BLOCKED_IPC_RECV) */
+	struct ulmk_waitset_src *ws_src;	/* wait set slot, NULL if none */
 } ulmk_endpoint_t;
 
 int           ulmk_ep_init(ulmk_endpoint_t *ep, ulmk_ep_t id);
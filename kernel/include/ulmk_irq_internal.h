@@ -2,7 +2,7 @@
 /*
  * Copyright (c) 2024-2026 Felipe Neves
  *
- * Internal IRQ binding table management.
+ * Internal IRQ binding management.
  */
 
 #ifndef UL_IRQ_INTERNAL_H
@@ -13,8 +13,9 @@
 #include <ulmk/microkernel.h>
 #include <kernel/include/ulmk_notif_internal.h>
 #include <kernel/include/ulmk_thread_internal.h>
+#include <kernel/include/ulmk_timer.h>
 
-typedef struct {
+typedef struct ulmk_irq_binding {
 	uint8_t			srpn;
 	ulmk_notif_obj_t	*notif;
 	uint32_t		bit;
@@ -24,10 +25,58 @@ typedef struct {
 	void			*attach_data;
 	ulmk_thread_t		*owner;
 	bool			owned_notif;	/* notif created by attach */
+	/* Threaded handler (ulmk_irq_thread_bind); NULL otherwise. */
+	ulmk_thread_t		*thread;
+	volatile uint32_t	thread_state;	/* UL_IRQ_THREAD_* */
+	uint8_t			thread_prio;	/* priority the handler runs at */
+	/* Coalescing (ulmk_irq_coalesce); coal_max < 2 = one signal per IRQ. */
+	uint32_t		coal_max;	/* events per batch */
+	uint32_t		coal_ticks;	/* batch deadline from first event */
+	volatile uint32_t	coal_count;	/* events in the open batch */
+	struct ulmk_timeout	coal_to;	/* flushes a partial batch */
+	volatile uint8_t	coal_busy;	/* coal_to callback past its check */
+	bool			coal_level;	/* level source: mask, don't count */
+	volatile uint8_t	coal_masked;	/* UL_IRQ_COAL_* */
+	/* Affinity (ulmk_irq_affinity). */
+	uint8_t			cpu;		/* CPU the source is routed to */
+	bool			cpu_auto;	/* follow the driver's CPU */
+	struct ulmk_irq_binding	*next_free;	/* irq.c free list while unbound */
 } ulmk_irq_binding_t;
 
+/*
+ * IRQ thread handshake, advanced with ulmk_arch_atomic_cas() so the ISR
+ * takes no lock:
+ *   BUSY    — handler running (or not armed yet); source masked.
+ *   WAITING — handler blocked in ulmk_irq_thread_wait(); source unmasked.
+ *   PENDING — an interrupt fired while BUSY; the next wait returns at once.
+ */
+#define UL_IRQ_THREAD_BUSY	0u
+#define UL_IRQ_THREAD_WAITING	1u
+#define UL_IRQ_THREAD_PENDING	2u
+
+/*
+ * Level source being coalesced (coal_level):
+ *   OPEN  — source unmasked.
+ *   BATCH — masked by the first event of the open batch.
+ *   ACK   — batch delivered; the driver's ulmk_irq_ack() unmasks it.
+ */
+#define UL_IRQ_COAL_OPEN	0u
+#define UL_IRQ_COAL_BATCH	1u
+#define UL_IRQ_COAL_ACK		2u
+
 void ulmk_irq_table_init(void);
+/*
+ * Bind @srpn and publish it.  Returns ULMK_OK, ULMK_EINVAL if @srpn is
+ * already bound or ULMK_ENOSPC if ULMK_CONFIG_MAX_IRQ_BINDINGS are live or
+ * the kernel heap is exhausted.
+ */
 int  ulmk_irq_binding_add(uint8_t srpn, ulmk_notif_obj_t *notif, uint32_t bit);
+/*
+ * Drop every IRQ thread binding held by @th (kill / exit).  The sources are
+ * masked first, so no ISR readies @th afterwards.
+ */
+void ulmk_irq_thread_release(ulmk_thread_t *th);
+/* O(1) SRPN lookup; lock-free, safe from the ISR path. */
 ulmk_irq_binding_t *ulmk_irq_binding_by_srpn(uint8_t srpn);
 
 /*
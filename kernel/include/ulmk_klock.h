@@ -4,17 +4,56 @@
  *
  * Lock order (never invert): thread → ipc (ep/notif) → rq → irq → timer → mem
  * RQ lock is internal to bitmap_rt (enqueue/dequeue/pick/peek).
+ *
+ * Kernel code takes these through ulmk_klock_irqsave/irqrestore.  With
+ * ULMK_CONFIG_IRQOFF_STATS=1 they time lock wait/hold and the IRQ-masked
+ * windows they open (ulmk_irqoff_stats()); otherwise they are the arch calls.
+ * The arch locks are FIFO ticket locks on SMP builds; with
+ * ULMK_CONFIG_SPINLOCK_STATS=1 they also count their own contention
+ * (ulmk_spinlock_stats()).
  */
 
 #ifndef UL_KLOCK_H
 #define UL_KLOCK_H
 
+#include <stdint.h>
+#include <ulmk/config.h>
 #include <ulmk_arch.h>
 
 extern ulmk_spinlock_t g_ulmk_lock_thread;
 extern ulmk_spinlock_t g_ulmk_lock_ipc;	/* ep + notif (shared for recv_or_notif) */
+extern ulmk_spinlock_t g_ulmk_lock_rq;	/* defined in bitmap_rt.c */
 extern ulmk_spinlock_t g_ulmk_lock_irq;
 extern ulmk_spinlock_t g_ulmk_lock_timer;
 extern ulmk_spinlock_t g_ulmk_lock_mem;
 
+#if ULMK_CONFIG_IRQOFF_STATS
+
+ulmk_arch_irq_key_t ulmk_klock_irqsave(ulmk_spinlock_t *lock);
+void                ulmk_klock_irqrestore(ulmk_spinlock_t *lock,
+					  ulmk_arch_irq_key_t key);
+
+/*
+ * Kernel gateways (syscall, IRQ, tick, IPI) run with IRQs masked from entry
+ * to the final reschedule: open at entry with a ULMK_IRQOFF_SITE_* tag,
+ * close at the context switch or, without one, at the end of
+ * ulmk_kern_sched_dispatch().
+ */
+void ulmk_irqoff_open(uint32_t site);
+void ulmk_irqoff_close(void);
+
+#else
+
+#define ulmk_klock_irqsave(lock)	ulmk_arch_spin_lock_irqsave(lock)
+#define ulmk_klock_irqrestore(lock, key) \
+	ulmk_arch_spin_unlock_irqrestore((lock), (key))
+
+static inline void ulmk_irqoff_open(uint32_t site) { (void)site; }
+static inline void ulmk_irqoff_close(void) {}
+
+#endif
+
+uint32_t ulmk_kern_irqoff_stats(uint32_t cpu, uint32_t out_ptr);
+uint32_t ulmk_kern_spinlock_stats(uint32_t id, uint32_t out_ptr);
+
 #endif /* UL_KLOCK_H */
@@ -38,7 +38,22 @@
 void   ulmk_heap_init(uintptr_t base, size_t size);
 void  *ulmk_heap_alloc(size_t size);
 void   ulmk_heap_free(void *ptr);
+size_t ulmk_heap_grow(void *ptr, size_t size);
 void  *ulmk_heap_aligned_alloc(size_t align, size_t size);
 size_t ulmk_heap_free_bytes(void);
 
+/* =========================================================================
+ * Kernel-owned memory published to a thread — backed by kernel/mem/mem.c
+ *
+ * ulmk_mem_publish maps [@base, @base + @size) read-only into @th as a
+ * ULMK_REGION_SHARED entry: the kernel object that owns the memory frees
+ * it, never the thread.  Returns ULMK_OK or ULMK_ENOSPC.  ulmk_mem_unpublish
+ * waits until no other CPU still runs @th on a view that maps @base.
+ * ========================================================================= */
+
+struct ulmk_thread;
+
+int    ulmk_mem_publish(struct ulmk_thread *th, uintptr_t base, size_t size);
+void   ulmk_mem_unpublish(struct ulmk_thread *th, uintptr_t base);
+
 #endif /* UL_MEM_INTERNAL_H */
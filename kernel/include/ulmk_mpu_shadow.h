@@ -0,0 +1,122 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Copyright (c) 2024-2026 Felipe Neves
+ *
+ * MPU region compaction — kernel/include/ulmk_mpu_shadow.h
+ *
+ * Shared by the arch MPU/PMP backends; include after <ulmk_arch.h>
+ * (ulmk_arch_region_t and ULMK_REGION_* are arch-defined).
+ *
+ * Every port keeps a per-CPU shadow of the protection registers it last
+ * wrote and rewrites only the slots whose encoded value changed.  Before
+ * encoding, ulmk_mpu_compact() drops STACK entries (covered by the static
+ * URAM window) and merges physically adjacent regions with identical
+ * permissions and memory type, so a thread that maps neighbouring buffers
+ * uses one slot instead of several.
+ */
+
+#ifndef UL_MPU_SHADOW_H
+#define UL_MPU_SHADOW_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Merge policy for ulmk_mpu_compact() */
+#define ULMK_MPU_MERGE_ANY	0u	/* base/limit hardware (PMSAv8, TriCore DPR) */
+#define ULMK_MPU_MERGE_POW2	1u	/* NAPOT / PMSAv7: union must be 2^n aligned */
+
+static inline bool ulmk_mpu_region_is_pow2(uintptr_t base, size_t size)
+{
+	return size != 0u && (size & (size - 1u)) == 0u &&
+	       (base & (uintptr_t)(size - 1u)) == 0u;
+}
+
+/*
+ * Merge @b into @a when the two are physically adjacent and compatible.
+ * With ULMK_MPU_MERGE_POW2 the union must itself be a naturally aligned power
+ * of two — the hardware would otherwise round it up and widen coverage past
+ * what the two regions programmed separately would grant.
+ */
+static inline bool ulmk_mpu_region_merge(ulmk_arch_region_t *a,
+					 const ulmk_arch_region_t *b,
+					 unsigned int mode)
+{
+	uintptr_t lo;
+	size_t    size;
+
+	if (a->perms != b->perms)
+		return false;
+	if ((a->type == ULMK_REGION_PERIPH) != (b->type == ULMK_REGION_PERIPH))
+		return false;
+
+	if (a->base + a->size == b->base)
+		lo = a->base;
+	else if (b->base + b->size == a->base)
+		lo = b->base;
+	else
+		return false;
+
+	size = a->size + b->size;
+	if (mode == ULMK_MPU_MERGE_POW2 && !ulmk_mpu_region_is_pow2(lo, size))
+		return false;
+
+	a->base = lo;
+	a->size = size;
+	return true;
+}
+
+/*
+ * Compact the dynamic part of a thread's region table into @out (at most
+ * @max entries).  STACK and zero-sized regions are skipped; regions that do
+ * not fit are dropped in table order, as the ports did before compaction.
+ * @out may alias @regions.  *@merged (optional) accumulates the number of
+ * slots saved by merging.  Returns the number of entries written.
+ */
+static inline uint8_t ulmk_mpu_compact(const ulmk_arch_region_t *regions,
+				       uint8_t count, ulmk_arch_region_t *out,
+				       uint8_t max, unsigned int mode,
+				       uint32_t *merged)
+{
+	ulmk_arch_region_t r;
+	uint8_t n = 0u;
+	uint8_t i;
+	uint8_t j;
+	uint8_t k;
+
+	if (!regions)
+		count = 0u;
+
+	for (i = 0u; i < count; i++) {
+		r = regions[i];
+		if (r.type == ULMK_REGION_STACK || r.size == 0u)
+			continue;
+
+		for (j = 0u; j < n; j++) {
+			if (ulmk_mpu_region_merge(&out[j], &r, mode))
+				break;
+		}
+		if (j == n) {
+			if (n < max)
+				out[n++] = r;
+			continue;
+		}
+		if (merged)
+			(*merged)++;
+
+		/* The grown entry may now bridge to another one — fold it in. */
+		for (k = 0u; k < n; k++) {
+			if (k == j || !ulmk_mpu_region_merge(&out[j], &out[k], mode))
+				continue;
+			if (merged)
+				(*merged)++;
+			out[k] = out[--n];
+			if (j == n)
+				j = k;
+			k = (uint8_t)-1;	/* rescan from the start */
+		}
+	}
+	return n;
+}
+
+#endif /* UL_MPU_SHADOW_H */
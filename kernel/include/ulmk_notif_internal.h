@@ -12,22 +12,57 @@
 #include <stdbool.h>
 #include <ulmk/microkernel.h>
 #include <kernel/include/ulmk_thread_internal.h>
+#include <kernel/include/list.h>
+
+/*
+ * waiters holds every thread blocked in ulmk_notif_wait*() or
+ * ulmk_ep_recv_or_notif() on this object, FIFO, linked through notif_node.
+ * Each waiter's interest set is its own notif_wait_mask.  Direct waiters
+ * are served first; bits they leave pending can then make the object's
+ * wait set source (ws_src) ready.
+ *
+ * A shared notification (ulmk_notif_create_shared) also mirrors bits into
+ * @word, a kernel-owned granule mapped read-only into @word_owner, so the
+ * owner can test pending bits with a plain load.  The kernel stays the only
+ * writer: every change to @bits is followed by ulmk_notif_publish().
+ */
+struct ulmk_waitset_src;
 
 typedef struct ulmk_notif_obj {
 	ulmk_notif_t   id;
 	bool         active;
 	uint32_t     bits;
-	ulmk_thread_t *waiter;		/* thread blocked in ulmk_notif_wait() */
-	uint32_t     wait_mask;
+	sys_dlist_t  waiters;
+	struct ulmk_waitset_src *ws_src;	/* wait set slot, NULL if none */
+	volatile uint32_t *word;		/* user-visible mirror, or NULL */
+	ulmk_tid_t   word_owner;		/* thread @word is mapped into */
 } ulmk_notif_obj_t;
 
 int             ulmk_notif_obj_init(ulmk_notif_obj_t *n, ulmk_notif_t id);
 ulmk_notif_obj_t *ulmk_notif_by_id(ulmk_notif_t id);
 
+/* Copy @n's pending bits to its user-visible word, if it has one. */
+static inline void ulmk_notif_publish(ulmk_notif_obj_t *n)
+{
+	if (n->word)
+		*n->word = n->bits;
+}
+
+/* Drop @th from its notification wait queue; no-op when not queued. */
+static inline void ulmk_notif_waiter_remove(ulmk_thread_t *th)
+{
+	if (sys_dnode_is_linked(&th->notif_node)) {
+		sys_dlist_remove(&th->notif_node);
+		sys_dnode_init(&th->notif_node);
+	}
+}
+
 /*
  * Core logic with native pointer types — used directly by unit tests.
  */
+uint32_t notif_create_shared_impl(const volatile uint32_t **out);
 int      notif_signal_impl(ulmk_notif_t id, uint32_t bits);
+int      notif_broadcast_impl(ulmk_notif_t id, uint32_t bits);
 int      notif_wait_impl(ulmk_notif_t id, uint32_t mask, uint32_t *out);
 int      notif_wait_timeout_impl(ulmk_notif_t id, uint32_t mask, uint32_t *out,
 				uint32_t timeout_ms);
@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <ulmk/config.h>
+#include <ulmk/microkernel.h>
 #include <ulmk_arch.h>
 
 #if ULMK_CONFIG_ENABLE_SMP
@@ -42,6 +43,13 @@ struct ulmk_percpu {
 	bool                in_irq_attach;
 	struct ulmk_thread *irq_attach_owner;
 	uint8_t             irq_attach_srpn;
+	/* MPU faults resolved by a lazy region load (ulmk_mpu_stats_t.faults). */
+	uint32_t            mpu_faults;
+	ulmk_irq_stats_t    irq_stats;	/* ulmk_irq_stats() */
+#if ULMK_CONFIG_THREAD_STATS
+	/* Cycle count up to which current's run time has been charged. */
+	uint32_t            acct_stamp;
+#endif
 #if ULMK_CONFIG_ENABLE_SMP
 	/* Bitmask of remote CPUs that need a resched IPI (see sched). */
 	uint32_t            ipi_pending;
@@ -14,6 +14,11 @@
  *
  * Output is routed through ulmk_printk_char_out(char c), a weak symbol
  * that boards override (e.g. boards/qemu_tc3xx/qemu_console.c).
+ *
+ * With ULMK_CONFIG_PRINTK_BUF_SIZE > 0 ulmk_printk() only formats into a
+ * per-CPU ring; ulmk_printk_flush() sends the calling CPU's ring to the
+ * console.  The idle thread flushes, as do the trap paths before they
+ * stop or kill.  Otherwise ulmk_printk_flush() is a no-op.
  */
 
 /*
@@ -43,11 +48,18 @@ void _ulmk_printk(const char *fmt, ...);
 #define UL_LOG_DBG(fmt, ...) _ulmk_printk("[DBG] " fmt "\n", ##__VA_ARGS__)
 #define UL_LOG_ERR(fmt, ...) _ulmk_printk("[ERR] " fmt "\n", ##__VA_ARGS__)
 
+#if ULMK_CONFIG_PRINTK_BUF_SIZE > 0
+void ulmk_printk_flush(void);
+#else
+#define ulmk_printk_flush()  ((void)0)
+#endif
+
 #else
 
 #define ulmk_printk(fmt, ...)  ((void)0)
 #define UL_LOG_DBG(fmt, ...) ((void)0)
 #define UL_LOG_ERR(fmt, ...) ((void)0)
+#define ulmk_printk_flush()  ((void)0)
 
 #endif /* ULMK_CONFIG_DEBUG_PRINTK */
 
@@ -21,12 +21,17 @@
  * pick_next() / peek_next() return the highest-priority ready thread.
  * The idle thread (lowest priority sentinel) is always in the run queue,
  * so these never return NULL after ulmk_sched_start().
+ *
+ * enqueue_list() is optional: insert every thread on @list (chained through
+ * sched_node) under one run-queue lock acquisition, leaving @list empty.
+ * Without it the core falls back to one enqueue() per thread.
  * ========================================================================= */
 
 typedef struct ulmk_sched_class {
 	const char	*name;
 	void		 (*init)(void);
 	void		 (*enqueue)(ulmk_thread_t *t);
+	void		 (*enqueue_list)(sys_dlist_t *list);
 	void		 (*dequeue)(ulmk_thread_t *t);
 	ulmk_thread_t	*(*pick_next)(void);
 	ulmk_thread_t	*(*peek_next)(void);
@@ -66,6 +71,19 @@ void		 ulmk_sched_request_resched(void);
 
 void		 ulmk_sched_enqueue(ulmk_thread_t *t);
 void		 ulmk_sched_dequeue(ulmk_thread_t *t);
+#if ULMK_CONFIG_THREAD_STATS
+/*
+ * Charge current's run time up to now (timer tick, stats reads) so a
+ * thread that is never switched out still gets every counter wrap.
+ */
+void		 ulmk_sched_acct_tick(void);
+#else
+static inline void ulmk_sched_acct_tick(void) { }
+#endif
+#if ULMK_CONFIG_SCHED_LATENCY
+/* Fold one wake-to-run sample of this CPU into its histogram (sched_lat.c). */
+void		 ulmk_sched_lat_record(uint32_t prio, uint32_t cycles);
+#endif
 #if ULMK_CONFIG_ENABLE_SMP
 /* Send deferred remote IPIs (call after releasing IPC locks). */
 void		 ulmk_sched_kick_pending(void);
@@ -78,6 +96,13 @@ static inline void ulmk_sched_kick_pending(void) { }
  */
 void		 ulmk_sched_enqueue_locked(ulmk_thread_t *t);
 void		 ulmk_sched_dequeue_locked(ulmk_thread_t *t);
+/*
+ * Batched wake: make every thread on @list READY with a single run-queue
+ * lock round trip.  @list chains blocked threads through their (idle)
+ * sched_node and is empty on return.  Same locking rules as
+ * ulmk_sched_enqueue_locked(); remote IPIs still go via kick_pending.
+ */
+void		 ulmk_sched_enqueue_list(sys_dlist_t *list);
 ulmk_thread_t	*ulmk_sched_current(void);
 ulmk_thread_t	*ulmk_sched_peek_next(void);
 
@@ -12,8 +12,11 @@
 struct ulmk_thread;
 
 uint32_t ulmk_kern_wcet_bind(uint32_t slot_ptr);
+uint32_t ulmk_kern_wcet_stats(uint32_t cpu, uint32_t nr, uint32_t out_ptr);
 
 #if ULMK_CONFIG_SYSCALL_WCET
+/* Fold one sample of syscall @nr into this CPU's histogram (trap path). */
+void ulmk_syscall_wcet_record(uint32_t nr, uint32_t cycles);
 void ulmk_syscall_wcet_account_reset(void);
 uint32_t ulmk_syscall_wcet_blocked_cycles(void);
 void ulmk_syscall_wcet_block_begin_th(struct ulmk_thread *th);
@@ -18,6 +18,9 @@
 #include <kernel/include/ulmk_timer.h>
 
 struct ulmk_syscall_wcet_slot;
+struct ulmk_domain_obj;
+struct ulmk_waitset_obj;
+struct ulmk_waitset_event;
 
 #define UL_THREAD_STATE_DEAD      0
 #define UL_THREAD_STATE_READY     1
@@ -32,6 +35,26 @@ struct ulmk_syscall_wcet_slot;
 #define UL_BLOCKED_NOTIF         4  /* waiting for notification bits */
 #define UL_BLOCKED_IPC_OR_NOTIF  5  /* ulmk_ep_recv_or_notif — either */
 #define UL_BLOCKED_SLEEP         6
+#define UL_BLOCKED_WAITSET       7  /* ulmk_wait_any — any source in a set */
+#define UL_BLOCKED_IRQ           8  /* ulmk_irq_thread_wait — next interrupt */
+
+/*
+ * Lazy MPU mapping (ULMK_CONFIG_MPU_LAZY_SLOTS > 0): at most UL_MPU_LAZY_SLOTS
+ * dynamic regions stay resident in regions[]; further maps wait in a spill
+ * table until an MPU fault loads them (kernel/mem/mem.c).  Off on ports that
+ * cannot report the faulting address.
+ */
+#if ULMK_CONFIG_MPU_LAZY_SLOTS > 0 && ULMK_ARCH_HAVE_MPU_FAULT_ADDR && \
+	ULMK_ARCH_MPU_DYN_SLOTS > 0
+#define UL_MPU_LAZY	1
+#if ULMK_CONFIG_MPU_LAZY_SLOTS < ULMK_ARCH_MPU_DYN_SLOTS
+#define UL_MPU_LAZY_SLOTS	ULMK_CONFIG_MPU_LAZY_SLOTS
+#else
+#define UL_MPU_LAZY_SLOTS	ULMK_ARCH_MPU_DYN_SLOTS
+#endif
+#else
+#define UL_MPU_LAZY	0
+#endif
 
 typedef struct ulmk_thread {
 	ulmk_arch_ctx_t    ctx;
@@ -61,12 +84,18 @@ typedef struct ulmk_thread {
 	void           (*start_entry)(void *arg);
 	void            *start_arg;
 	uint8_t          ctx_ready;
+	/*
+	 * Set when another CPU drops an entry from regions[] while this one
+	 * may be running on its affinity CPU; cleared by the next reload.
+	 */
+	volatile uint8_t mpu_stale;
 #endif
 	ulmk_tid_t         tid;	/* opaque handle: (uintptr_t)this */
 	ulmk_ep_t          blocked_ep;      /* ep blocked on; for cleanup on kill */
 	ulmk_notif_t       blocked_notif;   /* notif blocked on; recv_or_notif */
 	sys_dnode_t        sched_node;      /* run-queue linkage */
 	sys_dnode_t        ipc_node;        /* IPC send or recv queue linkage */
+	sys_dnode_t        notif_node;      /* notification wait-queue linkage */
 	sys_dnode_t        reg_node;        /* global TCB registry linkage */
 	struct ulmk_timeout timeout;
 	/*
@@ -87,6 +116,11 @@ typedef struct ulmk_thread {
 	ulmk_recv_or_notif_result_t *rn_result_outptr;
 	uint32_t          notif_wait_mask;
 	uint32_t          notif_received; /* bits consumed on notif wakeup */
+	struct ulmk_waitset_obj   *blocked_ws;      /* set blocked on (wait_any) */
+	struct ulmk_waitset_event *ws_event_outptr; /* filled before wake */
+	uint8_t           irq_bound;      /* IRQ thread bindings held */
+	uint8_t           irq_boosted;    /* running at an IRQ thread priority */
+	uint8_t           irq_saved_prio; /* own priority while irq_boosted */
 	/*
 	 * Status returned by a blocking syscall after wakeup.
 	 * 0 = normal completion; ULMK_EINVAL = object destroyed under us.
@@ -102,6 +136,27 @@ typedef struct ulmk_thread {
 	/* MPU regions owned by this thread (configured by mpu_switch on dispatch) */
 	ulmk_arch_region_t  regions[ULMK_ARCH_MAX_REGIONS];
 	uint8_t           region_count;
+	/*
+	 * Shared protection domain (NULL = none).  When set, the domain's table
+	 * replaces regions[] as the thread's MPU view; regions[0] still tracks
+	 * the slab for heap bookkeeping.
+	 */
+	struct ulmk_domain_obj *domain;
+#if UL_MPU_LAZY
+	/*
+	 * Spill table (kernel heap, grown by doubling) for dynamic regions past
+	 * UL_MPU_LAZY_SLOTS.  lazy_stamp[i] is the tick regions[i] was loaded
+	 * at — the MPU keeps no reference bits, so eviction is by load age.
+	 * lazy_stale[] is set for every CPU when a fault swaps entries in place:
+	 * the count is unchanged, so the ports' identity check would miss it.
+	 */
+	ulmk_arch_region_t *lazy_regions;
+	uint16_t          lazy_count;
+	uint16_t          lazy_cap;
+	uint32_t          lazy_clock;
+	uint32_t          lazy_stamp[ULMK_ARCH_MAX_REGIONS];
+	volatile uint8_t  lazy_stale[ULMK_ARCH_NUM_CPU];
+#endif
 	/*
 	 * Capability bitmask — which privileged operations this thread may invoke.
 	 */
@@ -118,13 +173,66 @@ typedef struct ulmk_thread {
 	 * also publishes there so same-CPU peers cannot overwrite samples.
 	 */
 	volatile struct ulmk_syscall_wcet_slot *wcet_out;
+#if ULMK_CONFIG_THREAD_STATS
+	/*
+	 * ulmk_thread_stats() counters, charged by sched.c at switch and tick.
+	 * acct_ready_at is the cycle count of this thread's CPU when it last
+	 * became READY there (valid while acct_ready_ok); acct_yield marks a
+	 * READY switch-out as voluntary.
+	 */
+	ulmk_thread_stats_t stats;
+	uint32_t          acct_ready_at;
+	uint8_t           acct_ready_ok;
+	uint8_t           acct_yield;
+#endif
+#if ULMK_CONFIG_SCHED_LATENCY
+	/* Cycle count of this thread's CPU at wake-up; valid while lat_armed. */
+	uint32_t          lat_wake_at;
+	uint8_t           lat_armed;
+#endif
+#if ULMK_CONFIG_STACK_WATERMARK
+	/*
+	 * ulmk_thread_stack_stats() state (stack_wm.c): most saved-context
+	 * pool frames seen at switch-in, and the latched guard-word hit.
+	 */
+	uint32_t          stack_ctx_max;
+	uint8_t           stack_overflow;
+#endif
 } ulmk_thread_t;
 
+#if ULMK_CONFIG_THREAD_STATS
+#define UL_THREAD_STAT_INC(t, field)	((t)->stats.field++)
+#else
+#define UL_THREAD_STAT_INC(t, field)	((void)(t))
+#endif
+
 int          ulmk_thread_init(ulmk_thread_t *th, const ulmk_thread_attr_t *attr,
 			    void *stack);
 ulmk_thread_t *ulmk_thread_by_tid(ulmk_tid_t tid);
 void         ulmk_thread_set_state(ulmk_thread_t *th, uint8_t state);
 void         ulmk_thread_free(ulmk_thread_t *th);
+#if ULMK_CONFIG_STACK_WATERMARK
+/*
+ * Stack watermarks (stack_wm.c): paint @th's stack at init, check prev's
+ * guard word and sample next's context-pool depth at every switch, print
+ * the high-water marks when @th is freed.
+ */
+void         ulmk_thread_stack_paint(ulmk_thread_t *th);
+void         ulmk_thread_stack_switch(ulmk_thread_t *prev, ulmk_thread_t *next);
+void         ulmk_thread_stack_report(const ulmk_thread_t *th);
+#else
+static inline void ulmk_thread_stack_paint(ulmk_thread_t *th) { (void)th; }
+static inline void ulmk_thread_stack_switch(ulmk_thread_t *prev,
+					    ulmk_thread_t *next)
+{
+	(void)prev;
+	(void)next;
+}
+static inline void ulmk_thread_stack_report(const ulmk_thread_t *th)
+{
+	(void)th;
+}
+#endif
 #if ULMK_CONFIG_ENABLE_SMP
 void         ulmk_thread_ensure_ctx(ulmk_thread_t *th);
 #else
@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Kernel event trace hooks — see include/ulmk/trace.h for the record format.
+ *
+ * UL_TRACE() costs nothing when ULMK_CONFIG_TRACE_ENTRIES is 0: the macro
+ * drops its arguments unevaluated.  When built in, a disabled event costs
+ * one load and test of the runtime mask.
+ */
+
+#ifndef UL_TRACE_H
+#define UL_TRACE_H
+
+#include <stdint.h>
+#include <ulmk/config.h>
+
+#if ULMK_CONFIG_TRACE_ENTRIES > 0
+
+#include <ulmk/trace.h>
+
+extern volatile uint32_t g_ulmk_trace_mask;
+
+void ulmk_trace_init(void);
+void ulmk_trace_emit(uint32_t ev, uint32_t a, uint32_t b);
+
+#define UL_TRACE(ev, a, b)						\
+	do {								\
+		if (g_ulmk_trace_mask & ULMK_TRACE_BIT(ev))		\
+			ulmk_trace_emit((ev), (uint32_t)(a),		\
+					(uint32_t)(b));			\
+	} while (0)
+
+#else
+
+static inline void ulmk_trace_init(void) {}
+
+#define UL_TRACE(ev, a, b)	do { } while (0)
+
+#endif
+
+uint32_t ulmk_kern_trace_mask(uint32_t mask);
+uint32_t ulmk_kern_trace_read(uint32_t cpu, uint32_t pos_ptr,
+			      uint32_t buf_ptr, uint32_t max);
+
+#endif /* UL_TRACE_H */
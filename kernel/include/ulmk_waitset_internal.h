@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Copyright (c) 2024-2026 Felipe Neves
+ *
+ * Internal wait set management.
+ *
+ * A wait set multiplexes endpoints and notifications for one server thread.
+ * Each registered object points back at its source slot, so a signal or a
+ * queued caller marks the source ready in O(1) by appending it to the set's
+ * ready list.  Readiness is re-checked when ulmk_wait_any() pops the list,
+ * so stale entries (bits polled elsewhere, caller timed out) are dropped
+ * there instead of being tracked on every state change.
+ *
+ * All fields are protected by g_ulmk_lock_ipc.
+ */
+
+#ifndef UL_WAITSET_INTERNAL_H
+#define UL_WAITSET_INTERNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ulmk/microkernel.h>
+#include <kernel/include/list.h>
+#include <kernel/include/ulmk_thread_internal.h>
+
+#ifdef UL_UNIT_TEST
+#define UL_TEST_MAX_WAITSETS	4u	/* host pool; slot 0 is never handed out */
+#endif
+
+struct ulmk_waitset_obj;
+
+typedef struct ulmk_waitset_src {
+	struct ulmk_waitset_obj *ws;
+	uint32_t     kind;		/* ULMK_WAITSET_EP / _NOTIF; 0 = free */
+	uintptr_t    handle;
+	uint32_t     mask;		/* NOTIF bits of interest */
+	sys_dnode_t  ready_node;	/* linked while on ws->ready */
+} ulmk_waitset_src_t;
+
+typedef struct ulmk_waitset_obj {
+	ulmk_waitset_t     id;
+	bool               active;
+	ulmk_thread_t     *waiter;	/* thread blocked in ulmk_wait_any() */
+	sys_dlist_t        ready;	/* sources that may be ready, FIFO */
+	ulmk_waitset_src_t src[ULMK_WAITSET_MAX_SOURCES];
+} ulmk_waitset_obj_t;
+
+int                 ulmk_waitset_obj_init(ulmk_waitset_obj_t *ws,
+					  ulmk_waitset_t id);
+ulmk_waitset_obj_t *ulmk_waitset_by_id(ulmk_waitset_t id);
+
+/*
+ * Source hooks, called with g_ulmk_lock_ipc held.
+ *
+ * ulmk_waitset_source_ready — queue @src on its set's ready list.  If the
+ *   set's waiter is blocked and a ready source is found, hand it the event
+ *   and return it (READY, not yet on the run queue) for the caller to
+ *   enqueue under its own locking rules; NULL otherwise.
+ * ulmk_waitset_source_detach — the object behind @src is being destroyed.
+ */
+ulmk_thread_t *ulmk_waitset_source_ready(ulmk_waitset_src_t *src);
+void           ulmk_waitset_source_detach(ulmk_waitset_src_t *src);
+
+/* Forget @th as the waiter of the set it is blocked on (kill path). */
+static inline void ulmk_waitset_waiter_remove(ulmk_thread_t *th)
+{
+	ulmk_waitset_obj_t *ws = th->blocked_ws;
+
+	if (ws && ws->waiter == th)
+		ws->waiter = NULL;
+	th->blocked_ws      = NULL;
+	th->ws_event_outptr = NULL;
+}
+
+/*
+ * Core logic with native pointer types — used directly by unit tests.
+ */
+int waitset_add_impl(ulmk_waitset_t ws, uint32_t kind, uintptr_t handle,
+		     uint32_t mask);
+int waitset_del_impl(ulmk_waitset_t ws, uint32_t kind, uintptr_t handle);
+int wait_any_impl(ulmk_waitset_t ws, ulmk_waitset_event_t *ev);
+int waitset_destroy_impl(ulmk_waitset_t ws);
+
+#endif /* UL_WAITSET_INTERNAL_H */
@@ -29,8 +29,10 @@
 #include <ulmk/microkernel.h>
 #include <kernel/include/ulmk_ep_internal.h>
 #include <kernel/include/ulmk_notif_internal.h>
+#include <kernel/include/ulmk_waitset_internal.h>
 #include <kernel/include/ulmk_sched.h>
 #include <kernel/include/ulmk_timeout_internal.h>
+#include <kernel/include/ulmk_trace.h>
 #include <kernel/syscall/syscall_router.h>
 #include <ulmk_arch.h>
 
@@ -49,6 +51,7 @@ int ulmk_ep_init(ulmk_endpoint_t *ep, ulmk_ep_t id)
 {
 	ep->id     = id;
 	ep->active = true;
+	ep->ws_src = NULL;
 	sys_dlist_init(&ep->send_queue);
 	sys_dlist_init(&ep->recv_queue);
 	return 0;
@@ -127,10 +130,7 @@ void clear_server_block(ulmk_thread_t *server)
 	server->blocked_ep     = ULMK_EP_INVALID;
 
 	if (server->blocked_notif != ULMK_NOTIF_INVALID) {
-		ulmk_notif_obj_t *n = ulmk_notif_by_id(server->blocked_notif);
-
-		if (n && n->waiter == server)
-			n->waiter = NULL;
+		ulmk_notif_waiter_remove(server);
 		server->blocked_notif = ULMK_NOTIF_INVALID;
 	}
 }
@@ -160,6 +160,7 @@ void prepare_server_delivery(ulmk_thread_t *server,
 	server->ipc_sender = caller->tid;
 	apply_prio_inherit(server, caller);
 	clear_server_block(server);
+	UL_THREAD_STAT_INC(server, ipc_recvs);
 
 	/*
 	 * Copy through the TCB as well as the userspace outptr so a
@@ -197,10 +198,7 @@ static void wake_blocked_on_destroy(ulmk_thread_t *th, int status)
 	}
 
 	if (th->blocked_notif != ULMK_NOTIF_INVALID) {
-		ulmk_notif_obj_t *n = ulmk_notif_by_id(th->blocked_notif);
-
-		if (n && n->waiter == th)
-			n->waiter = NULL;
+		ulmk_notif_waiter_remove(th);
 		th->blocked_notif = ULMK_NOTIF_INVALID;
 	}
 
@@ -220,7 +218,7 @@ static void ep_call_timeout_cb(struct ulmk_timeout *to)
 #endif
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 	if (!th || th->state != UL_THREAD_STATE_BLOCKED ||
 	    th->blocked_reason != UL_BLOCKED_IPC_CALL)
@@ -234,7 +232,7 @@ static void ep_call_timeout_cb(struct ulmk_timeout *to)
 
 out:
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 	ulmk_sched_kick_pending();
 #endif
 }
@@ -256,12 +254,12 @@ int ep_call_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg)
 		return -ULMK_EINVAL;
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 	ep = ulmk_ep_by_id(ep_id);
 	if (!ep) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -269,7 +267,7 @@ int ep_call_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg)
 	cur = ulmk_sched_current();
 	if (!cur) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -292,11 +290,16 @@ int ep_call_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg)
 		srv->state = UL_THREAD_STATE_READY;
 	} else {
 		ipc_enqueue_tail(&ep->send_queue, cur);
+		/* A wait set owner blocked in wait_any is woken like a server. */
+		if (ep->ws_src)
+			srv = ulmk_waitset_source_ready(ep->ws_src);
 	}
+	UL_TRACE(ULMK_TRACE_IPC_CALL, ep_id, srv ? srv->tid : 0u);
+	UL_THREAD_STAT_INC(cur, ipc_calls);
 
 	cur->state = UL_THREAD_STATE_BLOCKED;
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 	/* RQ ops outside IPC — IRQs masked at the gateway until trap exit. */
 	ulmk_sched_dequeue(cur);
@@ -327,12 +330,12 @@ int ep_call_timeout_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg,
 		return -ULMK_EINVAL;
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 	ep = ulmk_ep_by_id(ep_id);
 	if (!ep) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -340,7 +343,7 @@ int ep_call_timeout_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg,
 	cur = ulmk_sched_current();
 	if (!cur) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -356,7 +359,7 @@ int ep_call_timeout_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg,
 		cur->blocked_ep     = ULMK_EP_INVALID;
 		cur->ipc_msg_outptr = NULL;
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -367,11 +370,16 @@ int ep_call_timeout_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg,
 		srv->state = UL_THREAD_STATE_READY;
 	} else {
 		ipc_enqueue_tail(&ep->send_queue, cur);
+		/* A wait set owner blocked in wait_any is woken like a server. */
+		if (ep->ws_src)
+			srv = ulmk_waitset_source_ready(ep->ws_src);
 	}
+	UL_TRACE(ULMK_TRACE_IPC_CALL, ep_id, srv ? srv->tid : 0u);
+	UL_THREAD_STAT_INC(cur, ipc_calls);
 
 	cur->state = UL_THREAD_STATE_BLOCKED;
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 	ulmk_sched_dequeue(cur);
 	if (srv)
@@ -394,12 +402,12 @@ int ep_recv_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg, ulmk_tid_t *sender)
 		return -ULMK_EINVAL;
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 	ep = ulmk_ep_by_id(ep_id);
 	if (!ep) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -407,7 +415,7 @@ int ep_recv_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg, ulmk_tid_t *sender)
 	cur = ulmk_sched_current();
 	if (!cur) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -417,15 +425,18 @@ int ep_recv_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg, ulmk_tid_t *sender)
 
 		*msg = *caller_request(caller);
 		cur->ipc_sender = caller->tid;
+		UL_THREAD_STAT_INC(cur, ipc_recvs);
 		apply_prio_inherit(cur, caller);
 
 		if (sender)
 			*sender = caller->tid;
+		UL_TRACE(ULMK_TRACE_IPC_RECV, ep_id, caller->tid);
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return 0;
 	}
+	UL_TRACE(ULMK_TRACE_IPC_RECV, ep_id, 0u);
 
 	cur->ipc_msg_outptr    = msg;
 	cur->ipc_sender_outptr = sender;
@@ -436,7 +447,7 @@ int ep_recv_impl(ulmk_ep_t ep_id, ulmk_msg_t *msg, ulmk_tid_t *sender)
 
 	cur->state = UL_THREAD_STATE_BLOCKED;
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 	ulmk_sched_dequeue(cur);
 #ifndef UL_UNIT_TEST
@@ -458,18 +469,19 @@ int ep_reply_impl(ulmk_tid_t sender_tid, const ulmk_msg_t *reply)
 		return -ULMK_EINVAL;
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 	caller = ulmk_thread_by_tid(sender_tid);
 	if (!caller || caller->blocked_reason != UL_BLOCKED_IPC_CALL) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
 
 	if (cur)
 		cur->priority = cur->saved_prio;
+	UL_TRACE(ULMK_TRACE_IPC_REPLY, caller->tid, 0u);
 
 	ulmk_timeout_disarm(caller);
 
@@ -490,7 +502,7 @@ int ep_reply_impl(ulmk_tid_t sender_tid, const ulmk_msg_t *reply)
 	 * Holding IPC across rq_lock + remote IPI deadlocks with a peer in
 	 * ep_call (IPC then RQ) and inflates cross-CPU reply WCET.
 	 */
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 	ulmk_sched_enqueue(caller);
 #ifndef UL_UNIT_TEST
@@ -530,6 +542,7 @@ int ep_reply_recv_impl(ulmk_ep_t ep_id, ulmk_tid_t sender_tid,
 		caller = ipc_pop_head(&ep->send_queue);
 		*next = *caller_request(caller);
 		cur->ipc_sender = caller->tid;
+		UL_THREAD_STAT_INC(cur, ipc_recvs);
 		apply_prio_inherit(cur, caller);
 		if (next_sender)
 			*next_sender = caller->tid;
@@ -574,6 +587,7 @@ int ep_recv_or_notif_impl(ulmk_ep_t ep_id, ulmk_notif_t notif_id,
 	matched = n->bits & mask;
 	if (matched) {
 		n->bits         &= ~matched;
+		ulmk_notif_publish(n);
 		res->is_notif    = 1;
 		res->notif_bits  = matched;
 		res->sender      = ULMK_TID_INVALID;
@@ -586,6 +600,7 @@ int ep_recv_or_notif_impl(ulmk_ep_t ep_id, ulmk_notif_t notif_id,
 		apply_prio_inherit(cur, caller);
 		cur->ipc_sender = caller->tid;
 		cur->ipc_msg    = *caller_request(caller);
+		UL_THREAD_STAT_INC(cur, ipc_recvs);
 
 		res->is_notif = 0;
 		res->msg      = cur->ipc_msg;
@@ -604,8 +619,7 @@ int ep_recv_or_notif_impl(ulmk_ep_t ep_id, ulmk_notif_t notif_id,
 	cur->block_status      = 0;
 
 	ipc_enqueue_tail(&ep->recv_queue, cur);
-	n->waiter    = cur;
-	n->wait_mask = mask;
+	sys_dlist_append(&n->waiters, &cur->notif_node);
 
 	cur->state = UL_THREAD_STATE_BLOCKED;
 	ulmk_sched_dequeue_locked(cur);
@@ -632,6 +646,10 @@ int ep_destroy_impl(ulmk_ep_t ep_id)
 	while ((th = ipc_pop_head(&ep->recv_queue)) != NULL)
 		wake_blocked_on_destroy(th, ULMK_EINVAL);
 
+	if (ep->ws_src) {
+		ulmk_waitset_source_detach(ep->ws_src);
+		ep->ws_src = NULL;
+	}
 	ep->active = false;
 #ifndef UL_UNIT_TEST
 	ulmk_heap_free(ep);
@@ -0,0 +1,383 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Copyright (c) 2024-2026 Felipe Neves
+ *
+ * Wait set handlers — kernel/ipc/waitset.c
+ * Reference: docs/api_spec.md §8
+ *
+ * epoll-style multiplexing over endpoints and notifications:
+ *   - add/del bind a source object to a slot in the set (ws_src back-pointer).
+ *   - ep_call / notif_signal call ulmk_waitset_source_ready() — O(1) append
+ *     to the ready list, plus a direct hand-off when the owner is blocked.
+ *   - wait_any pops the ready list, re-checking each source, and blocks with
+ *     UL_BLOCKED_WAITSET when nothing is ready.
+ *
+ * Two-layer design, as in ep.c / notif.c:
+ *   *_impl() — core logic with native C pointer types; testable on host.
+ *   ulmk_kern_waitset_*() — syscall ABI wrappers.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <ulmk/microkernel.h>
+#include <kernel/include/ulmk_waitset_internal.h>
+#include <kernel/include/ulmk_ep_internal.h>
+#include <kernel/include/ulmk_notif_internal.h>
+#include <kernel/include/ulmk_sched.h>
+#include <kernel/syscall/syscall_router.h>
+#include <ulmk_arch.h>
+
+#ifndef UL_UNIT_TEST
+#include <kernel/include/ulmk_mem_internal.h>
+#include <kernel/include/ulmk_klock.h>
+#else
+#include <ulmk/config.h>
+#endif
+
+#ifdef UL_UNIT_TEST
+ulmk_waitset_obj_t waitset_pool[UL_TEST_MAX_WAITSETS];
+#endif
+
+int ulmk_waitset_obj_init(ulmk_waitset_obj_t *ws, ulmk_waitset_t id)
+{
+	uint32_t i;
+
+	ws->id     = id;
+	ws->active = true;
+	ws->waiter = NULL;
+	sys_dlist_init(&ws->ready);
+	for (i = 0u; i < ULMK_WAITSET_MAX_SOURCES; i++) {
+		ws->src[i].ws   = ws;
+		ws->src[i].kind = 0u;
+		sys_dnode_init(&ws->src[i].ready_node);
+	}
+	return 0;
+}
+
+ulmk_waitset_obj_t *ulmk_waitset_by_id(ulmk_waitset_t id)
+{
+#ifdef UL_UNIT_TEST
+	if (id == ULMK_WAITSET_INVALID || (uint32_t)id >= UL_TEST_MAX_WAITSETS)
+		return NULL;
+	if (!waitset_pool[(uint32_t)id].active)
+		return NULL;
+	return &waitset_pool[(uint32_t)id];
+#else
+	ulmk_waitset_obj_t *ws = (ulmk_waitset_obj_t *)(uintptr_t)id;
+
+	if (!ws || !ws->active)
+		return NULL;
+	return ws;
+#endif
+}
+
+/* =========================================================================
+ * Helpers
+ * ========================================================================= */
+
+/* The ws_src slot of the object behind (@kind, @handle); NULL if invalid. */
+static ulmk_waitset_src_t **source_slot(uint32_t kind, uintptr_t handle)
+{
+	ulmk_endpoint_t  *ep;
+	ulmk_notif_obj_t *n;
+
+	if (kind == ULMK_WAITSET_EP) {
+		ep = ulmk_ep_by_id((ulmk_ep_t)handle);
+		return ep ? &ep->ws_src : NULL;
+	}
+	if (kind == ULMK_WAITSET_NOTIF) {
+		n = ulmk_notif_by_id((ulmk_notif_t)handle);
+		return n ? &n->ws_src : NULL;
+	}
+	return NULL;
+}
+
+static void source_unready(ulmk_waitset_src_t *src)
+{
+	if (sys_dnode_is_linked(&src->ready_node)) {
+		sys_dlist_remove(&src->ready_node);
+		sys_dnode_init(&src->ready_node);
+	}
+}
+
+/*
+ * Pop ready sources until one still is, and describe it in @ev.  Notif bits
+ * are consumed here.  An endpoint stays queued at the tail while callers
+ * remain (level-triggered), so other sources get a turn before it repeats.
+ */
+static bool waitset_take(ulmk_waitset_obj_t *ws, ulmk_waitset_event_t *ev)
+{
+	ulmk_waitset_src_t *src;
+	ulmk_endpoint_t    *ep;
+	ulmk_notif_obj_t   *n;
+	sys_dnode_t        *dn;
+	uint32_t            matched;
+
+	while ((dn = sys_dlist_get(&ws->ready)) != NULL) {
+		src = SYS_DLIST_CONTAINER_OF(dn, ulmk_waitset_src_t, ready_node);
+		sys_dnode_init(&src->ready_node);
+
+		if (src->kind == ULMK_WAITSET_EP) {
+			ep = ulmk_ep_by_id((ulmk_ep_t)src->handle);
+			if (!ep || sys_dlist_is_empty(&ep->send_queue))
+				continue;
+			ev->kind   = ULMK_WAITSET_EP;
+			ev->handle = src->handle;
+			ev->bits   = 0u;
+			sys_dlist_append(&ws->ready, &src->ready_node);
+			return true;
+		}
+
+		if (src->kind == ULMK_WAITSET_NOTIF) {
+			n = ulmk_notif_by_id((ulmk_notif_t)src->handle);
+			matched = n ? (n->bits & src->mask) : 0u;
+			if (!matched)
+				continue;
+			n->bits   &= ~matched;
+			ulmk_notif_publish(n);
+			ev->kind   = ULMK_WAITSET_NOTIF;
+			ev->handle = src->handle;
+			ev->bits   = matched;
+			return true;
+		}
+	}
+	return false;
+}
+
+ulmk_thread_t *ulmk_waitset_source_ready(ulmk_waitset_src_t *src)
+{
+	ulmk_waitset_obj_t *ws = src->ws;
+	ulmk_thread_t      *w;
+
+	if (!sys_dnode_is_linked(&src->ready_node))
+		sys_dlist_append(&ws->ready, &src->ready_node);
+
+	w = ws->waiter;
+	if (!w || w->state != UL_THREAD_STATE_BLOCKED ||
+	    w->blocked_reason != UL_BLOCKED_WAITSET)
+		return NULL;
+	if (!waitset_take(ws, w->ws_event_outptr))
+		return NULL;
+
+	ws->waiter         = NULL;
+	w->blocked_ws      = NULL;
+	w->ws_event_outptr = NULL;
+	w->blocked_reason  = UL_BLOCKED_NONE;
+	w->state           = UL_THREAD_STATE_READY;
+	return w;
+}
+
+void ulmk_waitset_source_detach(ulmk_waitset_src_t *src)
+{
+	source_unready(src);
+	src->kind   = 0u;
+	src->handle = 0u;
+}
+
+/* =========================================================================
+ * Core implementation (_impl — native pointer types)
+ * ========================================================================= */
+
+int waitset_add_impl(ulmk_waitset_t ws_id, uint32_t kind, uintptr_t handle,
+		     uint32_t mask)
+{
+	ulmk_waitset_obj_t  *ws;
+	ulmk_waitset_src_t **slot;
+	ulmk_waitset_src_t  *src = NULL;
+	ulmk_thread_t       *w = NULL;
+	uint32_t             i;
+	int                  ret = ULMK_OK;
+#ifndef UL_UNIT_TEST
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
+#endif
+
+	ws   = ulmk_waitset_by_id(ws_id);
+	slot = source_slot(kind, handle);
+	if (!ws || !slot || *slot || (kind == ULMK_WAITSET_NOTIF && !mask)) {
+		ret = ULMK_EINVAL;
+		goto out;
+	}
+
+	for (i = 0u; i < ULMK_WAITSET_MAX_SOURCES; i++) {
+		if (ws->src[i].kind == 0u) {
+			src = &ws->src[i];
+			break;
+		}
+	}
+	if (!src) {
+		ret = ULMK_ENOSPC;
+		goto out;
+	}
+
+	src->kind   = kind;
+	src->handle = handle;
+	src->mask   = kind == ULMK_WAITSET_NOTIF ? mask : 0u;
+	*slot       = src;
+
+	/* Already-pending bits or queued callers count as ready right away. */
+	w = ulmk_waitset_source_ready(src);
+	if (w)
+		ulmk_sched_enqueue_locked(w);
+out:
+#ifndef UL_UNIT_TEST
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
+	if (w)
+		ulmk_sched_kick_pending();
+#endif
+	return ret;
+}
+
+int waitset_del_impl(ulmk_waitset_t ws_id, uint32_t kind, uintptr_t handle)
+{
+	ulmk_waitset_obj_t  *ws;
+	ulmk_waitset_src_t **slot;
+	int                  ret = ULMK_EINVAL;
+#ifndef UL_UNIT_TEST
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
+#endif
+
+	ws   = ulmk_waitset_by_id(ws_id);
+	slot = source_slot(kind, handle);
+	if (ws && slot && *slot && (*slot)->ws == ws) {
+		ulmk_waitset_source_detach(*slot);
+		*slot = NULL;
+		ret   = ULMK_OK;
+	}
+#ifndef UL_UNIT_TEST
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
+#endif
+	return ret;
+}
+
+int wait_any_impl(ulmk_waitset_t ws_id, ulmk_waitset_event_t *ev)
+{
+	ulmk_waitset_obj_t *ws;
+	ulmk_thread_t      *cur;
+	int                 ret = ULMK_OK;
+#ifndef UL_UNIT_TEST
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
+#endif
+
+	ws  = ulmk_waitset_by_id(ws_id);
+	cur = ulmk_sched_current();
+	if (!ws || !ev || !cur || ws->waiter) {
+		ret = ULMK_EINVAL;
+		goto out;
+	}
+
+	if (waitset_take(ws, ev))
+		goto out;
+
+	cur->blocked_reason  = UL_BLOCKED_WAITSET;
+	cur->blocked_ws      = ws;
+	cur->ws_event_outptr = ev;
+	cur->block_status    = 0;
+	ws->waiter           = cur;
+
+	cur->state = UL_THREAD_STATE_BLOCKED;
+	ulmk_sched_dequeue_locked(cur);
+	/* The waking source fills *ev; switch deferred to trap exit. */
+out:
+#ifndef UL_UNIT_TEST
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
+#endif
+	return ret;
+}
+
+int waitset_destroy_impl(ulmk_waitset_t ws_id)
+{
+	ulmk_waitset_obj_t  *ws;
+	ulmk_waitset_src_t **slot;
+	ulmk_thread_t       *w;
+	uint32_t             i;
+#ifndef UL_UNIT_TEST
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
+#endif
+
+	ws = ulmk_waitset_by_id(ws_id);
+	if (!ws) {
+#ifndef UL_UNIT_TEST
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
+#endif
+		return ULMK_EINVAL;
+	}
+
+	for (i = 0u; i < ULMK_WAITSET_MAX_SOURCES; i++) {
+		if (ws->src[i].kind == 0u)
+			continue;
+		slot = source_slot(ws->src[i].kind, ws->src[i].handle);
+		if (slot && *slot == &ws->src[i])
+			*slot = NULL;
+		ulmk_waitset_source_detach(&ws->src[i]);
+	}
+
+	w = ws->waiter;
+	if (w) {
+		ulmk_waitset_waiter_remove(w);
+		w->block_status   = ULMK_EINVAL;
+		w->blocked_reason = UL_BLOCKED_NONE;
+		w->state          = UL_THREAD_STATE_READY;
+		ulmk_sched_enqueue_locked(w);
+	}
+
+	ws->active = false;
+#ifndef UL_UNIT_TEST
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_sched_kick_pending();
+	ulmk_heap_free(ws);
+#endif
+	return ULMK_OK;
+}
+
+/* =========================================================================
+ * Syscall ABI wrappers
+ * ========================================================================= */
+
+uint32_t ulmk_kern_waitset_create(void)
+{
+#ifdef UL_UNIT_TEST
+	uint32_t i;
+
+	/* Slot 0 doubles as ULMK_WAITSET_INVALID. */
+	for (i = 1u; i < UL_TEST_MAX_WAITSETS; i++) {
+		if (!waitset_pool[i].active) {
+			ulmk_waitset_obj_init(&waitset_pool[i], (ulmk_waitset_t)i);
+			return i;
+		}
+	}
+	return (uint32_t)ULMK_WAITSET_INVALID;
+#else
+	ulmk_waitset_obj_t *ws =
+		(ulmk_waitset_obj_t *)ulmk_heap_alloc(sizeof(ulmk_waitset_obj_t));
+
+	if (!ws)
+		return (uint32_t)ULMK_WAITSET_INVALID;
+	ulmk_waitset_obj_init(ws, (ulmk_waitset_t)(uintptr_t)ws);
+	return (uint32_t)(uintptr_t)ws;
+#endif
+}
+
+uint32_t ulmk_kern_waitset_add(uint32_t ws, uint32_t kind, uint32_t handle,
+			       uint32_t mask)
+{
+	return (uint32_t)(int32_t)waitset_add_impl((ulmk_waitset_t)ws, kind,
+						   (uintptr_t)handle, mask);
+}
+
+uint32_t ulmk_kern_waitset_del(uint32_t ws, uint32_t kind, uint32_t handle)
+{
+	return (uint32_t)(int32_t)waitset_del_impl((ulmk_waitset_t)ws, kind,
+						   (uintptr_t)handle);
+}
+
+uint32_t ulmk_kern_wait_any(uint32_t ws, uint32_t ev_ptr)
+{
+	return (uint32_t)(int32_t)wait_any_impl(
+		(ulmk_waitset_t)ws,
+		(ulmk_waitset_event_t *)(uintptr_t)ev_ptr);
+}
+
+uint32_t ulmk_kern_waitset_destroy(uint32_t ws)
+{
+	return (uint32_t)(int32_t)waitset_destroy_impl((ulmk_waitset_t)ws);
+}
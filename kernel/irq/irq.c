@@ -2,40 +2,66 @@
 /*
  * Copyright (c) 2024-2026 Felipe Neves
  *
- * IRQ binding table and kernel IRQ handlers — kernel/irq/irq.c
+ * IRQ bindings and kernel IRQ handlers — kernel/irq/irq.c
  * Reference: docs/api_spec.md §10
  *
  * Routing model:
- *   ulmk_irq_bind()     → records irq_nr→(notif_obj, bit) in irq_table
+ *   ulmk_irq_bind()     → records irq_nr→(notif_obj, bit) in a binding
+ *                         published in irq_map[srpn]
  *   ulmk_irq_attach()   → callback fast-path + owned notif (bit 0)
+ *   ulmk_irq_thread_bind() → binding readies a handler thread directly
+ *   ulmk_irq_coalesce() → batch a notif binding's signals (count / ticks)
+ *   ulmk_irq_affinity() → route the source to a CPU, or after its driver
  *   ulmk_irq_enable()   → arms the interrupt controller via arch layer
  *   ulmk_irq_ack()      → acknowledges the interrupt source
- *   ulmk_kern_irq_dispatch() → ISR: attach trampoline and/or notif_signal
+ *   ulmk_kern_irq_dispatch() → ISR: IRQ thread wake, attach trampoline
+ *                              and/or notif_signal
  */
 
 #include <stdint.h>
 #include <string.h>
 #include <ulmk/microkernel.h>
 #include <ulmk/config.h>
+#include <kernel/include/ulmk_cycles.h>
 #include <kernel/include/ulmk_irq_internal.h>
 #include <kernel/include/ulmk_notif_internal.h>
+#include <kernel/include/ulmk_domain_internal.h>
 #include <kernel/include/ulmk_mem_internal.h>
 #include <kernel/include/ulmk_klock.h>
 #include <kernel/include/ulmk_percpu.h>
 #include <kernel/include/ulmk_sched.h>
+#include <kernel/include/ulmk_timer.h>
+#include <kernel/include/ulmk_trace.h>
 #include <kernel/include/ulmk_printk.h>
 #include <kernel/syscall/syscall_router.h>
 #include <ulmk_arch.h>
 
 /* =========================================================================
- * Binding table — static, kernel-space, hardware-bounded size.
+ * Binding objects — heap-allocated on first use, recycled through a free
+ * list, at most ULMK_CONFIG_MAX_IRQ_BINDINGS live at once.
  * ========================================================================= */
 
-static ulmk_irq_binding_t UL_KERNEL_BSS irq_table[ULMK_CONFIG_MAX_IRQ_BINDINGS];
+#if ULMK_CONFIG_MAX_IRQ_BINDINGS > 255
+#error "ULMK_CONFIG_MAX_IRQ_BINDINGS exceeds the 255 bindable SRPNs"
+#endif
+
+/*
+ * SRPN → binding (NULL = unbound).  ulmk_kern_irq_dispatch() reads it
+ * without the lock, so ISR lookup cost does not grow with the number of
+ * bound devices.  Writers hold g_ulmk_lock_irq: a binding is filled before
+ * it is published, and unpublished before it is wiped.  Unbound objects go
+ * to irq_free rather than back to the heap, so a reader that raced the
+ * unpublish still dereferences binding memory, as with a static table.
+ */
+static ulmk_irq_binding_t *volatile UL_KERNEL_BSS irq_map[256];
+static ulmk_irq_binding_t          *UL_KERNEL_BSS irq_free;
+static uint32_t                     UL_KERNEL_BSS irq_live;
 
 void ulmk_irq_table_init(void)
 {
-	memset(irq_table, 0, sizeof(irq_table));
+	memset((void *)irq_map, 0, sizeof(irq_map));
+	irq_free = NULL;
+	irq_live = 0u;
 }
 
 bool ulmk_irq_in_attach(void)
@@ -43,45 +69,262 @@ bool ulmk_irq_in_attach(void)
 	return ulmk_percpu()->in_irq_attach;
 }
 
-int ulmk_irq_binding_add(uint8_t srpn, ulmk_notif_obj_t *notif, uint32_t bit)
+static void irq_coal_expire(struct ulmk_timeout *to);
+
+/*
+ * Bind @srpn: O(1) — pop a recycled object, or take one from the heap the
+ * first time this many sources are bound.
+ */
+static ulmk_irq_binding_t *irq_binding_claim(uint8_t srpn,
+					     ulmk_notif_obj_t *notif,
+					     uint32_t bit,
+					     ulmk_thread_t *thread,
+					     uint8_t prio, int *err)
 {
 	ulmk_arch_irq_key_t key;
-	int i;
-	int ret = -1;
-
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_irq);
-	for (i = 0; i < ULMK_CONFIG_MAX_IRQ_BINDINGS; i++) {
-		if (!irq_table[i].notif) {
-			irq_table[i].srpn         = srpn;
-			irq_table[i].notif        = notif;
-			irq_table[i].bit          = bit;
-			irq_table[i].enabled      = false;
-			irq_table[i].attach_fn    = NULL;
-			irq_table[i].attach_data  = NULL;
-			irq_table[i].owner        = NULL;
-			irq_table[i].owned_notif  = false;
-			ret = i;
-			break;
+	ulmk_irq_binding_t *b;
+	ulmk_irq_binding_t *fresh = NULL;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_irq);
+	if (!irq_free && irq_live < ULMK_CONFIG_MAX_IRQ_BINDINGS) {
+		/* The heap has its own lock; recheck the map afterwards. */
+		ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+		fresh = (ulmk_irq_binding_t *)
+			ulmk_heap_alloc(sizeof(ulmk_irq_binding_t));
+		key = ulmk_klock_irqsave(&g_ulmk_lock_irq);
+		if (fresh) {
+			fresh->next_free = irq_free;
+			irq_free         = fresh;
 		}
 	}
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_irq, key);
-	return ret;
+	if (irq_map[srpn]) {
+		ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+		*err = ULMK_EINVAL;
+		return NULL;
+	}
+	b = irq_free;
+	if (!b || irq_live >= ULMK_CONFIG_MAX_IRQ_BINDINGS) {
+		ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+		*err = ULMK_ENOSPC;
+		return NULL;
+	}
+	irq_free = b->next_free;
+	irq_live++;
+
+	memset(b, 0, sizeof(*b));
+	b->srpn         = srpn;
+	b->notif        = notif;
+	b->bit          = bit;
+	b->thread       = thread;
+	b->thread_state = UL_IRQ_THREAD_BUSY;
+	b->thread_prio  = prio;
+	b->coal_to.cb   = irq_coal_expire;
+	sys_dnode_init(&b->coal_to.node);
+	ulmk_arch_wmb();
+	irq_map[srpn] = b;
+	ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+	*err = ULMK_OK;
+	return b;
+}
+
+int ulmk_irq_binding_add(uint8_t srpn, ulmk_notif_obj_t *notif, uint32_t bit)
+{
+	int err;
+
+	(void)irq_binding_claim(srpn, notif, bit, NULL, 0u, &err);
+	return err;
 }
 
 ulmk_irq_binding_t *ulmk_irq_binding_by_srpn(uint8_t srpn)
 {
-	int i;
+	return irq_map[srpn];
+}
 
-	for (i = 0; i < ULMK_CONFIG_MAX_IRQ_BINDINGS; i++) {
-		if (irq_table[i].notif && irq_table[i].srpn == srpn)
-			return &irq_table[i];
+/*
+ * Unbind step 1: unpublish @b from @srpn.  Detach, thread release and the
+ * attach-fault path look @b up without the lock and can race; only the
+ * caller that still finds @b in irq_map[] gets true, tears the source down
+ * and then owes irq_binding_free().
+ */
+static bool irq_binding_unpublish(ulmk_irq_binding_t *b, uint8_t srpn)
+{
+	ulmk_arch_irq_key_t key;
+	bool                won;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_irq);
+	won = irq_map[srpn] == b;
+	if (won) {
+		irq_map[srpn] = NULL;
+		ulmk_arch_wmb();
 	}
-	return NULL;
+	ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+	return won;
 }
 
-static void irq_binding_clear(ulmk_irq_binding_t *b)
+/*
+ * Unbind step 2: recycle an unpublished @b.  A deadline already running on
+ * another CPU either saw @b unpublished or set coal_busy first; wait for it.
+ */
+static void irq_binding_free(ulmk_irq_binding_t *b)
 {
+	ulmk_arch_irq_key_t key;
+
+	(void)ulmk_timer_cancel(&b->coal_to);
+	while (b->coal_busy)
+		;
+	key = ulmk_klock_irqsave(&g_ulmk_lock_irq);
 	memset(b, 0, sizeof(*b));
+	b->next_free = irq_free;
+	irq_free     = b;
+	irq_live--;
+	ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+}
+
+/* Retarget @b's source to @cpu. */
+static void irq_route(ulmk_irq_binding_t *b, uint8_t cpu)
+{
+	ulmk_arch_irq_key_t key;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_irq);
+	if (b->cpu != cpu) {
+		ulmk_arch_irq_src_route(b->srpn, cpu);
+		b->cpu = cpu;
+	}
+	ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+}
+
+/*
+ * Auto affinity: the driver arms, acks or waits on its source from the CPU
+ * it runs on, so route the next interrupt there and its wake stays local.
+ */
+static void irq_follow(ulmk_irq_binding_t *b)
+{
+	uint8_t cpu = (uint8_t)ulmk_arch_cpu_id();
+
+	if (b->cpu_auto && b->cpu != cpu)
+		irq_route(b, cpu);
+}
+
+/*
+ * Run @th at @b's IRQ priority until its next ulmk_irq_thread_wait().  @th
+ * must be off the run queue (blocked, or current).
+ */
+static void irq_thread_boost(ulmk_irq_binding_t *b, ulmk_thread_t *th)
+{
+	if (b->thread_prio < th->priority) {
+		th->irq_saved_prio = th->priority;
+		th->irq_boosted    = 1u;
+		th->priority       = b->thread_prio;
+	}
+}
+
+/*
+ * Ready the handler thread of @b.  Called by whoever moved thread_state off
+ * WAITING, so the thread is blocked in ulmk_irq_thread_wait() and nobody
+ * else touches it.
+ */
+static void irq_thread_wake(ulmk_irq_binding_t *b, int32_t status)
+{
+	ulmk_thread_t *th = b->thread;
+
+	if (status == ULMK_OK)
+		irq_thread_boost(b, th);
+	th->block_status   = status;
+	th->blocked_reason = UL_BLOCKED_NONE;
+	th->state          = UL_THREAD_STATE_READY;
+	ulmk_sched_enqueue(th);
+}
+
+/*
+ * Mask @b's source and unbind its thread, waking it with EINVAL if @wake.
+ * False if @b was no longer bound to @srpn (someone else unbound it).
+ */
+static bool irq_thread_unbind(ulmk_irq_binding_t *b, uint8_t srpn, bool wake)
+{
+	ulmk_thread_t *th;
+
+	if (!irq_binding_unpublish(b, srpn))
+		return false;
+	th = b->thread;
+	b->enabled = false;
+	ulmk_arch_irq_src_disable(b->srpn);
+	ulmk_arch_irq_src_ack(b->srpn);
+
+	if (ulmk_arch_atomic_cas(&b->thread_state, UL_IRQ_THREAD_WAITING,
+				 UL_IRQ_THREAD_BUSY) == UL_IRQ_THREAD_WAITING &&
+	    wake)
+		irq_thread_wake(b, ULMK_EINVAL);
+	if (th->irq_bound)
+		th->irq_bound--;
+	irq_binding_free(b);
+	return true;
+}
+
+/*
+ * Coalescing: the ISR only counts events into coal_count and re-arms the
+ * source; whoever swaps a non-zero count back to 0 — the ISR that closes a
+ * full batch, or the deadline timer — owes the notification for it.
+ */
+static uint32_t irq_coal_take(ulmk_irq_binding_t *b)
+{
+	uint32_t n;
+
+	do {
+		n = b->coal_count;
+	} while (n && ulmk_arch_atomic_cas(&b->coal_count, n, 0u) != n);
+	return n;
+}
+
+static void irq_coal_deliver(ulmk_irq_binding_t *b, ulmk_irq_stats_t *s,
+			     uint32_t n)
+{
+	/* A masked level source waits for the driver's ack, as if unbatched. */
+	if (b->coal_masked == UL_IRQ_COAL_BATCH)
+		b->coal_masked = UL_IRQ_COAL_ACK;
+	s->coal_events += n;
+	s->coal_batches++;
+	notif_signal_impl(b->notif->id, 1u << b->bit);
+}
+
+/*
+ * Deadline of a partial batch; runs from the tick with no lock held, so an
+ * unbind on another CPU may be recycling @b.  Check it is still published
+ * under the lock and keep irq_binding_free() off it until the signal is out.
+ */
+static void irq_coal_expire(struct ulmk_timeout *to)
+{
+	ulmk_irq_binding_t *b = CONTAINER_OF(to, ulmk_irq_binding_t, coal_to);
+	ulmk_irq_stats_t   *s = &ulmk_percpu()->irq_stats;
+	ulmk_arch_irq_key_t key;
+	uint32_t            n;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_irq);
+	if (irq_map[b->srpn] != b || !b->notif) {
+		ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+		return;
+	}
+	b->coal_busy = 1u;
+	ulmk_klock_irqrestore(&g_ulmk_lock_irq, key);
+
+	n = irq_coal_take(b);
+	if (n) {
+		s->signals++;
+		irq_coal_deliver(b, s, n);
+	}
+	ulmk_arch_wmb();
+	b->coal_busy = 0u;
+}
+
+void ulmk_irq_thread_release(ulmk_thread_t *th)
+{
+	ulmk_irq_binding_t *b;
+	uint32_t            srpn;
+
+	for (srpn = 1u; th->irq_bound && srpn < 256u; srpn++) {
+		b = irq_map[srpn];
+		if (b && b->thread == th)
+			(void)irq_thread_unbind(b, (uint8_t)srpn, false);
+	}
 }
 
 static uint32_t irq_attach_common(uint32_t srpn, uint32_t fn_addr,
@@ -99,6 +342,7 @@ static uint32_t irq_attach_common(uint32_t srpn, uint32_t fn_addr,
 	ulmk_notif_obj_t *notif;
 	ulmk_thread_t *cur;
 	ulmk_irq_attach_fn_t fn;
+	ulmk_irq_binding_t *b;
 	int ret;
 	uint32_t nid;
 
@@ -124,17 +368,17 @@ static uint32_t irq_attach_common(uint32_t srpn, uint32_t fn_addr,
 		return (uint32_t)ULMK_NOTIF_INVALID;
 	}
 
-	ret = ulmk_irq_binding_add((uint8_t)srpn, notif, 0u);
-	if (ret < 0) {
+	b = irq_binding_claim((uint8_t)srpn, notif, 0u, NULL, 0u, &ret);
+	if (!b) {
 		(void)ulmk_kern_notif_destroy(nid);
 		return (uint32_t)ULMK_NOTIF_INVALID;
 	}
 
 	fn = (ulmk_irq_attach_fn_t)(uintptr_t)fn_addr;
-	irq_table[ret].attach_fn   = fn;
-	irq_table[ret].attach_data = (void *)(uintptr_t)data_addr;
-	irq_table[ret].owner       = cur;
-	irq_table[ret].owned_notif = true;
+	b->attach_fn   = fn;
+	b->attach_data = (void *)(uintptr_t)data_addr;
+	b->owner       = cur;
+	b->owned_notif = true;
 
 	if (have_src)
 		ulmk_arch_irq_src_register((uint8_t)srpn, src_reg);
@@ -157,16 +401,14 @@ uint32_t ulmk_kern_irq_bind(uint32_t srpn, uint32_t notif_id, uint32_t bit)
 	if (srpn == 0u || srpn >= 256u || bit > 31u)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
-	if (ulmk_irq_binding_by_srpn((uint8_t)srpn))
-		return (uint32_t)(int32_t)ULMK_EINVAL;
-
 	notif = ulmk_notif_by_id((ulmk_notif_t)notif_id);
 	if (!notif)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
+	/* EINVAL if already bound, ENOSPC when the table is full. */
 	ret = ulmk_irq_binding_add((uint8_t)srpn, notif, bit);
 	if (ret < 0)
-		return (uint32_t)(int32_t)ULMK_ENOSPC;
+		return (uint32_t)(int32_t)ret;
 
 	ulmk_arch_irq_src_configure((uint8_t)srpn, (uint8_t)srpn, 0u);
 	return 0u;
@@ -181,16 +423,13 @@ uint32_t ulmk_kern_irq_bind_hw(uint32_t srpn, uint32_t notif_id,
 	if (srpn == 0u || srpn >= 256u || bit > 31u || src_reg == 0u)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
-	if (ulmk_irq_binding_by_srpn((uint8_t)srpn))
-		return (uint32_t)(int32_t)ULMK_EINVAL;
-
 	notif = ulmk_notif_by_id((ulmk_notif_t)notif_id);
 	if (!notif)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
 	ret = ulmk_irq_binding_add((uint8_t)srpn, notif, bit);
 	if (ret < 0)
-		return (uint32_t)(int32_t)ULMK_ENOSPC;
+		return (uint32_t)(int32_t)ret;
 
 	ulmk_arch_irq_src_register((uint8_t)srpn, src_reg);
 	return 0u;
@@ -207,21 +446,115 @@ uint32_t ulmk_kern_irq_attach_hw(uint32_t srpn, uint32_t fn, uint32_t data,
 	return irq_attach_common(srpn, fn, data, src_reg, true);
 }
 
+/*
+ * thread_bind — make the caller the handler thread for @srpn.  @src_reg as
+ * for ulmk_irq_bind_hw(), or 0 to route @srpn like ulmk_irq_bind().  Each
+ * interrupt masks the source and readies the caller at @prio (if that is
+ * higher than its own); ulmk_irq_thread_wait() undoes both.
+ */
+uint32_t ulmk_kern_irq_thread_bind(uint32_t srpn, uint32_t src_reg,
+				   uint32_t prio)
+{
+	ulmk_thread_t *cur = ulmk_sched_current();
+	int            ret;
+
+	if (srpn == 0u || srpn >= 256u || prio > 255u || !cur)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	if (!irq_binding_claim((uint8_t)srpn, NULL, 0u, cur, (uint8_t)prio,
+			       &ret))
+		return (uint32_t)(int32_t)ret;
+	cur->irq_bound++;
+
+	if (src_reg)
+		ulmk_arch_irq_src_register((uint8_t)srpn, src_reg);
+	else
+		ulmk_arch_irq_src_configure((uint8_t)srpn, (uint8_t)srpn, 0u);
+	/* Arbitrate at the handler's priority: 0 = highest → 255. */
+	ulmk_arch_irq_src_priority((uint8_t)srpn,
+				   prio == 255u ? 1u : (uint8_t)(255u - prio));
+	return 0u;
+}
+
+/*
+ * thread_wait — end of one handler pass: drop the IRQ priority, then either
+ * return at once for an interrupt latched while BUSY (source still masked)
+ * or block with the source acked and unmasked.
+ */
+uint32_t ulmk_kern_irq_thread_wait(uint32_t srpn)
+{
+	ulmk_thread_t      *cur = ulmk_sched_current();
+	ulmk_irq_binding_t *b;
+
+	if (!cur)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+	if (cur->irq_boosted) {
+		cur->irq_boosted = 0u;
+		cur->priority    = cur->irq_saved_prio;
+	}
+
+	if (srpn == 0u || srpn >= 256u)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+	b = ulmk_irq_binding_by_srpn((uint8_t)srpn);
+	if (!b || b->thread != cur)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	if (b->thread_state == UL_IRQ_THREAD_PENDING) {
+		b->thread_state = UL_IRQ_THREAD_BUSY;
+		irq_thread_boost(b, cur);
+		return 0u;
+	}
+
+	cur->blocked_reason = UL_BLOCKED_IRQ;
+	cur->block_status   = 0;
+	cur->state          = UL_THREAD_STATE_BLOCKED;
+	ulmk_sched_dequeue(cur);
+
+	/* Publish WAITING before unmasking so the next ISR finds the thread. */
+	if (ulmk_arch_atomic_cas(&b->thread_state, UL_IRQ_THREAD_BUSY,
+				 UL_IRQ_THREAD_WAITING) != UL_IRQ_THREAD_BUSY) {
+		/* Another CPU latched one in between: run the handler again. */
+		b->thread_state     = UL_IRQ_THREAD_BUSY;
+		cur->blocked_reason = UL_BLOCKED_NONE;
+		cur->state          = UL_THREAD_STATE_READY;
+		irq_thread_boost(b, cur);
+		ulmk_sched_enqueue(cur);
+		return 0u;
+	}
+	irq_follow(b);
+	b->enabled = true;
+	ulmk_arch_irq_src_ack((uint8_t)srpn);
+	ulmk_arch_irq_src_enable((uint8_t)srpn);
+	return 0u;
+}
+
 uint32_t ulmk_kern_irq_detach(uint32_t srpn)
 {
-#if !ULMK_CONFIG_IRQ_ATTACH
-	(void)srpn;
-	return (uint32_t)(int32_t)ULMK_ENOTSUP;
-#else
 	ulmk_irq_binding_t *b;
+	ulmk_thread_t      *cur;
+#if ULMK_CONFIG_IRQ_ATTACH
 	ulmk_notif_t nid;
 	bool owned;
+#endif
 
 	if (srpn == 0u || srpn >= 256u)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
 	b = ulmk_irq_binding_by_srpn((uint8_t)srpn);
-	if (!b || !b->attach_fn)
+	if (b && b->thread) {
+		/* Only the handler itself, or a thread that could kill it. */
+		cur = ulmk_sched_current();
+		if (b->thread != cur &&
+		    (!cur || !(cur->cap_flags & ULMK_CAP_KILL)))
+			return (uint32_t)(int32_t)ULMK_EPERM;
+		if (!irq_thread_unbind(b, (uint8_t)srpn, true))
+			return (uint32_t)(int32_t)ULMK_EINVAL;
+		return 0u;
+	}
+#if !ULMK_CONFIG_IRQ_ATTACH
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+#else
+	if (!b || !b->attach_fn || !irq_binding_unpublish(b, (uint8_t)srpn))
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
 	b->enabled = false;
@@ -230,7 +563,7 @@ uint32_t ulmk_kern_irq_detach(uint32_t srpn)
 
 	owned = b->owned_notif;
 	nid   = b->notif ? b->notif->id : ULMK_NOTIF_INVALID;
-	irq_binding_clear(b);
+	irq_binding_free(b);
 
 	if (owned && nid != ULMK_NOTIF_INVALID)
 		(void)ulmk_kern_notif_destroy((uint32_t)nid);
@@ -239,6 +572,60 @@ uint32_t ulmk_kern_irq_detach(uint32_t srpn)
 #endif
 }
 
+/*
+ * coalesce — deliver one signal per @max_events interrupts, or @max_ticks
+ * after the first interrupt of a batch, whichever comes first.  Only plain
+ * notification bindings qualify; @max_events < 2 restores one signal per
+ * interrupt and flushes an open batch.
+ */
+/* Unmask a level source held by coalescing, unless the driver masked it. */
+static void irq_coal_unmask(ulmk_irq_binding_t *b)
+{
+	if (b->coal_masked == UL_IRQ_COAL_OPEN)
+		return;
+	b->coal_masked = UL_IRQ_COAL_OPEN;
+	if (b->enabled)
+		ulmk_arch_irq_src_enable(b->srpn);
+}
+
+uint32_t ulmk_kern_irq_coalesce(uint32_t srpn, uint32_t max_events,
+				uint32_t max_ticks)
+{
+	ulmk_irq_binding_t *b;
+	uint32_t            n;
+	bool                level;
+
+	if (srpn == 0u || srpn >= 256u)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	b = ulmk_irq_binding_by_srpn((uint8_t)srpn);
+	if (!b || !b->notif || b->attach_fn || b->thread)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	level       = (max_events & ULMK_IRQ_COALESCE_LEVEL) != 0u;
+	max_events &= ~ULMK_IRQ_COALESCE_LEVEL;
+	if (max_events < 2u) {
+		b->coal_max = 0u;
+		(void)ulmk_timer_cancel(&b->coal_to);
+		n = irq_coal_take(b);
+		if (n) {
+			ulmk_percpu()->irq_stats.signals++;
+			irq_coal_deliver(b, &ulmk_percpu()->irq_stats, n);
+		}
+		b->coal_level = false;
+		irq_coal_unmask(b);
+		return 0u;
+	}
+	if (max_ticks == 0u || max_ticks > ULMK_TIMER_TIMEOUT_MAX)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	b->coal_ticks = max_ticks;
+	b->coal_level = level;
+	ulmk_arch_wmb();
+	b->coal_max   = max_events;
+	return 0u;
+}
+
 uint32_t ulmk_kern_irq_enable(uint32_t srpn)
 {
 	ulmk_irq_binding_t *b;
@@ -249,9 +636,14 @@ uint32_t ulmk_kern_irq_enable(uint32_t srpn)
 	b = ulmk_irq_binding_by_srpn((uint8_t)srpn);
 	if (!b)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
+	/* Attach fields are written after the slot is published — order them. */
+	ulmk_arch_wmb();
+	irq_follow(b);
 	b->enabled = true;
 
-	ulmk_arch_irq_src_enable((uint8_t)srpn);
+	/* A level source held for its batch stays masked until delivery. */
+	if (b->coal_masked == UL_IRQ_COAL_OPEN)
+		ulmk_arch_irq_src_enable((uint8_t)srpn);
 	return 0u;
 }
 
@@ -272,6 +664,20 @@ uint32_t ulmk_kern_irq_disable(uint32_t srpn)
 	return 0u;
 }
 
+uint32_t ulmk_kern_irq_stats(uint32_t cpu, uint32_t out_ptr)
+{
+	ulmk_irq_stats_t *out = (ulmk_irq_stats_t *)(uintptr_t)out_ptr;
+
+	if (!out || cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	if (cpu < (uint32_t)ULMK_NR_CPUS)
+		*out = ulmk_percpu_of(cpu)->irq_stats;
+	else
+		memset(out, 0, sizeof(*out));
+	return (uint32_t)ULMK_OK;
+}
+
 uint32_t ulmk_kern_irq_ack(uint32_t srpn)
 {
 	ulmk_irq_binding_t *b;
@@ -283,7 +689,37 @@ uint32_t ulmk_kern_irq_ack(uint32_t srpn)
 	if (!b)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
+	irq_follow(b);
 	ulmk_arch_irq_src_ack((uint8_t)srpn);
+	if (b->coal_masked == UL_IRQ_COAL_ACK)
+		irq_coal_unmask(b);
+	return 0u;
+}
+
+/*
+ * affinity — route @srpn to @cpu, or with ULMK_IRQ_CPU_AUTO to the CPU the
+ * caller runs on now and, from then on, wherever its driver next enables,
+ * acks or waits on it.
+ */
+uint32_t ulmk_kern_irq_affinity(uint32_t srpn, uint32_t cpu)
+{
+	ulmk_irq_binding_t *b;
+	bool                follow = cpu == ULMK_IRQ_CPU_AUTO;
+
+	if (srpn == 0u || srpn >= 256u)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	b = ulmk_irq_binding_by_srpn((uint8_t)srpn);
+	if (!b)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	if (follow)
+		cpu = ulmk_arch_cpu_id();
+	if (cpu >= (uint32_t)ULMK_NR_CPUS || !ulmk_percpu_of(cpu)->online)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	b->cpu_auto = follow;
+	irq_route(b, (uint8_t)cpu);
 	return 0u;
 }
 
@@ -301,13 +737,13 @@ void ulmk_kern_irq_attach_fault(void)
 	pc->irq_attach_srpn = 0u;
 
 	b = ulmk_irq_binding_by_srpn(srpn);
-	if (b) {
+	if (b && irq_binding_unpublish(b, srpn)) {
 		b->enabled = false;
 		ulmk_arch_irq_src_disable(srpn);
 		ulmk_arch_irq_src_ack(srpn);
 		owned = b->owned_notif;
 		nid   = b->notif ? b->notif->id : ULMK_NOTIF_INVALID;
-		irq_binding_clear(b);
+		irq_binding_free(b);
 		if (owned && nid != ULMK_NOTIF_INVALID)
 			(void)ulmk_kern_notif_destroy((uint32_t)nid);
 	}
@@ -328,16 +764,62 @@ void ulmk_kern_irq_attach_fault(void)
  * ISR dispatch — called from the arch generic ISR handler.
  * ========================================================================= */
 
-void ulmk_kern_irq_dispatch(uint8_t srpn)
+/* Account one signal; @t0 is the cycle count at dispatch entry. */
+static void irq_stats_signal(ulmk_irq_stats_t *s, uint32_t t0)
 {
-	ulmk_irq_binding_t *b = ulmk_irq_binding_by_srpn(srpn);
+#if UL_CYCLE_COUNTER
+	uint32_t lat = ulmk_arch_cycle_read() - t0;
+
+	s->lat_last   = lat;
+	s->lat_total += lat;
+	if (lat > s->lat_max)
+		s->lat_max = lat;
+#else
+	(void)t0;
+#endif
+	s->signals++;
+}
+
+static void irq_dispatch(uint8_t srpn)
+{
+#if UL_CYCLE_COUNTER
+	uint32_t            t0 = ulmk_arch_cycle_read();
+#else
+	uint32_t            t0 = 0u;
+#endif
+	ulmk_irq_stats_t   *s  = &ulmk_percpu()->irq_stats;
+	ulmk_irq_binding_t *b  = ulmk_irq_binding_by_srpn(srpn);
+
+	s->dispatches++;
+	if (!b || !b->enabled)
+		return;
+
+	if (b->thread) {
+		/* Masked until the handler calls ulmk_irq_thread_wait() again. */
+		ulmk_arch_irq_src_disable(srpn);
+		if (ulmk_arch_atomic_cas(&b->thread_state,
+					 UL_IRQ_THREAD_WAITING,
+					 UL_IRQ_THREAD_BUSY) ==
+		    UL_IRQ_THREAD_WAITING)
+			irq_thread_wake(b, ULMK_OK);
+		else
+			(void)ulmk_arch_atomic_cas(&b->thread_state,
+						   UL_IRQ_THREAD_BUSY,
+						   UL_IRQ_THREAD_PENDING);
+		irq_stats_signal(s, t0);
+		return;
+	}
 
-	if (!b || !b->enabled || !b->notif)
+	if (!b->notif)
 		return;
 
 	if (b->attach_fn) {
 #if ULMK_CONFIG_IRQ_ATTACH
 		struct ulmk_percpu *pc = ulmk_percpu();
+		/* Non-empty when this callback preempted another one. */
+		ulmk_thread_t *outer_owner = pc->irq_attach_owner;
+		uint8_t        outer_srpn  = pc->irq_attach_srpn;
+		bool           outer_in    = pc->in_irq_attach;
 		bool do_notify;
 
 		pc->irq_attach_owner = b->owner;
@@ -345,21 +827,60 @@ void ulmk_kern_irq_dispatch(uint8_t srpn)
 		pc->in_irq_attach    = true;
 		do_notify = ulmk_arch_irq_attach_call(
 			b->attach_fn, b->attach_data,
-			b->owner ? b->owner->regions : NULL,
-			b->owner ? b->owner->region_count : 0u);
-		pc->in_irq_attach    = false;
-		pc->irq_attach_owner = NULL;
-		pc->irq_attach_srpn  = 0u;
+			b->owner ? ulmk_thread_mpu_regions(b->owner) : NULL,
+			b->owner ? ulmk_thread_mpu_count(b->owner) : 0u);
+		pc->in_irq_attach    = outer_in;
+		pc->irq_attach_owner = outer_owner;
+		pc->irq_attach_srpn  = outer_srpn;
 		if (do_notify) {
 			ulmk_arch_irq_src_ack(srpn);
+			irq_stats_signal(s, t0);
 			notif_signal_impl(b->notif->id, 1u << b->bit);
 		}
 #else
 		/* Config off: treat as legacy notif-only if somehow bound. */
+		irq_stats_signal(s, t0);
 		notif_signal_impl(b->notif->id, 1u << b->bit);
 #endif
 		return;
 	}
 
+	if (b->coal_max >= 2u) {
+		uint32_t n = ulmk_arch_atomic_add(&b->coal_count, 1u) + 1u;
+
+		if (n < b->coal_max) {
+			/*
+			 * Absorbed: re-arm the source ourselves, no wake.  A
+			 * level source would fire again at once until the
+			 * driver serves it, so it stays masked for the batch.
+			 */
+			if (n == 1u)
+				(void)ulmk_timer_add(&b->coal_to, b->coal_ticks);
+			if (b->coal_level) {
+				b->coal_masked = UL_IRQ_COAL_BATCH;
+				ulmk_arch_irq_src_disable(srpn);
+			}
+			ulmk_arch_irq_src_ack(srpn);
+			return;
+		}
+		/* Batch full: the driver acks it as it would a single IRQ. */
+		(void)ulmk_timer_cancel(&b->coal_to);
+		n = irq_coal_take(b);
+		if (n) {
+			irq_stats_signal(s, t0);
+			irq_coal_deliver(b, s, n);
+		}
+		return;
+	}
+
+	irq_stats_signal(s, t0);
 	notif_signal_impl(b->notif->id, 1u << b->bit);
 }
+
+void ulmk_kern_irq_dispatch(uint8_t srpn)
+{
+	ulmk_irqoff_open(ULMK_IRQOFF_SITE_IRQ(srpn));
+	UL_TRACE(ULMK_TRACE_IRQ_ENTER, srpn, 0u);
+	irq_dispatch(srpn);
+	UL_TRACE(ULMK_TRACE_IRQ_EXIT, srpn, 0u);
+}
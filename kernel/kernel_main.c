@@ -14,12 +14,16 @@
 #include <ulmk_arch.h>
 #include <kernel/include/ulmk_sched.h>
 #include <kernel/include/ulmk_thread_internal.h>
+#include <kernel/include/ulmk_domain_internal.h>
 #include <kernel/include/ulmk_irq_internal.h>
 #include <kernel/include/ulmk_mem_internal.h>
 #include <kernel/include/ulmk_percpu.h>
 #include <kernel/include/ulmk_printk.h>
 #include <kernel/include/ulmk_syscall_wcet_internal.h>
 #include <kernel/include/ulmk_timer.h>
+#include <kernel/include/ulmk_trace.h>
+#include <kernel/include/ulmk_klock.h>
+#include <kernel/include/ulmk_cycles.h>
 #include <kernel/syscall/syscall_router.h>
 
 /* Linker-provided user pool boundaries (defined in .user_pool section). */
@@ -33,6 +37,8 @@ extern uint8_t _ulmk_user_pool_end[];
 void ulmk_kern_sched_dispatch(bool from_isr)
 {
 	ulmk_sched_trap_dispatch(from_isr);
+	/* No switch taken: the gateway ends here (else closed at the switch). */
+	ulmk_irqoff_close();
 }
 
 void ulmk_kern_ipi_resched(void)
@@ -43,13 +49,24 @@ void ulmk_kern_ipi_resched(void)
 #if ULMK_CONFIG_ENABLE_SMP
 void ulmk_kern_ipi_from_isr(void)
 {
+	ulmk_thread_t *cur;
+
+	ulmk_irqoff_open(ULMK_IRQOFF_SITE_IPI);
 	ulmk_sched_request_resched();
 	/*
 	 * Early IPI before sched_start publishes current: arm needs_resched
 	 * only.  sched_start must not clear it on SMP (see sched.c).
 	 */
-	if (!ulmk_percpu()->current)
+	cur = ulmk_percpu()->current;
+	if (!cur) {
+		ulmk_irqoff_close();
 		return;
+	}
+	/* Kicked by an unmap or unpublish: drop the region before returning. */
+	if ((cur->domain && cur->domain->stale[ulmk_arch_cpu_id()]) ||
+	    cur->mpu_stale)
+		ulmk_thread_mpu_switch(cur, cur->privilege == ULMK_PRIV_KERNEL ?
+					    0u : 1u);
 	ulmk_arch_ipi_note_enter();
 	ulmk_kern_sched_dispatch(true);
 }
@@ -57,10 +74,14 @@ void ulmk_kern_ipi_from_isr(void)
 
 void ulmk_kern_timer_tick(void)
 {
+	ulmk_irqoff_open(ULMK_IRQOFF_SITE_TICK);
 	ulmk_arch_tick_ack();
 	ulmk_timer_tick();
-	if (!ulmk_percpu()->current)
+	if (!ulmk_percpu()->current) {
+		ulmk_irqoff_close();
 		return;
+	}
+	ulmk_sched_acct_tick();
 	ulmk_kern_sched_dispatch(true);
 }
 
@@ -75,6 +96,22 @@ uint32_t ulmk_kern_tick_start(void)
 	return (uint32_t)(int32_t)ULMK_OK;
 }
 
+/* cycle_read — this CPU's cycle counter, for userspace benchmarks. */
+uint32_t ulmk_kern_cycle_read(uint32_t out_ptr)
+{
+#if ULMK_CONFIG_USER_CYCLES
+	uint32_t *out = (uint32_t *)(uintptr_t)out_ptr;
+
+	if (!out)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+	*out = ulmk_arch_cycle_read();
+	return (uint32_t)ULMK_OK;
+#else
+	(void)out_ptr;
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+#endif
+}
+
 /*
  * After trap-exit switch, pick up destroy errors / recv_or_notif notif rc
  * that were staged while this thread was blocked.
@@ -111,12 +148,12 @@ void ulmk_kern_trap_mpu_restore(void)
 	if (!cur)
 		return;
 
-	ulmk_arch_mpu_switch(cur->regions, cur->region_count,
-			     cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
+	ulmk_thread_mpu_switch(cur, cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
 }
 
 uint32_t ulmk_kern_trap_syscall(uint8_t tin, uint32_t args[4])
 {
+	ulmk_irqoff_open(ULMK_IRQOFF_SITE_SYSCALL(tin));
 #if ULMK_CONFIG_SYSCALL_WCET
 	uint32_t begin;
 	uint32_t end;
@@ -160,6 +197,7 @@ uint32_t ulmk_kern_trap_syscall(uint8_t tin, uint32_t args[4])
 			out->delta   = wall - blocked;
 			out->seq++;
 		}
+		ulmk_syscall_wcet_record(tin, wall - blocked);
 	}
 	return ret;
 #else
@@ -180,6 +218,7 @@ void ulmk_kern_trap_recoverable(void)
 	if (cur) {
 		ulmk_printk("TRAP: killing thread tid=%u\n",
 			  (unsigned)cur->tid);
+		ulmk_printk_flush();
 		cur->state = UL_THREAD_STATE_DEAD;
 		ulmk_sched_dequeue(cur);
 		ulmk_sched_set_dead_for_cleanup(cur);
@@ -193,6 +232,7 @@ void ulmk_kern_trap_recoverable(void)
 void ulmk_kern_trap_panic(void)
 {
 	ulmk_printk("KERNEL PANIC: unrecoverable trap\n");
+	ulmk_printk_flush();
 	for (;;)
 		;
 }
@@ -211,6 +251,8 @@ static void idle_thread_entry(void *arg)
 		 * arrives and sleepers park forever.
 		 */
 		ulmk_arch_cpu_irq_enable();
+		/* Buffered printk reaches the console only from here. */
+		ulmk_printk_flush();
 		ulmk_arch_cpu_idle();
 	}
 }
@@ -249,7 +291,7 @@ void ulmk_kern_secondary_main(void)
 	uint32_t cpu = ulmk_arch_cpu_id();
 
 	ulmk_printk("ulmk: CPU%u secondary entry\n", (unsigned)cpu);
-#if ULMK_CONFIG_SYSCALL_WCET
+#if UL_CYCLE_COUNTER
 	/* CCNT/DWT is per-core — primary enable does not cover this CPU. */
 	ulmk_arch_cycle_enable();
 #endif
@@ -297,6 +339,11 @@ void ulmk_kern_main(const ulmk_boot_info_t *info)
 	ulmk_irq_table_init();
 	UL_LOG_DBG("irq table init done");
 
+#if UL_CYCLE_COUNTER && !ULMK_CONFIG_SYSCALL_WCET
+	ulmk_arch_cycle_enable();	/* trace / thread stats timestamps */
+#endif
+	ulmk_trace_init();
+
 #if ULMK_CONFIG_SYSCALL_WCET
 	ulmk_arch_cycle_enable();
 	for (cpu = 0u; cpu < ULMK_SYSCALL_WCET_MAX_CPUS; cpu++) {
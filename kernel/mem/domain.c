@@ -0,0 +1,134 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Copyright (c) 2024-2026 Felipe Neves
+ *
+ * Shared protection domains — kernel/mem/domain.c
+ * Reference: docs/api_spec.md §9
+ *
+ * Object lifetime only: region inserts and grants go through the table
+ * helpers in kernel/mem/mem.c, which pick the domain table for members.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <ulmk/microkernel.h>
+#include <kernel/include/ulmk_domain_internal.h>
+#include <kernel/include/ulmk_mem_internal.h>
+#include <kernel/include/ulmk_klock.h>
+#include <kernel/syscall/syscall_router.h>
+#include <ulmk_arch.h>
+
+/*
+ * Release a domain nobody references any more.  Anonymous mappings made by
+ * members belong to the domain and go back to the heap with it; granted
+ * (SHARED) entries are owned elsewhere.
+ */
+static void domain_free(ulmk_domain_obj_t *d)
+{
+	uint8_t i;
+
+	for (i = 0u; i < d->region_count; i++) {
+		if (d->regions[i].type == ULMK_REGION_HEAP)
+			ulmk_heap_free((void *)d->regions[i].base);
+	}
+	ulmk_heap_free(d);
+}
+
+void ulmk_domain_obj_init(ulmk_domain_obj_t *d, ulmk_domain_t id)
+{
+	uint32_t i;
+
+	d->id           = id;
+	d->active       = true;
+	d->refs         = 0u;
+	d->region_count = 0u;
+	for (i = 0u; i < (uint32_t)ULMK_ARCH_NUM_CPU; i++)
+		d->stale[i] = 0u;
+}
+
+ulmk_domain_obj_t *ulmk_domain_by_id(ulmk_domain_t id)
+{
+	ulmk_domain_obj_t *d = (ulmk_domain_obj_t *)(uintptr_t)id;
+
+	if (!d || !d->active)
+		return NULL;
+	return d;
+}
+
+/*
+ * Make @th a member of domain @id.  Called once from spawn; the domain
+ * then outlives ulmk_domain_destroy() until its last member is freed.
+ */
+int ulmk_domain_attach(ulmk_thread_t *th, ulmk_domain_t id)
+{
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
+	ulmk_domain_obj_t  *d   = ulmk_domain_by_id(id);
+
+	if (!d || d->refs == UINT16_MAX) {
+		ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+		return ULMK_EINVAL;
+	}
+
+	d->refs++;
+	th->domain = d;
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+	return ULMK_OK;
+}
+
+void ulmk_domain_detach(ulmk_thread_t *th)
+{
+	ulmk_domain_obj_t  *d = th->domain;
+	ulmk_arch_irq_key_t key;
+	bool                release;
+
+	if (!d)
+		return;
+
+	key        = ulmk_klock_irqsave(&g_ulmk_lock_thread);
+	th->domain = NULL;
+	d->refs--;
+	release    = !d->active && d->refs == 0u;
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+
+	if (release)
+		domain_free(d);
+}
+
+/* =========================================================================
+ * Syscall handlers
+ * ========================================================================= */
+
+uint32_t ulmk_kern_domain_create(void)
+{
+	ulmk_domain_obj_t *d =
+		(ulmk_domain_obj_t *)ulmk_heap_alloc(sizeof(ulmk_domain_obj_t));
+
+	if (!d)
+		return (uint32_t)ULMK_DOMAIN_INVALID;
+	ulmk_domain_obj_init(d, (ulmk_domain_t)(uintptr_t)d);
+	return (uint32_t)(uintptr_t)d;
+}
+
+/*
+ * destroy — refuse new members; the table stays live for the threads that
+ * already joined and is freed by the last ulmk_domain_detach().
+ */
+uint32_t ulmk_kern_domain_destroy(uint32_t dom)
+{
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
+	ulmk_domain_obj_t  *d   = ulmk_domain_by_id((ulmk_domain_t)dom);
+	bool                release;
+
+	if (!d) {
+		ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+	}
+
+	d->active = false;
+	release   = d->refs == 0u;
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+
+	if (release)
+		domain_free(d);
+	return (uint32_t)ULMK_OK;
+}
@@ -15,51 +15,383 @@
 #include <kernel/include/ulmk_thread_internal.h>
 #include <kernel/include/ulmk_mem_internal.h>
 #include <kernel/include/ulmk_sched.h>
+#include <kernel/include/ulmk_domain_internal.h>
+#include <kernel/include/ulmk_klock.h>
+#include <kernel/include/ulmk_percpu.h>
+#include <kernel/include/ulmk_irq_internal.h>
 #include <ulmk_arch.h>
 
 /*
- * Add a region to a thread's MPU region list.
- * Returns ULMK_OK or ULMK_ENOSPC if the list is full.
+ * Add a region to an MPU region table.
+ * Returns ULMK_OK or ULMK_ENOSPC if the table is full.
  */
-static int thread_add_region(ulmk_thread_t *th, uintptr_t base, size_t size,
-			     uint32_t perms, uint8_t type)
+static int region_add(ulmk_arch_region_t *tab, uint8_t *count, uintptr_t base,
+		      size_t size, uint32_t perms, uint8_t type)
 {
 	ulmk_arch_region_t *r;
 
-	if (th->region_count >= ULMK_ARCH_MAX_REGIONS)
+	if (*count >= ULMK_ARCH_MAX_REGIONS)
 		return ULMK_ENOSPC;
 
-	r        = &th->regions[th->region_count];
+	r        = &tab[*count];
 	r->base  = base;
 	r->size  = size;
 	r->perms = perms;
 	r->type  = type;
-	th->region_count++;
+	(*count)++;
 	return ULMK_OK;
 }
 
 /*
- * Remove a region from @th that starts at @base.
+ * Remove the region that starts at @base from a table.
  * Returns ULMK_OK if found and removed, ULMK_EINVAL if not found.
+ * The removed entry's type is stored in *@type.
  */
-static int thread_remove_region(ulmk_thread_t *th, uintptr_t base)
+static int region_remove(ulmk_arch_region_t *tab, uint8_t *count,
+			 uintptr_t base, uint8_t *type)
 {
 	uint8_t i;
 	uint8_t last;
 
+	for (i = 0u; i < *count; i++) {
+		if (tab[i].base != base)
+			continue;
+
+		*type = tab[i].type;
+		last  = *count - 1u;
+		if (i != last)
+			tab[i] = tab[last];
+		(*count)--;
+		return ULMK_OK;
+	}
+
+	return ULMK_EINVAL;
+}
+
+#if UL_MPU_LAZY
+/*
+ * Lazy mapping — see UL_MPU_LAZY in ulmk_thread_internal.h.  regions[] holds
+ * the resident set the ports program on every switch; once it carries
+ * UL_MPU_LAZY_SLOTS dynamic entries, new maps go to the spill table and the
+ * first touch faults them in through ulmk_kern_trap_mpu_fault().  Domain
+ * tables stay bounded.  All helpers run under the thread lock.
+ */
+static uint8_t lazy_resident(const ulmk_thread_t *th)
+{
+	uint8_t n = 0u;
+	uint8_t i;
+
+	for (i = 0u; i < th->region_count; i++) {
+		if (th->regions[i].type != ULMK_REGION_STACK)
+			n++;
+	}
+	return n;
+}
+
+static int lazy_spill(ulmk_thread_t *th, uintptr_t base, size_t size,
+		      uint32_t perms, uint8_t type)
+{
+	ulmk_arch_region_t *tab;
+	ulmk_arch_region_t *r;
+	uint32_t            cap;
+	uint16_t            i;
+
+	if (th->lazy_count == th->lazy_cap) {
+		cap = th->lazy_cap ? 2u * th->lazy_cap : ULMK_ARCH_MAX_REGIONS;
+		if (cap > UINT16_MAX)
+			return ULMK_ENOSPC;
+		tab = (ulmk_arch_region_t *)ulmk_heap_alloc(cap * sizeof(*tab));
+		if (!tab)
+			return ULMK_ENOMEM;
+		for (i = 0u; i < th->lazy_count; i++)
+			tab[i] = th->lazy_regions[i];
+		if (th->lazy_regions)
+			ulmk_heap_free(th->lazy_regions);
+		th->lazy_regions = tab;
+		th->lazy_cap     = (uint16_t)cap;
+	}
+
+	r        = &th->lazy_regions[th->lazy_count++];
+	r->base  = base;
+	r->size  = size;
+	r->perms = perms;
+	r->type  = type;
+	return ULMK_OK;
+}
+
+static int lazy_add(ulmk_thread_t *th, uintptr_t base, size_t size,
+		    uint32_t perms, uint8_t type)
+{
+	int rc;
+
+	if (type != ULMK_REGION_STACK &&
+	    (lazy_resident(th) >= UL_MPU_LAZY_SLOTS ||
+	     th->region_count >= ULMK_ARCH_MAX_REGIONS))
+		return lazy_spill(th, base, size, perms, type);
+
+	rc = region_add(th->regions, &th->region_count, base, size, perms, type);
+	if (rc == ULMK_OK)
+		th->lazy_stamp[th->region_count - 1u] = ++th->lazy_clock;
+	return rc;
+}
+
+/*
+ * Unlike region_remove() this keeps lazy_stamp[] in step with regions[].
+ * A freed resident slot is not refilled here: the caller's switch sees the
+ * lower count and reprograms, and spilled entries come back on fault.
+ */
+static int lazy_remove(ulmk_thread_t *th, uintptr_t base, uint8_t *type)
+{
+	uint8_t  i;
+	uint8_t  last;
+	uint16_t j;
+
 	for (i = 0u; i < th->region_count; i++) {
 		if (th->regions[i].base != base)
 			continue;
 
-		last = th->region_count - 1u;
-		if (i != last)
-			th->regions[i] = th->regions[last];
+		*type = th->regions[i].type;
+		last  = th->region_count - 1u;
+		if (i != last) {
+			th->regions[i]    = th->regions[last];
+			th->lazy_stamp[i] = th->lazy_stamp[last];
+		}
 		th->region_count--;
 		return ULMK_OK;
 	}
 
+	for (j = 0u; j < th->lazy_count; j++) {
+		if (th->lazy_regions[j].base != base)
+			continue;
+
+		*type = th->lazy_regions[j].type;
+		th->lazy_regions[j] = th->lazy_regions[--th->lazy_count];
+		return ULMK_OK;
+	}
+
 	return ULMK_EINVAL;
 }
+#endif /* UL_MPU_LAZY */
+
+/*
+ * Thread-level wrappers: a member of a shared domain maps into the domain
+ * table, so one insert covers every sibling.  Tables may be edited from
+ * another CPU (grants, siblings), hence the thread lock.
+ */
+static int thread_add_region(ulmk_thread_t *th, uintptr_t base, size_t size,
+			     uint32_t perms, uint8_t type)
+{
+	ulmk_domain_obj_t  *d = th->domain;
+	ulmk_arch_irq_key_t key;
+	int                 rc;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
+	if (d)
+		rc = region_add(d->regions, &d->region_count,
+				base, size, perms, type);
+	else
+#if UL_MPU_LAZY
+		rc = lazy_add(th, base, size, perms, type);
+#else
+		rc = region_add(th->regions, &th->region_count,
+				base, size, perms, type);
+#endif
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+	return rc;
+}
+
+static int thread_remove_region(ulmk_thread_t *th, uintptr_t base,
+				uint8_t *type)
+{
+	ulmk_domain_obj_t  *d = th->domain;
+	ulmk_arch_irq_key_t key;
+	uint32_t            cpu;
+	int                 rc;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
+	if (d) {
+		rc = region_remove(d->regions, &d->region_count, base, type);
+		for (cpu = 0u; rc == ULMK_OK && cpu < ULMK_ARCH_NUM_CPU; cpu++) {
+			if (cpu != ulmk_arch_cpu_id())
+				d->stale[cpu] = 1u;
+		}
+	} else {
+#if UL_MPU_LAZY
+		rc = lazy_remove(th, base, type);
+#else
+		rc = region_remove(th->regions, &th->region_count, base, type);
+#endif
+#if ULMK_CONFIG_ENABLE_SMP
+		if (rc == ULMK_OK && th->cpu != ulmk_arch_cpu_id())
+			th->mpu_stale = 1u;
+#endif
+	}
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+	return rc;
+}
+
+#if ULMK_CONFIG_ENABLE_SMP
+/* True while @cpu runs a member of @d on a copy of d's table older than now. */
+static bool domain_cpu_stale(ulmk_domain_obj_t *d, uint32_t cpu)
+{
+	ulmk_thread_t *const volatile *cur = &ulmk_percpu_of(cpu)->current;
+	ulmk_thread_t *t = *cur;
+
+	return d->stale[cpu] && t && t->domain == d;
+}
+
+/*
+ * Before a block dropped from @d goes back to the heap, make every other
+ * CPU still running a member on the old table reload it: kick those CPUs
+ * (the IPI's trap exit reprograms a stale view) and wait until each has
+ * reloaded or switched away.  A peer doing the same for @d waits on this
+ * CPU in turn, so the loop reloads our own copy when it goes stale.
+ */
+static void domain_mpu_shootdown(ulmk_thread_t *cur, ulmk_domain_obj_t *d)
+{
+	uint32_t self = ulmk_arch_cpu_id();
+	uint32_t wait = 0u;
+	uint32_t cpu;
+
+	for (cpu = 0u; cpu < (uint32_t)ULMK_NR_CPUS; cpu++) {
+		if (cpu != self && domain_cpu_stale(d, cpu))
+			wait |= 1u << cpu;
+	}
+	if (!wait)
+		return;
+
+	ulmk_percpu()->ipi_pending |= wait;
+	ulmk_sched_kick_pending();
+	while (wait) {
+		if (d->stale[self])
+			ulmk_thread_mpu_switch(cur, cur->privilege ==
+						    ULMK_PRIV_KERNEL ? 0u : 1u);
+		for (cpu = 0u; cpu < (uint32_t)ULMK_NR_CPUS; cpu++) {
+			if ((wait & (1u << cpu)) && !domain_cpu_stale(d, cpu))
+				wait &= ~(1u << cpu);
+		}
+	}
+}
+
+/*
+ * Same for an entry dropped from @th's own table: @th only runs on its
+ * affinity CPU, so kick that one if it is still running @th on the old
+ * table and wait until it reloads or switches away.
+ */
+static void thread_mpu_shootdown(ulmk_thread_t *cur, ulmk_thread_t *th)
+{
+	ulmk_thread_t *const volatile *run = &ulmk_percpu_of(th->cpu)->current;
+	uint32_t self = ulmk_arch_cpu_id();
+
+	if (th->cpu == self || !th->mpu_stale || *run != th)
+		return;
+
+	ulmk_percpu()->ipi_pending |= 1u << th->cpu;
+	ulmk_sched_kick_pending();
+	while (th->mpu_stale && *run == th) {
+		if (cur->domain && cur->domain->stale[self])
+			ulmk_thread_mpu_switch(cur, cur->privilege ==
+						    ULMK_PRIV_KERNEL ? 0u : 1u);
+	}
+}
+#endif
+
+/* Copy the entry of @th's MPU view that starts at @base into *@out. */
+static bool thread_find_region(ulmk_thread_t *th, uintptr_t base,
+			       ulmk_arch_region_t *out)
+{
+	const ulmk_arch_region_t *tab;
+	ulmk_arch_irq_key_t       key;
+	uint8_t                   count;
+	uint8_t                   i;
+#if UL_MPU_LAZY
+	uint16_t                  j;
+#endif
+	bool                      found = false;
+
+	key   = ulmk_klock_irqsave(&g_ulmk_lock_thread);
+	tab   = ulmk_thread_mpu_regions(th);
+	count = ulmk_thread_mpu_count(th);
+	for (i = 0u; i < count; i++) {
+		if (tab[i].base == base) {
+			*out  = tab[i];
+			found = true;
+			break;
+		}
+	}
+#if UL_MPU_LAZY
+	for (j = 0u; !found && !th->domain && j < th->lazy_count; j++) {
+		if (th->lazy_regions[j].base == base) {
+			*out  = th->lazy_regions[j];
+			found = true;
+		}
+	}
+#endif
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+	return found;
+}
+
+/*
+ * ulmk_kern_trap_mpu_fault — called by the port for a user-mode MPU/PMP
+ * fault at @addr before the thread is killed.  When @addr lies in a spilled
+ * region of the current thread, load it into regions[] — into a free
+ * resident slot, else over the entry loaded longest ago, which moves to the
+ * spill table — and return true; the port then restores the MPU through
+ * ulmk_kern_trap_mpu_restore() and retries the access.
+ */
+bool ulmk_kern_trap_mpu_fault(uintptr_t addr)
+{
+#if UL_MPU_LAZY
+	ulmk_thread_t      *th = ulmk_sched_current();
+	ulmk_arch_region_t  r;
+	ulmk_arch_irq_key_t key;
+	uint32_t            cpu;
+	uint16_t            j;
+	uint8_t             victim = ULMK_ARCH_MAX_REGIONS;
+	uint8_t             i;
+
+	/* An attach callback runs on the interrupted thread's TCB. */
+	if (!th || th->domain || ulmk_irq_in_attach())
+		return false;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
+	for (j = 0u; j < th->lazy_count; j++) {
+		r = th->lazy_regions[j];
+		if (addr >= r.base && addr - r.base < r.size)
+			break;
+	}
+	if (j == th->lazy_count) {
+		ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+		return false;
+	}
+
+	if (lazy_resident(th) < UL_MPU_LAZY_SLOTS &&
+	    th->region_count < ULMK_ARCH_MAX_REGIONS) {
+		victim = th->region_count++;
+		th->lazy_regions[j] = th->lazy_regions[--th->lazy_count];
+	} else {
+		for (i = 0u; i < th->region_count; i++) {
+			if (th->regions[i].type == ULMK_REGION_STACK)
+				continue;
+			if (victim == ULMK_ARCH_MAX_REGIONS ||
+			    (int32_t)(th->lazy_stamp[i] -
+				      th->lazy_stamp[victim]) < 0)
+				victim = i;
+		}
+		th->lazy_regions[j] = th->regions[victim];
+	}
+	th->regions[victim]    = r;
+	th->lazy_stamp[victim] = ++th->lazy_clock;
+	for (cpu = 0u; cpu < ULMK_ARCH_NUM_CPU; cpu++)
+		th->lazy_stale[cpu] = 1u;
+	ulmk_percpu()->mpu_faults++;
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+	return true;
+#else
+	(void)addr;
+	return false;
+#endif
+}
 
 /*
  * Heap syscall handlers — expose TLSF heap to userspace.
@@ -111,8 +443,8 @@ uint32_t ulmk_kern_mem_map(uint32_t hint, uint32_t size,
 			return (uint32_t)(int32_t)rc;
 
 		/* Immediately apply the new region to PRS 1 DPRs. */
-		ulmk_arch_mpu_switch(cur->regions, cur->region_count,
-				     cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
+		ulmk_thread_mpu_switch(cur,
+				       cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
 		return (uint32_t)base;
 	}
 
@@ -129,8 +461,8 @@ uint32_t ulmk_kern_mem_map(uint32_t hint, uint32_t size,
 		}
 
 		/* Immediately apply the new region to PRS 1 DPRs. */
-		ulmk_arch_mpu_switch(cur->regions, cur->region_count,
-				     cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
+		ulmk_thread_mpu_switch(cur,
+				       cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
 		return (uint32_t)base;
 	}
 
@@ -140,80 +472,163 @@ uint32_t ulmk_kern_mem_map(uint32_t hint, uint32_t size,
 uint32_t ulmk_kern_mem_unmap(uint32_t addr, uint32_t size)
 {
 	ulmk_thread_t *cur = ulmk_sched_current();
-	ulmk_arch_region_t *r;
-	uint8_t i;
+	uint8_t        type;
 
 	if (!cur || addr == 0u)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
-	for (i = 0u; i < cur->region_count; i++) {
-		r = &cur->regions[i];
-		if ((uint32_t)r->base != addr)
-			continue;
-
-		if (r->type == ULMK_REGION_HEAP)
-			ulmk_heap_free((void *)(uintptr_t)addr);
+	if (thread_remove_region(cur, (uintptr_t)addr, &type) != ULMK_OK)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
 
-		thread_remove_region(cur, (uintptr_t)addr);
-		ulmk_arch_mpu_switch(cur->regions, cur->region_count,
-				     cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
-		(void)size;
-		return (uint32_t)ULMK_OK;
+	if (type == ULMK_REGION_HEAP) {
+#if ULMK_CONFIG_ENABLE_SMP
+		if (cur->domain)
+			domain_mpu_shootdown(cur, cur->domain);
+#endif
+		ulmk_heap_free((void *)(uintptr_t)addr);
 	}
 
-	return (uint32_t)(int32_t)ULMK_EINVAL;
+	ulmk_thread_mpu_switch(cur, cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
+	(void)size;
+	return (uint32_t)ULMK_OK;
 }
 
 uint32_t ulmk_kern_mem_grant(uint32_t addr, uint32_t size,
 			   uint32_t target_tid, uint32_t perms)
 {
-	ulmk_thread_t *target;
-	ulmk_thread_t *cur = ulmk_sched_current();
-	ulmk_arch_region_t *r;
-	uint8_t i;
-	int     rc;
+	ulmk_thread_t     *target;
+	ulmk_thread_t     *cur = ulmk_sched_current();
+	ulmk_arch_region_t r;
+	int                rc;
 
 	if (!cur || addr == 0u || size == 0u)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
 	/* Verify caller owns the region being granted */
-	for (i = 0u; i < cur->region_count; i++) {
-		if ((uint32_t)cur->regions[i].base == addr)
-			break;
-	}
-	if (i >= cur->region_count)
+	if (!thread_find_region(cur, (uintptr_t)addr, &r))
 		return (uint32_t)(int32_t)ULMK_EPERM;
 
-	r      = &cur->regions[i];
 	target = ulmk_thread_by_tid((ulmk_tid_t)target_tid);
 	if (!target)
 		return (uint32_t)(int32_t)ULMK_ESRCH;
 
+	/* Same domain: the target already maps the caller's table. */
+	if (target->domain && target->domain == cur->domain)
+		return (uint32_t)ULMK_OK;
+
 	/* Grant read-only by default; caller may not grant more perms than held */
-	uint32_t granted_perms = perms & r->perms;
+	uint32_t granted_perms = perms & r.perms;
 
-	rc = thread_add_region(target, (uintptr_t)addr, r->size,
+	rc = thread_add_region(target, (uintptr_t)addr, r.size,
 			       granted_perms, ULMK_REGION_SHARED);
 	return (rc == ULMK_OK) ? (uint32_t)ULMK_OK : (uint32_t)(int32_t)rc;
 }
 
+int ulmk_mem_publish(ulmk_thread_t *th, uintptr_t base, size_t size)
+{
+	int rc = thread_add_region(th, base, size, ULMK_PERM_READ,
+				   ULMK_REGION_SHARED);
+
+	if (rc == ULMK_OK && th == ulmk_sched_current())
+		ulmk_thread_mpu_switch(th,
+				       th->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
+	return rc;
+}
+
 /*
- * ulmk_kern_heap_extend — allocate an additional slab from user_pool and
- * add it as a new MPU DPR for the calling thread.
+ * Drop a published entry.  On return no CPU still runs @th (or a member of
+ * its domain) with @base mapped, so the caller may free the memory.
+ */
+void ulmk_mem_unpublish(ulmk_thread_t *th, uintptr_t base)
+{
+	ulmk_thread_t *cur = ulmk_sched_current();
+	uint8_t        type;
+
+	if (thread_remove_region(th, base, &type) != ULMK_OK)
+		return;
+#if ULMK_CONFIG_ENABLE_SMP
+	if (th->domain)
+		domain_mpu_shootdown(cur, th->domain);
+	else
+		thread_mpu_shootdown(cur, th);
+#endif
+	if (th == cur)
+		ulmk_thread_mpu_switch(th,
+				       th->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
+}
+
+/*
+ * ulmk_kern_domain_grant — share a region the caller owns with every member
+ * of domain @dom in one insert.  Members pick it up at their next dispatch;
+ * a caller inside @dom already has it.
+ */
+uint32_t ulmk_kern_domain_grant(uint32_t dom, uint32_t addr, uint32_t size,
+				uint32_t perms)
+{
+	ulmk_thread_t      *cur = ulmk_sched_current();
+	ulmk_domain_obj_t  *d;
+	ulmk_arch_region_t  r;
+	ulmk_arch_irq_key_t key;
+	int                 rc;
+
+	if (!cur || addr == 0u || size == 0u)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	if (!thread_find_region(cur, (uintptr_t)addr, &r))
+		return (uint32_t)(int32_t)ULMK_EPERM;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
+	d   = ulmk_domain_by_id((ulmk_domain_t)dom);
+	if (!d)
+		rc = ULMK_EINVAL;
+	else if (d == cur->domain)
+		rc = ULMK_OK;
+	else
+		rc = region_add(d->regions, &d->region_count, (uintptr_t)addr,
+				r.size, perms & r.perms, ULMK_REGION_SHARED);
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
+	return (rc == ULMK_OK) ? (uint32_t)ULMK_OK : (uint32_t)(int32_t)rc;
+}
+
+/*
+ * ulmk_kern_heap_extend — grow the calling thread's heap by @size bytes.
+ *
+ * First try to grow the slabAO in place: the heap sits at the tail of the
+ * slab, so absorbing the physically-next free TLSF block extends it without
+ * copying and without consuming an MPU region (regions[0] already covers
+ * the slab; only its size changes).  Only when the neighbour is in use do we
+ * fall back to a separate allocation covered by an extra ULMK_REGION_HEAP.
+ *
+ * If @info_ptr is non-zero it receives the range that was added: contiguous
+ * with the previous heap end for in-place growth, or a new base otherwise.
  * Requires the thread to already have a heap (attr.heap_size > 0).
  * Requires ULMK_PRIV_DRIVER (enforced by the syscall router).
  */
-uint32_t ulmk_kern_heap_extend(uint32_t size)
+uint32_t ulmk_kern_heap_extend(uint32_t size, uint32_t info_ptr)
 {
-	ulmk_thread_t *cur = ulmk_sched_current();
-	void          *mem;
-	int            rc;
+	ulmk_thread_t    *cur  = ulmk_sched_current();
+	ulmk_heap_info_t *info = (ulmk_heap_info_t *)(uintptr_t)info_ptr;
+	uintptr_t         added;
+	void             *mem;
+	int               rc;
 
 	if (!cur || size == 0u)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
-	if (cur->heap_size == 0u)
+	if (cur->heap_size == 0u || !cur->slab_base)
 		return (uint32_t)(int32_t)ULMK_EPERM;
 
+	size = (size + ULMK_ARCH_REGION_ALIGN - 1u) &
+	       ~((uint32_t)ULMK_ARCH_REGION_ALIGN - 1u);
+
+	if (ulmk_heap_grow(cur->slab_base, cur->slab_size + size) != 0u) {
+		added          = cur->heap_base + cur->heap_size;
+		cur->slab_size += size;
+		cur->heap_size += size;
+		if (cur->privilege != ULMK_PRIV_KERNEL)
+			cur->regions[0].size = cur->slab_size;
+		goto done;
+	}
+
 	mem = ulmk_heap_alloc((size_t)size);
 	if (!mem)
 		return (uint32_t)(int32_t)ULMK_ENOMEM;
@@ -225,8 +640,26 @@ uint32_t ulmk_kern_heap_extend(uint32_t size)
 		ulmk_heap_free(mem);
 		return (uint32_t)(int32_t)rc;
 	}
+	added = (uintptr_t)mem;
+
+done:
+	ulmk_thread_mpu_switch(cur, cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
+	if (info) {
+		info->base = added;
+		info->size = size;
+	}
+	return (uint32_t)ULMK_OK;
+}
+
+uint32_t ulmk_kern_mpu_stats(uint32_t cpu, uint32_t out_ptr)
+{
+	ulmk_mpu_stats_t *out = (ulmk_mpu_stats_t *)(uintptr_t)out_ptr;
+
+	if (!out || cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
 
-	ulmk_arch_mpu_switch(cur->regions, cur->region_count,
-			     cur->privilege == ULMK_PRIV_KERNEL ? 0u : 1u);
+	ulmk_arch_mpu_stats(cpu, out);
+	out->faults = cpu < (uint32_t)ULMK_NR_CPUS ?
+		      ulmk_percpu_of(cpu)->mpu_faults : 0u;
 	return (uint32_t)ULMK_OK;
 }
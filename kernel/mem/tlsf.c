@@ -4,7 +4,7 @@
  *
  * Minimal TLSF (Two-Level Segregated Fit) heap — kernel/mem/tlsf.c
  *
- * O(1) alloc/free.  Supports pools up to ~1 GB.  Every allocation is
+ * O(1) alloc/free/grow.  Supports pools up to ~1 GB.  Every allocation is
  * aligned to TLSF_HDR (64 bytes = ULMK_ARCH_REGION_ALIGN) so it can be
  * used as an MPU region without re-alignment.
  *
@@ -241,12 +241,12 @@ void *ulmk_heap_alloc(size_t size)
 	if (size == 0u)
 		return NULL;
 
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_mem);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_mem);
 	rounded = (uint32_t)(((size + TLSF_HDR - 1u) / TLSF_HDR) * TLSF_HDR);
 
 	blk = find_free_block(rounded);
 	if (!blk) {
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_mem, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_mem, key);
 		return NULL;
 	}
 
@@ -271,7 +271,7 @@ void *ulmk_heap_alloc(size_t size)
 	}
 
 	ret = (uint8_t *)blk + TLSF_HDR;
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_mem, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_mem, key);
 	return ret;
 }
 
@@ -285,7 +285,7 @@ void ulmk_heap_free(void *ptr)
 	if (!ptr)
 		return;
 
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_mem);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_mem);
 	blk = (blk_t *)((uint8_t *)ptr - TLSF_HDR);
 
 	/* Coalesce forward. */
@@ -310,7 +310,77 @@ void ulmk_heap_free(void *ptr)
 	}
 
 	insert_free(blk);
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_mem, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_mem, key);
+}
+
+/*
+ * In-place growth.  Extend the allocated block at @ptr so its payload holds
+ * at least @size bytes by absorbing the physically-next block, which must be
+ * free.  Any tail large enough to stand alone is split back onto the free
+ * lists.  The block never moves, so the payload contents and any MPU region
+ * based at @ptr stay valid.
+ *
+ * Returns the new payload size (≥ @size), or 0 if the neighbour is in use,
+ * is the sentinel, or is too small.
+ */
+size_t ulmk_heap_grow(void *ptr, size_t size)
+{
+	ulmk_arch_irq_key_t key;
+	uint32_t  rounded;
+	uint32_t  avail;
+	blk_t    *blk;
+	blk_t    *nxt;
+	blk_t    *after;
+	blk_t    *rem;
+	size_t    ret;
+
+	if (!ptr || size == 0u)
+		return 0u;
+
+	key = ulmk_klock_irqsave(&g_ulmk_lock_mem);
+	blk     = (blk_t *)((uint8_t *)ptr - TLSF_HDR);
+	rounded = (uint32_t)(((size + TLSF_HDR - 1u) / TLSF_HDR) * TLSF_HDR);
+
+	/* Split slack left over from the original allocation may already do. */
+	if (blk->size >= rounded) {
+		ret = blk->size;
+		ulmk_klock_irqrestore(&g_ulmk_lock_mem, key);
+		return ret;
+	}
+
+	nxt = blk_next(blk);
+	if (nxt->size == 0u || !(nxt->flags & BLKF_FREE)) {
+		ulmk_klock_irqrestore(&g_ulmk_lock_mem, key);
+		return 0u;
+	}
+
+	avail = blk->size + TLSF_HDR + nxt->size;
+	if (avail < rounded) {
+		ulmk_klock_irqrestore(&g_ulmk_lock_mem, key);
+		return 0u;
+	}
+
+	remove_free(nxt);
+	after = blk_next(nxt);
+
+	if (avail >= rounded + 2u * TLSF_HDR) {
+		rem             = (blk_t *)((uint8_t *)blk + TLSF_HDR + rounded);
+		rem->prev_phys  = blk;
+		rem->size       = avail - rounded - TLSF_HDR;
+		rem->flags      = 0u;
+		rem->next_free  = NULL;
+		rem->prev_free  = NULL;
+		after->prev_phys = rem;
+		blk->size       = rounded;
+		insert_free(rem);
+	} else {
+		blk->size        = avail;
+		after->prev_phys = blk;
+	}
+
+	ret = blk->size;
+	ulmk_klock_irqrestore(&g_ulmk_lock_mem, key);
+	return ret;
 }
 
 /*
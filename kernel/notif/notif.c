@@ -14,8 +14,10 @@
 #include <ulmk/microkernel.h>
 #include <kernel/include/ulmk_notif_internal.h>
 #include <kernel/include/ulmk_ep_internal.h>
+#include <kernel/include/ulmk_waitset_internal.h>
 #include <kernel/include/ulmk_sched.h>
 #include <kernel/include/ulmk_timeout_internal.h>
+#include <kernel/include/ulmk_trace.h>
 #ifndef UL_UNIT_TEST
 #include <kernel/include/ulmk_klock.h>
 #endif
@@ -29,27 +31,25 @@
 
 #ifdef UL_UNIT_TEST
 ulmk_notif_obj_t notif_pool[ULMK_CONFIG_MAX_NOTIFS];
+volatile uint32_t notif_word_pool[ULMK_CONFIG_MAX_NOTIFS];
 #endif
 
 static void notif_wait_timeout_cb(struct ulmk_timeout *to)
 {
 	ulmk_thread_t *th =
 		SYS_DLIST_CONTAINER_OF(to, ulmk_thread_t, timeout);
-	ulmk_notif_obj_t *n;
 #ifndef UL_UNIT_TEST
 	ulmk_arch_irq_key_t key;
 #endif
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 	if (!th || th->state != UL_THREAD_STATE_BLOCKED ||
 	    th->blocked_reason != UL_BLOCKED_NOTIF)
 		goto out;
 
-	n = ulmk_notif_by_id(th->blocked_notif);
-	if (n && n->waiter == th)
-		n->waiter = NULL;
+	ulmk_notif_waiter_remove(th);
 
 	th->blocked_notif  = ULMK_NOTIF_INVALID;
 	th->block_status   = ULMK_ETIMEOUT;
@@ -59,7 +59,7 @@ static void notif_wait_timeout_cb(struct ulmk_timeout *to)
 
 out:
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 	ulmk_sched_kick_pending();
 #endif
 }
@@ -69,8 +69,10 @@ int ulmk_notif_obj_init(ulmk_notif_obj_t *n, ulmk_notif_t id)
 	n->id        = id;
 	n->active    = true;
 	n->bits      = 0;
-	n->waiter    = NULL;
-	n->wait_mask = 0;
+	n->ws_src    = NULL;
+	n->word      = NULL;
+	n->word_owner = ULMK_TID_INVALID;
+	sys_dlist_init(&n->waiters);
 	return 0;
 }
 
@@ -95,94 +97,152 @@ ulmk_notif_obj_t *ulmk_notif_by_id(ulmk_notif_t id)
  * Core implementation (_impl — native pointer types)
  * ========================================================================= */
 
-int notif_signal_impl(ulmk_notif_t notif_id, uint32_t bits)
+/*
+ * Hand @delivered to blocked waiter @w and move it onto @wake, chained
+ * through its idle sched_node, for the caller's batched RQ insert.
+ */
+static void notif_wake_waiter(ulmk_thread_t *w, uint32_t delivered,
+			      sys_dlist_t *wake)
+{
+	UL_TRACE(ULMK_TRACE_NOTIF_WAKE, w->tid, delivered);
+	UL_THREAD_STAT_INC(w, notif_wakes);
+	ulmk_notif_waiter_remove(w);
+	w->notif_received = delivered;
+	w->blocked_notif  = ULMK_NOTIF_INVALID;
+	if (w->timeout.cb)
+		ulmk_timeout_disarm(w);
+
+	if (w->blocked_reason == UL_BLOCKED_IPC_OR_NOTIF) {
+		ulmk_recv_or_notif_result_t *rn = w->rn_result_outptr;
+
+		ulmk_ep_recv_queue_remove(w);
+		if (rn) {
+			rn->is_notif   = 1;
+			rn->notif_bits = delivered;
+			rn->sender     = ULMK_TID_INVALID;
+			w->rn_result_outptr = NULL;
+		}
+		w->syscall_wake_ret       = 1;
+		w->syscall_wake_ret_valid = 1;
+	} else if (w->notif_bits_outptr) {
+		*w->notif_bits_outptr = delivered;
+		w->notif_bits_outptr  = NULL;
+	}
+
+	w->blocked_reason = UL_BLOCKED_NONE;
+	w->state          = UL_THREAD_STATE_READY;
+	sys_dlist_append(wake, &w->sched_node);
+}
+
+/*
+ * OR @bits into @notif_id and walk the wait queue in FIFO order.
+ *
+ * Wake-one (broadcast == false): each pending bit goes to the first waiter
+ * whose mask covers it and is consumed there, so a bit wakes at most one
+ * thread.  Broadcast: every waiter whose mask intersects the pending bits
+ * receives (bits & mask); bits that reached anyone are consumed after the
+ * walk, the rest stay pending.
+ */
+static int notif_signal_mode(ulmk_notif_t notif_id, uint32_t bits,
+			     bool broadcast)
 {
 	ulmk_notif_obj_t *n;
 	ulmk_thread_t    *w;
+	ulmk_thread_t    *next;
+	sys_dlist_t       wake;
 	uint32_t          delivered;
+	uint32_t          consumed = 0u;
 #ifndef UL_UNIT_TEST
-	ulmk_arch_irq_key_t key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 
 	n = ulmk_notif_by_id(notif_id);
 	if (!n) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
 
 	n->bits |= bits;
+	UL_TRACE(ULMK_TRACE_NOTIF_SIGNAL, notif_id, bits);
 
-	w = n->waiter;
-	if (!w || w->state != UL_THREAD_STATE_BLOCKED) {
+	/* Nobody to wake: publish and skip the walk and the IPI flush. */
+	if (sys_dlist_is_empty(&n->waiters) && !n->ws_src) {
+		ulmk_notif_publish(n);
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return 0;
 	}
 
-	delivered = n->bits & w->notif_wait_mask;
-	if (!delivered) {
-#ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
-#endif
-		return 0;
-	}
+	sys_dlist_init(&wake);
 
-	n->bits          &= ~delivered;
-	n->waiter         = NULL;
-	w->notif_received = delivered;
-	if (w->timeout.cb)
-		ulmk_timeout_disarm(w);
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&n->waiters, w, next, notif_node) {
+		if (!n->bits)
+			break;
+		if (w->state != UL_THREAD_STATE_BLOCKED)
+			continue;
 
-	if (w->blocked_reason == UL_BLOCKED_IPC_OR_NOTIF) {
-		ulmk_recv_or_notif_result_t *rn = w->rn_result_outptr;
+		delivered = n->bits & w->notif_wait_mask;
+		if (!delivered)
+			continue;
 
-		ulmk_ep_recv_queue_remove(w);
-		w->blocked_notif = ULMK_NOTIF_INVALID;
-		if (rn) {
-			rn->is_notif   = 1;
-			rn->notif_bits = delivered;
-			rn->sender     = ULMK_TID_INVALID;
-			w->rn_result_outptr = NULL;
-		}
-		w->syscall_wake_ret       = 1;
-		w->syscall_wake_ret_valid = 1;
-	} else if (w->notif_bits_outptr) {
-		*w->notif_bits_outptr = delivered;
-		w->notif_bits_outptr  = NULL;
+		if (broadcast)
+			consumed |= delivered;
+		else
+			n->bits &= ~delivered;
+		notif_wake_waiter(w, delivered, &wake);
+	}
+	n->bits &= ~consumed;
+	ulmk_notif_publish(n);
+
+	/* Whatever direct waiters left over may satisfy the wait set. */
+	if (n->ws_src && (n->bits & n->ws_src->mask)) {
+		w = ulmk_waitset_source_ready(n->ws_src);
+		if (w)
+			sys_dlist_append(&wake, &w->sched_node);
 	}
 
-	w->blocked_reason = UL_BLOCKED_NONE;
-	w->state          = UL_THREAD_STATE_READY;
 	/*
 	 * Enqueue under IPC so an ISR signal cannot race a wait that still
 	 * holds the lock between unlock and RQ insert (lost wake / stuck
 	 * flood in silicon_irq_stress).  ep_reply uses unlock-first because
-	 * it can deadlock with call's IPC→RQ order across CPUs.
+	 * it can deadlock with call's IPC→RQ order across CPUs.  The whole
+	 * batch costs one RQ lock round trip.
 	 */
-	ulmk_sched_enqueue_locked(w);
+	if (!sys_dlist_is_empty(&wake))
+		ulmk_sched_enqueue_list(&wake);
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 	ulmk_sched_kick_pending();
 #endif
 	return 0;
 }
 
+int notif_signal_impl(ulmk_notif_t notif_id, uint32_t bits)
+{
+	return notif_signal_mode(notif_id, bits, false);
+}
+
+int notif_broadcast_impl(ulmk_notif_t notif_id, uint32_t bits)
+{
+	return notif_signal_mode(notif_id, bits, true);
+}
+
 int notif_wait_impl(ulmk_notif_t notif_id, uint32_t mask, uint32_t *out)
 {
 	ulmk_notif_obj_t *n;
 	ulmk_thread_t    *cur;
 	uint32_t          matched;
 #ifndef UL_UNIT_TEST
-	ulmk_arch_irq_key_t key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 
 	n = ulmk_notif_by_id(notif_id);
 	if (!n || !out) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -190,9 +250,10 @@ int notif_wait_impl(ulmk_notif_t notif_id, uint32_t mask, uint32_t *out)
 	matched = n->bits & mask;
 	if (matched) {
 		n->bits &= ~matched;
+		ulmk_notif_publish(n);
 		*out = matched;
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return 0;
 	}
@@ -200,7 +261,7 @@ int notif_wait_impl(ulmk_notif_t notif_id, uint32_t mask, uint32_t *out)
 	cur = ulmk_sched_current();
 	if (!cur) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -214,26 +275,26 @@ int notif_wait_impl(ulmk_notif_t notif_id, uint32_t mask, uint32_t *out)
 	cur->state = UL_THREAD_STATE_BLOCKED;
 	ulmk_sched_dequeue_locked(cur);
 
-	n->waiter    = cur;
-	n->wait_mask = mask;
+	sys_dlist_append(&n->waiters, &cur->notif_node);
 
 	matched = n->bits & mask;
 	if (matched) {
 		n->bits   &= ~matched;
-		n->waiter  = NULL;
+		ulmk_notif_publish(n);
+		ulmk_notif_waiter_remove(cur);
 		cur->state = UL_THREAD_STATE_READY;
 		cur->blocked_reason = UL_BLOCKED_NONE;
 		cur->blocked_notif  = ULMK_NOTIF_INVALID;
 		ulmk_sched_enqueue_locked(cur);
 		*out = matched;
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return 0;
 	}
 
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 	/* Wake writes *notif_bits_outptr; switch deferred to trap exit. */
 	return 0;
@@ -246,12 +307,12 @@ int notif_wait_timeout_impl(ulmk_notif_t notif_id, uint32_t mask,
 	ulmk_thread_t *cur;
 	uint32_t matched;
 #ifndef UL_UNIT_TEST
-	ulmk_arch_irq_key_t key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_ipc);
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_ipc);
 #endif
 
 	if (ulmk_ms_to_ticks(timeout_ms) == 0u) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -259,7 +320,7 @@ int notif_wait_timeout_impl(ulmk_notif_t notif_id, uint32_t mask,
 	n = ulmk_notif_by_id(notif_id);
 	if (!n || !out) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -267,9 +328,10 @@ int notif_wait_timeout_impl(ulmk_notif_t notif_id, uint32_t mask,
 	matched = n->bits & mask;
 	if (matched) {
 		n->bits &= ~matched;
+		ulmk_notif_publish(n);
 		*out = matched;
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return 0;
 	}
@@ -277,7 +339,7 @@ int notif_wait_timeout_impl(ulmk_notif_t notif_id, uint32_t mask,
 	cur = ulmk_sched_current();
 	if (!cur) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -293,7 +355,7 @@ int notif_wait_timeout_impl(ulmk_notif_t notif_id, uint32_t mask,
 		cur->blocked_notif     = ULMK_NOTIF_INVALID;
 		cur->notif_bits_outptr = NULL;
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 		return -ULMK_EINVAL;
 	}
@@ -301,13 +363,13 @@ int notif_wait_timeout_impl(ulmk_notif_t notif_id, uint32_t mask,
 	cur->state = UL_THREAD_STATE_BLOCKED;
 	ulmk_sched_dequeue_locked(cur);
 
-	n->waiter    = cur;
-	n->wait_mask = mask;
+	sys_dlist_append(&n->waiters, &cur->notif_node);
 
 	matched = n->bits & mask;
 	if (matched) {
 		n->bits   &= ~matched;
-		n->waiter  = NULL;
+		ulmk_notif_publish(n);
+		ulmk_notif_waiter_remove(cur);
 		ulmk_timeout_disarm(cur);
 		cur->state = UL_THREAD_STATE_READY;
 		cur->blocked_reason = UL_BLOCKED_NONE;
@@ -317,7 +379,7 @@ int notif_wait_timeout_impl(ulmk_notif_t notif_id, uint32_t mask,
 	}
 
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_ipc, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_ipc, key);
 #endif
 	return 0;
 }
@@ -332,6 +394,7 @@ uint32_t notif_poll_impl(ulmk_notif_t notif_id, uint32_t mask)
 
 	matched  = n->bits & mask;
 	n->bits &= ~matched;
+	ulmk_notif_publish(n);
 
 	return matched;
 }
@@ -340,13 +403,17 @@ int notif_destroy_impl(ulmk_notif_t notif_id)
 {
 	ulmk_notif_obj_t *n = ulmk_notif_by_id(notif_id);
 	ulmk_thread_t    *w;
+	sys_dnode_t      *dn;
+	sys_dlist_t       wake;
 
 	if (!n)
 		return -ULMK_EINVAL;
 
-	w = n->waiter;
-	n->waiter = NULL;
-	if (w) {
+	sys_dlist_init(&wake);
+	while ((dn = sys_dlist_get(&n->waiters)) != NULL) {
+		w = SYS_DLIST_CONTAINER_OF(dn, ulmk_thread_t, notif_node);
+		sys_dnode_init(&w->notif_node);
+
 		ulmk_timeout_disarm(w);
 		if (w->blocked_reason == UL_BLOCKED_IPC_OR_NOTIF)
 			ulmk_ep_recv_queue_remove(w);
@@ -356,9 +423,25 @@ int notif_destroy_impl(ulmk_notif_t notif_id)
 		w->block_status   = ULMK_EINVAL;
 		w->blocked_reason = UL_BLOCKED_NONE;
 		w->state          = UL_THREAD_STATE_READY;
-		ulmk_sched_enqueue(w);
+		sys_dlist_append(&wake, &w->sched_node);
+	}
+	if (!sys_dlist_is_empty(&wake))
+		ulmk_sched_enqueue_list(&wake);
+
+	if (n->ws_src) {
+		ulmk_waitset_source_detach(n->ws_src);
+		n->ws_src = NULL;
 	}
+	if (n->word) {
+#ifndef UL_UNIT_TEST
+		ulmk_thread_t *owner = ulmk_thread_by_tid(n->word_owner);
 
+		if (owner)
+			ulmk_mem_unpublish(owner, (uintptr_t)n->word);
+		ulmk_heap_free((void *)n->word);
+#endif
+		n->word = NULL;
+	}
 	n->active = false;
 #ifndef UL_UNIT_TEST
 	ulmk_heap_free(n);
@@ -392,16 +475,92 @@ uint32_t ulmk_kern_notif_create(void)
 #endif
 }
 
+/*
+ * create_shared — create() plus one MPU granule, mapped read-only into the
+ * caller, that mirrors the pending bits.  Its address goes to *@out.
+ */
+uint32_t notif_create_shared_impl(const volatile uint32_t **out)
+{
+	ulmk_notif_obj_t *n;
+	uint32_t          id;
+#ifndef UL_UNIT_TEST
+	ulmk_thread_t    *cur = ulmk_sched_current();
+	volatile uint32_t *word;
+#endif
+
+	if (!out)
+		return (uint32_t)ULMK_NOTIF_INVALID;
+
+#ifdef UL_UNIT_TEST
+	id = ulmk_kern_notif_create();
+	n  = ulmk_notif_by_id((ulmk_notif_t)id);
+	if (!n)
+		return id;
+	n->word  = &notif_word_pool[id];
+	*n->word = 0u;
+#else
+	if (!cur)
+		return (uint32_t)ULMK_NOTIF_INVALID;
+
+	word = (volatile uint32_t *)ulmk_heap_alloc(ULMK_ARCH_REGION_ALIGN);
+	if (!word)
+		return (uint32_t)ULMK_NOTIF_INVALID;
+	*word = 0u;
+
+	id = ulmk_kern_notif_create();
+	n  = ulmk_notif_by_id((ulmk_notif_t)id);
+	if (!n) {
+		ulmk_heap_free((void *)word);
+		return (uint32_t)ULMK_NOTIF_INVALID;
+	}
+	if (ulmk_mem_publish(cur, (uintptr_t)word,
+			     ULMK_ARCH_REGION_ALIGN) != ULMK_OK) {
+		(void)notif_destroy_impl((ulmk_notif_t)id);
+		ulmk_heap_free((void *)word);
+		return (uint32_t)ULMK_NOTIF_INVALID;
+	}
+	n->word_owner = cur->tid;
+	n->word       = word;
+#endif
+	*out = n->word;
+	return id;
+}
+
+uint32_t ulmk_kern_notif_create_shared(uint32_t word_ptr)
+{
+	return notif_create_shared_impl(
+		(const volatile uint32_t **)(uintptr_t)word_ptr);
+}
+
 uint32_t ulmk_kern_notif_destroy(uint32_t notif_id)
 {
 	return (uint32_t)(int32_t)notif_destroy_impl((ulmk_notif_t)notif_id);
 }
 
+/* Count the sender here: notif_signal_impl() also runs from IRQ dispatch. */
+static void notif_count_signal(void)
+{
+#if ULMK_CONFIG_THREAD_STATS
+	ulmk_thread_t *cur = ulmk_sched_current();
+
+	if (cur)
+		UL_THREAD_STAT_INC(cur, notif_signals);
+#endif
+}
+
 uint32_t ulmk_kern_notif_signal(uint32_t notif_id, uint32_t bits)
 {
+	notif_count_signal();
 	return (uint32_t)(int32_t)notif_signal_impl((ulmk_notif_t)notif_id, bits);
 }
 
+uint32_t ulmk_kern_notif_broadcast(uint32_t notif_id, uint32_t bits)
+{
+	notif_count_signal();
+	return (uint32_t)(int32_t)notif_broadcast_impl((ulmk_notif_t)notif_id,
+						       bits);
+}
+
 uint32_t ulmk_kern_notif_wait(uint32_t notif_id, uint32_t mask,
 			    uint32_t bits_ptr)
 {
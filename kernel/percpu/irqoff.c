@@ -0,0 +1,273 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * IRQ-off and kernel lock profile — kernel/percpu/irqoff.c
+ * Reference: docs/api_spec.md (ulmk_irqoff_stats)
+ *
+ * With ULMK_CONFIG_IRQOFF_STATS=1 each CPU keeps the profile read by
+ * ulmk_irqoff_stats().  A window opens where IRQs go from enabled to masked
+ * (a kernel gateway, or ulmk_klock_irqsave() with IRQs on) and closes where
+ * the gateway hands over (its context switch or the end of its reschedule)
+ * or at the matching ulmk_klock_irqrestore().  The arch switch and return
+ * tail after that point are not included.  An open restarts any window
+ * left by a path that never closed, so such paths go unmeasured rather
+ * than inflate the maximum.  Only the owning CPU writes
+ * its row, with IRQs masked; readers use the sequence count.
+ *
+ * ulmk_spinlock_stats() also lives here: with ULMK_CONFIG_SPINLOCK_STATS=1
+ * the arch lock keeps its own contention counters, read under the lock.
+ */
+
+#include <string.h>
+#include <ulmk/microkernel.h>
+#include <ulmk/config.h>
+#include <kernel/include/ulmk_klock.h>
+#include <kernel/include/ulmk_mem_internal.h>
+#include <kernel/include/ulmk_percpu.h>
+
+#if ULMK_CONFIG_SPINLOCK_STATS && defined(ULMK_ARCH_HAVE_SPINLOCK_STATS)
+#define UL_SPIN_STATS	1
+#else
+#define UL_SPIN_STATS	0
+#endif
+
+#if ULMK_CONFIG_IRQOFF_STATS || UL_SPIN_STATS
+/* Indexed by ULMK_LOCK_*. */
+static ulmk_spinlock_t *const g_klocks[ULMK_LOCK_NR] = {
+	&g_ulmk_lock_thread,
+	&g_ulmk_lock_ipc,
+	&g_ulmk_lock_rq,
+	&g_ulmk_lock_irq,
+	&g_ulmk_lock_timer,
+	&g_ulmk_lock_mem,
+};
+#endif
+
+#if ULMK_CONFIG_IRQOFF_STATS
+
+struct irqoff_cpu {
+	volatile uint32_t   seq;
+	uint8_t             open;
+	uint32_t            start;
+	uint32_t            site;
+	uint32_t            hold_at[ULMK_LOCK_NR];
+	uint32_t            hold_site[ULMK_LOCK_NR];
+	ulmk_irqoff_stats_t st;
+};
+
+static struct irqoff_cpu UL_KERNEL_BSS g_irqoff[ULMK_NR_CPUS];
+
+static struct irqoff_cpu *irqoff_cpu(void)
+{
+	uint32_t cpu = ulmk_arch_cpu_id();
+
+	return cpu < (uint32_t)ULMK_NR_CPUS ? &g_irqoff[cpu] : NULL;
+}
+
+static uint32_t klock_index(const ulmk_spinlock_t *lock)
+{
+	uint32_t i;
+
+	for (i = 0u; i < ULMK_LOCK_NR; i++)
+		if (g_klocks[i] == lock)
+			break;
+	return i;
+}
+
+static void irqoff_open_at(struct irqoff_cpu *c, uint32_t site, uint32_t now)
+{
+	c->open  = 1u;
+	c->start = now;
+	c->site  = site;
+}
+
+/* Keep worst[] longest-first with one entry per site. */
+static void irqoff_rank(ulmk_irqoff_stats_t *st, uint32_t site,
+			uint32_t cycles)
+{
+	ulmk_irqoff_site_t tmp;
+	uint32_t           i;
+
+	for (i = 0u; i < ULMK_IRQOFF_TOP - 1u; i++)
+		if (st->worst[i].site == site && st->worst[i].cycles != 0u)
+			break;
+	if (cycles <= st->worst[i].cycles)
+		return;
+	st->worst[i].cycles = cycles;
+	st->worst[i].site   = site;
+	for (; i > 0u && st->worst[i].cycles > st->worst[i - 1u].cycles; i--) {
+		tmp               = st->worst[i - 1u];
+		st->worst[i - 1u] = st->worst[i];
+		st->worst[i]      = tmp;
+	}
+}
+
+static void irqoff_close_at(struct irqoff_cpu *c, uint32_t now)
+{
+	if (!c->open)
+		return;
+	c->open = 0u;
+	c->seq++;
+	ulmk_arch_wmb();
+	c->st.windows++;
+	irqoff_rank(&c->st, c->site, now - c->start);
+	ulmk_arch_wmb();
+	c->seq++;
+}
+
+void ulmk_irqoff_open(uint32_t site)
+{
+	struct irqoff_cpu *c = irqoff_cpu();
+
+	if (c)
+		irqoff_open_at(c, site, ulmk_arch_cycle_read());
+}
+
+void ulmk_irqoff_close(void)
+{
+	struct irqoff_cpu *c = irqoff_cpu();
+
+	if (c)
+		irqoff_close_at(c, ulmk_arch_cycle_read());
+}
+
+/* noinline: the return address is the call site being profiled. */
+__attribute__((noinline))
+ulmk_arch_irq_key_t ulmk_klock_irqsave(ulmk_spinlock_t *lock)
+{
+	uint32_t             site = (uint32_t)(uintptr_t)__builtin_return_address(0);
+	uint32_t             t0   = ulmk_arch_cycle_read();
+	uint32_t             t1;
+	uint32_t             i;
+	ulmk_arch_irq_key_t  key;
+	struct irqoff_cpu   *c;
+	ulmk_lock_stats_t   *ls;
+
+	key = ulmk_arch_cpu_irq_save();
+	ulmk_arch_spin_lock(lock);
+	t1 = ulmk_arch_cycle_read();
+
+	c = irqoff_cpu();
+	if (!c)
+		return key;
+	if (!(key & ULMK_IRQ_KEY_SKIP))
+		irqoff_open_at(c, site, t0);
+	i = klock_index(lock);
+	if (i < ULMK_LOCK_NR) {
+		ls = &c->st.lock[i];
+		c->seq++;
+		ulmk_arch_wmb();
+		ls->acquires++;
+		ls->wait_sum += t1 - t0;
+		if (t1 - t0 > ls->wait_max)
+			ls->wait_max = t1 - t0;
+		ulmk_arch_wmb();
+		c->seq++;
+		c->hold_at[i]   = t1;
+		c->hold_site[i] = site;
+	}
+	return key;
+}
+
+void ulmk_klock_irqrestore(ulmk_spinlock_t *lock, ulmk_arch_irq_key_t key)
+{
+	uint32_t           now = ulmk_arch_cycle_read();
+	uint32_t           i;
+	uint32_t           held;
+	struct irqoff_cpu *c   = irqoff_cpu();
+	ulmk_lock_stats_t *ls;
+
+	if (c) {
+		i = klock_index(lock);
+		if (i < ULMK_LOCK_NR) {
+			ls   = &c->st.lock[i];
+			held = now - c->hold_at[i];
+			c->seq++;
+			ulmk_arch_wmb();
+			ls->hold_sum += held;
+			if (held > ls->hold_max) {
+				ls->hold_max      = held;
+				ls->hold_max_site = c->hold_site[i];
+			}
+			ulmk_arch_wmb();
+			c->seq++;
+		}
+		if (!(key & ULMK_IRQ_KEY_SKIP))
+			irqoff_close_at(c, now);
+	}
+	ulmk_arch_spin_unlock_irqrestore(lock, key);
+}
+
+uint32_t ulmk_kern_irqoff_stats(uint32_t cpu, uint32_t out_ptr)
+{
+	ulmk_irqoff_stats_t *out = (ulmk_irqoff_stats_t *)(uintptr_t)out_ptr;
+	struct irqoff_cpu   *c;
+	uint32_t             seq;
+
+	if (!out || cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	if (cpu >= (uint32_t)ULMK_NR_CPUS) {
+		memset(out, 0, sizeof(*out));
+		return (uint32_t)ULMK_OK;
+	}
+	c = &g_irqoff[cpu];
+	do {
+		do {
+			seq = c->seq;
+		} while (seq & 1u);
+		ulmk_arch_rmb();
+		*out = c->st;
+		ulmk_arch_rmb();
+	} while (c->seq != seq);
+	return (uint32_t)ULMK_OK;
+}
+
+#else /* !ULMK_CONFIG_IRQOFF_STATS */
+
+uint32_t ulmk_kern_irqoff_stats(uint32_t cpu, uint32_t out_ptr)
+{
+	(void)cpu;
+	(void)out_ptr;
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+}
+
+#endif /* ULMK_CONFIG_IRQOFF_STATS */
+
+/*
+ * spinlock_stats — copy the counters of global kernel lock @id.  They are
+ * updated by the holder, so they are read while holding the lock; the read
+ * itself counts as one acquisition.
+ */
+#if UL_SPIN_STATS
+
+uint32_t ulmk_kern_spinlock_stats(uint32_t id, uint32_t out_ptr)
+{
+	ulmk_spinlock_stats_t *out = (ulmk_spinlock_stats_t *)(uintptr_t)out_ptr;
+	ulmk_spinlock_stats_t  st;
+	ulmk_spinlock_t       *lock;
+	ulmk_arch_irq_key_t    key;
+
+	if (!out || id >= ULMK_LOCK_NR)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	lock = g_klocks[id];
+	key  = ulmk_klock_irqsave(lock);
+	st.acquires    = lock->acquires;
+	st.contended   = lock->contended;
+	st.spin_cycles = lock->spin_cycles;
+	ulmk_klock_irqrestore(lock, key);
+
+	*out = st;
+	return (uint32_t)ULMK_OK;
+}
+
+#else /* !UL_SPIN_STATS */
+
+uint32_t ulmk_kern_spinlock_stats(uint32_t id, uint32_t out_ptr)
+{
+	(void)id;
+	(void)out_ptr;
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+}
+
+#endif /* UL_SPIN_STATS */
@@ -6,6 +6,10 @@
  *
  * Self-contained format engine: no heap, no float, no <stdio.h>.
  * Output is routed one character at a time through ulmk_printk_char_out().
+ * With ULMK_CONFIG_PRINTK_BUF_SIZE > 0 it is instead formatted into a ring
+ * of the calling CPU and drained to the console later by that CPU's idle
+ * thread (ulmk_printk_flush()), so a print in a hot path costs only the
+ * formatting.  A full ring drops bytes; the drain reports how many.
  *
  * Supported specifiers:
  *   %c   char
@@ -35,12 +39,120 @@
 static const char hex_lower[] = "0123456789abcdef";
 static const char hex_upper[] = "0123456789ABCDEF";
 
+#if ULMK_CONFIG_PRINTK_BUF_SIZE > 0
+
+#include <kernel/include/ulmk_mem_internal.h>
+#include <kernel/include/ulmk_percpu.h>
+#include <ulmk_arch.h>
+
+#if (ULMK_CONFIG_PRINTK_BUF_SIZE & (ULMK_CONFIG_PRINTK_BUF_SIZE - 1)) != 0
+#error "ULMK_CONFIG_PRINTK_BUF_SIZE must be a power of two"
+#endif
+
+#define PK_MASK		((uint32_t)ULMK_CONFIG_PRINTK_BUF_SIZE - 1u)
+
+/*
+ * Producer (printk on this CPU, IRQs masked) and consumer
+ * (ulmk_printk_flush() on this CPU) share nothing but head and tail.  The
+ * drain can itself be entered twice — the idle loop and a recoverable
+ * trap or ISR that preempts it — so each drain claims a byte by moving
+ * tail with IRQs masked and sends it after; no drain ever stores a tail
+ * older than one it read.  dropped is written by printk only, reported by
+ * the drain under the same mask.
+ */
+struct pk_ring {
+	volatile uint32_t head;		/* bytes written */
+	volatile uint32_t tail;		/* bytes sent to the console */
+	volatile uint32_t dropped;	/* bytes lost to a full ring */
+	uint32_t          reported;	/* dropped count already announced */
+	char              buf[ULMK_CONFIG_PRINTK_BUF_SIZE];
+};
+
+static struct pk_ring UL_KERNEL_BSS g_pk[ULMK_NR_CPUS];
+
+static void pk_putc(char c)
+{
+	uint32_t        cpu = ulmk_arch_cpu_id();
+	struct pk_ring *r;
+	uint32_t        head;
+
+	if (cpu >= (uint32_t)ULMK_NR_CPUS) {
+		ulmk_printk_char_out(c);
+		return;
+	}
+	r    = &g_pk[cpu];
+	head = r->head;
+	if (head - r->tail >= (uint32_t)ULMK_CONFIG_PRINTK_BUF_SIZE) {
+		r->dropped++;
+		return;
+	}
+	r->buf[head & PK_MASK] = c;
+	r->head = head + 1u;
+}
+
+static void pk_direct_str(const char *s)
+{
+	while (*s)
+		ulmk_printk_char_out(*s++);
+}
+
+void ulmk_printk_flush(void)
+{
+	uint32_t            cpu = ulmk_arch_cpu_id();
+	struct pk_ring     *r;
+	ulmk_arch_irq_key_t key;
+	uint32_t            tail;
+	uint32_t            lost;
+	char                num[10];
+	char                c;
+	int                 i = 0;
+
+	if (cpu >= (uint32_t)ULMK_NR_CPUS)
+		return;
+	r = &g_pk[cpu];
+
+	/* One byte per claim so printk from an ISR can reuse the space. */
+	for (;;) {
+		key  = ulmk_arch_cpu_irq_save();
+		tail = r->tail;
+		if (tail == r->head) {
+			ulmk_arch_cpu_irq_restore(key);
+			break;
+		}
+		c       = r->buf[tail & PK_MASK];
+		r->tail = tail + 1u;
+		ulmk_arch_cpu_irq_restore(key);
+		ulmk_printk_char_out(c);
+	}
+
+	key  = ulmk_arch_cpu_irq_save();
+	lost = r->dropped - r->reported;
+	r->reported += lost;
+	ulmk_arch_cpu_irq_restore(key);
+	if (!lost)
+		return;
+	do {
+		num[i++] = (char)('0' + lost % 10u);
+		lost /= 10u;
+	} while (lost);
+	pk_direct_str("[printk: ");
+	while (i--)
+		ulmk_printk_char_out(num[i]);
+	pk_direct_str(" bytes dropped]\n");
+}
+
+#else
+
+#define pk_putc(c)	ulmk_printk_char_out(c)
+
+#endif /* ULMK_CONFIG_PRINTK_BUF_SIZE */
+
 static void emit_str(const char *s)
 {
 	if (!s)
 		s = "(null)";
 	while (*s)
-		ulmk_printk_char_out(*s++);
+		pk_putc(*s++);
 }
 
 static void emit_u32_dec(uint32_t v)
@@ -49,7 +161,7 @@ static void emit_u32_dec(uint32_t v)
 	int i = 0;
 
 	if (v == 0) {
-		ulmk_printk_char_out('0');
+		pk_putc('0');
 		return;
 	}
 	while (v) {
@@ -57,13 +169,13 @@ static void emit_u32_dec(uint32_t v)
 		v /= 10;
 	}
 	while (i--)
-		ulmk_printk_char_out(buf[i]);
+		pk_putc(buf[i]);
 }
 
 static void emit_i32_dec(int32_t v)
 {
 	if (v < 0) {
-		ulmk_printk_char_out('-');
+		pk_putc('-');
 		/* avoid UB for INT32_MIN: cast through unsigned */
 		emit_u32_dec((uint32_t)(-(v + 1)) + 1u);
 	} else {
@@ -77,7 +189,7 @@ static void emit_u32_hex(uint32_t v, const char *digits)
 	int i = 0;
 
 	if (v == 0) {
-		ulmk_printk_char_out('0');
+		pk_putc('0');
 		return;
 	}
 	while (v) {
@@ -85,7 +197,7 @@ static void emit_u32_hex(uint32_t v, const char *digits)
 		v >>= 4;
 	}
 	while (i--)
-		ulmk_printk_char_out(buf[i]);
+		pk_putc(buf[i]);
 }
 
 static void emit_ulmk_dec(unsigned long v)
@@ -94,7 +206,7 @@ static void emit_ulmk_dec(unsigned long v)
 	int i = 0;
 
 	if (v == 0) {
-		ulmk_printk_char_out('0');
+		pk_putc('0');
 		return;
 	}
 	while (v) {
@@ -102,7 +214,7 @@ static void emit_ulmk_dec(unsigned long v)
 		v /= 10;
 	}
 	while (i--)
-		ulmk_printk_char_out(buf[i]);
+		pk_putc(buf[i]);
 }
 
 static void emit_ulmk_hex(unsigned long v, const char *digits)
@@ -111,7 +223,7 @@ static void emit_ulmk_hex(unsigned long v, const char *digits)
 	int i = 0;
 
 	if (v == 0) {
-		ulmk_printk_char_out('0');
+		pk_putc('0');
 		return;
 	}
 	while (v) {
@@ -119,17 +231,21 @@ static void emit_ulmk_hex(unsigned long v, const char *digits)
 		v >>= 4;
 	}
 	while (i--)
-		ulmk_printk_char_out(buf[i]);
+		pk_putc(buf[i]);
 }
 
 void _ulmk_printk(const char *fmt, ...)
 {
 	va_list ap;
+#if ULMK_CONFIG_PRINTK_BUF_SIZE > 0
+	/* Keep one message contiguous in the ring against a nested printk. */
+	ulmk_arch_irq_key_t key = ulmk_arch_cpu_irq_save();
+#endif
 	va_start(ap, fmt);
 
 	while (*fmt) {
 		if (*fmt != '%') {
-			ulmk_printk_char_out(*fmt++);
+			pk_putc(*fmt++);
 			continue;
 		}
 		fmt++; /* consume '%' */
@@ -146,7 +262,7 @@ void _ulmk_printk(const char *fmt, ...)
 
 		switch (*fmt++) {
 		case 'c':
-			ulmk_printk_char_out((char)va_arg(ap, int));
+			pk_putc((char)va_arg(ap, int));
 			break;
 		case 's':
 			emit_str(va_arg(ap, const char *));
@@ -178,21 +294,24 @@ void _ulmk_printk(const char *fmt, ...)
 			break;
 		case 'p': {
 			uintptr_t p = (uintptr_t)va_arg(ap, void *);
-			ulmk_printk_char_out('0');
-			ulmk_printk_char_out('x');
+			pk_putc('0');
+			pk_putc('x');
 			emit_ulmk_hex((unsigned long)p, hex_lower);
 			break;
 		}
 		case '%':
-			ulmk_printk_char_out('%');
+			pk_putc('%');
 			break;
 		default:
-			ulmk_printk_char_out('?');
+			pk_putc('?');
 			break;
 		}
 	}
 
 	va_end(ap);
+#if ULMK_CONFIG_PRINTK_BUF_SIZE > 0
+	ulmk_arch_cpu_irq_restore(key);
+#endif
 }
 
 #endif /* ULMK_CONFIG_DEBUG_PRINTK */
@@ -14,6 +14,7 @@
 #include <kernel/include/ulmk_sched.h>
 #include <kernel/include/ulmk_percpu.h>
 #include <kernel/include/list.h>
+#include <kernel/include/ulmk_klock.h>
 #include <ulmk_arch.h>
 
 #define BITMAP_WORDS	8u		/* 8 × 32 = 256 priority levels */
@@ -28,7 +29,7 @@ static struct cpu_rq rq[ULMK_NR_CPUS];
  * Protects all RQ mutation.  Remote CPUs enqueue under this lock; the owner
  * CPU pick_next/dequeue also take it — required for SMP without migration.
  */
-static ulmk_spinlock_t rq_lock = ULMK_SPINLOCK_INIT;
+ulmk_spinlock_t g_ulmk_lock_rq = ULMK_SPINLOCK_INIT;
 
 static uint8_t bitmap_first_set(const struct cpu_rq *q)
 {
@@ -77,7 +78,7 @@ static void bitmap_rt_init(void)
 
 static void bitmap_rt_enqueue(ulmk_thread_t *t)
 {
-	ulmk_arch_irq_key_t key = ulmk_arch_spin_lock_irqsave(&rq_lock);
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_rq);
 	struct cpu_rq *q = rq_of_cpu(t->cpu);
 	uint8_t        p = t->priority;
 
@@ -86,12 +87,30 @@ static void bitmap_rt_enqueue(ulmk_thread_t *t)
 		bitmap_set(q, p);
 	}
 	t->state = UL_THREAD_STATE_READY;
-	ulmk_arch_spin_unlock_irqrestore(&rq_lock, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_rq, key);
+}
+
+/* Broadcast wakes: one rq_lock round trip for the whole batch. */
+static void bitmap_rt_enqueue_list(sys_dlist_t *list)
+{
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_rq);
+	struct cpu_rq *q;
+	sys_dnode_t   *dn;
+	ulmk_thread_t *t;
+
+	while ((dn = sys_dlist_get(list)) != NULL) {
+		t = SYS_DLIST_CONTAINER_OF(dn, ulmk_thread_t, sched_node);
+		q = rq_of_cpu(t->cpu);
+		sys_dlist_append(&q->level[t->priority], &t->sched_node);
+		bitmap_set(q, t->priority);
+		t->state = UL_THREAD_STATE_READY;
+	}
+	ulmk_klock_irqrestore(&g_ulmk_lock_rq, key);
 }
 
 static void bitmap_rt_dequeue(ulmk_thread_t *t)
 {
-	ulmk_arch_irq_key_t key = ulmk_arch_spin_lock_irqsave(&rq_lock);
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_rq);
 	struct cpu_rq *q = rq_of_cpu(t->cpu);
 	uint8_t        p = t->priority;
 
@@ -102,12 +121,12 @@ static void bitmap_rt_dequeue(ulmk_thread_t *t)
 		if (sys_dlist_is_empty(&q->level[p]))
 			bitmap_clear(q, p);
 	}
-	ulmk_arch_spin_unlock_irqrestore(&rq_lock, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_rq, key);
 }
 
 static ulmk_thread_t *bitmap_rt_pick_next(void)
 {
-	ulmk_arch_irq_key_t key = ulmk_arch_spin_lock_irqsave(&rq_lock);
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_rq);
 	struct cpu_rq *q = rq_of_cpu((uint8_t)ulmk_arch_cpu_id());
 	uint8_t        p;
 	sys_dnode_t   *dn;
@@ -116,7 +135,7 @@ static ulmk_thread_t *bitmap_rt_pick_next(void)
 	p = bitmap_first_set(q);
 	dn = sys_dlist_get(&q->level[p]);
 	if (!dn) {
-		ulmk_arch_spin_unlock_irqrestore(&rq_lock, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_rq, key);
 		return NULL;
 	}
 
@@ -125,28 +144,29 @@ static ulmk_thread_t *bitmap_rt_pick_next(void)
 
 	t = SYS_DLIST_CONTAINER_OF(dn, ulmk_thread_t, sched_node);
 	sys_dnode_init(&t->sched_node);
-	ulmk_arch_spin_unlock_irqrestore(&rq_lock, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_rq, key);
 	return t;
 }
 
 static ulmk_thread_t *bitmap_rt_peek_next(void)
 {
-	ulmk_arch_irq_key_t key = ulmk_arch_spin_lock_irqsave(&rq_lock);
+	ulmk_arch_irq_key_t key = ulmk_klock_irqsave(&g_ulmk_lock_rq);
 	struct cpu_rq *q = rq_of_cpu((uint8_t)ulmk_arch_cpu_id());
 	uint8_t        p = bitmap_first_set(q);
 	ulmk_thread_t *t;
 
 	t = SYS_DLIST_PEEK_HEAD_CONTAINER_OF(&q->level[p], ulmk_thread_t,
 					     sched_node);
-	ulmk_arch_spin_unlock_irqrestore(&rq_lock, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_rq, key);
 	return t;
 }
 
 const ulmk_sched_class_t ulmk_bitmap_rt_class = {
-	.name      = "bitmap-rt",
-	.init      = bitmap_rt_init,
-	.enqueue   = bitmap_rt_enqueue,
-	.dequeue   = bitmap_rt_dequeue,
-	.pick_next = bitmap_rt_pick_next,
-	.peek_next = bitmap_rt_peek_next,
+	.name         = "bitmap-rt",
+	.init         = bitmap_rt_init,
+	.enqueue      = bitmap_rt_enqueue,
+	.enqueue_list = bitmap_rt_enqueue_list,
+	.dequeue      = bitmap_rt_dequeue,
+	.pick_next    = bitmap_rt_pick_next,
+	.peek_next    = bitmap_rt_peek_next,
 };
@@ -18,8 +18,11 @@
 #include <ulmk/config.h>
 #include <kernel/include/ulmk_sched.h>
 #include <kernel/include/ulmk_thread_internal.h>
+#include <kernel/include/ulmk_domain_internal.h>
 #include <kernel/include/ulmk_mem_internal.h>
 #include <kernel/include/ulmk_percpu.h>
+#include <kernel/include/ulmk_trace.h>
+#include <kernel/include/ulmk_klock.h>
 #include <ulmk_arch.h>
 
 static const ulmk_sched_class_t * UL_KERNEL_BSS sched_class;
@@ -69,6 +72,108 @@ static void sched_reap_dead(ulmk_thread_t *prev)
 	pc->dead_for_cleanup = NULL;
 }
 
+#if ULMK_CONFIG_THREAD_STATS
+/*
+ * Run-time accounting (ulmk_thread_stats()).  Cycle deltas are 32-bit; the
+ * tick folds current's time in (ulmk_sched_acct_tick) so no interval spans
+ * a counter wrap.  Every timestamp is taken on the thread's own CPU: a
+ * remote wake-up leaves acct_ready_ok clear rather than mix counters.
+ */
+static void sched_acct_ready(ulmk_thread_t *t, uint32_t now)
+{
+	t->acct_ready_at = now;
+	t->acct_ready_ok = 1u;
+}
+
+static void sched_acct_switch(struct ulmk_percpu *pc, ulmk_thread_t *prev,
+			      ulmk_thread_t *next)
+{
+	uint32_t now = ulmk_arch_cycle_read();
+
+	if (prev) {
+		prev->stats.cycles += now - pc->acct_stamp;
+		if (prev->state == UL_THREAD_STATE_READY ||
+		    prev->state == UL_THREAD_STATE_RUNNING) {
+			if (prev->acct_yield)
+				prev->stats.voluntary++;
+			else
+				prev->stats.involuntary++;
+			sched_acct_ready(prev, now);
+		} else {
+			prev->stats.voluntary++;
+		}
+		prev->acct_yield = 0u;
+	}
+	if (next->acct_ready_ok) {
+		next->stats.ready_cycles += now - next->acct_ready_at;
+		next->acct_ready_ok = 0u;
+	}
+	next->stats.runs++;
+	pc->acct_stamp = now;
+}
+
+static void sched_acct_enqueue(ulmk_thread_t *t)
+{
+	if (t->cpu == (uint8_t)ulmk_arch_cpu_id() && t != ulmk_percpu()->current)
+		sched_acct_ready(t, ulmk_arch_cycle_read());
+	else
+		t->acct_ready_ok = 0u;
+}
+
+void ulmk_sched_acct_tick(void)
+{
+	struct ulmk_percpu *pc = ulmk_percpu();
+	uint32_t            now = ulmk_arch_cycle_read();
+
+	if (pc->current)
+		pc->current->stats.cycles += now - pc->acct_stamp;
+	pc->acct_stamp = now;
+}
+#else
+#define sched_acct_switch(pc, prev, next)	((void)(pc), (void)(prev), (void)(next))
+#define sched_acct_enqueue(t)			((void)(t))
+#endif
+
+#if ULMK_CONFIG_SCHED_LATENCY
+/*
+ * Wake-up latency (ulmk_sched_lat_stats()): enqueue of a thread other than
+ * current on its own CPU arms a stamp, the next switch to it records the
+ * delta.  Remote wake-ups are not timed, as for the run-time accounting.
+ */
+static void sched_lat_wake(ulmk_thread_t *t)
+{
+	if (t->cpu == (uint8_t)ulmk_arch_cpu_id() && t != ulmk_percpu()->current) {
+		t->lat_wake_at = ulmk_arch_cycle_read();
+		t->lat_armed   = 1u;
+	} else {
+		t->lat_armed = 0u;
+	}
+}
+
+static void sched_lat_run(ulmk_thread_t *next)
+{
+	if (next->lat_armed) {
+		next->lat_armed = 0u;
+		ulmk_sched_lat_record(next->priority,
+				      ulmk_arch_cycle_read() - next->lat_wake_at);
+	}
+}
+#else
+#define sched_lat_wake(t)			((void)(t))
+#define sched_lat_run(next)			((void)(next))
+#endif
+
+/* Bookkeeping for a switch that is about to happen on this CPU. */
+static void sched_note_switch(struct ulmk_percpu *pc, ulmk_thread_t *prev,
+			      ulmk_thread_t *next)
+{
+	ulmk_irqoff_close();
+	UL_TRACE(ULMK_TRACE_SWITCH, prev ? prev->tid : 0u, next->tid);
+	sched_acct_switch(pc, prev, next);
+	sched_lat_run(next);
+	ulmk_thread_stack_switch(prev, next);
+}
+
 static void sched_switch_to(ulmk_thread_t *prev, ulmk_thread_t *next)
 {
 	struct ulmk_percpu *pc = ulmk_percpu();
@@ -93,8 +198,8 @@ static void sched_switch_to(ulmk_thread_t *prev, ulmk_thread_t *next)
 		return;
 	}
 
-	ulmk_arch_mpu_switch(next->regions, next->region_count,
-			     sched_thread_prs(next));
+	ulmk_thread_mpu_switch(next, sched_thread_prs(next));
+	sched_note_switch(pc, prev, next);
 
 	pc->current = next;
 	next->state = UL_THREAD_STATE_RUNNING;
@@ -136,6 +241,7 @@ void ulmk_sched_start(void)
 	 * lands with current==NULL only arms needs_resched; sched_start
 	 * must keep that flag on SMP so the first trap/ISR exit can switch.
 	 */
+	sched_note_switch(pc, NULL, first);
 	pc->current  = first;
 	first->state = UL_THREAD_STATE_RUNNING;
 	pc->online   = true;
@@ -154,8 +260,7 @@ void ulmk_sched_start(void)
 	 * context races with STM0 on QEMU TriCore and can hang before the
 	 * first root instruction.  Arm on the first trap/syscall instead.
 	 */
-	ulmk_arch_mpu_switch(first->regions, first->region_count,
-			     sched_thread_prs(first));
+	ulmk_thread_mpu_switch(first, sched_thread_prs(first));
 	ulmk_arch_ctx_switch(&pc->startup_ctx, &first->ctx);
 }
 
@@ -177,8 +282,10 @@ void ulmk_sched_kick_pending(void)
 	pc->ipi_pending = 0u;
 
 	for (cpu = 0u; cpu < (uint32_t)ULMK_NR_CPUS; cpu++) {
-		if (pending & (1u << cpu))
+		if (pending & (1u << cpu)) {
 			ulmk_arch_send_ipi(cpu);
+			pc->irq_stats.ipis++;
+		}
 	}
 }
 #endif
@@ -197,12 +304,41 @@ void ulmk_sched_resched(void)
 
 void ulmk_sched_enqueue(ulmk_thread_t *t)
 {
+	UL_TRACE(ULMK_TRACE_ENQUEUE, t->tid, t->priority);
+	sched_acct_enqueue(t);
+	sched_lat_wake(t);
 	sched_class->enqueue(t);
 	sched_mark_preempt_if_higher(t);
 }
 
+void ulmk_sched_enqueue_list(sys_dlist_t *list)
+{
+	ulmk_thread_t *t;
+	sys_dnode_t   *dn;
+
+	/* Preempt marks only read priorities; IPIs stay deferred past the insert. */
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, sched_node) {
+		UL_TRACE(ULMK_TRACE_ENQUEUE, t->tid, t->priority);
+		sched_acct_enqueue(t);
+		sched_lat_wake(t);
+		sched_mark_preempt_if_higher(t);
+	}
+
+	if (sched_class->enqueue_list) {
+		sched_class->enqueue_list(list);
+		return;
+	}
+
+	while ((dn = sys_dlist_get(list)) != NULL) {
+		t = SYS_DLIST_CONTAINER_OF(dn, ulmk_thread_t, sched_node);
+		sys_dnode_init(&t->sched_node);
+		sched_class->enqueue(t);
+	}
+}
+
 void ulmk_sched_dequeue(ulmk_thread_t *t)
 {
+	UL_TRACE(ULMK_TRACE_DEQUEUE, t->tid, t->priority);
 	sched_class->dequeue(t);
 }
 
@@ -269,10 +405,11 @@ void ulmk_sched_trap_dispatch(bool from_isr)
 			next = sched_class->pick_next();
 			ulmk_thread_ensure_ctx(next);
 
+			if (next != cur)
+				sched_note_switch(pc, cur, next);
 			pc->current = next;
 			next->state = UL_THREAD_STATE_RUNNING;
-			ulmk_arch_mpu_switch(next->regions, next->region_count,
-					     sched_thread_prs(next));
+			ulmk_thread_mpu_switch(next, sched_thread_prs(next));
 			ulmk_arch_sched_switch(&cur->ctx, &next->ctx,
 					       ULMK_SCHED_SWITCH_PREEMPT_ISR);
 			return;
@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Scheduling latency — kernel/sched/sched_lat.c
+ * Reference: docs/api_spec.md (ulmk_sched_lat_stats)
+ *
+ * Wake-up-to-run histograms, one row per CPU and one entry per band of 32
+ * priorities.  sched.c stamps a thread when it is woken on its own CPU and
+ * records here when that CPU switches it in, so only the owning CPU writes
+ * a row (IRQs masked, no lock).  Each entry carries a sequence count, odd
+ * while being written, for a consistent copy from any CPU.
+ */
+
+#include <string.h>
+#include <ulmk/microkernel.h>
+#include <ulmk/config.h>
+#include <ulmk_arch.h>
+#include <kernel/include/ulmk_sched.h>
+#include <kernel/include/ulmk_mem_internal.h>
+#include <kernel/include/ulmk_percpu.h>
+#include <kernel/syscall/syscall_router.h>
+
+#if ULMK_CONFIG_SCHED_LATENCY
+
+typedef struct {
+	volatile uint32_t      seq;
+	ulmk_sched_lat_stats_t st;
+} lat_hist_t;
+
+static lat_hist_t UL_KERNEL_BSS g_lat_hist[ULMK_NR_CPUS][ULMK_SCHED_LAT_BANDS];
+
+void ulmk_sched_lat_record(uint32_t prio, uint32_t cycles)
+{
+	uint32_t    cpu  = ulmk_arch_cpu_id();
+	uint32_t    band = (prio & 0xFFu) >> 5;
+	uint32_t    b;
+	lat_hist_t *h;
+
+	if (cpu >= (uint32_t)ULMK_NR_CPUS)
+		return;
+	h = &g_lat_hist[cpu][band];
+	b = cycles ? 31u - ulmk_arch_cpu_clz(cycles) : 0u;
+	if (b >= ULMK_SCHED_LAT_BUCKETS)
+		b = ULMK_SCHED_LAT_BUCKETS - 1u;
+
+	h->seq++;
+	ulmk_arch_wmb();
+	if (h->st.count == 0u || cycles < h->st.min)
+		h->st.min = cycles;
+	if (cycles > h->st.max)
+		h->st.max = cycles;
+	h->st.count++;
+	h->st.sum += cycles;
+	h->st.hist[b]++;
+	ulmk_arch_wmb();
+	h->seq++;
+}
+
+uint32_t ulmk_kern_sched_lat_stats(uint32_t cpu, uint32_t band,
+				   uint32_t out_ptr)
+{
+	ulmk_sched_lat_stats_t *out = (ulmk_sched_lat_stats_t *)(uintptr_t)out_ptr;
+	lat_hist_t             *h;
+	uint32_t                seq;
+
+	if (!out || cpu >= (uint32_t)ULMK_ARCH_NUM_CPU ||
+	    band >= ULMK_SCHED_LAT_BANDS)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	if (cpu >= (uint32_t)ULMK_NR_CPUS) {
+		memset(out, 0, sizeof(*out));
+		return (uint32_t)ULMK_OK;
+	}
+	h = &g_lat_hist[cpu][band];
+	do {
+		do {
+			seq = h->seq;
+		} while (seq & 1u);
+		ulmk_arch_rmb();
+		*out = h->st;
+		ulmk_arch_rmb();
+	} while (h->seq != seq);
+	return (uint32_t)ULMK_OK;
+}
+
+#else /* !ULMK_CONFIG_SCHED_LATENCY */
+
+uint32_t ulmk_kern_sched_lat_stats(uint32_t cpu, uint32_t band,
+				   uint32_t out_ptr)
+{
+	(void)cpu;
+	(void)band;
+	(void)out_ptr;
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+}
+
+#endif /* ULMK_CONFIG_SCHED_LATENCY */
@@ -21,6 +21,8 @@
 #include <kernel/include/ulmk_thread_internal.h>
 #include <kernel/include/ulmk_irq_internal.h>
 #include <kernel/include/ulmk_syscall_wcet_internal.h>
+#include <kernel/include/ulmk_trace.h>
+#include <kernel/include/ulmk_klock.h>
 
 /* Shorthand: fetch caller's privilege from the scheduler. */
 static inline ulmk_privilege_t _caller_priv(void)
@@ -74,7 +76,7 @@ uint32_t ulmk_syscall_router(uint32_t nr,
 
 	case ULMK_SYS_HEAP_EXTEND:
 		REQUIRE_DRIVER(a0);
-		return ulmk_kern_heap_extend(a0);
+		return ulmk_kern_heap_extend(a0, a1);
 
 	/* ── Scheduling (any privilege) ──────────────────────────────── */
 	case ULMK_SYS_YIELD:
@@ -97,6 +99,9 @@ uint32_t ulmk_syscall_router(uint32_t nr,
 		REQUIRE_DRIVER(a0);
 		return ulmk_kern_tick_start();
 
+	case ULMK_SYS_CYCLE_READ:
+		return ulmk_kern_cycle_read(a0);
+
 	/* ── Thread query (any privilege) ────────────────────────────── */
 	case ULMK_SYS_THREAD_SELF:
 		return ulmk_kern_thread_self();
@@ -107,6 +112,31 @@ uint32_t ulmk_syscall_router(uint32_t nr,
 	case ULMK_SYS_WCET_BIND:
 		return ulmk_kern_wcet_bind(a0);
 
+	case ULMK_SYS_MPU_STATS:
+		return ulmk_kern_mpu_stats(a0, a1);
+
+	case ULMK_SYS_IRQ_STATS:
+		return ulmk_kern_irq_stats(a0, a1);
+
+	case ULMK_SYS_WCET_STATS:
+		return ulmk_kern_wcet_stats(a0, a1, a2);
+
+	case ULMK_SYS_THREAD_STATS:
+		/* Own counters are free; anyone else's need ULMK_CAP_STATS. */
+		if (a0 != 0u && a0 != ulmk_kern_thread_self())
+			REQUIRE_CAP(ULMK_CAP_STATS);
+		return ulmk_kern_thread_stats(a0, a1);
+
+	case ULMK_SYS_SCHED_LAT_STATS:
+		return ulmk_kern_sched_lat_stats(a0, a1, a2);
+
+	case ULMK_SYS_IRQOFF_STATS:
+		REQUIRE_CAP(ULMK_CAP_STATS);
+		return ulmk_kern_irqoff_stats(a0, a1);
+
+	case ULMK_SYS_SPINLOCK_STATS:
+		return ulmk_kern_spinlock_stats(a0, a1);
+
 	/* ── IPC endpoints (any privilege) ──────────────────────────── */
 	case ULMK_SYS_EP_CREATE:
 		return ulmk_kern_ep_create();
@@ -136,9 +166,15 @@ uint32_t ulmk_syscall_router(uint32_t nr,
 	case ULMK_SYS_NOTIF_CREATE:
 		return ulmk_kern_notif_create();
 
+	case ULMK_SYS_NOTIF_CREATE_SHARED:
+		return ulmk_kern_notif_create_shared(a0);
+
 	case ULMK_SYS_NOTIF_SIGNAL:
 		return ulmk_kern_notif_signal(a0, a1);
 
+	case ULMK_SYS_NOTIF_BROADCAST:
+		return ulmk_kern_notif_broadcast(a0, a1);
+
 	case ULMK_SYS_NOTIF_WAIT:
 		return ulmk_kern_notif_wait(a0, a1, a2);
 
@@ -151,6 +187,22 @@ uint32_t ulmk_syscall_router(uint32_t nr,
 	case ULMK_SYS_NOTIF_DESTROY:
 		return ulmk_kern_notif_destroy(a0);
 
+	/* ── Wait sets (any privilege) ──────────────────────────────── */
+	case ULMK_SYS_WAITSET_CREATE:
+		return ulmk_kern_waitset_create();
+
+	case ULMK_SYS_WAITSET_ADD:
+		return ulmk_kern_waitset_add(a0, a1, a2, a3);
+
+	case ULMK_SYS_WAITSET_DEL:
+		return ulmk_kern_waitset_del(a0, a1, a2);
+
+	case ULMK_SYS_WAIT_ANY:
+		return ulmk_kern_wait_any(a0, a1);
+
+	case ULMK_SYS_WAITSET_DESTROY:
+		return ulmk_kern_waitset_destroy(a0);
+
 	/* ── IRQ (requires ULMK_PRIV_DRIVER) ──────────────────────────── */
 	case ULMK_SYS_IRQ_BIND:
 		REQUIRE_DRIVER(a0);
@@ -189,6 +241,15 @@ uint32_t ulmk_syscall_router(uint32_t nr,
 		REQUIRE_CAP(ULMK_CAP_IRQ);
 		return ulmk_kern_irq_detach(a0);
 
+	case ULMK_SYS_IRQ_THREAD_BIND:
+		REQUIRE_DRIVER(a0);
+		REQUIRE_CAP(ULMK_CAP_IRQ);
+		return ulmk_kern_irq_thread_bind(a0, a1, a2);
+
+	case ULMK_SYS_IRQ_THREAD_WAIT:
+		REQUIRE_DRIVER(a0);
+		return ulmk_kern_irq_thread_wait(a0);
+
 	/* ── Thread management (requires IO >= 1 / ULMK_PRIV_DRIVER) ─── */
 	case ULMK_SYS_THREAD_SPAWN:
 		/*
@@ -220,12 +281,51 @@ uint32_t ulmk_syscall_router(uint32_t nr,
 		REQUIRE_DRIVER(a0);
 		return ulmk_kern_thread_get_prio(a0);
 
+	case ULMK_SYS_THREAD_STACK_STATS:
+		/* Any privilege: own stack is free; anyone else's needs ULMK_CAP_STATS. */
+		if (a0 != 0u && a0 != ulmk_kern_thread_self())
+			REQUIRE_CAP(ULMK_CAP_STATS);
+		return ulmk_kern_thread_stack_stats(a0, a1);
+
+	/* ── Shared protection domains (requires ULMK_PRIV_DRIVER) ────── */
+	case ULMK_SYS_PROC_CREATE:
+		REQUIRE_DRIVER(a0);
+		return ulmk_kern_domain_create();
+
+	case ULMK_SYS_PROC_DESTROY:
+		REQUIRE_DRIVER(a0);
+		return ulmk_kern_domain_destroy(a0);
+
+	case ULMK_SYS_PROC_ADD_REGION:
+		REQUIRE_DRIVER(a0);
+		return ulmk_kern_domain_grant(a0, a1, a2, a3);
+
 	/* ── Capability management (requires ULMK_CAP_GRANT_CAP) ───────── */
 	case ULMK_SYS_PROC_GRANT_CAP:
 		REQUIRE_DRIVER(a0);
 		REQUIRE_CAP(ULMK_CAP_GRANT_CAP);
 		return ulmk_kern_cap_grant(a0, a1);
 
+	/* ── IRQ, continued (requires IO >= 1 / ULMK_PRIV_DRIVER) ─────── */
+	case ULMK_SYS_IRQ_COALESCE:
+		REQUIRE_DRIVER(a0);
+		REQUIRE_CAP(ULMK_CAP_IRQ);
+		return ulmk_kern_irq_coalesce(a0, a1, a2);
+
+	case ULMK_SYS_IRQ_AFFINITY:
+		REQUIRE_DRIVER(a0);
+		REQUIRE_CAP(ULMK_CAP_IRQ);
+		return ulmk_kern_irq_affinity(a0, a1);
+
+	/* ── Kernel trace (IO >= 1) ──────────────────────────────────── */
+	case ULMK_SYS_TRACE_MASK:
+		REQUIRE_DRIVER(a0);
+		return ulmk_kern_trace_mask(a0);
+
+	case ULMK_SYS_TRACE_READ:
+		REQUIRE_DRIVER(a0);
+		return ulmk_kern_trace_read(a0, a1, a2, a3);
+
 	default:
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 	}
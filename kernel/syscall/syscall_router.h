@@ -38,12 +38,19 @@ uint32_t ulmk_kern_mem_unmap(uint32_t addr, uint32_t size);
 uint32_t ulmk_kern_mem_grant(uint32_t addr, uint32_t size,
 			   uint32_t target_tid, uint32_t perms);
 /* Per-thread heap (slabAO model) */
-uint32_t ulmk_kern_heap_extend(uint32_t size);
+uint32_t ulmk_kern_heap_extend(uint32_t size, uint32_t info_ptr);
 uint32_t ulmk_kern_get_thread_heap(uint32_t info_ptr);
 /* Kernel-internal heap helpers (not exposed as syscalls) */
 uint32_t ulmk_kern_heap_alloc(uint32_t size);
 uint32_t ulmk_kern_heap_free(uint32_t ptr);
 uint32_t ulmk_kern_heap_aligned_alloc(uint32_t align, uint32_t size);
+/* Shared protection domains (ULMK_PRIV_DRIVER) */
+uint32_t ulmk_kern_domain_create(void);
+uint32_t ulmk_kern_domain_destroy(uint32_t dom);
+uint32_t ulmk_kern_domain_grant(uint32_t dom, uint32_t addr, uint32_t size,
+				uint32_t perms);
+/* MPU switch counters (any privilege) */
+uint32_t ulmk_kern_mpu_stats(uint32_t cpu, uint32_t out_ptr);
 
 /* Scheduling */
 uint32_t ulmk_kern_yield(void);
@@ -52,6 +59,7 @@ uint32_t ulmk_kern_thread_self(void);
 uint32_t ulmk_kern_sleep(uint32_t ms);
 uint32_t ulmk_kern_sleep_cancel(uint32_t tid);
 uint32_t ulmk_kern_tick_start(void);
+uint32_t ulmk_kern_cycle_read(uint32_t out_ptr);
 
 /* IPC endpoints */
 uint32_t ulmk_kern_ep_create(void);
@@ -69,13 +77,23 @@ uint32_t ulmk_kern_ep_destroy(uint32_t ep);
 
 /* Notifications */
 uint32_t ulmk_kern_notif_create(void);
+uint32_t ulmk_kern_notif_create_shared(uint32_t word_ptr);
 uint32_t ulmk_kern_notif_signal(uint32_t notif, uint32_t bits);
+uint32_t ulmk_kern_notif_broadcast(uint32_t notif, uint32_t bits);
 uint32_t ulmk_kern_notif_wait(uint32_t notif, uint32_t mask, uint32_t bits_ptr);
 uint32_t ulmk_kern_notif_wait_timeout(uint32_t notif, uint32_t mask,
 				      uint32_t bits_ptr, uint32_t ms);
 uint32_t ulmk_kern_notif_poll(uint32_t notif, uint32_t mask);
 uint32_t ulmk_kern_notif_destroy(uint32_t notif);
 
+/* Wait sets */
+uint32_t ulmk_kern_waitset_create(void);
+uint32_t ulmk_kern_waitset_add(uint32_t ws, uint32_t kind, uint32_t handle,
+			       uint32_t mask);
+uint32_t ulmk_kern_waitset_del(uint32_t ws, uint32_t kind, uint32_t handle);
+uint32_t ulmk_kern_wait_any(uint32_t ws, uint32_t ev_ptr);
+uint32_t ulmk_kern_waitset_destroy(uint32_t ws);
+
 /* IRQ (requires ULMK_PRIV_DRIVER) */
 uint32_t ulmk_kern_irq_bind(uint32_t srpn, uint32_t notif, uint32_t bit);
 uint32_t ulmk_kern_irq_bind_hw(uint32_t srpn, uint32_t notif_id,
@@ -84,9 +102,17 @@ uint32_t ulmk_kern_irq_attach(uint32_t srpn, uint32_t fn, uint32_t data);
 uint32_t ulmk_kern_irq_attach_hw(uint32_t srpn, uint32_t fn, uint32_t data,
 				 uint32_t src_reg);
 uint32_t ulmk_kern_irq_detach(uint32_t srpn);
+uint32_t ulmk_kern_irq_thread_bind(uint32_t srpn, uint32_t src_reg,
+				   uint32_t prio);
+uint32_t ulmk_kern_irq_thread_wait(uint32_t srpn);
 uint32_t ulmk_kern_irq_enable(uint32_t srpn);
 uint32_t ulmk_kern_irq_disable(uint32_t srpn);
 uint32_t ulmk_kern_irq_ack(uint32_t srpn);
+uint32_t ulmk_kern_irq_coalesce(uint32_t srpn, uint32_t max_events,
+				uint32_t max_ticks);
+uint32_t ulmk_kern_irq_affinity(uint32_t srpn, uint32_t cpu);
+/* IRQ dispatch counters (any privilege) */
+uint32_t ulmk_kern_irq_stats(uint32_t cpu, uint32_t out_ptr);
 
 /* Thread management (requires ULMK_PRIV_DRIVER) */
 uint32_t ulmk_kern_thread_spawn(uint32_t attr_ptr);
@@ -95,6 +121,13 @@ uint32_t ulmk_kern_thread_suspend(uint32_t tid);
 uint32_t ulmk_kern_thread_resume(uint32_t tid);
 uint32_t ulmk_kern_thread_set_prio(uint32_t tid, uint32_t prio);
 uint32_t ulmk_kern_thread_get_prio(uint32_t tid);
+/* Thread run-time counters (self: any; others: ULMK_CAP_STATS) */
+uint32_t ulmk_kern_thread_stats(uint32_t tid, uint32_t out_ptr);
+/* Thread stack high-water marks (self: any; others: ULMK_CAP_STATS) */
+uint32_t ulmk_kern_thread_stack_stats(uint32_t tid, uint32_t out_ptr);
+/* Wake-up latency histograms (any privilege) */
+uint32_t ulmk_kern_sched_lat_stats(uint32_t cpu, uint32_t band,
+				   uint32_t out_ptr);
 
 /* Capability management */
 uint32_t ulmk_kern_cap_grant(uint32_t target_tid, uint32_t caps);
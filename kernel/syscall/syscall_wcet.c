@@ -4,14 +4,24 @@
  *
  * Compiled always; the object is only updated when ULMK_CONFIG_SYSCALL_WCET=1
  * (see ulmk_kern_trap_syscall in kernel_main.c).
+ *
+ * Histograms: one row per CPU, one entry per assigned syscall number
+ * (0..ULMK_SYS_LAST; the router accepts up to ULMK_SYS_MAX).  Only the
+ * owning CPU writes a row, from the trap path, so updates take no lock;
+ * each entry carries a sequence count (odd while being written) that lets
+ * ulmk_wcet_stats() on any CPU take a consistent copy.
  */
 
+#include <string.h>
 #include <ulmk/syscall_wcet.h>
 #include <ulmk/microkernel.h>
 #include <ulmk/config.h>
 #include <ulmk_arch.h>
 #include <kernel/include/ulmk_sched.h>
 #include <kernel/include/ulmk_thread_internal.h>
+#include <kernel/include/ulmk_mem_internal.h>
+#include <kernel/include/ulmk_percpu.h>
+#include <kernel/include/ulmk_syscall_wcet_internal.h>
 
 volatile struct ulmk_syscall_wcet_slot
 g_ulmk_syscall_wcet[ULMK_SYSCALL_WCET_MAX_CPUS]
@@ -19,6 +29,70 @@ g_ulmk_syscall_wcet[ULMK_SYSCALL_WCET_MAX_CPUS]
 
 #if ULMK_CONFIG_SYSCALL_WCET
 
+#if ULMK_SYS_LAST >= ULMK_SYS_MAX
+#error "ULMK_SYS_LAST must stay below the router bound ULMK_SYS_MAX"
+#endif
+
+typedef struct {
+	volatile uint32_t seq;
+	ulmk_wcet_stats_t st;
+} wcet_hist_t;
+
+static wcet_hist_t UL_KERNEL_BSS g_wcet_hist[ULMK_NR_CPUS][ULMK_SYS_LAST + 1];
+
+void ulmk_syscall_wcet_record(uint32_t nr, uint32_t cycles)
+{
+	uint32_t     cpu = ulmk_arch_cpu_id();
+	uint32_t     b;
+	wcet_hist_t *h;
+
+	if (cpu >= (uint32_t)ULMK_NR_CPUS || nr > ULMK_SYS_LAST)
+		return;
+	h = &g_wcet_hist[cpu][nr];
+	b = cycles ? 31u - ulmk_arch_cpu_clz(cycles) : 0u;
+	if (b >= ULMK_SYSCALL_WCET_BUCKETS)
+		b = ULMK_SYSCALL_WCET_BUCKETS - 1u;
+
+	h->seq++;
+	ulmk_arch_wmb();
+	if (h->st.count == 0u || cycles < h->st.min)
+		h->st.min = cycles;
+	if (cycles > h->st.max)
+		h->st.max = cycles;
+	h->st.count++;
+	h->st.sum += cycles;
+	h->st.hist[b]++;
+	ulmk_arch_wmb();
+	h->seq++;
+}
+
+uint32_t ulmk_kern_wcet_stats(uint32_t cpu, uint32_t nr, uint32_t out_ptr)
+{
+	ulmk_wcet_stats_t *out = (ulmk_wcet_stats_t *)(uintptr_t)out_ptr;
+	wcet_hist_t       *h;
+	uint32_t           seq;
+
+	if (!out || cpu >= (uint32_t)ULMK_ARCH_NUM_CPU || nr >= ULMK_SYS_MAX)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+
+	/* CPUs not brought up and unassigned numbers never record a sample. */
+	if (cpu >= (uint32_t)ULMK_NR_CPUS || nr > ULMK_SYS_LAST) {
+		memset(out, 0, sizeof(*out));
+		return (uint32_t)ULMK_OK;
+	}
+	/* The writer holds an entry for a few dozen cycles; retry around it. */
+	h = &g_wcet_hist[cpu][nr];
+	do {
+		do {
+			seq = h->seq;
+		} while (seq & 1u);
+		ulmk_arch_rmb();
+		*out = h->st;
+		ulmk_arch_rmb();
+	} while (h->seq != seq);
+	return (uint32_t)ULMK_OK;
+}
+
 void ulmk_syscall_wcet_account_reset(void)
 {
 	ulmk_thread_t *cur = ulmk_sched_current();
@@ -83,4 +157,12 @@ uint32_t ulmk_kern_wcet_bind(uint32_t slot_ptr)
 	return (uint32_t)(int32_t)ULMK_EINVAL;
 }
 
+uint32_t ulmk_kern_wcet_stats(uint32_t cpu, uint32_t nr, uint32_t out_ptr)
+{
+	(void)cpu;
+	(void)nr;
+	(void)out_ptr;
+	return (uint32_t)(int32_t)ULMK_EINVAL;
+}
+
 #endif /* ULMK_CONFIG_SYSCALL_WCET */
@@ -0,0 +1,146 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Stack watermarks — kernel/thread/stack_wm.c
+ * Reference: docs/api_spec.md (ulmk_thread_stack_stats)
+ *
+ * ulmk_thread_init() fills the whole stack with a pattern word.  Stacks
+ * grow down on every port, so the untouched words left at the low end give
+ * the high-water mark; it is scanned on demand (query, thread free) rather
+ * than on the switch path.  A switch only compares prev's lowest word, and
+ * on ports with a saved-context pool (TriCore CSA) counts next's frames.
+ *
+ * Layout, in words from stack_base:
+ *
+ *   [0, user)      user stack; word 0 is the overflow guard
+ *   [user, total)  per-thread exception-frame reserve (ULMK_ARCH_KSTACK_SIZE,
+ *                  ARM only; empty elsewhere)
+ */
+
+#include <stdint.h>
+#include <ulmk/microkernel.h>
+#include <ulmk/config.h>
+#include <ulmk_arch.h>
+#include <kernel/include/ulmk_thread_internal.h>
+#include <kernel/include/ulmk_sched.h>
+#include <kernel/include/ulmk_printk.h>
+#include <kernel/syscall/syscall_router.h>
+
+#if ULMK_CONFIG_STACK_WATERMARK
+
+#ifndef ULMK_ARCH_KSTACK_SIZE
+#define ULMK_ARCH_KSTACK_SIZE	0u
+#endif
+
+#define UL_STACK_PAINT		0xA5A5A5A5u
+
+static void stack_split(const ulmk_thread_t *th, uint32_t *user,
+			uint32_t *total)
+{
+	uint32_t kw = (uint32_t)ULMK_ARCH_KSTACK_SIZE / 4u;
+
+	*total = (uint32_t)th->stack_size / 4u;
+	*user  = *total > kw ? *total - kw : *total;
+}
+
+/* Words in [lo, hi) still holding the paint, counted up from @lo. */
+static uint32_t stack_untouched(const uint32_t *w, uint32_t lo, uint32_t hi)
+{
+	uint32_t i = lo;
+
+	while (i < hi && w[i] == UL_STACK_PAINT)
+		i++;
+	return i - lo;
+}
+
+static void stack_measure(const ulmk_thread_t *th, ulmk_stack_stats_t *st)
+{
+	const uint32_t *w = (const uint32_t *)th->stack_base;
+	uint32_t        user;
+	uint32_t        total;
+
+	stack_split(th, &user, &total);
+	st->size        = user * 4u;
+	st->used        = (user - stack_untouched(w, 0u, user)) * 4u;
+	st->kstack_size = (total - user) * 4u;
+	st->kstack_used = (total - user - stack_untouched(w, user, total)) * 4u;
+	st->csa_used    = th->stack_ctx_max;
+	st->overflow    = (th->stack_overflow ||
+			   (user != 0u && w[0] != UL_STACK_PAINT)) ? 1u : 0u;
+}
+
+void ulmk_thread_stack_paint(ulmk_thread_t *th)
+{
+	uint32_t *w = (uint32_t *)th->stack_base;
+	uint32_t  n = (uint32_t)th->stack_size / 4u;
+	uint32_t  i;
+
+	for (i = 0u; i < n; i++)
+		w[i] = UL_STACK_PAINT;
+	th->stack_ctx_max  = 0u;
+	th->stack_overflow = 0u;
+}
+
+/* Called from sched_note_switch(): IRQs masked, next not yet running. */
+void ulmk_thread_stack_switch(ulmk_thread_t *prev, ulmk_thread_t *next)
+{
+#ifdef ULMK_ARCH_HAVE_CTX_DEPTH
+	uint32_t depth;
+#endif
+
+	if (prev && !prev->stack_overflow && prev->stack_size >= 4u &&
+	    *(const uint32_t *)prev->stack_base != UL_STACK_PAINT) {
+		prev->stack_overflow = 1u;
+		ulmk_printk("stack: tid=%x hit the bottom of its %u-byte stack\n",
+			    (unsigned)prev->tid, (unsigned)prev->stack_size);
+	}
+#ifdef ULMK_ARCH_HAVE_CTX_DEPTH
+	depth = ulmk_arch_ctx_depth(&next->ctx);
+	if (depth > next->stack_ctx_max)
+		next->stack_ctx_max = depth;
+#else
+	(void)next;
+#endif
+}
+
+void ulmk_thread_stack_report(const ulmk_thread_t *th)
+{
+	ulmk_stack_stats_t st;
+
+	if (!th->stack_base)
+		return;
+	stack_measure(th, &st);
+	ulmk_printk("stack: tid=%x used=%u/%u kstack=%u/%u csa=%u%s\n",
+		    (unsigned)th->tid, (unsigned)st.used, (unsigned)st.size,
+		    (unsigned)st.kstack_used, (unsigned)st.kstack_size,
+		    (unsigned)st.csa_used, st.overflow ? " OVERFLOW" : "");
+}
+
+/*
+ * thread_stack_stats — scan @tid's stack (0 = the caller).  Gating of
+ * foreign tids (ULMK_CAP_STATS) is done by the router.
+ */
+uint32_t ulmk_kern_thread_stack_stats(uint32_t tid, uint32_t out_ptr)
+{
+	ulmk_stack_stats_t *out = (ulmk_stack_stats_t *)(uintptr_t)out_ptr;
+	ulmk_thread_t      *th;
+
+	if (!out)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+	th = tid ? ulmk_thread_by_tid((ulmk_tid_t)tid) : ulmk_sched_current();
+	if (!th || th->state == UL_THREAD_STATE_DEAD)
+		return (uint32_t)(int32_t)ULMK_ESRCH;
+
+	stack_measure(th, out);
+	return (uint32_t)ULMK_OK;
+}
+
+#else /* !ULMK_CONFIG_STACK_WATERMARK */
+
+uint32_t ulmk_kern_thread_stack_stats(uint32_t tid, uint32_t out_ptr)
+{
+	(void)tid;
+	(void)out_ptr;
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+}
+
+#endif /* ULMK_CONFIG_STACK_WATERMARK */
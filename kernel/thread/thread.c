@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <string.h>
 #include <ulmk/microkernel.h>
 #include <ulmk/config.h>
 #include <kernel/include/ulmk_thread_internal.h>
@@ -16,6 +17,9 @@
 #include <kernel/include/ulmk_mem_internal.h>
 #include <kernel/include/ulmk_ep_internal.h>
 #include <kernel/include/ulmk_notif_internal.h>
+#include <kernel/include/ulmk_waitset_internal.h>
+#include <kernel/include/ulmk_domain_internal.h>
+#include <kernel/include/ulmk_irq_internal.h>
 #include <kernel/include/ulmk_timeout_internal.h>
 #include <kernel/syscall/syscall_router.h>
 #include <ulmk_arch.h>
@@ -61,6 +65,10 @@ static void tcb_registry_ensure_init(void)
 
 int ulmk_thread_init(ulmk_thread_t *th, const ulmk_thread_attr_t *attr, void *stack)
 {
+#if UL_MPU_LAZY
+	uint32_t i;
+#endif
+
 	if (!th || !attr || !stack || !attr->entry)
 		return ULMK_EINVAL;
 	if (attr->stack_size == 0)
@@ -68,6 +76,7 @@ int ulmk_thread_init(ulmk_thread_t *th, const ulmk_thread_attr_t *attr, void *st
 
 	sys_dnode_init(&th->sched_node);
 	sys_dnode_init(&th->ipc_node);
+	sys_dnode_init(&th->notif_node);
 	sys_dnode_init(&th->reg_node);
 	sys_dnode_init(&th->timeout.node);
 	th->timeout.cb = NULL;
@@ -102,8 +111,27 @@ int ulmk_thread_init(ulmk_thread_t *th, const ulmk_thread_attr_t *attr, void *st
 	th->ipc_sender_outptr = NULL;
 	th->notif_bits_outptr  = NULL;
 	th->rn_result_outptr   = NULL;
+	th->blocked_ws         = NULL;
+	th->ws_event_outptr    = NULL;
+	th->irq_bound          = 0u;
+	th->irq_boosted        = 0u;
 	th->wcet_out          = NULL;
 	th->region_count      = 0u;
+	th->domain            = NULL;
+#if UL_MPU_LAZY
+	th->lazy_regions = NULL;
+	th->lazy_count   = 0u;
+	th->lazy_cap     = 0u;
+	th->lazy_clock   = 0u;
+	for (i = 0u; i < (uint32_t)ULMK_ARCH_NUM_CPU; i++)
+		th->lazy_stale[i] = 0u;
+#endif
+#if ULMK_CONFIG_THREAD_STATS
+	memset(&th->stats, 0, sizeof(th->stats));
+	th->stats.cpu     = th->cpu;
+	th->acct_ready_ok = 0u;
+	th->acct_yield    = 0u;
+#endif
 
 	th->cap_flags = (attr->privilege == ULMK_PRIV_KERNEL) ? ULMK_CAP_ALL : 0u;
 	/*
@@ -114,6 +142,12 @@ int ulmk_thread_init(ulmk_thread_t *th, const ulmk_thread_attr_t *attr, void *st
 	if (attr->privilege == ULMK_PRIV_DRIVER)
 		th->cap_flags |= (uint8_t)(ULMK_CAP_MAP_PERIPH | ULMK_CAP_IRQ);
 
+	/*
+	 * Paint before ctx_init: ports that build the first frame on the
+	 * stack (RISC-V) then write over the top of the pattern.
+	 */
+	ulmk_thread_stack_paint(th);
+
 	/*
 	 * Every non-kernel thread gets its stack as a default R+W MPU region.
 	 */
@@ -206,6 +240,35 @@ void ulmk_thread_set_state(ulmk_thread_t *th, uint8_t state)
 	th->state = state;
 }
 
+/*
+ * Return the anonymous maps and out-of-place heap extensions @th never
+ * unmapped (ULMK_REGION_HEAP, resident or spilled), as ulmk_kern_mem_unmap()
+ * would, then the spill table itself.
+ */
+static void thread_free_heap_regions(ulmk_thread_t *th)
+{
+	uint8_t  i;
+#if UL_MPU_LAZY
+	uint16_t j;
+#endif
+
+	for (i = 0u; i < th->region_count; i++) {
+		if (th->regions[i].type == ULMK_REGION_HEAP)
+			ulmk_heap_free((void *)th->regions[i].base);
+	}
+#if UL_MPU_LAZY
+	for (j = 0u; j < th->lazy_count; j++) {
+		if (th->lazy_regions[j].type == ULMK_REGION_HEAP)
+			ulmk_heap_free((void *)th->lazy_regions[j].base);
+	}
+	th->lazy_count = 0u;
+	if (th->lazy_regions) {
+		ulmk_heap_free(th->lazy_regions);
+		th->lazy_regions = NULL;
+	}
+#endif
+}
+
 /*
  * Unlink a TCB from the global registry list and free its heap memory.
  * Stack is freed first (it was allocated from the heap), then the TCB.
@@ -214,6 +277,7 @@ void ulmk_thread_set_state(ulmk_thread_t *th, uint8_t state)
  */
 void ulmk_thread_free(ulmk_thread_t *th)
 {
+	ulmk_thread_stack_report(th);
 	ulmk_timeout_disarm(th);
 
 	if (sys_dnode_is_linked(&th->reg_node)) {
@@ -221,6 +285,9 @@ void ulmk_thread_free(ulmk_thread_t *th)
 		sys_dnode_init(&th->reg_node);
 	}
 
+	ulmk_domain_detach(th);
+	thread_free_heap_regions(th);
+
 	/*
 	 * Static threads (idle, root) have slab_base == NULL; their TCB and
 	 * stack live in linker-reserved sections and must not be passed to
@@ -254,6 +321,9 @@ uint32_t ulmk_kern_yield(void)
 
 	if (cur) {
 		cur->state = UL_THREAD_STATE_READY;
+#if ULMK_CONFIG_THREAD_STATS
+		cur->acct_yield = 1u;
+#endif
 		ulmk_sched_dequeue(cur);
 		ulmk_sched_enqueue(cur);
 		/* Equal-prio FIFO rotation — enqueue alone may not preempt. */
@@ -273,6 +343,8 @@ uint32_t ulmk_kern_exit(void)
 	ulmk_thread_t *cur = ulmk_sched_current();
 
 	if (cur) {
+		if (cur->irq_bound)
+			ulmk_irq_thread_release(cur);
 		cur->state = UL_THREAD_STATE_DEAD;
 		ulmk_sched_dequeue(cur);
 		ulmk_sched_set_dead_for_cleanup(cur);
@@ -320,6 +392,9 @@ uint32_t ulmk_kern_thread_spawn(uint32_t attr_ptr)
 #endif
 	attr.stack_size += ULMK_ARCH_KSTACK_SIZE;
 
+	if (attr.domain != ULMK_DOMAIN_INVALID && !ulmk_domain_by_id(attr.domain))
+		return (uint32_t)ULMK_TID_INVALID;
+
 	heap_size = attr.heap_size;
 	slab_size = attr.stack_size + heap_size;
 
@@ -355,6 +430,18 @@ uint32_t ulmk_kern_thread_spawn(uint32_t attr_ptr)
 		th->regions[0].size = slab_size;
 	}
 
+	/*
+	 * Join the shared protection domain last: the thread is registered
+	 * by now, so a domain destroyed since the check above is unwound
+	 * through the normal free path.
+	 */
+	if (attr.domain != ULMK_DOMAIN_INVALID &&
+	    ulmk_domain_attach(th, attr.domain) != ULMK_OK) {
+		ulmk_arch_ctx_free(&th->ctx);
+		ulmk_thread_free(th);
+		return (uint32_t)ULMK_TID_INVALID;
+	}
+
 	ulmk_sched_enqueue(th);
 #ifdef THREAD_UNIT_TEST
 	return (uint32_t)th->tid;
@@ -389,8 +476,8 @@ uint32_t ulmk_kern_thread_kill(uint32_t tid)
 	ulmk_timeout_disarm(th);
 
 	/*
-	 * Drop from IPC queues (send or recv share ipc_node) and clear any
-	 * notif waiter slot before the TCB disappears.
+	 * Drop from IPC queues (send or recv share ipc_node) and from any
+	 * notif wait queue before the TCB disappears.
 	 */
 	if (th->blocked_reason == UL_BLOCKED_IPC_CALL ||
 	    th->blocked_reason == UL_BLOCKED_IPC_RECV ||
@@ -398,12 +485,13 @@ uint32_t ulmk_kern_thread_kill(uint32_t tid)
 		ulmk_ep_recv_queue_remove(th);
 
 	if (th->blocked_notif != ULMK_NOTIF_INVALID) {
-		ulmk_notif_obj_t *n = ulmk_notif_by_id(th->blocked_notif);
-
-		if (n && n->waiter == th)
-			n->waiter = NULL;
+		ulmk_notif_waiter_remove(th);
 		th->blocked_notif = ULMK_NOTIF_INVALID;
 	}
+	if (th->blocked_reason == UL_BLOCKED_WAITSET)
+		ulmk_waitset_waiter_remove(th);
+	if (th->irq_bound)
+		ulmk_irq_thread_release(th);
 
 	/*
 	 * Mid-rendezvous: this thread already received a call and has not
@@ -496,6 +584,34 @@ uint32_t ulmk_kern_thread_get_prio(uint32_t tid)
 	return (uint32_t)th->priority;
 }
 
+/*
+ * thread_stats — copy @tid's run-time counters (0 = the caller).  The
+ * caller's own CPU time is charged up to now first.  Gating of foreign
+ * tids (ULMK_CAP_STATS) is done by the router.
+ */
+uint32_t ulmk_kern_thread_stats(uint32_t tid, uint32_t out_ptr)
+{
+#if ULMK_CONFIG_THREAD_STATS
+	ulmk_thread_stats_t *out = (ulmk_thread_stats_t *)(uintptr_t)out_ptr;
+	ulmk_thread_t       *th;
+
+	if (!out)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+	th = tid ? ulmk_thread_by_tid((ulmk_tid_t)tid) : ulmk_sched_current();
+	if (!th || th->state == UL_THREAD_STATE_DEAD)
+		return (uint32_t)(int32_t)ULMK_ESRCH;
+
+	if (th == ulmk_sched_current())
+		ulmk_sched_acct_tick();
+	*out = th->stats;
+	return (uint32_t)ULMK_OK;
+#else
+	(void)tid;
+	(void)out_ptr;
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+#endif
+}
+
 uint32_t ulmk_kern_cap_grant(uint32_t target_tid, uint32_t caps)
 {
 	ulmk_thread_t *cur    = ulmk_sched_current();
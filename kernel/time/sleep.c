@@ -57,12 +57,12 @@ static void sleep_timeout_cb(struct ulmk_timeout *to)
 #endif
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_thread);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
 #endif
 	if (!th || th->state != UL_THREAD_STATE_BLOCKED ||
 	    th->blocked_reason != UL_BLOCKED_SLEEP) {
 #ifndef UL_UNIT_TEST
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_thread, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
 #endif
 		return;
 	}
@@ -72,7 +72,7 @@ static void sleep_timeout_cb(struct ulmk_timeout *to)
 	th->state          = UL_THREAD_STATE_READY;
 	ulmk_sched_enqueue(th);
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_thread, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
 	ulmk_sched_request_resched();
 	ulmk_sched_kick_pending();
 #endif
@@ -90,7 +90,7 @@ uint32_t ulmk_kern_sleep(uint32_t ms)
 	if (!cur)
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_thread);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
 
 	cur->blocked_reason = UL_BLOCKED_SLEEP;
 	cur->block_status   = 0;
@@ -99,12 +99,12 @@ uint32_t ulmk_kern_sleep(uint32_t ms)
 	if (ulmk_timeout_arm(cur, ms, sleep_timeout_cb) != ULMK_OK) {
 		cur->state          = UL_THREAD_STATE_READY;
 		cur->blocked_reason = UL_BLOCKED_NONE;
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_thread, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 	}
 
 	ulmk_sched_dequeue(cur);
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_thread, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
 	return 0u;
 }
 
@@ -117,11 +117,11 @@ uint32_t ulmk_kern_sleep_cancel(uint32_t tid)
 	if (!th)
 		return (uint32_t)(int32_t)ULMK_ESRCH;
 
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_thread);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_thread);
 
 	if (th->state != UL_THREAD_STATE_BLOCKED ||
 	    th->blocked_reason != UL_BLOCKED_SLEEP) {
-		ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_thread, key);
+		ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
 		return (uint32_t)(int32_t)ULMK_EINVAL;
 	}
 
@@ -130,7 +130,7 @@ uint32_t ulmk_kern_sleep_cancel(uint32_t tid)
 	th->blocked_reason = UL_BLOCKED_NONE;
 	th->state          = UL_THREAD_STATE_READY;
 	ulmk_sched_enqueue(th);
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_thread, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_thread, key);
 #ifndef UL_UNIT_TEST
 	ulmk_sched_request_resched();
 	ulmk_sched_kick_pending();
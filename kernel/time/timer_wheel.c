@@ -15,6 +15,7 @@
 #include <ulmk/microkernel.h>
 #include <kernel/include/ulmk_timer.h>
 #include <kernel/include/ulmk_percpu.h>
+#include <kernel/include/ulmk_trace.h>
 #ifndef UL_UNIT_TEST
 #include <kernel/include/ulmk_klock.h>
 #include <ulmk_arch.h>
@@ -134,7 +135,7 @@ int ulmk_timer_add(struct ulmk_timeout *to, uint32_t delta_ticks)
 		return ULMK_EINVAL;
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_timer);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_timer);
 #endif
 	w = wheel_of();
 
@@ -147,7 +148,7 @@ int ulmk_timer_add(struct ulmk_timeout *to, uint32_t delta_ticks)
 	w->pending[lvl] |= (1ull << bucket);
 
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_timer, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_timer, key);
 #endif
 	return ULMK_OK;
 }
@@ -163,7 +164,7 @@ bool ulmk_timer_cancel(struct ulmk_timeout *to)
 		return false;
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_timer);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_timer);
 #endif
 	if (sys_dnode_is_linked(&to->node)) {
 		sys_dlist_remove(&to->node);
@@ -175,7 +176,7 @@ bool ulmk_timer_cancel(struct ulmk_timeout *to)
 		 */
 	}
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_timer, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_timer, key);
 #endif
 	return removed;
 }
@@ -210,6 +211,7 @@ static void expire_list(sys_dlist_t *list)
 
 		sys_dlist_remove(node);
 		sys_dnode_init(node);
+		UL_TRACE(ULMK_TRACE_TIMER_EXPIRE, (uintptr_t)to, (uintptr_t)to->cb);
 		if (to->cb)
 			to->cb(to);
 	}
@@ -227,7 +229,7 @@ void ulmk_timer_run(void)
 	sys_dlist_init(&pending);
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_timer);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_timer);
 #endif
 	w = wheel_of();
 
@@ -247,7 +249,7 @@ void ulmk_timer_run(void)
 	}
 
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_timer, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_timer, key);
 #endif
 
 	/* Callbacks run with the timer lock released. */
@@ -285,11 +287,11 @@ void ulmk_timer_tick(void)
 	sys_dlist_init(&pending);
 
 #ifndef UL_UNIT_TEST
-	key = ulmk_arch_spin_lock_irqsave(&g_ulmk_lock_timer);
+	key = ulmk_klock_irqsave(&g_ulmk_lock_timer);
 #endif
 	wheel_advance_collect(wheel_of(), &pending);
 #ifndef UL_UNIT_TEST
-	ulmk_arch_spin_unlock_irqrestore(&g_ulmk_lock_timer, key);
+	ulmk_klock_irqrestore(&g_ulmk_lock_timer, key);
 #endif
 
 	expire_list(&pending);
@@ -0,0 +1,143 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Kernel event trace — kernel/trace/trace.c
+ * Reference: docs/api_spec.md §15
+ *
+ * One ring per CPU, written only by that CPU from kernel context (IRQs are
+ * masked across the kernel gateway, so a record is never interleaved with
+ * another on the same CPU).  Writers take no lock and never wait; the
+ * oldest record is overwritten.  A record is stamped with ~seq while being
+ * filled and with seq once complete, so ulmk_trace_read() on another CPU
+ * drops anything torn or recycled under it.
+ */
+
+#include <stdint.h>
+#include <ulmk/microkernel.h>
+#include <ulmk/config.h>
+#include <kernel/include/ulmk_trace.h>
+#include <kernel/include/ulmk_mem_internal.h>
+#include <kernel/include/ulmk_percpu.h>
+#include <ulmk_arch.h>
+
+#if ULMK_CONFIG_TRACE_ENTRIES > 0
+
+#if (ULMK_CONFIG_TRACE_ENTRIES & (ULMK_CONFIG_TRACE_ENTRIES - 1)) != 0
+#error "ULMK_CONFIG_TRACE_ENTRIES must be a power of two"
+#endif
+
+#define TRACE_MASK	((uint32_t)ULMK_CONFIG_TRACE_ENTRIES - 1u)
+
+struct trace_ring {
+	volatile uint32_t head;		/* next record number */
+	ulmk_trace_rec_t  rec[ULMK_CONFIG_TRACE_ENTRIES];
+};
+
+static struct trace_ring UL_KERNEL_BSS g_trace[ULMK_NR_CPUS];
+
+volatile uint32_t UL_KERNEL_BSS g_ulmk_trace_mask;
+
+void ulmk_trace_init(void)
+{
+	g_ulmk_trace_mask = ULMK_TRACE_ALL;
+}
+
+void ulmk_trace_emit(uint32_t ev, uint32_t a, uint32_t b)
+{
+	uint32_t           cpu = ulmk_arch_cpu_id();
+	struct trace_ring *r;
+	ulmk_trace_rec_t  *rec;
+	uint32_t           seq;
+
+	if (cpu >= (uint32_t)ULMK_NR_CPUS)
+		return;
+	r   = &g_trace[cpu];
+	seq = r->head;
+	rec = &r->rec[seq & TRACE_MASK];
+
+	*(volatile uint32_t *)&rec->seq = ~seq;
+	ulmk_arch_wmb();
+	rec->ts  = ulmk_arch_cycle_read();
+	rec->ev  = (uint16_t)ev;
+	rec->cpu = (uint8_t)cpu;
+	rec->a   = a;
+	rec->b   = b;
+	ulmk_arch_wmb();
+	*(volatile uint32_t *)&rec->seq = seq;
+	r->head = seq + 1u;
+}
+
+/* =========================================================================
+ * Syscall handlers
+ * ========================================================================= */
+
+uint32_t ulmk_kern_trace_mask(uint32_t mask)
+{
+	uint32_t old = g_ulmk_trace_mask;
+
+	g_ulmk_trace_mask = mask & ULMK_TRACE_ALL;
+	return old;
+}
+
+/*
+ * read — copy up to @max records of @cpu from record number *@pos on and
+ * advance *@pos past them.  A cursor that fell behind the ring restarts at
+ * the oldest record still held; the jump shows up as a seq gap.
+ */
+uint32_t ulmk_kern_trace_read(uint32_t cpu, uint32_t pos_ptr,
+			      uint32_t buf_ptr, uint32_t max)
+{
+	uint32_t               *pos = (uint32_t *)(uintptr_t)pos_ptr;
+	ulmk_trace_rec_t       *buf = (ulmk_trace_rec_t *)(uintptr_t)buf_ptr;
+	struct trace_ring      *r;
+	const ulmk_trace_rec_t *src;
+	uint32_t                head;
+	uint32_t                seq;
+	uint32_t                n = 0u;
+
+	if (!pos || !buf || cpu >= (uint32_t)ULMK_ARCH_NUM_CPU)
+		return (uint32_t)(int32_t)ULMK_EINVAL;
+	if (cpu >= (uint32_t)ULMK_NR_CPUS)
+		return 0u;
+
+	r    = &g_trace[cpu];
+	head = r->head;
+	ulmk_arch_rmb();
+	seq  = *pos;
+	if (head - seq > (uint32_t)ULMK_CONFIG_TRACE_ENTRIES)
+		seq = head - (uint32_t)ULMK_CONFIG_TRACE_ENTRIES;
+
+	for (; seq != head && n < max; seq++) {
+		src = &r->rec[seq & TRACE_MASK];
+		if (*(const volatile uint32_t *)&src->seq != seq)
+			continue;
+		ulmk_arch_rmb();
+		buf[n] = *src;
+		ulmk_arch_rmb();
+		if (*(const volatile uint32_t *)&src->seq != seq)
+			continue;
+		buf[n].seq = seq;
+		n++;
+	}
+	*pos = seq;
+	return n;
+}
+
+#else /* ULMK_CONFIG_TRACE_ENTRIES == 0 */
+
+uint32_t ulmk_kern_trace_mask(uint32_t mask)
+{
+	(void)mask;
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+}
+
+uint32_t ulmk_kern_trace_read(uint32_t cpu, uint32_t pos_ptr,
+			      uint32_t buf_ptr, uint32_t max)
+{
+	(void)cpu;
+	(void)pos_ptr;
+	(void)buf_ptr;
+	(void)max;
+	return (uint32_t)(int32_t)ULMK_ENOTSUP;
+}
+
+#endif /* ULMK_CONFIG_TRACE_ENTRIES */
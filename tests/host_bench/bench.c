@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Runner for the host micro-benchmarks — see bench.h.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+
+#define BENCH_MAX_ITERS		1000000000ull
+#define BENCH_NAME_MAX		64
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void bench_start(bench_t *b)
+{
+	if (!b->running) {
+		b->running = 1;
+		b->t0      = now_ns();
+	}
+}
+
+void bench_stop(bench_t *b)
+{
+	if (b->running) {
+		b->ns     += now_ns() - b->t0;
+		b->running = 0;
+	}
+}
+
+static int g_failed;
+
+/* One run of @c with @n iterations; returns the timed ns, items in *@items. */
+static uint64_t run_once(const bench_case_t *c, uint64_t n, uint64_t *items)
+{
+	bench_t b;
+
+	memset(&b, 0, sizeof(b));
+	b.n = n;
+	c->fn(&b, c->arg);
+	bench_stop(&b);
+	*items = b.items ? b.items : n;
+	if (b.failed)
+		g_failed = 1;
+	return b.ns;
+}
+
+/*
+ * Grow the iteration count until a run lasts @min_ns, predicting the
+ * next count from the last one with 40% headroom, at most 10x per step.
+ */
+static uint64_t calibrate(const bench_case_t *c, uint64_t min_ns)
+{
+	uint64_t n = 1u;
+	uint64_t items;
+	uint64_t ns;
+	uint64_t next;
+
+	for (;;) {
+		ns = run_once(c, n, &items);
+		if (ns >= min_ns || n >= BENCH_MAX_ITERS)
+			return n;
+		if (ns == 0u)
+			next = n * 10u;
+		else
+			next = (uint64_t)((double)n * 1.4 * (double)min_ns /
+					  (double)ns);
+		if (next > n * 10u)
+			next = n * 10u;
+		if (next <= n)
+			next = n + 1u;
+		n = next > BENCH_MAX_ITERS ? BENCH_MAX_ITERS : next;
+	}
+}
+
+static void case_name(const bench_case_t *c, char *buf, size_t len)
+{
+	if (c->arg)
+		snprintf(buf, len, "%s/%ld", c->name, c->arg);
+	else
+		snprintf(buf, len, "%s", c->name);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"usage: %s [--filter=<substr>] [--min-time=<ms>] [--reps=<n>] "
+		"[--list]\n", prog);
+}
+
+int bench_main(int argc, char **argv, const bench_case_t *cases)
+{
+	const bench_case_t *c;
+	const char         *filter = NULL;
+	char                name[BENCH_NAME_MAX];
+	uint64_t            min_ns = 100000000ull;
+	unsigned long       reps   = 3u;
+	int                 list   = 0;
+	int                 status = 0;
+	int                 i;
+
+	for (i = 1; i < argc; i++) {
+		if (strncmp(argv[i], "--filter=", 9) == 0) {
+			filter = argv[i] + 9;
+		} else if (strncmp(argv[i], "--min-time=", 11) == 0) {
+			min_ns = strtoull(argv[i] + 11, NULL, 0) * 1000000ull;
+		} else if (strncmp(argv[i], "--reps=", 7) == 0) {
+			reps = strtoul(argv[i] + 7, NULL, 0);
+		} else if (strcmp(argv[i], "--list") == 0) {
+			list = 1;
+		} else {
+			usage(argv[0]);
+			return 2;
+		}
+	}
+	if (reps == 0u)
+		reps = 1u;
+
+	if (!list)
+		printf("%-32s %12s %10s %10s %10s\n", "case", "iters",
+		       "ns/item", "avg", "Mitems/s");
+
+	for (c = cases; c->name; c++) {
+		uint64_t      n;
+		uint64_t      items = 0u;
+		uint64_t      ns;
+		double        best  = 0.0;
+		double        sum   = 0.0;
+		double        per;
+		unsigned long r;
+
+		case_name(c, name, sizeof(name));
+		if (filter && !strstr(name, filter))
+			continue;
+		if (list) {
+			printf("%s\n", name);
+			continue;
+		}
+
+		g_failed = 0;
+		n = calibrate(c, min_ns);
+		for (r = 0u; r < reps; r++) {
+			ns  = run_once(c, n, &items);
+			per = (double)ns / (double)items;
+			if (r == 0u || per < best)
+				best = per;
+			sum += per;
+		}
+		if (g_failed) {
+			printf("%-32s FAIL\n", name);
+			status = 1;
+		} else {
+			printf("%-32s %12llu %10.2f %10.2f %10.2f\n", name,
+			       (unsigned long long)items, best,
+			       sum / (double)reps, best > 0.0 ? 1e3 / best : 0.0);
+		}
+		fflush(stdout);
+	}
+	return status;
+}
@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Host micro-benchmark harness for kernel data structures.
+ *
+ * Each bench_*.c links one kernel module against the stub headers of the
+ * matching tests/<name>_unit directory and registers its cases in a table:
+ *
+ *   static void bm_alloc_free(bench_t *b, long arg)
+ *   {
+ *           setup(arg);                    (untimed: the clock starts
+ *           bench_start(b);                 at bench_start())
+ *           for (i = 0; i < b->n; i++)
+ *                   op();
+ *   }
+ *
+ *   static const bench_case_t cases[] = {
+ *           { "tlsf/alloc_free", bm_alloc_free, 64 },
+ *           { NULL, NULL, 0 }
+ *   };
+ *
+ *   int main(int argc, char **argv) { return bench_main(argc, argv, cases); }
+ *
+ * As with Google benchmark, the runner grows b->n until one run lasts
+ * --min-time, then repeats that run --reps times and reports the fastest
+ * and mean time per item.  An item is one iteration unless the case adds
+ * its own count to b->items (a batch case doing N ops per iteration).
+ * bench_stop()/bench_start() pause the clock around per-iteration setup.
+ * A case that fails a BENCH_CHECK() is reported as FAIL and the runner
+ * exits non-zero.
+ */
+
+#ifndef UL_HOST_BENCH_H
+#define UL_HOST_BENCH_H
+
+#include <stdint.h>
+
+typedef struct bench {
+	uint64_t n;		/* iterations to run */
+	uint64_t items;		/* items processed; 0 means n */
+	uint64_t ns;		/* accumulated timed nanoseconds */
+	uint64_t t0;		/* clock at the last bench_start() */
+	int      running;
+	int      failed;	/* set by BENCH_CHECK() */
+} bench_t;
+
+typedef struct bench_case {
+	const char *name;
+	void      (*fn)(bench_t *b, long arg);
+	long        arg;	/* printed as a /<arg> name suffix when non-zero */
+} bench_case_t;
+
+void bench_start(bench_t *b);
+void bench_stop(bench_t *b);
+
+/*
+ * Fail the case (and the run's exit status) when @cond is false, so a
+ * hot-path change that stops taking the measured path is not reported as
+ * a speed-up.  Check after the timed loop, not inside it.
+ */
+#define BENCH_CHECK(b, cond)	do { if (!(cond)) (b)->failed = 1; } while (0)
+
+/* xorshift32: repeatable input patterns; *@s must start non-zero. */
+static inline uint32_t bench_rand(uint32_t *s)
+{
+	uint32_t x = *s;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*s = x;
+	return x;
+}
+
+/*
+ * Options: --filter=<substr> runs only cases whose name contains it,
+ * --min-time=<ms> (default 100), --reps=<n> (default 3), --list.
+ * Returns the process exit status: 1 if any case failed.
+ */
+int bench_main(int argc, char **argv, const bench_case_t *cases);
+
+#endif /* UL_HOST_BENCH_H */
@@ -0,0 +1,296 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * IPC rendezvous throughput (kernel/ipc/ep.c, kernel/notif/notif.c).
+ *
+ * Same stubs as ipc_unit: blocking only changes thread state and queues,
+ * the switch itself is deferred to trap exit and not part of the numbers.
+ * g_current plays the thread that would be running at each step.
+ *
+ * Cases:
+ *   ep/call_recv_reply     server parked in recv; call hands off on the fast
+ *                          path, reply wakes the caller, server recvs again
+ *   ep/call_reply_recv     the same round trip with the combined
+ *                          reply_recv of a server loop
+ *   ep/send_first          caller queues first (no server waiting); recv
+ *                          takes it on its fast path, then reply
+ *   notif/signal_wait      waiter blocks, signal wakes it
+ *   notif/signal_poll      signal with no waiter, poll consumes the bit
+ *   notif/broadcast/<n>    broadcast wakes <n> blocked waiters
+ *
+ * An item is one round trip, one wake or one signal/poll pair; broadcast
+ * counts each woken waiter.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../ipc_unit/include/ulmk_arch.h"
+#include "../ipc_unit/include/ulmk/microkernel.h"
+#include "../ipc_unit/include/ulmk/config.h"
+#include "../../kernel/include/ulmk_thread_internal.h"
+#include "../../kernel/include/ulmk_sched.h"
+#include "../../kernel/include/ulmk_ep_internal.h"
+#include "../../kernel/include/ulmk_notif_internal.h"
+#include "../../kernel/include/ulmk_waitset_internal.h"
+#include "../../kernel/syscall/syscall_router.h"
+
+#include "bench.h"
+
+#define MAX_WAITERS	32u
+
+/* ── Scheduler, registry and timeout stubs (as ipc_unit) ──────────────── */
+
+static ulmk_thread_t *g_current;
+
+ulmk_thread_t *ulmk_sched_current(void)   { return g_current; }
+void ulmk_sched_enqueue(ulmk_thread_t *t) { t->state = UL_THREAD_STATE_READY; }
+void ulmk_sched_dequeue(ulmk_thread_t *t) { (void)t; }
+void ulmk_sched_enqueue_locked(ulmk_thread_t *t) { ulmk_sched_enqueue(t); }
+void ulmk_sched_dequeue_locked(ulmk_thread_t *t) { ulmk_sched_dequeue(t); }
+void ulmk_sched_enqueue_list(sys_dlist_t *list)
+{
+	sys_dnode_t *dn;
+
+	while ((dn = sys_dlist_get(list)) != NULL) {
+		sys_dnode_init(dn);
+		ulmk_sched_enqueue(SYS_DLIST_CONTAINER_OF(dn, ulmk_thread_t,
+							  sched_node));
+	}
+}
+void ulmk_sched_resched(void)           { }
+void ulmk_sched_request_resched(void)   { }
+
+ulmk_thread_t *ulmk_thread_by_tid(ulmk_tid_t tid)
+{
+	ulmk_thread_t *th = (ulmk_thread_t *)tid;
+
+	if (tid == ULMK_TID_INVALID || !th)
+		return NULL;
+	if (th->state == UL_THREAD_STATE_DEAD)
+		return NULL;
+	return th;
+}
+
+uint32_t ulmk_ms_to_ticks(uint32_t ms)
+{
+	return ms ? ms : 1u;
+}
+
+int ulmk_timeout_arm(ulmk_thread_t *th, uint32_t ms,
+		     void (*cb)(struct ulmk_timeout *to))
+{
+	(void)ms;
+	(void)cb;
+	return th ? ULMK_OK : ULMK_EINVAL;
+}
+
+void ulmk_timeout_disarm(ulmk_thread_t *th)
+{
+	(void)th;
+}
+
+/* ── Helpers ───────────────────────────────────────────────────────────── */
+
+extern ulmk_endpoint_t  ep_pool[];
+extern ulmk_notif_obj_t notif_pool[];
+
+static ulmk_thread_t g_th[MAX_WAITERS + 2u];
+
+static void make_thread(ulmk_thread_t *t, uint8_t prio)
+{
+	memset(t, 0, sizeof(*t));
+	t->tid            = (ulmk_tid_t)(uintptr_t)t;
+	t->priority       = prio;
+	t->saved_prio     = prio;
+	t->state          = UL_THREAD_STATE_READY;
+	t->blocked_reason = UL_BLOCKED_NONE;
+	t->blocked_ep     = ULMK_EP_INVALID;
+	t->blocked_notif  = ULMK_NOTIF_INVALID;
+	t->ipc_sender     = ULMK_TID_INVALID;
+	sys_dnode_init(&t->sched_node);
+	sys_dnode_init(&t->ipc_node);
+	sys_dnode_init(&t->notif_node);
+	sys_dnode_init(&t->reg_node);
+}
+
+/* Fresh pools, endpoint 0 and notification 0, caller g_th[0] (prio 5)
+ * and server g_th[1] (prio 20). */
+static void reset(void)
+{
+	memset(ep_pool, 0, sizeof(ulmk_endpoint_t) * ULMK_CONFIG_MAX_ENDPOINTS);
+	memset(notif_pool, 0, sizeof(ulmk_notif_obj_t) * ULMK_CONFIG_MAX_NOTIFS);
+	(void)ulmk_kern_ep_create();
+	(void)ulmk_kern_notif_create();
+	make_thread(&g_th[0], 5u);
+	make_thread(&g_th[1], 20u);
+}
+
+/* ── Endpoints ─────────────────────────────────────────────────────────── */
+
+static void bm_call_recv_reply(bench_t *b, long arg)
+{
+	ulmk_thread_t *caller = &g_th[0];
+	ulmk_thread_t *server = &g_th[1];
+	ulmk_msg_t     req    = { .label = 0x11u };
+	ulmk_msg_t     rep    = { .label = 0x22u };
+	ulmk_msg_t     in;
+	ulmk_tid_t     sender = ULMK_TID_INVALID;
+	uint64_t       i;
+	int            rc = 0;
+
+	reset();
+	g_current = server;
+	(void)ep_recv_impl(0, &in, &sender);
+
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		g_current = caller;
+		rc |= ep_call_impl(0, &req);
+		g_current = server;
+		rc |= ep_reply_impl(sender, &rep);
+		rc |= ep_recv_impl(0, &in, &sender);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, rc == 0 && sender == caller->tid &&
+		       caller->state == UL_THREAD_STATE_READY &&
+		       server->blocked_reason == UL_BLOCKED_IPC_RECV);
+}
+
+static void bm_call_reply_recv(bench_t *b, long arg)
+{
+	ulmk_thread_t *caller = &g_th[0];
+	ulmk_thread_t *server = &g_th[1];
+	ulmk_msg_t     req    = { .label = 0x11u };
+	ulmk_msg_t     rep    = { .label = 0x22u };
+	ulmk_msg_t     in;
+	ulmk_tid_t     sender = ULMK_TID_INVALID;
+	uint64_t       i;
+	int            rc = 0;
+
+	reset();
+	g_current = server;
+	(void)ep_recv_impl(0, &in, &sender);
+
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		g_current = caller;
+		rc |= ep_call_impl(0, &req);
+		g_current = server;
+		rc |= ep_reply_recv_impl(0, sender, &rep, &in, &sender);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, rc == 0 && sender == caller->tid &&
+		       caller->state == UL_THREAD_STATE_READY &&
+		       server->blocked_reason == UL_BLOCKED_IPC_RECV);
+}
+
+static void bm_send_first(bench_t *b, long arg)
+{
+	ulmk_thread_t *caller = &g_th[0];
+	ulmk_thread_t *server = &g_th[1];
+	ulmk_msg_t     req    = { .label = 0x11u };
+	ulmk_msg_t     rep    = { .label = 0x22u };
+	ulmk_msg_t     in;
+	ulmk_tid_t     sender = ULMK_TID_INVALID;
+	uint64_t       i;
+	int            rc = 0;
+
+	reset();
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		g_current = caller;
+		rc |= ep_call_impl(0, &req);
+		g_current = server;
+		rc |= ep_recv_impl(0, &in, &sender);
+		rc |= ep_reply_impl(sender, &rep);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, rc == 0 && sender == caller->tid &&
+		       caller->state == UL_THREAD_STATE_READY &&
+		       server->state == UL_THREAD_STATE_READY);
+}
+
+/* ── Notifications ─────────────────────────────────────────────────────── */
+
+static void bm_signal_wait(bench_t *b, long arg)
+{
+	ulmk_thread_t *waiter = &g_th[1];
+	uint32_t       bits;
+	uint64_t       i;
+	int            rc = 0;
+
+	reset();
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		g_current = waiter;
+		rc |= notif_wait_impl(0, 0x1u, &bits);
+		g_current = &g_th[0];
+		rc |= notif_signal_impl(0, 0x1u);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, rc == 0 && waiter->state == UL_THREAD_STATE_READY &&
+		       waiter->notif_received == 0x1u);
+}
+
+static void bm_signal_poll(bench_t *b, long arg)
+{
+	uint32_t got = 0x1u;
+	uint64_t i;
+	int      rc  = 0;
+
+	reset();
+	g_current = &g_th[0];
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		rc |= notif_signal_impl(0, 0x1u);
+		got &= notif_poll_impl(0, 0x1u);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, rc == 0 && got == 0x1u);
+}
+
+static void bm_broadcast(bench_t *b, long n)
+{
+	uint32_t bits[MAX_WAITERS];
+	uint32_t k;
+	uint64_t i;
+	int      rc = 0;
+
+	reset();
+	for (k = 0u; k < (uint32_t)n; k++)
+		make_thread(&g_th[2u + k], 10u);
+
+	for (i = 0u; i < b->n; i++) {
+		bench_stop(b);
+		for (k = 0u; k < (uint32_t)n; k++) {
+			g_current = &g_th[2u + k];
+			(void)notif_wait_impl(0, 0x1u, &bits[k]);
+		}
+		g_current = &g_th[0];
+		bench_start(b);
+		rc |= notif_broadcast_impl(0, 0x1u);
+	}
+	bench_stop(b);
+	for (k = 0u; k < (uint32_t)n; k++)
+		BENCH_CHECK(b, g_th[2u + k].state == UL_THREAD_STATE_READY);
+	BENCH_CHECK(b, rc == 0);
+	b->items = b->n * (uint64_t)n;
+}
+
+static const bench_case_t cases[] = {
+	{ "ep/call_recv_reply",		bm_call_recv_reply,	0 },
+	{ "ep/call_reply_recv",		bm_call_reply_recv,	0 },
+	{ "ep/send_first",		bm_send_first,		0 },
+	{ "notif/signal_wait",		bm_signal_wait,		0 },
+	{ "notif/signal_poll",		bm_signal_poll,		0 },
+	{ "notif/broadcast",		bm_broadcast,		4 },
+	{ "notif/broadcast",		bm_broadcast,		32 },
+	{ NULL, NULL, 0 }
+};
+
+int main(int argc, char **argv)
+{
+	return bench_main(argc, argv, cases);
+}
@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Run-queue throughput of the scheduling classes (kernel/sched/bitmap_rt.c,
+ * with fifo_rt.c as the reference).  The class hooks are called directly,
+ * as the scheduler core does under the run-queue lock.
+ *
+ * Cases, with <n> ready threads at priorities spread over 0..255:
+ *   <class>/pick_requeue/<n>    pick the next thread and enqueue it again
+ *                               (one dispatch plus the yield that follows)
+ *   <class>/enqueue_dequeue/<n> wake and block one random-priority thread
+ *                               next to the <n> ready ones
+ *
+ * An item is one pick + enqueue or one enqueue + dequeue pair.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <kernel/include/ulmk_sched.h>
+
+#include "bench.h"
+
+#define MAX_READY	256u
+
+static ulmk_thread_t g_th[MAX_READY + 1u];
+
+static void make_thread(ulmk_thread_t *t, uint8_t prio)
+{
+	memset(t, 0, sizeof(*t));
+	t->tid      = (ulmk_tid_t)(uintptr_t)t;
+	t->priority = prio;
+	t->state    = UL_THREAD_STATE_READY;
+	sys_dnode_init(&t->sched_node);
+	sys_dnode_init(&t->ipc_node);
+	sys_dnode_init(&t->reg_node);
+}
+
+static void fill(const ulmk_sched_class_t *cls, uint32_t n)
+{
+	uint32_t i;
+
+	cls->init();
+	for (i = 0u; i < n; i++) {
+		make_thread(&g_th[i], (uint8_t)(i * 255u / n));
+		cls->enqueue(&g_th[i]);
+	}
+}
+
+static void pick_requeue(bench_t *b, const ulmk_sched_class_t *cls, long n)
+{
+	ulmk_thread_t *t;
+	uint64_t       i;
+	int            ok = 1;
+
+	fill(cls, (uint32_t)n);
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		t = cls->pick_next();
+		ok &= t != NULL && t->priority == 0u;
+		cls->dequeue(t);
+		cls->enqueue(t);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, ok);
+}
+
+static void enqueue_dequeue(bench_t *b, const ulmk_sched_class_t *cls, long n)
+{
+	ulmk_thread_t *t    = &g_th[MAX_READY];
+	uint32_t       seed = 0x6C8E9CF5u;
+	uint64_t       i;
+
+	fill(cls, (uint32_t)n);
+	make_thread(t, 0u);
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		t->priority = (uint8_t)bench_rand(&seed);
+		cls->enqueue(t);
+		cls->dequeue(t);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, !sys_dnode_is_linked(&t->sched_node) &&
+		       cls->peek_next() == &g_th[0]);
+}
+
+static void bm_bitmap_pick(bench_t *b, long n)
+{
+	pick_requeue(b, &ulmk_bitmap_rt_class, n);
+}
+
+static void bm_bitmap_enq(bench_t *b, long n)
+{
+	enqueue_dequeue(b, &ulmk_bitmap_rt_class, n);
+}
+
+static void bm_fifo_pick(bench_t *b, long n)
+{
+	pick_requeue(b, &ulmk_fifo_rt_class, n);
+}
+
+static void bm_fifo_enq(bench_t *b, long n)
+{
+	enqueue_dequeue(b, &ulmk_fifo_rt_class, n);
+}
+
+static const bench_case_t cases[] = {
+	{ "bitmap_rt/pick_requeue",	bm_bitmap_pick,	1 },
+	{ "bitmap_rt/pick_requeue",	bm_bitmap_pick,	16 },
+	{ "bitmap_rt/pick_requeue",	bm_bitmap_pick,	256 },
+	{ "bitmap_rt/enqueue_dequeue",	bm_bitmap_enq,	1 },
+	{ "bitmap_rt/enqueue_dequeue",	bm_bitmap_enq,	256 },
+	{ "fifo_rt/pick_requeue",	bm_fifo_pick,	1 },
+	{ "fifo_rt/pick_requeue",	bm_fifo_pick,	16 },
+	{ "fifo_rt/pick_requeue",	bm_fifo_pick,	256 },
+	{ "fifo_rt/enqueue_dequeue",	bm_fifo_enq,	1 },
+	{ "fifo_rt/enqueue_dequeue",	bm_fifo_enq,	256 },
+	{ NULL, NULL, 0 }
+};
+
+int main(int argc, char **argv)
+{
+	return bench_main(argc, argv, cases);
+}
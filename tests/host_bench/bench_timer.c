@@ -0,0 +1,166 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Timer wheel throughput (kernel/time/timer_wheel.c).
+ *
+ * Cases, each with <n> timers and random deltas:
+ *   timer/add/<n>         arm <n> timers on an empty wheel (deltas over the
+ *                         whole range, so every level is used)
+ *   timer/rearm/<n>       cancel + re-add one of <n> armed timers; the
+ *                         timeout-refresh pattern of blocking IPC
+ *   timer/cancel/<n>      cancel <n> armed timers
+ *   timer/expire/<n>      tick until <n> timers (deltas 1..4096) all fired;
+ *                         includes the ticks that find nothing due
+ *
+ * An item is one timer.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define UL_UNIT_TEST 1
+
+#include <ulmk/microkernel.h>
+#include <kernel/include/ulmk_timer.h>
+
+#include "bench.h"
+
+#define MAX_TIMERS	100000u
+#define EXPIRE_SPAN	4096u
+
+static struct ulmk_timeout g_to[MAX_TIMERS];
+static uint32_t            g_fired;
+
+static void fire_cb(struct ulmk_timeout *to)
+{
+	(void)to;
+	g_fired++;
+}
+
+static uint32_t any_delta(uint32_t *seed)
+{
+	return 1u + bench_rand(seed) % ULMK_TIMER_TIMEOUT_MAX;
+}
+
+/* Fresh wheel with timers [0, n) initialised but not armed. */
+static void reset(uint32_t n)
+{
+	uint32_t i;
+
+	ulmk_timer_init();
+	g_fired = 0u;
+	for (i = 0u; i < n; i++) {
+		sys_dnode_init(&g_to[i].node);
+		g_to[i].cb = fire_cb;
+	}
+}
+
+static int arm_all(uint32_t n, uint32_t *seed)
+{
+	uint32_t i;
+	int      rc = 0;
+
+	for (i = 0u; i < n; i++)
+		rc |= ulmk_timer_add(&g_to[i], any_delta(seed));
+	return rc;
+}
+
+static void bm_add(bench_t *b, long n)
+{
+	uint32_t seed = 0x9E3779B9u;
+	uint64_t i;
+	int      rc   = 0;
+
+	for (i = 0u; i < b->n; i++) {
+		bench_stop(b);
+		reset((uint32_t)n);
+		bench_start(b);
+		rc |= arm_all((uint32_t)n, &seed);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, rc == ULMK_OK);
+	b->items = b->n * (uint64_t)n;
+}
+
+static void bm_rearm(bench_t *b, long n)
+{
+	uint32_t seed = 0x9E3779B9u;
+	uint32_t k;
+	uint64_t i;
+	bool     ok   = true;
+	int      rc;
+
+	reset((uint32_t)n);
+	rc = arm_all((uint32_t)n, &seed);
+
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		k = bench_rand(&seed) % (uint32_t)n;
+		ok &= ulmk_timer_cancel(&g_to[k]);
+		rc |= ulmk_timer_add(&g_to[k], any_delta(&seed));
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, ok && rc == ULMK_OK);
+}
+
+static void bm_cancel(bench_t *b, long n)
+{
+	uint32_t seed = 0x9E3779B9u;
+	uint32_t k;
+	uint64_t i;
+	bool     ok   = true;
+	int      rc   = 0;
+
+	for (i = 0u; i < b->n; i++) {
+		bench_stop(b);
+		reset((uint32_t)n);
+		rc |= arm_all((uint32_t)n, &seed);
+		bench_start(b);
+		for (k = 0u; k < (uint32_t)n; k++)
+			ok &= ulmk_timer_cancel(&g_to[k]);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, ok && rc == ULMK_OK);
+	b->items = b->n * (uint64_t)n;
+}
+
+static void bm_expire(bench_t *b, long n)
+{
+	uint32_t seed = 0x9E3779B9u;
+	uint32_t k;
+	uint64_t i;
+	int      rc   = 0;
+
+	for (i = 0u; i < b->n; i++) {
+		bench_stop(b);
+		reset((uint32_t)n);
+		for (k = 0u; k < (uint32_t)n; k++)
+			rc |= ulmk_timer_add(&g_to[k],
+					     1u + bench_rand(&seed) % EXPIRE_SPAN);
+		if (rc != ULMK_OK)
+			break;
+		bench_start(b);
+		while (g_fired < (uint32_t)n)
+			ulmk_timer_tick();
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, rc == ULMK_OK);
+	b->items = b->n * (uint64_t)n;
+}
+
+static const bench_case_t cases[] = {
+	{ "timer/add",		bm_add,		10000 },
+	{ "timer/add",		bm_add,		100000 },
+	{ "timer/rearm",	bm_rearm,	10000 },
+	{ "timer/rearm",	bm_rearm,	100000 },
+	{ "timer/cancel",	bm_cancel,	10000 },
+	{ "timer/cancel",	bm_cancel,	100000 },
+	{ "timer/expire",	bm_expire,	10000 },
+	{ "timer/expire",	bm_expire,	100000 },
+	{ NULL, NULL, 0 }
+};
+
+int main(int argc, char **argv)
+{
+	return bench_main(argc, argv, cases);
+}
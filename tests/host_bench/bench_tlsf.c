@@ -0,0 +1,143 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * TLSF allocator throughput (kernel/mem/tlsf.c).
+ *
+ * Cases:
+ *   tlsf/alloc_free/<size>  alloc + immediate free of one size: the block
+ *                           splits off and coalesces back every time
+ *   tlsf/lifo/<size>        64 allocs of one size, freed in reverse order
+ *   tlsf/fifo/<size>        64 allocs of one size, freed in alloc order
+ *   tlsf/random/<slots>     random alloc or free over <slots> live slots,
+ *                           sizes 16..2048; the fragmented steady state.
+ *                           Every block freed at the end must coalesce
+ *                           back into the whole pool.
+ *
+ * Batch cases count each alloc and each free as one item.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "../../kernel/include/ulmk_mem_internal.h"
+#include "bench.h"
+
+#define POOL_SIZE	(4u * 1024u * 1024u)
+#define BATCH		64u
+#define MAX_SLOTS	1024u
+
+static uint8_t pool_buf[POOL_SIZE] __attribute__((aligned(64)));
+static void   *slots[MAX_SLOTS];
+
+static void reset_pool(void)
+{
+	ulmk_heap_init((uintptr_t)pool_buf, sizeof(pool_buf));
+}
+
+static void bm_alloc_free(bench_t *b, long size)
+{
+	uint64_t i;
+	void    *p;
+	int      ok = 1;
+
+	reset_pool();
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		p = ulmk_heap_alloc((size_t)size);
+		ok &= p != NULL;
+		ulmk_heap_free(p);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, ok);
+}
+
+static void bm_lifo(bench_t *b, long size)
+{
+	uint64_t i;
+	uint32_t k;
+	int      ok = 1;
+
+	reset_pool();
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		for (k = 0u; k < BATCH; k++)
+			slots[k] = ulmk_heap_alloc((size_t)size);
+		ok &= slots[BATCH - 1u] != NULL;
+		for (k = BATCH; k-- > 0u;)
+			ulmk_heap_free(slots[k]);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, ok);
+	b->items = b->n * BATCH * 2u;
+}
+
+static void bm_fifo(bench_t *b, long size)
+{
+	uint64_t i;
+	uint32_t k;
+	int      ok = 1;
+
+	reset_pool();
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		for (k = 0u; k < BATCH; k++)
+			slots[k] = ulmk_heap_alloc((size_t)size);
+		ok &= slots[BATCH - 1u] != NULL;
+		for (k = 0u; k < BATCH; k++)
+			ulmk_heap_free(slots[k]);
+	}
+	bench_stop(b);
+	BENCH_CHECK(b, ok);
+	b->items = b->n * BATCH * 2u;
+}
+
+static void bm_random(bench_t *b, long nslots)
+{
+	uint32_t seed = 0x2545F491u;
+	uint32_t r;
+	uint32_t k;
+	uint64_t i;
+	size_t   full;
+
+	reset_pool();
+	full = ulmk_heap_free_bytes();
+	memset(slots, 0, sizeof(slots));
+	/* Half-fill so the first timed ops already see a fragmented heap. */
+	for (k = 0u; k < (uint32_t)nslots; k += 2u)
+		slots[k] = ulmk_heap_alloc(16u + bench_rand(&seed) % 2033u);
+
+	bench_start(b);
+	for (i = 0u; i < b->n; i++) {
+		r = bench_rand(&seed);
+		k = r % (uint32_t)nslots;
+		if (slots[k]) {
+			ulmk_heap_free(slots[k]);
+			slots[k] = NULL;
+		} else {
+			slots[k] = ulmk_heap_alloc(16u + (r >> 16) % 2033u);
+		}
+	}
+	bench_stop(b);
+
+	for (k = 0u; k < (uint32_t)nslots; k++)
+		ulmk_heap_free(slots[k]);
+	BENCH_CHECK(b, ulmk_heap_free_bytes() == full);
+}
+
+static const bench_case_t cases[] = {
+	{ "tlsf/alloc_free",	bm_alloc_free,	16 },
+	{ "tlsf/alloc_free",	bm_alloc_free,	256 },
+	{ "tlsf/alloc_free",	bm_alloc_free,	4096 },
+	{ "tlsf/lifo",		bm_lifo,	64 },
+	{ "tlsf/lifo",		bm_lifo,	1024 },
+	{ "tlsf/fifo",		bm_fifo,	64 },
+	{ "tlsf/fifo",		bm_fifo,	1024 },
+	{ "tlsf/random",	bm_random,	64 },
+	{ "tlsf/random",	bm_random,	1024 },
+	{ NULL, NULL, 0 }
+};
+
+int main(int argc, char **argv)
+{
+	return bench_main(argc, argv, cases);
+}
@@ -31,19 +31,25 @@ INTEG_KERNEL_SRCS ?= \
 	$(ROOT)/kernel/printk/ulmk_printk.c \
 	$(ROOT)/kernel/percpu/percpu.c \
 	$(ROOT)/kernel/percpu/klock.c \
+	$(ROOT)/kernel/percpu/irqoff.c \
 	$(ROOT)/kernel/sched/sched.c \
 	$(ROOT)/kernel/sched/fifo_rt.c \
 	$(ROOT)/kernel/sched/bitmap_rt.c \
+	$(ROOT)/kernel/sched/sched_lat.c \
 	$(ROOT)/kernel/irq/irq.c \
 	$(ROOT)/kernel/mem/mem.c \
+	$(ROOT)/kernel/mem/domain.c \
 	$(ROOT)/kernel/mem/tlsf.c \
 	$(ROOT)/kernel/thread/thread.c \
+	$(ROOT)/kernel/thread/stack_wm.c \
 	$(ROOT)/kernel/ipc/ep.c \
+	$(ROOT)/kernel/ipc/waitset.c \
 	$(ROOT)/kernel/notif/notif.c \
 	$(ROOT)/kernel/time/timer_wheel.c \
 	$(ROOT)/kernel/time/sleep.c \
 	$(ROOT)/kernel/syscall/syscall_router.c \
 	$(ROOT)/kernel/syscall/syscall_wcet.c \
+	$(ROOT)/kernel/trace/trace.c \
 	$(INTEG_KERNEL_STUB) \
 	$(INTEG_KERNEL_EXTRA_SRCS)
 
@@ -60,4 +60,17 @@ typedef struct {
 	int      is_notif;
 } ulmk_recv_or_notif_result_t;
 
+/* Wait sets */
+typedef int32_t ulmk_waitset_t;
+#define ULMK_WAITSET_INVALID     ((ulmk_waitset_t)0)
+#define ULMK_WAITSET_MAX_SOURCES 16u
+#define ULMK_WAITSET_EP          1u
+#define ULMK_WAITSET_NOTIF       2u
+
+typedef struct ulmk_waitset_event {
+	uint32_t  kind;
+	uintptr_t handle;
+	uint32_t  bits;
+} ulmk_waitset_event_t;
+
 #endif /* ULMK_MICROKERNEL_H */
@@ -1,7 +1,7 @@
 /* SPDX-License-Identifier: MIT */
 /*
- * ipc_unit_test.c — host unit tests for kernel/ipc/ep.c and
- *                   kernel/notif/notif.c
+ * ipc_unit_test.c — host unit tests for kernel/ipc/ep.c,
+ *                   kernel/notif/notif.c and kernel/ipc/waitset.c
  *
  * Compiles both modules against stub implementations of the scheduler,
  * thread registry, and arch layer.  No QEMU or hardware required.
@@ -52,6 +52,10 @@
  *  22.  signal on invalid notif returns -ULMK_EINVAL
  *  23.  signal with no waiter — bits accumulated
  *  24.  signal wakes waiting thread, consumes bits
+ *  24a. signal is wake-one: FIFO head takes the bit, others stay queued
+ *  24b. signal splits distinct bits across waiters with disjoint masks
+ *  24c. broadcast wakes every matching waiter in one batched RQ insert
+ *  24d. broadcast leaves bits nobody waited for pending
  *
  *  notif_wait:
  *  25.  wait on invalid notif returns -ULMK_EINVAL
@@ -70,6 +74,17 @@
  *
  *  kill cleanup:
  *  34.  kill IPC-RECV thread removes it from recv_queue
+ *
+ *  notif_destroy:
+ *  35.  destroy wakes every queued waiter with ULMK_EINVAL
+ *
+ *  waitset:
+ *  36.  add rejects bad set / handle / zero mask / second registration
+ *  37.  pending notif bits make wait_any return at once, bits consumed
+ *  38.  wait_any blocks; ep_call on a member endpoint wakes the owner
+ *  39.  notif signal wakes the owner after direct waiters are served
+ *  40.  stale ready entry (bits polled away) is dropped, wait_any blocks
+ *  41.  waitset destroy wakes the owner with ULMK_EINVAL; ep destroy detaches
  */
 
 #include <stdint.h>
@@ -87,6 +102,7 @@
 #include "../../kernel/include/ulmk_sched.h"
 #include "../../kernel/include/ulmk_ep_internal.h"
 #include "../../kernel/include/ulmk_notif_internal.h"
+#include "../../kernel/include/ulmk_waitset_internal.h"
 #include "../../kernel/syscall/syscall_router.h"
 
 /* ── Test framework ────────────────────────────────────────────────────── */
@@ -119,12 +135,24 @@ static ulmk_thread_t *g_current;
 static int          g_enqueue_count;
 static int          g_schedule_count;
 static int          g_dequeue_count;
+static int          g_enqueue_list_count;
 
 ulmk_thread_t *ulmk_sched_current(void)   { return g_current; }
 void ulmk_sched_enqueue(ulmk_thread_t *t) { t->state = UL_THREAD_STATE_READY; g_enqueue_count++; }
 void ulmk_sched_dequeue(ulmk_thread_t *t) { (void)t; g_dequeue_count++; }
 void ulmk_sched_enqueue_locked(ulmk_thread_t *t) { ulmk_sched_enqueue(t); }
 void ulmk_sched_dequeue_locked(ulmk_thread_t *t) { ulmk_sched_dequeue(t); }
+void ulmk_sched_enqueue_list(sys_dlist_t *list)
+{
+	sys_dnode_t *dn;
+
+	g_enqueue_list_count++;
+	while ((dn = sys_dlist_get(list)) != NULL) {
+		sys_dnode_init(dn);
+		ulmk_sched_enqueue(SYS_DLIST_CONTAINER_OF(dn, ulmk_thread_t,
+							  sched_node));
+	}
+}
 void ulmk_sched_resched(void)           { g_schedule_count++; }
 void ulmk_sched_request_resched(void)   { g_schedule_count++; }
 
@@ -179,6 +207,7 @@ static void reset_counters(void)
 	g_enqueue_count  = 0;
 	g_schedule_count = 0;
 	g_dequeue_count  = 0;
+	g_enqueue_list_count = 0;
 }
 
 static ulmk_thread_t *make_thread(uint8_t prio)
@@ -197,6 +226,7 @@ static ulmk_thread_t *make_thread(uint8_t prio)
 	t->ipc_sender     = ULMK_TID_INVALID;
 	sys_dnode_init(&t->sched_node);
 	sys_dnode_init(&t->ipc_node);
+	sys_dnode_init(&t->notif_node);
 	sys_dnode_init(&t->reg_node);
 
 	if (g_reg_count < MAX_REG)
@@ -217,14 +247,27 @@ static void ipc_test_enqueue_send(ulmk_endpoint_t *ep, ulmk_thread_t *th)
 	sys_dlist_append(&ep->send_queue, &th->ipc_node);
 }
 
+/* Block @th on notification @n (id 0 in these tests) waiting for @mask. */
+static void notif_test_block(ulmk_notif_obj_t *n, ulmk_thread_t *th,
+			     uint32_t mask)
+{
+	th->state           = UL_THREAD_STATE_BLOCKED;
+	th->blocked_reason  = UL_BLOCKED_NOTIF;
+	th->blocked_notif   = 0;
+	th->notif_wait_mask = mask;
+	sys_dlist_append(&n->waiters, &th->notif_node);
+}
+
 /* Reset the static pools used by ep.c and notif.c between test groups. */
 extern ulmk_endpoint_t  ep_pool[];
 extern ulmk_notif_obj_t notif_pool[];
+extern ulmk_waitset_obj_t waitset_pool[];
 
 static void reset_pools(void)
 {
 	memset(ep_pool,    0, sizeof(ulmk_endpoint_t)  * ULMK_CONFIG_MAX_ENDPOINTS);
 	memset(notif_pool, 0, sizeof(ulmk_notif_obj_t) * ULMK_CONFIG_MAX_NOTIFS);
+	memset(waitset_pool, 0, sizeof(ulmk_waitset_obj_t) * UL_TEST_MAX_WAITSETS);
 	/* Reset thread pool and registry so each test starts clean. */
 	g_tpool_idx = 0;
 	g_reg_count = 0;
@@ -598,11 +641,7 @@ static void test_notif_signal_wakes_waiter(void)
 	ulmk_kern_notif_create();
 	n = ulmk_notif_by_id(0);
 
-	waiter->state          = UL_THREAD_STATE_BLOCKED;
-	waiter->blocked_reason = UL_BLOCKED_NOTIF;
-	waiter->notif_wait_mask = 0x5;
-	n->waiter    = waiter;
-	n->wait_mask = 0x5;
+	notif_test_block(n, waiter, 0x5);
 
 	g_current = NULL;  /* simulate idle so schedule() is called */
 	ulmk_kern_notif_signal(0, 0x4); /* bit 2 matches mask 0x5 */
@@ -610,12 +649,119 @@ static void test_notif_signal_wakes_waiter(void)
 	ASSERT(waiter->state == UL_THREAD_STATE_READY);
 	ASSERT(waiter->notif_received == 0x4);
 	ASSERT((n->bits & 0x4) == 0);   /* consumed */
-	ASSERT(n->waiter == NULL);
+	ASSERT(sys_dlist_is_empty(&n->waiters));
 	ASSERT(g_enqueue_count == 1);
 	/* schedule is NOT called directly from signal; preemption is handled
 	 * by the arch ISR exit mechanism, not inline from the signal path */
 }
 
+static void test_notif_signal_wake_one_fifo(void)
+{
+	ulmk_notif_obj_t *n;
+	ulmk_thread_t    *a;
+	ulmk_thread_t    *b;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	n = ulmk_notif_by_id(0);
+
+	a = make_thread(10);
+	b = make_thread(5);
+	notif_test_block(n, a, 0x1);
+	notif_test_block(n, b, 0x1);
+
+	ulmk_kern_notif_signal(0, 0x1);
+
+	ASSERT(a->state == UL_THREAD_STATE_READY);
+	ASSERT(a->notif_received == 0x1);
+	ASSERT(b->state == UL_THREAD_STATE_BLOCKED);
+	ASSERT(sys_dnode_is_linked(&b->notif_node));
+	ASSERT(n->bits == 0);
+	ASSERT(g_enqueue_count == 1);
+
+	ulmk_kern_notif_signal(0, 0x1);
+	ASSERT(b->state == UL_THREAD_STATE_READY);
+	ASSERT(sys_dlist_is_empty(&n->waiters));
+}
+
+static void test_notif_signal_splits_bits(void)
+{
+	ulmk_notif_obj_t *n;
+	ulmk_thread_t    *a;
+	ulmk_thread_t    *b;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	n = ulmk_notif_by_id(0);
+
+	a = make_thread(10);
+	b = make_thread(10);
+	notif_test_block(n, a, 0x1);
+	notif_test_block(n, b, 0x2);
+
+	ulmk_kern_notif_signal(0, 0x3);
+
+	ASSERT(a->notif_received == 0x1);
+	ASSERT(b->notif_received == 0x2);
+	ASSERT(n->bits == 0);
+	ASSERT(g_enqueue_count == 2);
+	ASSERT(g_enqueue_list_count == 1);
+}
+
+static void test_notif_broadcast_wakes_all(void)
+{
+	ulmk_notif_obj_t *n;
+	ulmk_thread_t    *a;
+	ulmk_thread_t    *b;
+	ulmk_thread_t    *c;
+	uint32_t          bits_a = 0;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	n = ulmk_notif_by_id(0);
+
+	a = make_thread(10);
+	b = make_thread(10);
+	c = make_thread(10);
+	notif_test_block(n, a, 0x1);
+	a->notif_bits_outptr = &bits_a;
+	notif_test_block(n, b, 0x3);
+	notif_test_block(n, c, 0x4);
+
+	ASSERT(ulmk_kern_notif_broadcast(0, 0x1) == 0);
+
+	ASSERT(a->state == UL_THREAD_STATE_READY);
+	ASSERT(bits_a == 0x1);
+	ASSERT(b->state == UL_THREAD_STATE_READY);
+	ASSERT(b->notif_received == 0x1);
+	ASSERT(c->state == UL_THREAD_STATE_BLOCKED);
+	ASSERT(n->bits == 0);
+	ASSERT(g_enqueue_count == 2);
+	ASSERT(g_enqueue_list_count == 1);
+	ASSERT(SYS_DLIST_PEEK_HEAD_CONTAINER_OF(&n->waiters, ulmk_thread_t,
+						notif_node) == c);
+}
+
+static void test_notif_broadcast_keeps_unmatched(void)
+{
+	ulmk_notif_obj_t *n;
+	ulmk_thread_t    *a;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	n = ulmk_notif_by_id(0);
+
+	a = make_thread(10);
+	notif_test_block(n, a, 0x1);
+
+	ulmk_kern_notif_broadcast(0, 0x9);
+
+	ASSERT(a->notif_received == 0x1);
+	ASSERT(n->bits == 0x8);
+	ASSERT(g_enqueue_list_count == 1);
+	ASSERT((int32_t)ulmk_kern_notif_broadcast(999, 0x1) == -ULMK_EINVAL);
+}
+
 /* ── notif_wait ────────────────────────────────────────────────────────── */
 
 static void test_notif_wait_invalid(void)
@@ -670,7 +816,8 @@ static void test_notif_wait_slow_path(void)
 
 	ASSERT(waiter->state == UL_THREAD_STATE_BLOCKED);
 	ASSERT(waiter->blocked_reason == UL_BLOCKED_NOTIF);
-	ASSERT(n->waiter == waiter);
+	ASSERT(SYS_DLIST_PEEK_HEAD_CONTAINER_OF(&n->waiters, ulmk_thread_t,
+						notif_node) == waiter);
 	ASSERT(g_schedule_count == 0);
 }
 
@@ -710,6 +857,70 @@ static void test_notif_poll_no_match(void)
 	ASSERT(n->bits == 0x0F);    /* unchanged */
 }
 
+/* ── shared notification word ──────────────────────────────────────────── */
+
+static void test_notif_shared_word_mirrors_bits(void)
+{
+	const volatile uint32_t *word = NULL;
+	ulmk_notif_obj_t        *n;
+	uint32_t                 out = 0;
+	uint32_t                 id;
+
+	reset_pools();
+	id = notif_create_shared_impl(&word);
+	n  = ulmk_notif_by_id((ulmk_notif_t)id);
+	ASSERT(n != NULL);
+	ASSERT(word != NULL && word == n->word);
+	ASSERT(*word == 0);
+
+	ulmk_kern_notif_signal(id, 0x6);
+	ASSERT(*word == 0x6);
+
+	ASSERT(ulmk_kern_notif_poll(id, 0x2) == 0x2);
+	ASSERT(*word == 0x4);
+
+	ASSERT(notif_wait_impl((ulmk_notif_t)id, 0x4, &out) == 0);
+	ASSERT(out == 0x4);
+	ASSERT(*word == 0);
+
+	ASSERT(notif_create_shared_impl(NULL) ==
+	       (uint32_t)ULMK_NOTIF_INVALID);
+}
+
+static void test_notif_shared_word_skips_consumed(void)
+{
+	const volatile uint32_t *word = NULL;
+	ulmk_notif_obj_t        *n;
+	ulmk_thread_t           *w;
+	uint32_t                 id;
+
+	reset_pools();
+	id = notif_create_shared_impl(&word);
+	n  = ulmk_notif_by_id((ulmk_notif_t)id);
+	w  = make_thread(10);
+	notif_test_block(n, w, 0x1);
+
+	/* Bit 0 goes straight to the waiter; only bit 1 is left pending. */
+	ulmk_kern_notif_signal(id, 0x3);
+	ASSERT(w->notif_received == 0x1);
+	ASSERT(*word == 0x2);
+
+	ASSERT(ulmk_kern_notif_destroy(id) == 0);
+	ASSERT(n->word == NULL);
+}
+
+static void test_notif_signal_no_waiter_skips_wake(void)
+{
+	reset_pools();
+	ulmk_kern_notif_create();
+
+	ulmk_kern_notif_signal(0, 0x1);
+	ulmk_kern_notif_broadcast(0, 0x2);
+	ASSERT(ulmk_notif_by_id(0)->bits == 0x3);
+	ASSERT(g_enqueue_count == 0);
+	ASSERT(g_enqueue_list_count == 0);
+}
+
 /* ── priority inheritance ──────────────────────────────────────────────── */
 
 static void test_prio_inherit_boost(void)
@@ -842,11 +1053,7 @@ static void test_notif_destroy_wakes_waiter(void)
 	n = ulmk_notif_by_id(0);
 
 	waiter = make_thread(10);
-	waiter->state           = UL_THREAD_STATE_BLOCKED;
-	waiter->blocked_reason  = UL_BLOCKED_NOTIF;
-	waiter->blocked_notif   = 0;
-	waiter->notif_wait_mask = 0x1;
-	n->waiter = waiter;
+	notif_test_block(n, waiter, 0x1);
 
 	ASSERT(notif_destroy_impl(0) == 0);
 	ASSERT(waiter->state == UL_THREAD_STATE_READY);
@@ -855,6 +1062,31 @@ static void test_notif_destroy_wakes_waiter(void)
 	ASSERT(g_enqueue_count == 1);
 }
 
+static void test_notif_destroy_wakes_all_waiters(void)
+{
+	ulmk_notif_obj_t *n;
+	ulmk_thread_t    *a;
+	ulmk_thread_t    *b;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	n = ulmk_notif_by_id(0);
+
+	a = make_thread(10);
+	b = make_thread(20);
+	notif_test_block(n, a, 0x1);
+	notif_test_block(n, b, 0x2);
+
+	ASSERT(notif_destroy_impl(0) == 0);
+	ASSERT(a->state == UL_THREAD_STATE_READY);
+	ASSERT(b->state == UL_THREAD_STATE_READY);
+	ASSERT(a->block_status == ULMK_EINVAL);
+	ASSERT(b->block_status == ULMK_EINVAL);
+	ASSERT(!sys_dnode_is_linked(&b->notif_node));
+	ASSERT(g_enqueue_count == 2);
+	ASSERT(g_enqueue_list_count == 1);
+}
+
 /* ── kill cleanup ──────────────────────────────────────────────────────── */
 
 static void test_kill_removes_from_recv_queue(void)
@@ -879,6 +1111,181 @@ static void test_kill_removes_from_recv_queue(void)
 	ASSERT(srv->blocked_ep == ULMK_EP_INVALID);
 }
 
+/* ── waitset ───────────────────────────────────────────────────────────── */
+
+static void test_waitset_add_invalid(void)
+{
+	ulmk_waitset_t ws;
+	ulmk_waitset_t ws2;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	ulmk_kern_ep_create();
+	ws  = (ulmk_waitset_t)ulmk_kern_waitset_create();
+	ws2 = (ulmk_waitset_t)ulmk_kern_waitset_create();
+	ASSERT(ws != ULMK_WAITSET_INVALID);
+
+	ASSERT(waitset_add_impl(3, ULMK_WAITSET_NOTIF, 0, 0x1) == ULMK_EINVAL);
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_NOTIF, 5, 0x1) == ULMK_EINVAL);
+	ASSERT(waitset_add_impl(ws, 7u, 0, 0x1) == ULMK_EINVAL);
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_NOTIF, 0, 0) == ULMK_EINVAL);
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_NOTIF, 0, 0x1) == ULMK_OK);
+	ASSERT(waitset_add_impl(ws2, ULMK_WAITSET_NOTIF, 0, 0x1) == ULMK_EINVAL);
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_EP, 0, 0) == ULMK_OK);
+
+	ASSERT(waitset_del_impl(ws2, ULMK_WAITSET_EP, 0) == ULMK_EINVAL);
+	ASSERT(waitset_del_impl(ws, ULMK_WAITSET_EP, 0) == ULMK_OK);
+	ASSERT(ulmk_ep_by_id(0)->ws_src == NULL);
+	ASSERT(waitset_add_impl(ws2, ULMK_WAITSET_EP, 0, 0) == ULMK_OK);
+}
+
+static void test_waitset_pending_notif_ready(void)
+{
+	ulmk_waitset_event_t ev = {0};
+	ulmk_notif_obj_t    *n;
+	ulmk_waitset_t       ws;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	n  = ulmk_notif_by_id(0);
+	ws = (ulmk_waitset_t)ulmk_kern_waitset_create();
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_NOTIF, 0, 0x6) == ULMK_OK);
+
+	ulmk_kern_notif_signal(0, 0x3);
+	g_current = make_thread(10);
+
+	ASSERT(wait_any_impl(ws, &ev) == ULMK_OK);
+	ASSERT(ev.kind == ULMK_WAITSET_NOTIF);
+	ASSERT(ev.handle == 0);
+	ASSERT(ev.bits == 0x2);
+	ASSERT(n->bits == 0x1);
+	ASSERT(g_current->state == UL_THREAD_STATE_READY);
+	ASSERT(g_dequeue_count == 0);
+}
+
+static void test_waitset_ep_call_wakes_owner(void)
+{
+	ulmk_waitset_event_t ev = {0};
+	ulmk_msg_t           msg = { .label = 7 };
+	ulmk_waitset_t       ws;
+	ulmk_thread_t       *owner;
+	ulmk_thread_t       *caller;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	ulmk_kern_ep_create();
+	ulmk_kern_ep_create();
+	ws = (ulmk_waitset_t)ulmk_kern_waitset_create();
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_NOTIF, 0, 0x1) == ULMK_OK);
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_EP, 1, 0) == ULMK_OK);
+
+	owner     = make_thread(20);
+	g_current = owner;
+	ASSERT(wait_any_impl(ws, &ev) == ULMK_OK);
+	ASSERT(owner->state == UL_THREAD_STATE_BLOCKED);
+	ASSERT(owner->blocked_reason == UL_BLOCKED_WAITSET);
+
+	/* A second waiter on the same set is refused. */
+	g_current = make_thread(30);
+	ASSERT(wait_any_impl(ws, &ev) == ULMK_EINVAL);
+
+	caller    = make_thread(5);
+	g_current = caller;
+	reset_counters();
+	ep_call_impl(1, &msg);
+
+	ASSERT(caller->state == UL_THREAD_STATE_BLOCKED);
+	ASSERT(owner->state == UL_THREAD_STATE_READY);
+	ASSERT(owner->blocked_reason == UL_BLOCKED_NONE);
+	ASSERT(ev.kind == ULMK_WAITSET_EP);
+	ASSERT(ev.handle == 1);
+	ASSERT(g_enqueue_count == 1);
+	ASSERT(ulmk_waitset_by_id(ws)->waiter == NULL);
+}
+
+static void test_waitset_notif_after_direct_waiters(void)
+{
+	ulmk_waitset_event_t ev = {0};
+	ulmk_notif_obj_t    *n;
+	ulmk_waitset_t       ws;
+	ulmk_thread_t       *direct;
+	ulmk_thread_t       *owner;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	n  = ulmk_notif_by_id(0);
+	ws = (ulmk_waitset_t)ulmk_kern_waitset_create();
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_NOTIF, 0, 0x3) == ULMK_OK);
+
+	direct = make_thread(10);
+	notif_test_block(n, direct, 0x1);
+
+	owner     = make_thread(20);
+	g_current = owner;
+	wait_any_impl(ws, &ev);
+	ASSERT(owner->state == UL_THREAD_STATE_BLOCKED);
+
+	ulmk_kern_notif_signal(0, 0x1);
+	ASSERT(direct->state == UL_THREAD_STATE_READY);
+	ASSERT(owner->state == UL_THREAD_STATE_BLOCKED);
+
+	ulmk_kern_notif_signal(0, 0x2);
+	ASSERT(owner->state == UL_THREAD_STATE_READY);
+	ASSERT(ev.kind == ULMK_WAITSET_NOTIF);
+	ASSERT(ev.bits == 0x2);
+	ASSERT(n->bits == 0);
+}
+
+static void test_waitset_stale_entry_dropped(void)
+{
+	ulmk_waitset_event_t ev = {0};
+	ulmk_waitset_t       ws;
+	ulmk_thread_t       *owner;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	ws = (ulmk_waitset_t)ulmk_kern_waitset_create();
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_NOTIF, 0, 0x1) == ULMK_OK);
+
+	ulmk_kern_notif_signal(0, 0x1);
+	ASSERT(ulmk_kern_notif_poll(0, 0x1) == 0x1);
+
+	owner     = make_thread(20);
+	g_current = owner;
+	ASSERT(wait_any_impl(ws, &ev) == ULMK_OK);
+	ASSERT(owner->state == UL_THREAD_STATE_BLOCKED);
+	ASSERT(sys_dlist_is_empty(&ulmk_waitset_by_id(ws)->ready));
+}
+
+static void test_waitset_destroy_wakes_owner(void)
+{
+	ulmk_waitset_event_t ev = {0};
+	ulmk_waitset_t       ws;
+	ulmk_thread_t       *owner;
+
+	reset_pools();
+	ulmk_kern_notif_create();
+	ulmk_kern_ep_create();
+	ws = (ulmk_waitset_t)ulmk_kern_waitset_create();
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_NOTIF, 0, 0x1) == ULMK_OK);
+	ASSERT(waitset_add_impl(ws, ULMK_WAITSET_EP, 0, 0) == ULMK_OK);
+
+	ASSERT(ep_destroy_impl(0) == 0);
+	ASSERT(ulmk_waitset_by_id(ws)->src[1].kind == 0u);
+
+	owner     = make_thread(20);
+	g_current = owner;
+	wait_any_impl(ws, &ev);
+	ASSERT(owner->state == UL_THREAD_STATE_BLOCKED);
+
+	ASSERT(waitset_destroy_impl(ws) == ULMK_OK);
+	ASSERT(owner->state == UL_THREAD_STATE_READY);
+	ASSERT(owner->block_status == ULMK_EINVAL);
+	ASSERT(owner->blocked_ws == NULL);
+	ASSERT(ulmk_notif_by_id(0)->ws_src == NULL);
+	ASSERT(ulmk_waitset_by_id(ws) == NULL);
+}
+
 /* ── runner ────────────────────────────────────────────────────────────── */
 
 int main(void)
@@ -915,6 +1322,10 @@ int main(void)
 	RUN(test_notif_signal_invalid);
 	RUN(test_notif_signal_no_waiter_accumulates);
 	RUN(test_notif_signal_wakes_waiter);
+	RUN(test_notif_signal_wake_one_fifo);
+	RUN(test_notif_signal_splits_bits);
+	RUN(test_notif_broadcast_wakes_all);
+	RUN(test_notif_broadcast_keeps_unmatched);
 
 	RUN(test_notif_wait_invalid);
 	RUN(test_notif_wait_null_out);
@@ -925,6 +1336,10 @@ int main(void)
 	RUN(test_notif_poll_consumes_matched);
 	RUN(test_notif_poll_no_match);
 
+	RUN(test_notif_shared_word_mirrors_bits);
+	RUN(test_notif_shared_word_skips_consumed);
+	RUN(test_notif_signal_no_waiter_skips_wake);
+
 	RUN(test_prio_inherit_boost);
 	RUN(test_prio_inherit_restore_on_reply);
 	RUN(test_prio_inherit_boost_on_recv);
@@ -932,9 +1347,17 @@ int main(void)
 	RUN(test_ep_destroy_wakes_recv_waiter);
 	RUN(test_ep_destroy_wakes_send_waiter);
 	RUN(test_notif_destroy_wakes_waiter);
+	RUN(test_notif_destroy_wakes_all_waiters);
 
 	RUN(test_kill_removes_from_recv_queue);
 
+	RUN(test_waitset_add_invalid);
+	RUN(test_waitset_pending_notif_ready);
+	RUN(test_waitset_ep_call_wakes_owner);
+	RUN(test_waitset_notif_after_direct_waiters);
+	RUN(test_waitset_stale_entry_dropped);
+	RUN(test_waitset_destroy_wakes_owner);
+
 	printf("\nResults: %d passed, %d failed\n", g_pass, g_fail);
 	return g_fail ? 1 : 0;
 }
@@ -0,0 +1,7 @@
+/* Stub config for unit tests — kernel profiling options off */
+#ifndef ULMK_CONFIG_H
+#define ULMK_CONFIG_H
+
+#define ULMK_CONFIG_ENABLE_SMP       0
+
+#endif /* ULMK_CONFIG_H */
@@ -212,6 +212,64 @@ static void test_aligned_alloc(void)
 	ulmk_heap_free(p);
 }
 
+static void test_grow_in_place(void)
+{
+	uint8_t *p;
+	size_t   got;
+	size_t   free_initial;
+	size_t   free_before;
+	int      ok = 1;
+	int      i;
+
+	printf("test_grow_in_place\n");
+	reset_pool();
+	free_initial = ulmk_heap_free_bytes();
+
+	p = ulmk_heap_alloc(256);
+	CHECK(p != NULL, "alloc(256) succeeds");
+	for (i = 0; i < 256; i++)
+		p[i] = (uint8_t)i;
+
+	free_before = ulmk_heap_free_bytes();
+	got = ulmk_heap_grow(p, 1024);
+	CHECK(got >= 1024, "grow to 1024 absorbs the free neighbour");
+	CHECK(ulmk_heap_free_bytes() == free_before - (got - 256),
+	      "free bytes drop by exactly the absorbed amount");
+	for (i = 0; i < 256; i++) {
+		if (p[i] != (uint8_t)i)
+			ok = 0;
+	}
+	CHECK(ok, "payload preserved across in-place growth");
+	memset(p, 0x5A, got);
+
+	CHECK(ulmk_heap_grow(p, 512) == got, "shrinking request keeps current size");
+
+	ulmk_heap_free(p);
+	CHECK(ulmk_heap_free_bytes() == free_initial,
+	      "grown block coalesces back into a single free block");
+}
+
+static void test_grow_blocked(void)
+{
+	void *p1;
+	void *p2;
+
+	printf("test_grow_blocked\n");
+	reset_pool();
+
+	p1 = ulmk_heap_alloc(128);
+	p2 = ulmk_heap_alloc(128);
+	CHECK(p1 && p2, "two adjacent allocs succeed");
+	CHECK(ulmk_heap_grow(p1, 512) == 0u, "grow fails when neighbour is in use");
+	CHECK(ulmk_heap_grow(p2, sizeof(pool_buf)) == 0u,
+	      "grow fails when neighbour is too small");
+	CHECK(ulmk_heap_grow(NULL, 64) == 0u, "grow(NULL) fails");
+
+	ulmk_heap_free(p2);
+	CHECK(ulmk_heap_grow(p1, 512) >= 512u, "grow succeeds once neighbour is freed");
+	ulmk_heap_free(p1);
+}
+
 int main(void)
 {
 	printf("=== mem_unit: TLSF allocator tests ===\n");
@@ -225,6 +283,8 @@ int main(void)
 	test_multiple_sizes();
 	test_alignment_varied_sizes();
 	test_aligned_alloc();
+	test_grow_in_place();
+	test_grow_blocked();
 
 	printf("\n=== Results: %d passed, %d failed ===\n", g_pass, g_fail);
 	return (g_fail == 0) ? 0 : 1;
@@ -14,10 +14,12 @@ typedef enum {
 typedef uintptr_t ulmk_tid_t;
 typedef int32_t ulmk_ep_t;
 typedef int32_t ulmk_notif_t;
+typedef uintptr_t ulmk_domain_t;
 
 #define ULMK_TID_INVALID   ((ulmk_tid_t)0)
 #define ULMK_EP_INVALID    ((ulmk_ep_t)-1)
 #define ULMK_NOTIF_INVALID ((ulmk_notif_t)-1)
+#define ULMK_DOMAIN_INVALID ((ulmk_domain_t)0)
 
 #define ULMK_OK		 0
 #define ULMK_EINVAL	-1
@@ -54,6 +56,18 @@ typedef struct {
 	int      is_notif;
 } ulmk_recv_or_notif_result_t;
 
+/* Per-CPU IRQ counters (embedded in struct ulmk_percpu) */
+typedef struct {
+	uint32_t dispatches;
+	uint32_t signals;
+	uint32_t lat_last;
+	uint32_t lat_max;
+	uint32_t lat_total;
+	uint32_t coal_events;
+	uint32_t coal_batches;
+	uint32_t ipis;
+} ulmk_irq_stats_t;
+
 typedef struct {
 	const char	*name;
 	void		(*entry)(void *arg);
@@ -63,6 +77,7 @@ typedef struct {
 	ulmk_privilege_t	 privilege;
 	size_t		 heap_size;
 	uint8_t		 cpu;
+	ulmk_domain_t	 domain;
 } ulmk_thread_attr_t;
 
 #endif /* ULMK_MICROKERNEL_H */
@@ -1,11 +1,24 @@
 /* SPDX-License-Identifier: MIT */
+/*
+ * atomic_stress — yield storm of CTX_WORKERS threads, then a timed phase
+ * in which FAIR_WORKERS equal-priority threads yield to each other for
+ * FAIR_MS.  Their counts give yield throughput (each yield takes the rq
+ * lock) and round-robin fairness: every worker runs, and the spread stays
+ * within a few rounds plus 1/8 of the largest count.
+ */
 #include "sdk_test_util.h"
 
 #define CTX_YIELD_ITERS	100u
 #define CTX_WORKERS	8
+#define FAIR_WORKERS	4u
+#define FAIR_MS		20u
 
 static volatile int g_ctx_done;
 
+static volatile uint32_t g_fair_stop;
+static volatile uint32_t g_fair_ops[FAIR_WORKERS];
+static volatile uint32_t g_fair_done;
+
 static void ctx_worker(void *arg)
 {
 	uint32_t i;
@@ -17,6 +30,63 @@ static void ctx_worker(void *arg)
 	ulmk_thread_exit();
 }
 
+static void fair_worker(void *arg)
+{
+	uint32_t me = (uint32_t)(uintptr_t)arg;
+
+	while (!g_fair_stop) {
+		g_fair_ops[me]++;
+		ulmk_thread_yield();
+	}
+	g_fair_done++;
+	ulmk_thread_exit();
+}
+
+/* Workers run below the supervisor, which preempts them when its sleep ends. */
+static int fair_phase(void)
+{
+	uint32_t i;
+	uint32_t lo = 0xffffffffu;
+	uint32_t hi = 0u;
+	uint32_t sum = 0u;
+	uint32_t waited = 0u;
+
+	for (i = 0u; i < FAIR_WORKERS; i++)
+		if (sdk_spawn("fw", fair_worker, (void *)(uintptr_t)i, 30u,
+			      2048u, 0u) == ULMK_TID_INVALID)
+			return -1;
+	(void)ulmk_sleep_ms(FAIR_MS);
+	g_fair_stop = 1u;
+	while (g_fair_done != FAIR_WORKERS && waited < 1000u) {
+		(void)ulmk_sleep_ms(1u);
+		waited++;
+	}
+	if (g_fair_done != FAIR_WORKERS)
+		return -1;
+
+	for (i = 0u; i < FAIR_WORKERS; i++) {
+		sum += g_fair_ops[i];
+		if (g_fair_ops[i] < lo)
+			lo = g_fair_ops[i];
+		if (g_fair_ops[i] > hi)
+			hi = g_fair_ops[i];
+	}
+	sdk_puts("atomic_stress: yields/ms ");
+	sdk_put_u32(sum / FAIR_MS);
+	sdk_puts(" min ");
+	sdk_put_u32(lo);
+	sdk_puts(" max ");
+	sdk_put_u32(hi);
+	sdk_puts("\n");
+
+	/*
+	 * Round-robin keeps counts within one of each other; a tick
+	 * preemption between the count and the yield costs that thread a
+	 * turn, so allow some slack.
+	 */
+	return (lo > 0u && hi - lo <= hi / 8u + FAIR_WORKERS) ? 0 : -1;
+}
+
 static void supervisor(void *arg)
 {
 	int      i;
@@ -34,7 +104,7 @@ static void supervisor(void *arg)
 		waited++;
 	}
 
-	if (g_ctx_done == CTX_WORKERS)
+	if (g_ctx_done == CTX_WORKERS && fair_phase() == 0)
 		sdk_puts("atomic_stress: PASS\n");
 	else
 		sdk_puts("atomic_stress: FAIL\n");
@@ -0,0 +1,415 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * bench — cycle counts of kernel hot paths (ULMK_CONFIG_USER_CYCLES=1).
+ *
+ *   null_syscall  ulmk_cpu_id() round trip
+ *   yield         switch between two equal-priority threads, per switch
+ *   ep_call       ep_call -> reply_recv round trip, server on this CPU
+ *   ep_call_xcpu  the same with the server on CPU 1 (smp_bench only)
+ *   notif_wake    notif_signal until the higher-priority waiter runs
+ *   irq_wake      software IRQ until its handler thread runs
+ *
+ * Every case prints one machine-readable line
+ *
+ *   ulmk-bench: <case> n=<rounds> min=<cyc> avg=<cyc> max=<cyc>
+ *
+ * over BENCH_ROUNDS rounds, in ulmk_cycle_read() cycles with the cost of
+ * the read itself ("cycle_read") subtracted.  Loop cases count the mean of
+ * LOOP_N operations as one round; wake cases time single events.
+ * tools/bench_compare.py checks the lines against a stored baseline.  The
+ * driver thread runs at PRIO_DRV so wake targets can preempt it.  Trigger
+ * sources as in irq_sw.
+ */
+#include "sdk_test_util.h"
+#include <board_config.h>
+
+#if BENCH_XCPU
+#define BENCH_NAME		"smp_bench"
+#else
+#define BENCH_NAME		"bench"
+#endif
+
+#define BENCH_ROUNDS		8u
+#define LOOP_N			64u
+#define STACK_SZ		1024u
+#define PRIO_HI			5u	/* preempts the driver */
+#define PRIO_DRV		10u
+#define PRIO_LO			15u	/* runs while the driver blocks */
+#define LABEL_PING		0x62u
+#define LABEL_QUIT		0x63u
+
+#define UL_IRQ_SRPN		12u
+#define IRQ_BIT			0u
+#define SRC_SETR_BIT		(1u << 26)
+
+#define UL_NVIC_SRC(irq)	(0x8000u | ((uint32_t)(irq) & 0x7FFFu))
+
+#if defined(ULMK_BOARD_SRC_BASE)
+#define UL_IRQ_SRC_REG		(ULMK_BOARD_SRC_BASE + 0xC2u * 4u)
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_SRC_BASE
+#define UL_IRQ_MAP_SIZE		1024u
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+#define UL_IRQ_SRC_REG		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_SIZE		0x1000u
+#elif defined(__ARM_ARCH)
+#ifndef UL_IRQ_NVIC_LINE
+#define UL_IRQ_NVIC_LINE	3u
+#endif
+#define ARM_NVIC_STIR		0xE000EF00u
+#define UL_IRQ_SRC_REG		UL_NVIC_SRC(UL_IRQ_NVIC_LINE)
+#else
+#error "bench: unsupported board"
+#endif
+
+struct result {
+	uint32_t n;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+};
+
+static int               g_fail;
+static uint32_t          g_cal;		/* cycles of one ulmk_cycle_read() */
+static ulmk_notif_t      g_done;
+static ulmk_notif_t      g_wake;
+static volatile uint32_t g_t0;
+static volatile uint32_t g_y0;
+static volatile uint32_t g_y1;
+static volatile uint32_t g_seen;
+static struct result     g_res;
+
+#define CHECK(name, cond)						\
+	do {								\
+		if (!(cond)) {						\
+			sdk_puts(BENCH_NAME ": " name " FAIL\n");	\
+			g_fail = 1;					\
+		}							\
+	} while (0)
+
+static uint32_t now(void)
+{
+	uint32_t c = 0u;
+
+	(void)ulmk_cycle_read(&c);
+	return c;
+}
+
+/* @d minus the read overhead that every interval includes once. */
+static uint32_t net(uint32_t d)
+{
+	return d > g_cal ? d - g_cal : 0u;
+}
+
+static void res_init(struct result *r)
+{
+	r->n   = 0u;
+	r->min = 0xFFFFFFFFu;
+	r->max = 0u;
+	r->sum = 0u;
+}
+
+static void res_add(struct result *r, uint32_t v)
+{
+	r->n++;
+	r->sum += v;
+	if (v < r->min)
+		r->min = v;
+	if (v > r->max)
+		r->max = v;
+}
+
+static void res_print(const char *name, const struct result *r)
+{
+	sdk_puts("ulmk-bench: ");
+	sdk_puts(name);
+	sdk_puts(" n=");
+	sdk_put_u32(r->n);
+	sdk_puts(" min=");
+	sdk_put_u32(r->n ? r->min : 0u);
+	sdk_puts(" avg=");
+	sdk_put_u32(r->n ? (uint32_t)(r->sum / r->n) : 0u);
+	sdk_puts(" max=");
+	sdk_put_u32(r->max);
+	sdk_puts("\n");
+}
+
+static ulmk_tid_t spawn_on(const char *name, void (*entry)(void *),
+			   void *arg, uint8_t prio, uint8_t cpu)
+{
+	ulmk_thread_attr_t a = {0};
+
+	a.name       = name;
+	a.entry      = entry;
+	a.arg        = arg;
+	a.priority   = prio;
+	a.stack_size = STACK_SZ;
+	a.privilege  = ULMK_PRIV_DRIVER;
+	a.cpu        = cpu;
+	return ulmk_thread_create(&a);
+}
+
+static void wait_done(uint32_t mask)
+{
+	uint32_t bits = 0u;
+	uint32_t got  = 0u;
+
+	while ((got & mask) != mask &&
+	       ulmk_notif_wait(g_done, mask & ~got, &bits) == ULMK_OK)
+		got |= bits;
+}
+
+static void irq_sw_trigger(void)
+{
+#if defined(ULMK_BOARD_SRC_BASE)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG |= SRC_SETR_BIT;
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG = 1u;
+#elif defined(__ARM_ARCH)
+	*(volatile uint32_t *)(uintptr_t)ARM_NVIC_STIR = UL_IRQ_NVIC_LINE;
+#endif
+}
+
+/* ── cycle_read / null_syscall ──────────────────────────────────── */
+
+static void bench_null(void)
+{
+	uint32_t t0;
+	uint32_t t1;
+	uint32_t r;
+	uint32_t i;
+
+	/* Back-to-back reads: the floor subtracted from every interval. */
+	res_init(&g_res);
+	for (r = 0u; r < BENCH_ROUNDS; r++) {
+		t0 = now();
+		t1 = now();
+		res_add(&g_res, t1 - t0);
+	}
+	g_cal = g_res.min;
+	res_print("cycle_read", &g_res);
+
+	res_init(&g_res);
+	for (r = 0u; r < BENCH_ROUNDS; r++) {
+		t0 = now();
+		for (i = 0u; i < LOOP_N; i++)
+			(void)ulmk_cpu_id();
+		t1 = now();
+		res_add(&g_res, net(t1 - t0) / LOOP_N);
+	}
+	CHECK("counter", g_res.max > 0u);
+	res_print("null_syscall", &g_res);
+}
+
+/* ── yield ──────────────────────────────────────────────────────── */
+
+/* Two of these ping-pong; the first one (@arg 1) times all 2 * LOOP_N. */
+static void yielder(void *arg)
+{
+	uint32_t first = (uint32_t)(uintptr_t)arg;
+	uint32_t i;
+
+	if (first)
+		g_y0 = now();
+	for (i = 0u; i < LOOP_N; i++)
+		ulmk_thread_yield();
+	if (first)
+		g_y1 = now();
+	ulmk_notif_signal(g_done, first ? 1u : 2u);
+	ulmk_thread_exit();
+}
+
+static void bench_yield(void)
+{
+	uint32_t r;
+
+	res_init(&g_res);
+	for (r = 0u; r < BENCH_ROUNDS; r++) {
+		CHECK("spawn_yield",
+		      sdk_spawn("y0", yielder, (void *)1u, PRIO_LO,
+				STACK_SZ, 0u) != ULMK_TID_INVALID &&
+		      sdk_spawn("y1", yielder, (void *)0u, PRIO_LO,
+				STACK_SZ, 0u) != ULMK_TID_INVALID);
+		wait_done(3u);
+		res_add(&g_res, net(g_y1 - g_y0) / (2u * LOOP_N));
+	}
+	res_print("yield", &g_res);
+}
+
+/* ── ep_call (same CPU and cross CPU) ───────────────────────────── */
+
+static void server(void *arg)
+{
+	ulmk_ep_t  ep = (ulmk_ep_t)arg;
+	ulmk_msg_t msg;
+	ulmk_msg_t reply;
+	ulmk_tid_t sender;
+
+	if (ulmk_ep_recv(ep, &msg, &sender) != ULMK_OK)
+		ulmk_thread_exit();
+	while (msg.label != LABEL_QUIT) {
+		reply = msg;
+		if (ulmk_ep_reply_recv(ep, sender, &reply, &msg,
+				       &sender) != ULMK_OK)
+			ulmk_thread_exit();
+	}
+	ulmk_ep_reply(sender, &msg);
+	ulmk_thread_exit();
+}
+
+static void bench_call(const char *name, uint8_t cpu)
+{
+	ulmk_ep_t  ep = ulmk_ep_create();
+	ulmk_msg_t msg = {0};
+	uint32_t   t0;
+	uint32_t   t1;
+	uint32_t   r;
+	uint32_t   i;
+	int        ok = 1;
+
+	CHECK("ep_create", ep != ULMK_EP_INVALID);
+	CHECK("spawn_server", spawn_on("srv", server, (void *)ep, PRIO_HI,
+				       cpu) != ULMK_TID_INVALID);
+
+	/* Warm-up: the remote server may not be in recv yet. */
+	msg.label = LABEL_PING;
+	CHECK("warmup", ulmk_ep_call(ep, &msg) == ULMK_OK);
+
+	res_init(&g_res);
+	for (r = 0u; r < BENCH_ROUNDS; r++) {
+		t0 = now();
+		for (i = 0u; i < LOOP_N; i++) {
+			msg.label = LABEL_PING;
+			ok &= ulmk_ep_call(ep, &msg) == ULMK_OK;
+		}
+		t1 = now();
+		res_add(&g_res, net(t1 - t0) / LOOP_N);
+	}
+	CHECK("call", ok);
+	msg.label = LABEL_QUIT;
+	(void)ulmk_ep_call(ep, &msg);
+	res_print(name, &g_res);
+}
+
+/* ── notif_wake / irq_wake ──────────────────────────────────────── */
+
+/* Higher priority than the driver: runs as soon as its wait completes. */
+static void waker(void *arg)
+{
+	uint32_t mask = (uint32_t)(uintptr_t)arg;
+	uint32_t bits = 0u;
+	uint32_t t1;
+	uint32_t i;
+
+	for (i = 0u; i < BENCH_ROUNDS; i++) {
+		if (ulmk_notif_wait(g_wake, mask, &bits) != ULMK_OK)
+			break;
+		t1 = now();
+		res_add(&g_res, net(t1 - g_t0));
+		if (mask == (1u << IRQ_BIT))
+			ulmk_irq_ack(UL_IRQ_SRPN);
+		g_seen++;
+	}
+	ulmk_notif_signal(g_done, 1u);
+	ulmk_thread_exit();
+}
+
+static void bench_notif(void)
+{
+	uint32_t r;
+
+	res_init(&g_res);
+	CHECK("spawn_waiter", sdk_spawn("nw", waker, (void *)2u, PRIO_HI,
+					STACK_SZ, 0u) != ULMK_TID_INVALID);
+	for (r = 0u; r < BENCH_ROUNDS; r++) {
+		g_t0 = now();
+		ulmk_notif_signal(g_wake, 2u);
+	}
+	wait_done(1u);
+	CHECK("notif_n", g_res.n == BENCH_ROUNDS);
+	res_print("notif_wake", &g_res);
+}
+
+static void bench_irq(void)
+{
+	uint32_t r;
+	uint32_t spin;
+
+#if defined(UL_IRQ_MAP_BASE)
+	if (!sdk_map_ok(ulmk_mem_map((void *)(uintptr_t)UL_IRQ_MAP_BASE,
+				     UL_IRQ_MAP_SIZE,
+				     ULMK_PERM_READ | ULMK_PERM_WRITE,
+				     ULMK_MMAP_PERIPH))) {
+		CHECK("map", 0);
+		return;
+	}
+#endif
+	CHECK("bind", ulmk_irq_bind_hw(UL_IRQ_SRPN, g_wake, IRQ_BIT,
+				       (uintptr_t)UL_IRQ_SRC_REG) == ULMK_OK);
+	CHECK("enable", ulmk_irq_enable(UL_IRQ_SRPN) == ULMK_OK);
+
+	res_init(&g_res);
+	g_seen = 0u;
+	CHECK("spawn_handler", sdk_spawn("irq", waker,
+					 (void *)(1u << IRQ_BIT), PRIO_HI,
+					 STACK_SZ, 0u) != ULMK_TID_INVALID);
+	for (r = 0u; r < BENCH_ROUNDS; r++) {
+		g_t0 = now();
+		irq_sw_trigger();
+		for (spin = 0u; g_seen == r && spin < 100000u; spin++)
+			;
+	}
+	wait_done(1u);
+	CHECK("irq_n", g_res.n == BENCH_ROUNDS);
+	res_print("irq_wake", &g_res);
+
+	/* See irq_sw: do not exit with the line armed on ARM. */
+	ulmk_irq_disable(UL_IRQ_SRPN);
+}
+
+static void driver(void *arg)
+{
+	uint32_t c;
+
+	(void)arg;
+	if (ulmk_cycle_read(&c) != ULMK_OK) {
+		sdk_puts(BENCH_NAME ": needs ULMK_CONFIG_USER_CYCLES=1\n");
+		sdk_puts(BENCH_NAME ": FAIL\n");
+		ulmk_thread_exit();
+	}
+	CHECK("null_out", ulmk_cycle_read(NULL) == ULMK_EINVAL);
+
+	bench_null();
+	bench_yield();
+	bench_call("ep_call", 0u);
+#if BENCH_XCPU
+	bench_call("ep_call_xcpu", 1u);
+#endif
+	bench_notif();
+	bench_irq();
+
+	sdk_puts(g_fail ? BENCH_NAME ": FAIL\n" : BENCH_NAME ": PASS\n");
+	ulmk_thread_exit();
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_tid_t tid;
+
+	board_services_init(info);
+	sdk_puts(BENCH_NAME ": begin\n");
+
+	g_done = ulmk_notif_create();
+	g_wake = ulmk_notif_create();
+	if (g_done == ULMK_NOTIF_INVALID || g_wake == ULMK_NOTIF_INVALID) {
+		sdk_puts(BENCH_NAME ": FAIL notif\n");
+		ulmk_thread_exit();
+	}
+
+	tid = sdk_spawn("drv", driver, NULL, PRIO_DRV, 2048u, 0u);
+	if (tid == ULMK_TID_INVALID ||
+	    ulmk_cap_grant(tid, ULMK_CAP_SPAWN | ULMK_CAP_IRQ |
+			   ULMK_CAP_MAP_PERIPH) != ULMK_OK)
+		sdk_puts(BENCH_NAME ": FAIL driver\n");
+	ulmk_thread_exit();
+}
@@ -1,10 +1,97 @@
 /* SPDX-License-Identifier: MIT */
 #include "sdk_test_util.h"
 
+/*
+ * Yield ping-pong between two equal-priority threads, first with stack-only
+ * address spaces, then with one mapped buffer each so every switch carries a
+ * dynamic MPU region.  The per-CPU MPU counters show how many protection
+ * slots the switches rewrote versus left alone because the shadow matched.
+ */
+#define YIELDS		200u
+#define MAP_SIZE	256u
+
+static volatile int g_pass;
+static volatile int g_fail;
+static ulmk_notif_t g_done;
+static volatile int g_map;
+
+#define CHECK(cond) do { if (cond) g_pass++; else g_fail++; } while (0)
+
+static void pingpong(void *arg)
+{
+	uint32_t bit = (uint32_t)(uintptr_t)arg;
+	volatile uint8_t *buf = NULL;
+	uint32_t i;
+
+	if (g_map) {
+		buf = (volatile uint8_t *)ulmk_mem_map(NULL, MAP_SIZE,
+						       ULMK_PERM_READ |
+						       ULMK_PERM_WRITE,
+						       ULMK_MMAP_ANON);
+		CHECK(sdk_map_ok((const void *)buf));
+	}
+	for (i = 0u; i < YIELDS; i++) {
+		if (buf)
+			buf[i % MAP_SIZE] = (uint8_t)i;
+		ulmk_thread_yield();
+	}
+	ulmk_notif_signal(g_done, bit);
+	ulmk_thread_exit();
+}
+
+static void run_phase(const char *name, int map)
+{
+	ulmk_mpu_stats_t before;
+	ulmk_mpu_stats_t after;
+	uint32_t         bits = 0u;
+	uint32_t         writes;
+	uint32_t         skipped;
+
+	g_map = map;
+	CHECK(ulmk_mpu_stats(0u, &before) == ULMK_OK);
+	sdk_spawn("ping", pingpong, (void *)(uintptr_t)1u, 2u, 1024u, 0u);
+	sdk_spawn("pong", pingpong, (void *)(uintptr_t)2u, 2u, 1024u, 0u);
+	ulmk_notif_wait(g_done, 1u, &bits);
+	ulmk_notif_wait(g_done, 2u, &bits);
+	CHECK(ulmk_mpu_stats(0u, &after) == ULMK_OK);
+
+	writes  = after.slot_writes - before.slot_writes;
+	skipped = after.slot_skips - before.slot_skips;
+	CHECK(after.switches - before.switches >= YIELDS);
+	if (map)
+		CHECK(skipped > 0u);
+
+	sdk_puts("ctx_switch: mpu ");
+	sdk_puts(name);
+	sdk_puts(" switches=");
+	sdk_put_u32(after.switches - before.switches);
+	sdk_puts(" unchanged=");
+	sdk_put_u32(after.unchanged - before.unchanged);
+	sdk_puts(" writes=");
+	sdk_put_u32(writes);
+	sdk_puts(" skipped=");
+	sdk_put_u32(skipped);
+	sdk_puts(" merged=");
+	sdk_put_u32(after.merged - before.merged);
+	sdk_puts("\n");
+}
+
 void ulmk_root_thread(const ulmk_boot_info_t *info)
 {
+	ulmk_mpu_stats_t st;
+
 	board_services_init(info);
 	sdk_puts("ctx_switch: ROOT THREAD RUNNING\n");
-	sdk_puts("ctx_switch: PASS\n");
+	g_done = ulmk_notif_create();
+
+	CHECK(ulmk_mpu_stats(0xFFFFu, &st) == ULMK_EINVAL);
+	CHECK(ulmk_mpu_stats(0u, NULL) == ULMK_EINVAL);
+	run_phase("stack", 0);
+	run_phase("mapped", 1);
+
+	if (g_fail == 0)
+		sdk_puts("ctx_switch: PASS\n");
+	else
+		sdk_puts("ctx_switch: FAIL\n");
 	ulmk_thread_exit();
 }
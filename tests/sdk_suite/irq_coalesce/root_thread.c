@@ -0,0 +1,182 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * irq_coalesce — software-triggered IRQ batched by ulmk_irq_coalesce().
+ *
+ * Covers: a full batch signals once on its last event, a partial batch is
+ * flushed by the tick deadline, per-batch counters in ulmk_irq_stats(),
+ * argument checks, a level source held masked for its batch and unmasked
+ * by the ack, and turning coalescing off.  Trigger sources as in irq_sw.
+ */
+#include "sdk_test_util.h"
+#include <board_config.h>
+
+#define UL_IRQ_SRPN		12u
+#define UL_IRQ_UNBOUND		13u
+#define IRQ_BIT			0u
+#define BATCH			4u
+#define DEADLINE_TICKS		5u
+#define SRC_SETR_BIT		(1u << 26)
+
+#define UL_NVIC_SRC(irq)	(0x8000u | ((uint32_t)(irq) & 0x7FFFu))
+
+#if defined(ULMK_BOARD_SRC_BASE)
+#define UL_IRQ_SRC_REG		(ULMK_BOARD_SRC_BASE + 0xC2u * 4u)
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_SRC_BASE
+#define UL_IRQ_MAP_SIZE		1024u
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+#define UL_IRQ_SRC_REG		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_SIZE		0x1000u
+#elif defined(__ARM_ARCH)
+#ifndef UL_IRQ_NVIC_LINE
+#define UL_IRQ_NVIC_LINE	3u
+#endif
+#define ARM_NVIC_STIR		0xE000EF00u
+#define UL_IRQ_SRC_REG		UL_NVIC_SRC(UL_IRQ_NVIC_LINE)
+#else
+#error "irq_coalesce: unsupported board"
+#endif
+
+static int g_fail;
+
+#define CHECK(name, cond)					\
+	do {							\
+		if (!(cond)) {					\
+			sdk_puts("irq_coalesce: " name " FAIL\n");	\
+			g_fail = 1;				\
+		}						\
+	} while (0)
+
+static void irq_sw_trigger(void)
+{
+#if defined(ULMK_BOARD_SRC_BASE)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG |= SRC_SETR_BIT;
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG = 1u;
+#elif defined(__ARM_ARCH)
+	*(volatile uint32_t *)(uintptr_t)ARM_NVIC_STIR = UL_IRQ_NVIC_LINE;
+#endif
+}
+
+/* Fire @n interrupts, giving each one time to be taken before the next. */
+static void trigger_n(uint32_t n)
+{
+	volatile uint32_t spin;
+
+	while (n--) {
+		irq_sw_trigger();
+		for (spin = 0u; spin < 2000u; spin++)
+			;
+	}
+}
+
+/* Coalescing counters summed over every CPU. */
+static void coal_totals(uint32_t *events, uint32_t *batches)
+{
+	ulmk_irq_stats_t st;
+	uint32_t         cpu;
+
+	*events  = 0u;
+	*batches = 0u;
+	for (cpu = 0u; ulmk_irq_stats(cpu, &st) == ULMK_OK; cpu++) {
+		*events  += st.coal_events;
+		*batches += st.coal_batches;
+	}
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_notif_t n;
+	uint32_t     bits;
+	uint32_t     ev0, bt0, ev1, bt1;
+
+	board_services_init(info);
+	sdk_puts("irq_coalesce: start\n");
+
+#if defined(UL_IRQ_MAP_BASE)
+	if (!sdk_map_ok(ulmk_mem_map((void *)(uintptr_t)UL_IRQ_MAP_BASE,
+				     UL_IRQ_MAP_SIZE,
+				     ULMK_PERM_READ | ULMK_PERM_WRITE,
+				     ULMK_MMAP_PERIPH))) {
+		sdk_puts("irq_coalesce: map FAIL\n");
+		ulmk_thread_exit();
+	}
+#endif
+
+	n = ulmk_notif_create();
+	CHECK("bind", ulmk_irq_bind_hw(UL_IRQ_SRPN, n, IRQ_BIT,
+				       (uintptr_t)UL_IRQ_SRC_REG) == ULMK_OK);
+
+	CHECK("unbound_einval",
+	      ulmk_irq_coalesce(UL_IRQ_UNBOUND, BATCH, DEADLINE_TICKS) ==
+	      ULMK_EINVAL);
+	CHECK("zero_ticks_einval",
+	      ulmk_irq_coalesce(UL_IRQ_SRPN, BATCH, 0u) == ULMK_EINVAL);
+	CHECK("coalesce", ulmk_irq_coalesce(UL_IRQ_SRPN, BATCH,
+					    DEADLINE_TICKS) == ULMK_OK);
+	CHECK("enable", ulmk_irq_enable(UL_IRQ_SRPN) == ULMK_OK);
+
+	/* Full batch: one wake for BATCH interrupts. */
+	coal_totals(&ev0, &bt0);
+	trigger_n(BATCH);
+	bits = 0u;
+	CHECK("batch_wait",
+	      ulmk_notif_wait(n, 1u << IRQ_BIT, &bits) == ULMK_OK);
+	ulmk_irq_ack(UL_IRQ_SRPN);
+	CHECK("batch_no_extra", ulmk_notif_poll(n, 1u << IRQ_BIT) == 0u);
+	coal_totals(&ev1, &bt1);
+	CHECK("batch_events", ev1 - ev0 == BATCH);
+	CHECK("batch_count", bt1 - bt0 == 1u);
+
+	/* Partial batch: the deadline delivers it. */
+	trigger_n(BATCH / 2u);
+	bits = 0u;
+	CHECK("deadline_wait",
+	      ulmk_notif_wait(n, 1u << IRQ_BIT, &bits) == ULMK_OK);
+	ulmk_irq_ack(UL_IRQ_SRPN);
+	coal_totals(&ev0, &bt0);
+	CHECK("deadline_events", ev0 - ev1 == BATCH / 2u);
+	CHECK("deadline_count", bt0 - bt1 == 1u);
+
+	/*
+	 * Level source: the first interrupt masks it, so the rest of the
+	 * burst stays pending and the ack after the wake clears it.
+	 */
+	CHECK("level", ulmk_irq_coalesce(UL_IRQ_SRPN,
+					 BATCH | ULMK_IRQ_COALESCE_LEVEL,
+					 DEADLINE_TICKS) == ULMK_OK);
+	trigger_n(BATCH);
+	bits = 0u;
+	CHECK("level_wait",
+	      ulmk_notif_wait(n, 1u << IRQ_BIT, &bits) == ULMK_OK);
+	ulmk_irq_ack(UL_IRQ_SRPN);
+	coal_totals(&ev1, &bt1);
+	CHECK("level_events", ev1 - ev0 == 1u);
+	CHECK("level_count", bt1 - bt0 == 1u);
+
+	/* Unmasked by that ack: the next interrupt opens a new batch. */
+	trigger_n(1u);
+	bits = 0u;
+	CHECK("level_rearm_wait",
+	      ulmk_notif_wait(n, 1u << IRQ_BIT, &bits) == ULMK_OK);
+	ulmk_irq_ack(UL_IRQ_SRPN);
+	coal_totals(&ev0, &bt0);
+	CHECK("level_rearm_events", ev0 - ev1 == 1u);
+	CHECK("level_rearm_count", bt0 - bt1 == 1u);
+
+	/* Off again: every interrupt signals, counters stand still. */
+	CHECK("off", ulmk_irq_coalesce(UL_IRQ_SRPN, 0u, 0u) == ULMK_OK);
+	trigger_n(1u);
+	bits = 0u;
+	CHECK("off_wait",
+	      ulmk_notif_wait(n, 1u << IRQ_BIT, &bits) == ULMK_OK);
+	ulmk_irq_ack(UL_IRQ_SRPN);
+	coal_totals(&ev1, &bt1);
+	CHECK("off_counters", ev1 == ev0 && bt1 == bt0);
+
+	/* See irq_sw: do not exit with the line armed on ARM. */
+	ulmk_irq_disable(UL_IRQ_SRPN);
+
+	sdk_puts(g_fail ? "irq_coalesce: FAIL\n" : "irq_coalesce: PASS\n");
+	ulmk_thread_exit();
+}
@@ -0,0 +1,142 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * irq_plic_order — PLIC claim order follows the binding priority.
+ *
+ * RISC-V virt only (other boards report SKIP).  The UART THR-empty line
+ * (PLIC 10) is attached at a low SRPN and the goldfish RTC alarm (PLIC 11)
+ * at a high one.  An attach callback on CLINT MSIP raises both lines, the
+ * less urgent one first, with interrupts off, so both are pending when the
+ * hart next claims.  The RTC must be served first: on a priority tie the
+ * PLIC would pick the lower id, the UART.
+ */
+#include "sdk_test_util.h"
+#include <board_config.h>
+
+#if defined(ULMK_BOARD_PLIC_BASE) && defined(ULMK_BOARD_TIMER_RTC_BASE)
+
+#define UL_IRQ_SRPN_KICK	11u
+#define UL_IRQ_SRPN_LOW		20u
+#define UL_IRQ_SRPN_HIGH	200u
+
+/* Match arch/riscv ULMK_ARCH_PLIC_SRC() — a PLIC id as a bind address. */
+#define UL_PLIC_SRC(id)		((uint32_t)(id) << 2)
+#define UL_PLIC_UART		10u
+
+#define UART_IER		(ULMK_BOARD_PERIPH_BASE + 1u)
+#define UART_IER_THRI		0x02u
+
+#define RTC_ALARM_LOW		(ULMK_BOARD_TIMER_RTC_BASE + 0x08u)
+#define RTC_ALARM_HIGH		(ULMK_BOARD_TIMER_RTC_BASE + 0x0Cu)
+#define RTC_IRQ_ENABLED		(ULMK_BOARD_TIMER_RTC_BASE + 0x10u)
+#define RTC_CLEAR_INTERRUPT	(ULMK_BOARD_TIMER_RTC_BASE + 0x1Cu)
+
+#define MMIO32(a)		(*(volatile uint32_t *)(uintptr_t)(a))
+#define MMIO8(a)		(*(volatile uint8_t *)(uintptr_t)(a))
+
+static volatile uint8_t g_order[2];
+static volatile int     g_hits;
+
+static bool uart_cb(void *data)
+{
+	(void)data;
+	MMIO8(UART_IER) = 0u;
+	if (g_hits < 2)
+		g_order[g_hits] = UL_IRQ_SRPN_LOW;
+	g_hits++;
+	return false;
+}
+
+static bool rtc_cb(void *data)
+{
+	(void)data;
+	MMIO32(RTC_IRQ_ENABLED)     = 0u;
+	MMIO32(RTC_CLEAR_INTERRUPT) = 1u;
+	if (g_hits < 2)
+		g_order[g_hits] = UL_IRQ_SRPN_HIGH;
+	g_hits++;
+	return false;
+}
+
+/* Both lines go up here, under MIE clear; UART first. */
+static bool kick_cb(void *data)
+{
+	(void)data;
+	MMIO32(ULMK_BOARD_CLINT_BASE) = 0u;
+	MMIO8(UART_IER)        = UART_IER_THRI;
+	MMIO32(RTC_IRQ_ENABLED) = 1u;
+	MMIO32(RTC_ALARM_HIGH)  = 0u;
+	MMIO32(RTC_ALARM_LOW)   = 0u;		/* in the past: fires now */
+	return false;
+}
+
+static int attach_ok(uint8_t srpn, ulmk_irq_attach_fn_t fn, uint32_t src)
+{
+	ulmk_notif_t n = ulmk_irq_attach_hw(srpn, fn, NULL, (uintptr_t)src);
+
+	/* Errors are small negative ULMK_E*; notif handles may be high ptrs. */
+	if (n == ULMK_NOTIF_INVALID || ((int32_t)n < 0 && (int32_t)n >= -16))
+		return 0;
+	return ulmk_irq_enable(srpn) == ULMK_OK;
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	int ok = 1;
+	int i;
+
+	board_services_init(info);
+	sdk_puts("irq_plic_order: start\n");
+
+	if (!sdk_map_ok(ulmk_mem_map((void *)(uintptr_t)ULMK_BOARD_CLINT_BASE,
+				     0x1000u, ULMK_PERM_READ | ULMK_PERM_WRITE,
+				     ULMK_MMAP_PERIPH))) {
+		sdk_puts("irq_plic_order: map FAIL\n");
+		ulmk_thread_exit();
+	}
+
+	ok &= attach_ok(UL_IRQ_SRPN_LOW, uart_cb, UL_PLIC_SRC(UL_PLIC_UART));
+	ok &= attach_ok(UL_IRQ_SRPN_HIGH, rtc_cb,
+			UL_PLIC_SRC(ULMK_BOARD_TIMER_PLIC_IRQ));
+	ok &= attach_ok(UL_IRQ_SRPN_KICK, kick_cb, ULMK_BOARD_CLINT_BASE);
+	if (!ok) {
+		sdk_puts("irq_plic_order: attach FAIL\n");
+		ulmk_thread_exit();
+	}
+
+	MMIO32(ULMK_BOARD_CLINT_BASE) = 1u;
+	for (i = 0; i < 50 && g_hits < 2; i++)
+		ulmk_thread_yield();
+
+	if (g_hits != 2 || g_order[0] != UL_IRQ_SRPN_HIGH ||
+	    g_order[1] != UL_IRQ_SRPN_LOW) {
+		sdk_puts("irq_plic_order: order FAIL hits=");
+		sdk_put_u32((uint32_t)g_hits);
+		sdk_puts(" first=");
+		sdk_put_u32(g_order[0]);
+		sdk_puts("\n");
+		ok = 0;
+	}
+
+	ulmk_irq_disable(UL_IRQ_SRPN_KICK);
+	ulmk_irq_disable(UL_IRQ_SRPN_HIGH);
+	ulmk_irq_disable(UL_IRQ_SRPN_LOW);
+	(void)ulmk_irq_detach(UL_IRQ_SRPN_KICK);
+	(void)ulmk_irq_detach(UL_IRQ_SRPN_HIGH);
+	(void)ulmk_irq_detach(UL_IRQ_SRPN_LOW);
+
+	sdk_puts(ok ? "irq_plic_order: PASS\n" : "irq_plic_order: FAIL\n");
+	ulmk_thread_exit();
+}
+
+#else
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	board_services_init(info);
+	sdk_puts("irq_plic_order: start\n");
+	sdk_puts("irq_plic_order: no PLIC SKIP\n");
+	sdk_puts("irq_plic_order: PASS\n");
+	ulmk_thread_exit();
+}
+
+#endif
@@ -1,6 +1,15 @@
 /* SPDX-License-Identifier: MIT */
 /*
- * irq_stress — flood / ooo-ack / rebind / preempt / bind-table exhaust.
+ * irq_stress — bind churn / flood / ooo-ack / rebind / preempt /
+ * bind-table exhaust.  The case raises ULMK_CONFIG_MAX_IRQ_BINDINGS
+ * (IRQ_STRESS_BINDINGS, see Makefile); bind churn fills the whole table
+ * with handler-thread bindings, drops them by detach and by thread exit,
+ * and refills it: a full table every time means the live count is back
+ * to 0.
+ * The flood phase also reports kernel entry-to-signal latency from
+ * ulmk_irq_stats() (cycles; 0 unless the kernel enables the cycle counter)
+ * and the reschedule IPIs sent meanwhile; the source follows its consumer
+ * (ULMK_IRQ_CPU_AUTO), so that count stays flat.
  *
  * Soft-trigger backends match sdk_suite/irq_sw.
  * Root maps the trigger MMIO and fires; a high-prio consumer binds/waits
@@ -17,6 +26,12 @@
 #define FLOOD_N		32
 #define REBIND_N	8
 #define PREEMPT_N	16
+#define CHURN_SRPN0	40u
+#define CHURN_ROUNDS	4
+
+#ifndef IRQ_STRESS_BINDINGS
+#define IRQ_STRESS_BINDINGS	16
+#endif
 
 #define UL_NVIC_SRC(irq)	(0x8000u | ((uint32_t)(irq) & 0x7FFFu))
 
@@ -112,6 +127,9 @@ static int bind_enable(uint8_t srpn, ulmk_notif_t n, uintptr_t src)
 	int rc;
 
 	rc = ulmk_irq_bind_hw(srpn, n, IRQ_BIT_IDX, src);
+	if (rc != ULMK_OK)
+		return rc;
+	rc = ulmk_irq_affinity(srpn, ULMK_IRQ_CPU_AUTO);
 	if (rc != ULMK_OK)
 		return rc;
 	return ulmk_irq_enable(srpn);
@@ -167,11 +185,115 @@ static void fire_n(uint32_t n)
 	(void)ulmk_thread_priority_set(ulmk_thread_self(), 100u);
 }
 
-static void run_flood(void)
+static void report_latency(const ulmk_irq_stats_t *a,
+			   const ulmk_irq_stats_t *b)
+{
+	uint32_t n = b->signals - a->signals;
+
+	sdk_puts("irq_stress: latency signals=");
+	sdk_put_u32(n);
+	sdk_puts(" avg=");
+	sdk_put_u32(n ? (b->lat_total - a->lat_total) / n : 0u);
+	sdk_puts(" max=");
+	sdk_put_u32(b->lat_max);
+	sdk_puts(" cycles ipis=");
+	sdk_put_u32(b->ipis - a->ipis);
+	sdk_puts("\n");
+}
+
+/*
+ * Thread-bind SRPNs from CHURN_SRPN0 up until the table is full.  Returns
+ * how many were bound; *@full is set when the last one hit ULMK_ENOSPC.
+ */
+static int churn_fill(int *full)
+{
+	int i;
+	int rc;
+
+	*full = 0;
+	for (i = 0; CHURN_SRPN0 + (unsigned)i < 256u; i++) {
+		rc = ulmk_irq_thread_bind((uint8_t)(CHURN_SRPN0 + (unsigned)i),
+					  (uintptr_t)UL_IRQ_SRC_B, 4u);
+		if (rc != ULMK_OK) {
+			*full = (rc == ULMK_ENOSPC);
+			break;
+		}
+	}
+	return i;
+}
+
+static int churn_drop(int n)
+{
+	int i;
+	int ok = 1;
+
+	for (i = 0; i < n; i++)
+		ok &= ulmk_irq_detach((uint8_t)(CHURN_SRPN0 + (unsigned)i)) ==
+		      ULMK_OK;
+	return ok;
+}
+
+/* Fill the table and exit: thread exit must free every binding. */
+static void churn_exit_worker(void *arg)
+{
+	int full;
+
+	(void)arg;
+	g_count = churn_fill(&full);
+	if (!full)
+		g_count = -1;
+	ulmk_notif_signal(g_sync, BIT_FIN);
+	ulmk_thread_exit();
+}
+
+static void run_bind_churn(void)
 {
 	ulmk_tid_t w;
+	uint32_t   bits;
+	int        n;
+	int        full;
+	int        round;
+	int        ok;
+
+	n = churn_fill(&full);
+	CHECK("churn_full", full);
+	CHECK("churn_table", n == IRQ_STRESS_BINDINGS);
+	CHECK("churn_past_16", n > 16);
+	CHECK("churn_dup", ulmk_irq_thread_bind((uint8_t)CHURN_SRPN0, 0u, 4u) ==
+			   ULMK_EINVAL);
+
+	/* Reuse after unbind: every round gets the whole table back. */
+	ok = 1;
+	for (round = 0; round < CHURN_ROUNDS; round++) {
+		ok &= churn_drop(n);
+		ok &= churn_fill(&full) == n && full;
+	}
+	CHECK("churn_reuse", ok);
+	CHECK("churn_drop", churn_drop(n));
+	CHECK("churn_detach_gone",
+	      ulmk_irq_detach((uint8_t)CHURN_SRPN0) != ULMK_OK);
 
 	g_count = 0;
+	w = sdk_spawn("churn_w", churn_exit_worker, NULL, 2u, 2048u, 0u);
+	CHECK("churn_spawn", w != ULMK_TID_INVALID);
+	(void)ulmk_cap_grant(w, ULMK_CAP_IRQ);
+	bits = 0u;
+	(void)ulmk_notif_wait(g_sync, BIT_FIN, &bits);
+	CHECK("churn_exit_fill", g_count == n);
+	/* Let the worker finish exiting before its bindings are counted. */
+	sdk_msleep_yield(2u);
+	CHECK("churn_exit_freed", churn_fill(&full) == n && full);
+	CHECK("churn_exit_drop", churn_drop(n));
+}
+
+static void run_flood(void)
+{
+	ulmk_irq_stats_t before;
+	ulmk_irq_stats_t after;
+	ulmk_tid_t       w;
+
+	g_count = 0;
+	CHECK("flood_stats", ulmk_irq_stats(0u, &before) == ULMK_OK);
 	w = sdk_spawn("flood_w", irq_consumer, (void *)(uintptr_t)FLOOD_N,
 		      2u, 2048u, 0u);
 	CHECK("flood_spawn", w != ULMK_TID_INVALID);
@@ -179,6 +301,12 @@ static void run_flood(void)
 	(void)ulmk_cap_grant(w, ULMK_CAP_MAP_PERIPH);
 	fire_n(FLOOD_N);
 	CHECK("flood_count", g_count == FLOOD_N);
+	CHECK("flood_stats2", ulmk_irq_stats(0u, &after) == ULMK_OK);
+	CHECK("flood_signals", after.signals - before.signals >= FLOOD_N);
+	CHECK("flood_lat_max", after.lat_max >= after.lat_last);
+	CHECK("flood_affinity_bad_cpu",
+	      ulmk_irq_affinity(UL_IRQ_SRPN_A, 200u) == ULMK_EINVAL);
+	report_latency(&before, &after);
 }
 
 static void run_ooo_ack(void)
@@ -280,11 +408,11 @@ static void run_bind_exhaust(void)
 
 	n = 0;
 	hit_nospace = 0;
-	for (i = 0; i < 32; i++) {
-		dummy = ulmk_notif_create();
-		if (dummy == ULMK_NOTIF_INVALID)
-			break;
-		rc = ulmk_irq_bind((uint8_t)(40u + (unsigned)i), dummy, 0u);
+	dummy = ulmk_notif_create();
+	for (i = 0; dummy != ULMK_NOTIF_INVALID &&
+		    40u + (unsigned)i < 256u; i++) {
+		rc = ulmk_irq_bind((uint8_t)(40u + (unsigned)i), dummy,
+				   (uint32_t)i & 31u);
 		if (rc == ULMK_ENOSPC) {
 			hit_nospace = 1;
 			break;
@@ -294,6 +422,8 @@ static void run_bind_exhaust(void)
 	}
 	CHECK("bind_got_space", n > 0);
 	CHECK("bind_exhausted", hit_nospace);
+	CHECK("bind_dup", ulmk_irq_bind(UL_IRQ_SRPN_A, g_irq, 0u) == ULMK_EINVAL);
+	CHECK("stats_bad_cpu", ulmk_irq_stats(0xFFFFu, NULL) == ULMK_EINVAL);
 }
 
 void ulmk_root_thread(const ulmk_boot_info_t *info)
@@ -314,6 +444,8 @@ void ulmk_root_thread(const ulmk_boot_info_t *info)
 
 	(void)ulmk_thread_priority_set(ulmk_thread_self(), 100u);
 
+	sdk_puts("> bind_churn\n");
+	run_bind_churn();
 	sdk_puts("> flood\n");
 	run_flood();
 	sdk_puts("> ooo_ack\n");
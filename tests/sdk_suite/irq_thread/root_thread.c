@@ -0,0 +1,153 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * irq_thread — software-triggered IRQ served by a threaded handler.
+ *
+ * Covers: ISR readies the bound thread directly, handler runs at the IRQ
+ * priority and drops back on the next wait, another driver thread cannot
+ * detach the binding without ULMK_CAP_KILL, detach wakes a blocked handler
+ * with EINVAL.  Trigger sources as in irq_sw.
+ */
+#include "sdk_test_util.h"
+#include <board_config.h>
+
+#define UL_IRQ_SRPN		12u
+#define BIT_SRV_RDY		(1u << 0)
+#define BIT_DONE		(1u << 1)
+#define BIT_TRIG_DONE		(1u << 2)
+#define ITER_COUNT		10
+#define SRV_PRIO		20u
+#define IRQ_PRIO		2u
+#define SRC_SETR_BIT		(1u << 26)
+
+#define UL_NVIC_SRC(irq)	(0x8000u | ((uint32_t)(irq) & 0x7FFFu))
+
+#if defined(ULMK_BOARD_SRC_BASE)
+#define UL_IRQ_SRC_REG		(ULMK_BOARD_SRC_BASE + 0xC2u * 4u)
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_SRC_BASE
+#define UL_IRQ_MAP_SIZE		1024u
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+#define UL_IRQ_SRC_REG		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_SIZE		0x1000u
+#elif defined(__ARM_ARCH)
+#ifndef UL_IRQ_NVIC_LINE
+#define UL_IRQ_NVIC_LINE	3u
+#endif
+#define ARM_NVIC_STIR		0xE000EF00u
+#define UL_IRQ_SRC_REG		UL_NVIC_SRC(UL_IRQ_NVIC_LINE)
+#else
+#error "irq_thread: unsupported board"
+#endif
+
+static volatile ulmk_notif_t g_sync = ULMK_NOTIF_INVALID;
+static volatile ulmk_tid_t   g_srv  = ULMK_TID_INVALID;
+static volatile int          g_irq_count;
+static volatile int          g_prio_ok = 1;
+static volatile int          g_detach_rc = 1;
+static volatile int          g_foreign_rc = 1;
+
+static void irq_sw_trigger(void)
+{
+#if defined(ULMK_BOARD_SRC_BASE)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG |= SRC_SETR_BIT;
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG = 1u;
+#elif defined(__ARM_ARCH)
+	*(volatile uint32_t *)(uintptr_t)ARM_NVIC_STIR = UL_IRQ_NVIC_LINE;
+#endif
+}
+
+static void irq_handler_thread(void *arg)
+{
+	int i;
+
+	(void)arg;
+	if (ulmk_irq_thread_bind(UL_IRQ_SRPN, (uintptr_t)UL_IRQ_SRC_REG,
+				 IRQ_PRIO) != ULMK_OK) {
+		sdk_puts("irq_thread: bind FAIL\n");
+		ulmk_thread_exit();
+	}
+	ulmk_notif_signal(g_sync, BIT_SRV_RDY);
+
+	for (i = 0; i < ITER_COUNT; i++) {
+		if (ulmk_irq_thread_wait(UL_IRQ_SRPN) != ULMK_OK)
+			break;
+		if (ulmk_thread_priority_get(ulmk_thread_self()) != (int)IRQ_PRIO)
+			g_prio_ok = 0;
+		g_irq_count++;
+		ulmk_notif_signal(g_sync, BIT_SRV_RDY);
+	}
+
+	/* Blocks with the source unmasked until root detaches the binding. */
+	g_detach_rc = ulmk_irq_thread_wait(UL_IRQ_SRPN);
+	if (ulmk_thread_priority_get(ulmk_thread_self()) != (int)SRV_PRIO)
+		g_prio_ok = 0;
+	ulmk_notif_signal(g_sync, BIT_DONE);
+	ulmk_thread_exit();
+}
+
+static void trigger(void *arg)
+{
+	uint32_t bits;
+	int      i;
+
+	(void)arg;
+#if defined(UL_IRQ_MAP_BASE)
+	if (!sdk_map_ok(ulmk_mem_map((void *)(uintptr_t)UL_IRQ_MAP_BASE,
+				     UL_IRQ_MAP_SIZE,
+				     ULMK_PERM_READ | ULMK_PERM_WRITE,
+				     ULMK_MMAP_PERIPH)))
+		ulmk_thread_exit();
+#endif
+	bits = 0u;
+	ulmk_notif_wait(g_sync, BIT_SRV_RDY, &bits);
+	for (i = 0; i < ITER_COUNT; i++) {
+		irq_sw_trigger();
+		bits = 0u;
+		ulmk_notif_wait(g_sync, BIT_SRV_RDY, &bits);
+	}
+	/* CAP_IRQ but not CAP_KILL: the binding belongs to irq_thr. */
+	g_foreign_rc = ulmk_irq_detach(UL_IRQ_SRPN);
+	ulmk_notif_signal(g_sync, BIT_TRIG_DONE);
+	ulmk_thread_exit();
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_tid_t tid;
+	uint32_t   bits = 0u;
+	int        own_rc;
+
+	board_services_init(info);
+	sdk_puts("irq_thread: start\n");
+
+	g_sync = ulmk_notif_create();
+
+	g_srv = sdk_spawn("irq_thr", irq_handler_thread, NULL, SRV_PRIO,
+			  2048u, 0u);
+	ulmk_cap_grant(g_srv, ULMK_CAP_IRQ);
+	ulmk_cap_grant(g_srv, ULMK_CAP_MAP_PERIPH);
+
+	tid = sdk_spawn("trigger", trigger, NULL, 8u, 2048u, 0u);
+	ulmk_cap_grant(tid, ULMK_CAP_IRQ);
+	ulmk_cap_grant(tid, ULMK_CAP_MAP_PERIPH);
+
+	ulmk_notif_wait(g_sync, BIT_TRIG_DONE, &bits);
+	/* Root holds ULMK_CAP_KILL, so it may detach irq_thr's binding. */
+	own_rc = ulmk_irq_detach(UL_IRQ_SRPN);
+	bits = 0u;
+	ulmk_notif_wait(g_sync, BIT_DONE, &bits);
+
+	sdk_puts("irq_thread: count=");
+	sdk_put_u32((uint32_t)g_irq_count);
+	sdk_puts("\n");
+	if (g_foreign_rc != ULMK_EPERM)
+		sdk_puts("irq_thread: foreign detach not refused\n");
+	if (g_irq_count == ITER_COUNT && g_prio_ok &&
+	    g_foreign_rc == ULMK_EPERM && own_rc == ULMK_OK &&
+	    g_detach_rc == ULMK_EINVAL)
+		sdk_puts("irq_thread: PASS\n");
+	else
+		sdk_puts("irq_thread: FAIL\n");
+	ulmk_thread_exit();
+}
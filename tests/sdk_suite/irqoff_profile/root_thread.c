@@ -0,0 +1,254 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * irqoff_profile — IRQ-off windows and kernel lock profile
+ * (ULMK_CONFIG_IRQOFF_STATS=1).
+ *
+ * Drives IPC, notification, sleep, thread create/kill and a software IRQ
+ * through the kernel, then prints the worst IRQ-masked windows with their
+ * sites and the wait/hold times of each global lock.  Covers: windows are
+ * counted and ranked longest-first with distinct sites, gateway windows are
+ * tagged, the locks those paths take record acquisitions and a hold site;
+ * reading needs ULMK_CAP_STATS; argument checks.  Trigger sources as in
+ * irq_sw.
+ */
+#include "sdk_test_util.h"
+#include <board_config.h>
+
+#define UL_IRQ_SRPN		12u
+#define IRQ_BIT			0u
+#define LABEL_PING		0x41u
+#define SRC_SETR_BIT		(1u << 26)
+#define STACK_SZ		1024u
+#define N_ROUNDS		8u
+
+#define UL_NVIC_SRC(irq)	(0x8000u | ((uint32_t)(irq) & 0x7FFFu))
+
+#if defined(ULMK_BOARD_SRC_BASE)
+#define UL_IRQ_SRC_REG		(ULMK_BOARD_SRC_BASE + 0xC2u * 4u)
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_SRC_BASE
+#define UL_IRQ_MAP_SIZE		1024u
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+#define UL_IRQ_SRC_REG		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_SIZE		0x1000u
+#elif defined(__ARM_ARCH)
+#ifndef UL_IRQ_NVIC_LINE
+#define UL_IRQ_NVIC_LINE	3u
+#endif
+#define ARM_NVIC_STIR		0xE000EF00u
+#define UL_IRQ_SRC_REG		UL_NVIC_SRC(UL_IRQ_NVIC_LINE)
+#else
+#error "irqoff_profile: unsupported board"
+#endif
+
+static const char *const g_lock_name[ULMK_LOCK_NR] = {
+	"thread", "ipc", "rq", "irq", "timer", "mem",
+};
+
+static int          g_fail;
+static ulmk_ep_t    g_ep;
+static ulmk_notif_t g_notif;
+static volatile int g_probe;
+
+#define CHECK(name, cond)					\
+	do {							\
+		if (!(cond)) {					\
+			sdk_puts("irqoff_profile: " name " FAIL\n");	\
+			g_fail = 1;				\
+		}						\
+	} while (0)
+
+static void irq_sw_trigger(void)
+{
+#if defined(ULMK_BOARD_SRC_BASE)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG |= SRC_SETR_BIT;
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG = 1u;
+#elif defined(__ARM_ARCH)
+	*(volatile uint32_t *)(uintptr_t)ARM_NVIC_STIR = UL_IRQ_NVIC_LINE;
+#endif
+}
+
+static void put_hex32(uint32_t v)
+{
+	static const char hex[] = "0123456789abcdef";
+	char              buf[11];
+	int               i;
+
+	buf[0] = '0';
+	buf[1] = 'x';
+	for (i = 0; i < 8; i++)
+		buf[2 + i] = hex[(v >> (28 - 4 * i)) & 0xFu];
+	buf[10] = '\0';
+	sdk_puts(buf);
+}
+
+static void put_site(uint32_t site)
+{
+	if (!ULMK_IRQOFF_SITE_IS_GATEWAY(site)) {
+		put_hex32(site);
+		return;
+	}
+	switch (site & 0xFF00u) {
+	case 0x0000u:
+		sdk_puts("syscall ");
+		sdk_put_u32(site & 0xFFu);
+		break;
+	case 0x0100u:
+		sdk_puts("irq ");
+		sdk_put_u32(site & 0xFFu);
+		break;
+	case 0x0200u:
+		sdk_puts("tick");
+		break;
+	default:
+		sdk_puts("ipi");
+		break;
+	}
+}
+
+static void server(void *arg)
+{
+	ulmk_msg_t msg;
+	ulmk_tid_t sender;
+
+	(void)arg;
+	while (ulmk_ep_recv(g_ep, &msg, &sender) == ULMK_OK)
+		ulmk_ep_reply(sender, &msg);
+	ulmk_thread_exit();
+}
+
+static void short_lived(void *arg)
+{
+	(void)arg;
+	ulmk_thread_exit();
+}
+
+/* Driver thread without ULMK_CAP_STATS. */
+static void probe(void *arg)
+{
+	ulmk_irqoff_stats_t st;
+
+	(void)arg;
+	g_probe = ulmk_irqoff_stats(ulmk_cpu_id(), &st);
+	ulmk_thread_exit();
+}
+
+static void report(const ulmk_irqoff_stats_t *st)
+{
+	uint32_t i;
+
+	sdk_puts("irqoff_profile: windows ");
+	sdk_put_u32(st->windows);
+	sdk_puts("\n");
+	for (i = 0u; i < ULMK_IRQOFF_TOP; i++) {
+		if (st->worst[i].cycles == 0u)
+			break;
+		sdk_puts("irqoff_profile: worst ");
+		sdk_put_u32(st->worst[i].cycles);
+		sdk_puts(" cycles at ");
+		put_site(st->worst[i].site);
+		sdk_puts("\n");
+	}
+	for (i = 0u; i < ULMK_LOCK_NR; i++) {
+		sdk_puts("irqoff_profile: lock ");
+		sdk_puts(g_lock_name[i]);
+		sdk_puts(" acq ");
+		sdk_put_u32(st->lock[i].acquires);
+		sdk_puts(" wait_max ");
+		sdk_put_u32(st->lock[i].wait_max);
+		sdk_puts(" hold_max ");
+		sdk_put_u32(st->lock[i].hold_max);
+		sdk_puts(" at ");
+		put_hex32(st->lock[i].hold_max_site);
+		sdk_puts("\n");
+	}
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_irqoff_stats_t st;
+	ulmk_msg_t          msg;
+	ulmk_tid_t          srv;
+	ulmk_tid_t          t;
+	uint32_t            cpu;
+	uint32_t            i;
+	uint32_t            j;
+	int                 gateway = 0;
+
+	board_services_init(info);
+	sdk_puts("irqoff_profile: begin\n");
+
+#if defined(UL_IRQ_MAP_BASE)
+	if (!sdk_map_ok(ulmk_mem_map((void *)(uintptr_t)UL_IRQ_MAP_BASE,
+				     UL_IRQ_MAP_SIZE,
+				     ULMK_PERM_READ | ULMK_PERM_WRITE,
+				     ULMK_MMAP_PERIPH))) {
+		sdk_puts("irqoff_profile: map FAIL\n");
+		ulmk_thread_exit();
+	}
+#endif
+
+	cpu = ulmk_cpu_id();
+	CHECK("bad_cpu", ulmk_irqoff_stats(0xFFFFu, &st) == ULMK_EINVAL);
+	CHECK("null_out", ulmk_irqoff_stats(cpu, NULL) == ULMK_EINVAL);
+
+	g_ep    = ulmk_ep_create();
+	g_notif = ulmk_notif_create();
+	CHECK("objs", g_ep != ULMK_EP_INVALID &&
+		      g_notif != ULMK_NOTIF_INVALID);
+	CHECK("bind", ulmk_irq_bind_hw(UL_IRQ_SRPN, g_notif, IRQ_BIT,
+				       (uintptr_t)UL_IRQ_SRC_REG) == ULMK_OK);
+	srv = sdk_spawn("srv", server, NULL, 2u, STACK_SZ, 0u);
+	CHECK("spawn_srv", srv != ULMK_TID_INVALID);
+
+	for (i = 0u; i < N_ROUNDS; i++) {
+		msg.label    = LABEL_PING;
+		msg.words[0] = i;
+		CHECK("call", ulmk_ep_call(g_ep, &msg) == ULMK_OK);
+		CHECK("signal", ulmk_notif_signal(g_notif, 2u) == ULMK_OK);
+		CHECK("poll", ulmk_notif_poll(g_notif, 2u) == 2u);
+		CHECK("enable", ulmk_irq_enable(UL_IRQ_SRPN) == ULMK_OK);
+		irq_sw_trigger();
+		(void)ulmk_sleep_ms(1u);
+		ulmk_irq_ack(UL_IRQ_SRPN);
+		t = sdk_spawn("tmp", short_lived, NULL, 3u, STACK_SZ, 0u);
+		CHECK("spawn_tmp", t != ULMK_TID_INVALID);
+	}
+	/* See irq_sw: do not exit with the line armed on ARM. */
+	ulmk_irq_disable(UL_IRQ_SRPN);
+
+	CHECK("read", ulmk_irqoff_stats(cpu, &st) == ULMK_OK);
+	report(&st);
+
+	CHECK("windows", st.windows > 0u);
+	CHECK("worst", st.worst[0].cycles > 0u);
+	for (i = 0u; i < ULMK_IRQOFF_TOP; i++) {
+		if (st.worst[i].cycles == 0u)
+			break;
+		if (ULMK_IRQOFF_SITE_IS_GATEWAY(st.worst[i].site))
+			gateway = 1;
+		if (i > 0u)
+			CHECK("ranked", st.worst[i].cycles <=
+					st.worst[i - 1u].cycles);
+		for (j = 0u; j < i; j++)
+			CHECK("distinct", st.worst[i].site != st.worst[j].site);
+	}
+	CHECK("gateway_site", gateway);
+	CHECK("lock_ipc", st.lock[ULMK_LOCK_IPC].acquires >= N_ROUNDS);
+	CHECK("lock_rq", st.lock[ULMK_LOCK_RQ].acquires > 0u);
+	CHECK("lock_thread", st.lock[ULMK_LOCK_THREAD].acquires >= N_ROUNDS);
+	CHECK("lock_timer", st.lock[ULMK_LOCK_TIMER].acquires > 0u);
+	CHECK("hold_site", st.lock[ULMK_LOCK_IPC].hold_max_site != 0u);
+
+	/* The profile exposes kernel addresses: ULMK_CAP_STATS only. */
+	CHECK("probe", sdk_spawn("probe", probe, NULL, 1u, STACK_SZ, 0u) !=
+		       ULMK_TID_INVALID);
+	(void)ulmk_sleep_ms(2u);
+	CHECK("probe_perm", g_probe == ULMK_EPERM);
+
+	(void)ulmk_thread_kill(srv);
+
+	sdk_puts(g_fail ? "irqoff_profile: FAIL\n" : "irqoff_profile: PASS\n");
+	ulmk_thread_exit();
+}
@@ -0,0 +1,123 @@
+/* SPDX-License-Identifier: MIT */
+#include "sdk_test_util.h"
+
+/*
+ * Two threads spawned into one protection domain: a buffer granted to the
+ * domain once is reachable from both, a buffer one member maps is reachable
+ * from the other, and yields between them leave the MPU alone.
+ */
+#define YIELDS		200u
+#define MAP_SIZE	256u
+#define MAGIC_ROOT	0xD0A1u
+#define MAGIC_MEMBER	0x5EEDu
+
+static volatile int g_pass;
+static volatile int g_fail;
+static ulmk_notif_t g_done;
+static volatile uint32_t *g_granted;
+static volatile uint32_t *volatile g_member_buf;
+
+#define CHECK(cond) do { if (cond) g_pass++; else g_fail++; } while (0)
+
+static void member(void *arg)
+{
+	uint32_t bit = (uint32_t)(uintptr_t)arg;
+	volatile uint32_t *buf;
+	uint32_t i;
+
+	CHECK(g_granted[0] == MAGIC_ROOT);
+
+	if (bit == 1u) {
+		buf = (volatile uint32_t *)ulmk_mem_map(NULL, MAP_SIZE,
+							ULMK_PERM_READ |
+							ULMK_PERM_WRITE,
+							ULMK_MMAP_ANON);
+		CHECK(sdk_map_ok((const void *)buf));
+		if (sdk_map_ok((const void *)buf)) {
+			buf[0] = MAGIC_MEMBER;
+			g_member_buf = buf;
+		}
+	}
+	for (i = 0u; i < YIELDS; i++) {
+		if (bit == 2u && g_member_buf)
+			CHECK(g_member_buf[0] == MAGIC_MEMBER);
+		ulmk_thread_yield();
+	}
+	ulmk_notif_signal(g_done, bit);
+	ulmk_thread_exit();
+}
+
+static ulmk_tid_t spawn_member(ulmk_domain_t dom, uint32_t bit)
+{
+	ulmk_thread_attr_t a = {0};
+
+	a.name       = "member";
+	a.entry      = member;
+	a.arg        = (void *)(uintptr_t)bit;
+	a.priority   = 2u;
+	a.stack_size = 1024u;
+	a.privilege  = ULMK_PRIV_DRIVER;
+	a.domain     = dom;
+	return ulmk_thread_create(&a);
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_mpu_stats_t before;
+	ulmk_mpu_stats_t after;
+	ulmk_domain_t    dom;
+	uint32_t        *page;
+	uint32_t         bits = 0u;
+
+	board_services_init(info);
+	sdk_puts("mem_domain: ROOT THREAD RUNNING\n");
+	g_done = ulmk_notif_create();
+
+	dom = ulmk_domain_create();
+	CHECK(dom != ULMK_DOMAIN_INVALID);
+	CHECK(ulmk_domain_destroy(ULMK_DOMAIN_INVALID) == ULMK_EINVAL);
+
+	page = (uint32_t *)ulmk_mem_map(NULL, MAP_SIZE,
+					ULMK_PERM_READ | ULMK_PERM_WRITE,
+					ULMK_MMAP_ANON);
+	CHECK(sdk_map_ok(page));
+	if (!sdk_map_ok(page) || dom == ULMK_DOMAIN_INVALID)
+		goto report;
+	page[0]   = MAGIC_ROOT;
+	g_granted = page;
+
+	/* Only regions the caller owns may be granted. */
+	CHECK(ulmk_domain_grant(dom, page + 1, 4u, ULMK_PERM_READ) ==
+	      ULMK_EPERM);
+	CHECK(ulmk_domain_grant(dom, page, MAP_SIZE, ULMK_PERM_READ) ==
+	      ULMK_OK);
+
+	CHECK(ulmk_mpu_stats(0u, &before) == ULMK_OK);
+	CHECK(spawn_member(dom, 1u) != ULMK_TID_INVALID);
+	CHECK(spawn_member(dom, 2u) != ULMK_TID_INVALID);
+
+	/* Live members keep the domain; it only stops accepting new ones. */
+	CHECK(ulmk_domain_destroy(dom) == ULMK_OK);
+	CHECK(spawn_member(dom, 4u) == ULMK_TID_INVALID);
+	CHECK(ulmk_domain_destroy(dom) == ULMK_EINVAL);
+
+	ulmk_notif_wait(g_done, 1u, &bits);
+	ulmk_notif_wait(g_done, 2u, &bits);
+	CHECK(ulmk_mpu_stats(0u, &after) == ULMK_OK);
+	CHECK(g_member_buf != NULL);
+
+	sdk_puts("mem_domain: mpu switches=");
+	sdk_put_u32(after.switches - before.switches);
+	sdk_puts(" unchanged=");
+	sdk_put_u32(after.unchanged - before.unchanged);
+	sdk_puts(" writes=");
+	sdk_put_u32(after.slot_writes - before.slot_writes);
+	sdk_puts("\n");
+
+report:
+	if (g_fail == 0)
+		sdk_puts("mem_domain: PASS\n");
+	else
+		sdk_puts("mem_domain: FAIL\n");
+	ulmk_thread_exit();
+}
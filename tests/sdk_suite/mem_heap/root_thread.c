@@ -1,17 +1,40 @@
 /* SPDX-License-Identifier: MIT */
 #include "sdk_test_util.h"
+#include <umalloc.h>
 
 #define HEAP_SIZE	4096u
+#define UM_HEAP_SIZE	1024u
+#define UM_BLOCKS	8u
+#define UM_BLOCK_SZ	256u
+
+/*
+ * Allocation-throughput benchmark: allocations completed in BENCH_MS by
+ * umalloc vs a bump allocator, same size mix.  A higher-priority stopper
+ * thread ends each run, so no cycle counter is needed in userspace.
+ */
+#define BENCH_HEAP_SIZE	8192u
+#define BENCH_MS	100u
+#define BENCH_BATCH	16u
+#define BENCH_BUMP_SZ	4096u
 
 static volatile int g_pass;
 static volatile int g_fail;
 static ulmk_notif_t g_done;
+static ulmk_notif_t g_go;
+static volatile int g_stop;
+static uint8_t      g_bump[BENCH_BUMP_SZ] __attribute__((aligned(8)));
+
+static const uint16_t g_bench_sizes[8] = {
+	16u, 24u, 40u, 64u, 96u, 128u, 200u, 320u
+};
 
 #define CHECK(cond) do { if (cond) g_pass++; else g_fail++; } while (0)
 
 static void heap_test(void *arg)
 {
 	ulmk_heap_info_t info;
+	ulmk_heap_info_t added;
+	ulmk_heap_info_t after;
 	volatile uint8_t *heap;
 	size_t           i;
 	int              ok;
@@ -32,12 +55,150 @@ static void heap_test(void *arg)
 		}
 	}
 	CHECK(ok);
-	CHECK(ulmk_heap_extend(512u) == ULMK_OK);
+	CHECK(ulmk_heap_extend_info(512u, &added) == ULMK_OK);
+	CHECK(added.size == 512u);
+	CHECK(ulmk_get_thread_heap(&after) == ULMK_OK);
+	/* In-place growth lengthens the heap; otherwise it is left untouched. */
+	if (added.base == info.base + info.size)
+		CHECK(after.size == info.size + 512u);
+	else
+		CHECK(after.size == info.size);
+	heap = (volatile uint8_t *)(uintptr_t)added.base;
+	heap[0] = 0xA5u;
+	heap[added.size - 1u] = 0x5Au;
+	CHECK(heap[0] == 0xA5u && heap[added.size - 1u] == 0x5Au);
 
 	ulmk_notif_signal(g_done, 1u);
 	ulmk_thread_exit();
 }
 
+/*
+ * umalloc over a deliberately small heap: the arena must extend on demand
+ * to satisfy UM_BLOCKS × UM_BLOCK_SZ, and freed blocks must be reusable.
+ */
+static void umalloc_test(void *arg)
+{
+	umalloc_arena_t *a;
+	uint8_t         *blk[UM_BLOCKS];
+	uint32_t         i;
+	uint32_t         j;
+	umalloc_stats_t  st;
+	int              ok = 1;
+
+	(void)arg;
+	a = umalloc_init(UMALLOC_F_EXTEND);
+	CHECK(a != NULL);
+	for (i = 0u; i < UM_BLOCKS; i++) {
+		blk[i] = umalloc(a, UM_BLOCK_SZ);
+		CHECK(blk[i] != NULL);
+		if (!blk[i])
+			break;
+		for (j = 0u; j < UM_BLOCK_SZ; j++)
+			blk[i][j] = (uint8_t)(i + j);
+	}
+	umalloc_stats(a, &st);
+	CHECK(st.extends > 0u);
+	for (i = 0u; i < UM_BLOCKS && blk[i]; i++) {
+		for (j = 0u; j < UM_BLOCK_SZ; j++)
+			if (blk[i][j] != (uint8_t)(i + j))
+				ok = 0;
+	}
+	CHECK(ok);
+	for (i = 0u; i < UM_BLOCKS && blk[i]; i++)
+		ufree(a, blk[i]);
+	CHECK(umalloc(a, UM_BLOCK_SZ * 2u) != NULL);
+
+	/* Small frees are recycled by the size-class fast path. */
+	blk[0] = umalloc(a, 48u);
+	ufree(a, blk[0]);
+	CHECK(umalloc(a, 48u) == blk[0]);
+	umalloc_stats(a, &st);
+	CHECK(st.fast_hits == 1u);
+
+	ulmk_notif_signal(g_done, 2u);
+	ulmk_thread_exit();
+}
+
+/* One stop per bench_run(): umalloc pass, then bump pass. */
+static void bench_stopper(void *arg)
+{
+	uint32_t bits = 0u;
+	uint32_t run;
+
+	(void)arg;
+	for (run = 0u; run < 2u; run++) {
+		ulmk_notif_wait(g_go, 1u, &bits);
+		(void)ulmk_sleep_ms(BENCH_MS);
+		g_stop = 1;
+	}
+	ulmk_thread_exit();
+}
+
+static uint32_t bench_run(umalloc_arena_t *a)
+{
+	void     *p[BENCH_BATCH];
+	size_t    off;
+	uint32_t  ops = 0u;
+	uint32_t  i;
+
+	g_stop = 0;
+	ulmk_notif_signal(g_go, 1u);
+	while (!g_stop) {
+		off = 0u;
+		for (i = 0u; i < BENCH_BATCH; i++) {
+			size_t sz = g_bench_sizes[(ops + i) & 7u];
+
+			if (a) {
+				p[i] = umalloc(a, sz);
+			} else {
+				p[i] = &g_bump[off];
+				off += (sz + 7u) & ~(size_t)7u;
+			}
+			if (p[i])
+				*(volatile uint8_t *)p[i] = (uint8_t)i;
+		}
+		if (a) {
+			for (i = 0u; i < BENCH_BATCH; i++)
+				ufree(a, p[i]);
+		}
+		ops += BENCH_BATCH;
+	}
+	return ops;
+}
+
+static void bench_test(void *arg)
+{
+	umalloc_arena_t *a;
+	umalloc_stats_t  st;
+	uint32_t         um_ops;
+	uint32_t         bump_ops;
+
+	(void)arg;
+	a = umalloc_init(0u);
+	CHECK(a != NULL);
+	um_ops   = bench_run(a);
+	bump_ops = bench_run(NULL);
+	umalloc_stats(a, &st);
+	CHECK(um_ops > 0u && bump_ops > 0u);
+	CHECK(st.failures == 0u);
+	CHECK(st.fast_hits > st.slow_allocs);
+
+	sdk_puts("mem_heap: bench umalloc=");
+	sdk_put_u32(um_ops);
+	sdk_puts(" bump=");
+	sdk_put_u32(bump_ops);
+	sdk_puts(" allocs/");
+	sdk_put_u32(BENCH_MS);
+	sdk_puts("ms fast=");
+	sdk_put_u32(st.fast_hits);
+	sdk_puts(" slow=");
+	sdk_put_u32(st.slow_allocs);
+	sdk_puts("\n");
+
+	ulmk_notif_signal(g_done, 4u);
+	ulmk_thread_exit();
+}
+
 void ulmk_root_thread(const ulmk_boot_info_t *info)
 {
 	uint32_t bits = 0u;
@@ -47,6 +208,12 @@ void ulmk_root_thread(const ulmk_boot_info_t *info)
 	g_done = ulmk_notif_create();
 	sdk_spawn("heap", heap_test, NULL, 1u, 1024u, HEAP_SIZE);
 	ulmk_notif_wait(g_done, 1u, &bits);
+	sdk_spawn("umalloc", umalloc_test, NULL, 1u, 1024u, UM_HEAP_SIZE);
+	ulmk_notif_wait(g_done, 2u, &bits);
+	g_go = ulmk_notif_create();
+	sdk_spawn("stop", bench_stopper, NULL, 1u, 1024u, 0u);
+	sdk_spawn("bench", bench_test, NULL, 2u, 1024u, BENCH_HEAP_SIZE);
+	ulmk_notif_wait(g_done, 4u, &bits);
 
 	if (g_fail == 0)
 		sdk_puts("mem_heap: PASS\n");
@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: MIT */
+#include "sdk_test_util.h"
+
+/*
+ * Lazy MPU mapping (ULMK_CONFIG_MPU_LAZY_SLOTS=1): a user thread maps more
+ * buffers than the MPU has dynamic slots and touches them round-robin.
+ * Every buffer keeps its contents and each miss is served by a region load
+ * instead of killing the thread.  TriCore ignores the knob (no fault
+ * address), so only the data checks apply there.
+ */
+#define NBUF		6u
+#define ROUNDS		8u
+#define MAP_SIZE	256u
+
+static volatile int g_pass;
+static volatile int g_fail;
+static ulmk_notif_t g_done;
+
+#define CHECK(cond) do { if (cond) g_pass++; else g_fail++; } while (0)
+
+static void worker(void *arg)
+{
+	volatile uint32_t *buf[NBUF];
+	uint32_t           i;
+	uint32_t           r;
+
+	(void)arg;
+	for (i = 0u; i < NBUF; i++) {
+		buf[i] = (volatile uint32_t *)ulmk_mem_map(NULL, MAP_SIZE,
+							   ULMK_PERM_READ |
+							   ULMK_PERM_WRITE,
+							   ULMK_MMAP_ANON);
+		CHECK(sdk_map_ok((const void *)buf[i]));
+		if (!sdk_map_ok((const void *)buf[i]))
+			goto out;
+	}
+
+	for (r = 0u; r < ROUNDS; r++) {
+		for (i = 0u; i < NBUF; i++)
+			buf[i][r] = (i << 8) | r;
+		for (i = 0u; i < NBUF; i++)
+			CHECK(buf[i][r] == ((i << 8) | r));
+	}
+
+	/* A spilled region can be unmapped like a resident one. */
+	for (i = 0u; i < NBUF; i++)
+		CHECK(ulmk_mem_unmap((void *)buf[i], MAP_SIZE) == ULMK_OK);
+out:
+	ulmk_notif_signal(g_done, 1u);
+	ulmk_thread_exit();
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_thread_attr_t a = {0};
+	ulmk_mpu_stats_t   before;
+	ulmk_mpu_stats_t   after;
+	uint32_t           bits = 0u;
+
+	board_services_init(info);
+	sdk_puts("mem_lazy: ROOT THREAD RUNNING\n");
+	g_done = ulmk_notif_create();
+
+	a.name       = "lazy";
+	a.entry      = worker;
+	a.priority   = 2u;
+	a.stack_size = 1024u;
+	a.privilege  = ULMK_PRIV_USER;
+
+	CHECK(ulmk_mpu_stats(0u, &before) == ULMK_OK);
+	CHECK(ulmk_thread_create(&a) != ULMK_TID_INVALID);
+	ulmk_notif_wait(g_done, 1u, &bits);
+	CHECK(ulmk_mpu_stats(0u, &after) == ULMK_OK);
+#if !defined(__TRICORE__) && !defined(__tricore__)
+	CHECK(after.faults - before.faults >= NBUF);
+#endif
+
+	sdk_puts("mem_lazy: mpu faults=");
+	sdk_put_u32(after.faults - before.faults);
+	sdk_puts(" switches=");
+	sdk_put_u32(after.switches - before.switches);
+	sdk_puts("\n");
+
+	if (g_fail == 0)
+		sdk_puts("mem_lazy: PASS\n");
+	else
+		sdk_puts("mem_lazy: FAIL\n");
+	ulmk_thread_exit();
+}
@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * printk_ring — buffered kernel printk (ULMK_CONFIG_PRINTK_BUF_SIZE=1024).
+ *
+ * Boot messages sit in the ring until root sleeps and idle drains them; a
+ * user fault's "TRAP: killing thread" line is flushed by the trap path.
+ * Both are checked as sentinels.  Fault set-up as in fault_policy.
+ */
+#include "sdk_test_util.h"
+
+#define STACK_SZ	1024u
+
+static volatile uint32_t *g_forbidden;
+static volatile int       g_survived;
+
+static void faulter(void *arg)
+{
+	(void)arg;
+	g_forbidden[0] = 0xDEADBEEFu;
+	g_survived = 1;
+	ulmk_thread_exit();
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	void      *page;
+	ulmk_tid_t tid;
+
+	board_services_init(info);
+	sdk_puts("printk_ring: begin\n");
+
+	/* Let idle drain the boot log. */
+	(void)ulmk_sleep_ms(5u);
+
+	page = ulmk_mem_map(NULL, 128u, ULMK_PERM_READ | ULMK_PERM_WRITE,
+			    ULMK_MMAP_ANON);
+	if (!sdk_map_ok(page)) {
+		sdk_puts("printk_ring: FAIL\n");
+		ulmk_thread_exit();
+	}
+	g_forbidden = (volatile uint32_t *)page;
+
+	tid = sdk_spawn_priv("flt", faulter, NULL, 20u, STACK_SZ, 0u,
+			     ULMK_PRIV_USER);
+	(void)ulmk_sleep_ms(5u);
+
+	sdk_puts(tid != ULMK_TID_INVALID && !g_survived &&
+		 ulmk_thread_priority_get(tid) < 0 ?
+		 "printk_ring: PASS\n" : "printk_ring: FAIL\n");
+	(void)ulmk_mem_unmap(page, 128u);
+	ulmk_thread_exit();
+}
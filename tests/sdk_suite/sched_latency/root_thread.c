@@ -0,0 +1,256 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * sched_latency — cyclictest-style wake-up latency (ULMK_CONFIG_SCHED_LATENCY=1).
+ *
+ * Periodic threads at priorities 2, 40 and 100 (bands 0, 1 and 3) sleep
+ * 1 ms at a time while a low-priority IPC ping-pong pair keeps the CPU
+ * busy and raises a software IRQ, taken by an IRQ thread, every few
+ * round trips.  Afterwards each band's histogram is read back and printed
+ * as count / min / p50 / p99 / max in cycles (percentiles are bucket upper
+ * bounds).  Covers: every timed wake-up is counted in its band, the
+ * histogram sums to the count, min <= max; argument checks.  Trigger
+ * sources as in irq_sw.
+ */
+#include "sdk_test_util.h"
+#include <board_config.h>
+
+#define UL_IRQ_SRPN		12u
+#define IRQ_BIT			(1u << 0)
+#define LABEL_PING		0x61u
+#define SRC_SETR_BIT		(1u << 26)
+#define STACK_SZ		1024u
+#define N_PERIODS		50u
+#define N_RT			3u
+#define CALLS_PER_IRQ		16u
+#define LOAD_PRIO		200u
+#define IRQ_PRIO		150u
+
+#define UL_NVIC_SRC(irq)	(0x8000u | ((uint32_t)(irq) & 0x7FFFu))
+
+#if defined(ULMK_BOARD_SRC_BASE)
+#define UL_IRQ_SRC_REG		(ULMK_BOARD_SRC_BASE + 0xC2u * 4u)
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_SRC_BASE
+#define UL_IRQ_MAP_SIZE		1024u
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+#define UL_IRQ_SRC_REG		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_SIZE		0x1000u
+#elif defined(__ARM_ARCH)
+#ifndef UL_IRQ_NVIC_LINE
+#define UL_IRQ_NVIC_LINE	3u
+#endif
+#define ARM_NVIC_STIR		0xE000EF00u
+#define UL_IRQ_SRC_REG		UL_NVIC_SRC(UL_IRQ_NVIC_LINE)
+#else
+#error "sched_latency: unsupported board"
+#endif
+
+static const uint8_t g_rt_prio[N_RT] = { 2u, 40u, 100u };
+
+static int               g_fail;
+static ulmk_ep_t         g_ep;
+static ulmk_notif_t      g_notif;
+static volatile int      g_stop;
+static volatile uint32_t g_done;
+static volatile uint32_t g_irqs;
+
+#define CHECK(name, cond)					\
+	do {							\
+		if (!(cond)) {					\
+			sdk_puts("sched_latency: " name " FAIL\n");	\
+			g_fail = 1;				\
+		}						\
+	} while (0)
+
+static void irq_sw_trigger(void)
+{
+#if defined(ULMK_BOARD_SRC_BASE)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG |= SRC_SETR_BIT;
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG = 1u;
+#elif defined(__ARM_ARCH)
+	*(volatile uint32_t *)(uintptr_t)ARM_NVIC_STIR = UL_IRQ_NVIC_LINE;
+#endif
+}
+
+/* Periodic measured thread: N_PERIODS timed wake-ups, then idle. */
+static void rt_thread(void *arg)
+{
+	uint32_t i;
+
+	(void)arg;
+	for (i = 0u; i < N_PERIODS; i++)
+		(void)ulmk_sleep_ms(1u);
+	g_done++;
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+static void load_server(void *arg)
+{
+	ulmk_msg_t msg;
+	ulmk_tid_t sender;
+
+	(void)arg;
+	while (ulmk_ep_recv(g_ep, &msg, &sender) == ULMK_OK)
+		ulmk_ep_reply(sender, &msg);
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+static void load_client(void *arg)
+{
+	ulmk_msg_t msg;
+	uint32_t   n = 0u;
+
+	(void)arg;
+	while (!g_stop) {
+		msg.label    = LABEL_PING;
+		msg.words[0] = n;
+		(void)ulmk_ep_call(g_ep, &msg);
+		if ((++n % CALLS_PER_IRQ) == 0u)
+			irq_sw_trigger();
+	}
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+static void irq_thread(void *arg)
+{
+	uint32_t bits;
+
+	(void)arg;
+	for (;;) {
+		bits = 0u;
+		if (ulmk_notif_wait(g_notif, IRQ_BIT, &bits) != ULMK_OK)
+			break;
+		g_irqs++;
+		ulmk_irq_ack(UL_IRQ_SRPN);
+	}
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+/* Upper bound (cycles) of the bucket holding the @pct-th percentile. */
+static uint32_t percentile(const ulmk_sched_lat_stats_t *st, uint32_t pct)
+{
+	uint32_t want = (st->count * pct + 99u) / 100u;
+	uint32_t sum  = 0u;
+	uint32_t i;
+
+	for (i = 0u; i < ULMK_SCHED_LAT_BUCKETS; i++) {
+		sum += st->hist[i];
+		if (sum >= want)
+			break;
+	}
+	if (i >= ULMK_SCHED_LAT_BUCKETS - 1u)
+		return st->max;
+	return (2u << i) - 1u;
+}
+
+static void report(uint32_t cpu, uint8_t prio)
+{
+	ulmk_sched_lat_stats_t st;
+	uint32_t               band = (uint32_t)prio >> 5;
+	uint32_t               sum  = 0u;
+	uint32_t               i;
+
+	if (ulmk_sched_lat_stats(cpu, band, &st) != ULMK_OK) {
+		CHECK("read", 0);
+		return;
+	}
+	for (i = 0u; i < ULMK_SCHED_LAT_BUCKETS; i++)
+		sum += st.hist[i];
+
+	sdk_puts("sched_latency: prio ");
+	sdk_put_u32(prio);
+	sdk_puts(" band ");
+	sdk_put_u32(band);
+	sdk_puts(" count ");
+	sdk_put_u32(st.count);
+	sdk_puts(" min ");
+	sdk_put_u32(st.min);
+	sdk_puts(" p50<= ");
+	sdk_put_u32(percentile(&st, 50u));
+	sdk_puts(" p99<= ");
+	sdk_put_u32(percentile(&st, 99u));
+	sdk_puts(" max ");
+	sdk_put_u32(st.max);
+	sdk_puts(" cycles\n");
+
+	CHECK("count", st.count >= N_PERIODS);
+	CHECK("hist_sum", sum == st.count);
+	CHECK("min_max", st.min <= st.max);
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_sched_lat_stats_t st;
+	ulmk_tid_t             rt[N_RT];
+	ulmk_tid_t             srv;
+	ulmk_tid_t             cli;
+	ulmk_tid_t             irq;
+	uint32_t               cpu;
+	uint32_t               i;
+
+	board_services_init(info);
+	sdk_puts("sched_latency: begin\n");
+
+#if defined(UL_IRQ_MAP_BASE)
+	if (!sdk_map_ok(ulmk_mem_map((void *)(uintptr_t)UL_IRQ_MAP_BASE,
+				     UL_IRQ_MAP_SIZE,
+				     ULMK_PERM_READ | ULMK_PERM_WRITE,
+				     ULMK_MMAP_PERIPH))) {
+		sdk_puts("sched_latency: map FAIL\n");
+		ulmk_thread_exit();
+	}
+#endif
+
+	cpu = ulmk_cpu_id();
+	CHECK("bad_cpu", ulmk_sched_lat_stats(0xFFFFu, 0u, &st) == ULMK_EINVAL);
+	CHECK("bad_band", ulmk_sched_lat_stats(cpu, ULMK_SCHED_LAT_BANDS,
+					       &st) == ULMK_EINVAL);
+	CHECK("null_out", ulmk_sched_lat_stats(cpu, 0u, NULL) == ULMK_EINVAL);
+
+	g_ep    = ulmk_ep_create();
+	g_notif = ulmk_notif_create();
+	CHECK("objs", g_ep != ULMK_EP_INVALID &&
+		      g_notif != ULMK_NOTIF_INVALID);
+	CHECK("bind", ulmk_irq_bind_hw(UL_IRQ_SRPN, g_notif, 0u,
+				       (uintptr_t)UL_IRQ_SRC_REG) == ULMK_OK);
+	CHECK("enable", ulmk_irq_enable(UL_IRQ_SRPN) == ULMK_OK);
+
+	irq = sdk_spawn("irq", irq_thread, NULL, IRQ_PRIO, STACK_SZ, 0u);
+	srv = sdk_spawn("srv", load_server, NULL, LOAD_PRIO, STACK_SZ, 0u);
+	cli = sdk_spawn("cli", load_client, NULL, LOAD_PRIO, STACK_SZ, 0u);
+	CHECK("spawn_load", irq != ULMK_TID_INVALID &&
+			    srv != ULMK_TID_INVALID &&
+			    cli != ULMK_TID_INVALID);
+	for (i = 0u; i < N_RT; i++) {
+		rt[i] = sdk_spawn("rt", rt_thread, NULL, g_rt_prio[i],
+				  STACK_SZ, 0u);
+		CHECK("spawn_rt", rt[i] != ULMK_TID_INVALID);
+	}
+
+	/* Bounded wait for every periodic thread to finish its run. */
+	for (i = 0u; i < 200u && g_done < N_RT; i++)
+		(void)ulmk_sleep_ms(5u);
+	CHECK("done", g_done == N_RT);
+	CHECK("irq_load", g_irqs > 0u);
+
+	g_stop = 1;
+	(void)ulmk_thread_kill(cli);
+	(void)ulmk_thread_kill(srv);
+	(void)ulmk_thread_kill(irq);
+	for (i = 0u; i < N_RT; i++)
+		(void)ulmk_thread_kill(rt[i]);
+
+	/* See irq_sw: do not exit with the line armed on ARM. */
+	ulmk_irq_disable(UL_IRQ_SRPN);
+
+	for (i = 0u; i < N_RT; i++)
+		report(cpu, g_rt_prio[i]);
+
+	sdk_puts(g_fail ? "sched_latency: FAIL\n" : "sched_latency: PASS\n");
+	ulmk_thread_exit();
+}
@@ -77,6 +77,94 @@ TAG_SUFFIX := $(TAG_SUFFIX)_irqattach
 else
 SDK_IRQ_ATTACH_FLAG :=
 endif
+# Opt-in lazy MPU region loading (separate SDK cache + kernel).
+MPU_LAZY_SLOTS ?= 0
+ifneq ($(MPU_LAZY_SLOTS),0)
+SDK_MPU_LAZY_FLAG := --mpu-lazy-slots $(MPU_LAZY_SLOTS)
+TAG_SUFFIX := $(TAG_SUFFIX)_lazy$(MPU_LAZY_SLOTS)
+else
+SDK_MPU_LAZY_FLAG :=
+endif
+# Opt-in kernel event trace ring (separate SDK cache + kernel).
+TRACE_ENTRIES ?= 0
+ifneq ($(TRACE_ENTRIES),0)
+SDK_TRACE_FLAG := --trace-entries $(TRACE_ENTRIES)
+TAG_SUFFIX := $(TAG_SUFFIX)_trace$(TRACE_ENTRIES)
+else
+SDK_TRACE_FLAG :=
+endif
+# Larger IRQ binding table (separate SDK cache + kernel).
+IRQ_BINDINGS ?= 0
+ifneq ($(IRQ_BINDINGS),0)
+SDK_IRQ_BINDINGS_FLAG := --irq-bindings $(IRQ_BINDINGS)
+TAG_SUFFIX := $(TAG_SUFFIX)_irqb$(IRQ_BINDINGS)
+else
+SDK_IRQ_BINDINGS_FLAG :=
+endif
+# Opt-in buffered printk (separate SDK cache + kernel).
+PRINTK_BUF_SIZE ?= 0
+ifneq ($(PRINTK_BUF_SIZE),0)
+SDK_PRINTK_BUF_FLAG := --printk-buf-size $(PRINTK_BUF_SIZE)
+TAG_SUFFIX := $(TAG_SUFFIX)_pkbuf$(PRINTK_BUF_SIZE)
+else
+SDK_PRINTK_BUF_FLAG :=
+endif
+# Opt-in per-thread run-time statistics (separate SDK cache + kernel).
+THREAD_STATS ?= 0
+ifeq ($(THREAD_STATS),1)
+SDK_THREAD_STATS_FLAG := --enable-thread-stats
+TAG_SUFFIX := $(TAG_SUFFIX)_tstats
+else
+SDK_THREAD_STATS_FLAG :=
+endif
+# Opt-in wake-up latency histograms (separate SDK cache + kernel).
+SCHED_LATENCY ?= 0
+ifeq ($(SCHED_LATENCY),1)
+SDK_SCHED_LATENCY_FLAG := --enable-sched-latency
+TAG_SUFFIX := $(TAG_SUFFIX)_schedlat
+else
+SDK_SCHED_LATENCY_FLAG :=
+endif
+# Opt-in IRQ-off / kernel lock profiler (separate SDK cache + kernel).
+IRQOFF_STATS ?= 0
+ifeq ($(IRQOFF_STATS),1)
+SDK_IRQOFF_STATS_FLAG := --enable-irqoff-stats
+TAG_SUFFIX := $(TAG_SUFFIX)_irqoff
+else
+SDK_IRQOFF_STATS_FLAG :=
+endif
+# Opt-in per-lock spinlock contention counters (separate SDK cache + kernel).
+SPINLOCK_STATS ?= 0
+ifeq ($(SPINLOCK_STATS),1)
+SDK_SPINLOCK_STATS_FLAG := --enable-spinlock-stats
+TAG_SUFFIX := $(TAG_SUFFIX)_spinstats
+else
+SDK_SPINLOCK_STATS_FLAG :=
+endif
+# Opt-in ulmk_cycle_read() for benchmarks (separate SDK cache + kernel).
+USER_CYCLES ?= 0
+ifeq ($(USER_CYCLES),1)
+SDK_USER_CYCLES_FLAG := --enable-user-cycles
+TAG_SUFFIX := $(TAG_SUFFIX)_cycles
+else
+SDK_USER_CYCLES_FLAG :=
+endif
+# Opt-in stack painting and high-water marks (separate SDK cache + kernel).
+STACK_WATERMARK ?= 0
+ifeq ($(STACK_WATERMARK),1)
+SDK_STACK_WATERMARK_FLAG := --enable-stack-watermark
+TAG_SUFFIX := $(TAG_SUFFIX)_stackwm
+else
+SDK_STACK_WATERMARK_FLAG :=
+endif
+# Opt-in syscall WCET slot and histograms (separate SDK cache + kernel).
+SYSCALL_WCET ?= 0
+ifeq ($(SYSCALL_WCET),1)
+SDK_SYSCALL_WCET_FLAG := --enable-syscall-wcet
+TAG_SUFFIX := $(TAG_SUFFIX)_wcet
+else
+SDK_SYSCALL_WCET_FLAG :=
+endif
 TAG        := $(ARCH)_$(BOARD_NAME)_gcc$(TAG_SUFFIX)
 TOOLCHAIN  := $(WS)/cmake/toolchain-$(ARCH)-gcc.cmake
 
@@ -131,7 +219,13 @@ sdk:
 			--board-name $(BOARD_NAME) \
 			--build-dir $(BUILD) \
 			--out-dir $(SDK) \
-			$(SDK_SMP_FLAG) $(SDK_IRQ_ATTACH_FLAG); \
+			$(SDK_SMP_FLAG) $(SDK_IRQ_ATTACH_FLAG) \
+			$(SDK_MPU_LAZY_FLAG) $(SDK_TRACE_FLAG) \
+			$(SDK_IRQ_BINDINGS_FLAG) \
+			$(SDK_PRINTK_BUF_FLAG) $(SDK_THREAD_STATS_FLAG) \
+			$(SDK_SCHED_LATENCY_FLAG) $(SDK_IRQOFF_STATS_FLAG) \
+			$(SDK_SPINLOCK_STATS_FLAG) $(SDK_USER_CYCLES_FLAG) \
+			$(SDK_STACK_WATERMARK_FLAG) $(SDK_SYSCALL_WCET_FLAG); \
 	fi
 
 all: sdk $(TARGET)
@@ -4,19 +4,27 @@
  *
  * Same spawn+wait cadence as smp4_smoke (stable under QEMU MTTCG load).
  * Yields exercise remote RQ / syscall paths without a create storm.
+ *
+ * Then a lock contention phase: one pinned worker per hart signals the same
+ * notification (kernel ipc lock) in a loop for CONTEND_MS.  Per-hart op
+ * counts show throughput and fairness of the kernel spinlock; with
+ * "make SPINLOCK_STATS=1" the ipc lock's own counters are printed too.
  */
-#include <stdint.h>
-#include <ulmk/microkernel.h>
-#include <board_services.h>
-#include <board_console.h>
+#include "sdk_test_util.h"
 
-#define NCPU	4u
-#define NYIELD	32u
+#define NCPU		4u
+#define NYIELD		32u
+#define CONTEND_MS	50u
 
 static volatile uint32_t g_seen;
 static volatile uint32_t g_bad;
 static ulmk_notif_t g_done;
 
+static ulmk_notif_t      g_hot;
+static volatile uint32_t g_stop;
+static volatile uint32_t g_ops[NCPU];
+static volatile uint32_t g_fin[NCPU];
+
 static void worker(void *arg)
 {
 	uint32_t expect = (uint32_t)(uintptr_t)arg;
@@ -36,6 +44,98 @@ static void worker(void *arg)
 	ulmk_thread_exit();
 }
 
+static void hammer(void *arg)
+{
+	uint32_t me = (uint32_t)(uintptr_t)arg;
+
+	while (!g_stop) {
+		(void)ulmk_notif_signal(g_hot, 2u);
+		g_ops[me]++;
+	}
+	g_fin[me] = 1u;
+	ulmk_thread_exit();
+}
+
+static int contend(void)
+{
+	ulmk_thread_attr_t    attr = {0};
+	ulmk_spinlock_stats_t ls;
+	uint32_t              lo = 0xffffffffu;
+	uint32_t              hi = 0u;
+	uint32_t              sum = 0u;
+	uint32_t              cpu;
+	uint32_t              fin;
+	uint32_t              i;
+	int                   rc;
+
+	g_hot = ulmk_notif_create();
+	if (g_hot == ULMK_NOTIF_INVALID)
+		return -1;
+
+	/* Root (prio 0) keeps hart 0 until it sleeps; all four start then. */
+	for (cpu = 0u; cpu < NCPU; cpu++) {
+		attr.name = "hot";
+		attr.entry = hammer;
+		attr.arg = (void *)(uintptr_t)cpu;
+		attr.priority = 2u;
+		attr.stack_size = 4096u;
+		attr.privilege = ULMK_PRIV_DRIVER;
+		attr.cpu = (uint8_t)cpu;
+		if (ulmk_thread_create(&attr) == ULMK_TID_INVALID)
+			return -1;
+	}
+	(void)ulmk_sleep_ms(CONTEND_MS);
+	g_stop = 1u;
+
+	for (i = 0u; i < 1000u; i++) {
+		for (fin = 0u, cpu = 0u; cpu < NCPU; cpu++)
+			fin += g_fin[cpu];
+		if (fin == NCPU)
+			break;
+		(void)ulmk_sleep_ms(1u);
+	}
+	if (fin != NCPU)
+		return -1;
+
+	for (cpu = 0u; cpu < NCPU; cpu++) {
+		sdk_puts("smp4_stress: contend cpu ");
+		sdk_put_u32(cpu);
+		sdk_puts(" ops ");
+		sdk_put_u32(g_ops[cpu]);
+		sdk_puts("\n");
+		sum += g_ops[cpu];
+		if (g_ops[cpu] < lo)
+			lo = g_ops[cpu];
+		if (g_ops[cpu] > hi)
+			hi = g_ops[cpu];
+	}
+	sdk_puts("smp4_stress: contend ops/ms ");
+	sdk_put_u32(sum / CONTEND_MS);
+	sdk_puts(" min ");
+	sdk_put_u32(lo);
+	sdk_puts(" max ");
+	sdk_put_u32(hi);
+	sdk_puts("\n");
+
+	rc = ulmk_spinlock_stats(ULMK_LOCK_IPC, &ls);
+	if (rc == ULMK_OK) {
+		sdk_puts("smp4_stress: ipc lock acquires ");
+		sdk_put_u32(ls.acquires);
+		sdk_puts(" contended ");
+		sdk_put_u32(ls.contended);
+		sdk_puts(" spin_cycles ");
+		sdk_put_u32((uint32_t)ls.spin_cycles);
+		sdk_puts("\n");
+		if (ls.contended > ls.acquires || ls.acquires < sum)
+			return -1;
+	} else if (rc != ULMK_ENOTSUP) {
+		return -1;
+	}
+
+	/* Every hart made progress: no waiter starved behind the others. */
+	return lo > 0u ? 0 : -1;
+}
+
 void ulmk_root_thread(const ulmk_boot_info_t *info)
 {
 	ulmk_thread_attr_t attr = {0};
@@ -90,6 +190,12 @@ void ulmk_root_thread(const ulmk_boot_info_t *info)
 		}
 	}
 
+	if (contend() != 0) {
+		board_console_puts("smp4_stress: FAIL contend\n");
+		for (;;)
+			;
+	}
+
 	board_console_puts("smp4_stress: PASS\n");
 	ulmk_thread_exit();
 }
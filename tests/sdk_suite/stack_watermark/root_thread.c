@@ -0,0 +1,115 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * stack_watermark — stack high-water marks (ULMK_CONFIG_STACK_WATERMARK=1).
+ *
+ * Covers: a thread that writes a known-size local buffer reports at least
+ * that much stack used, a sleeper far less; the user stack size excludes
+ * the kernel-stack reserve; no overflow is flagged; the exit report line
+ * is printed when a thread is killed; reading another thread needs
+ * ULMK_CAP_STATS while reading oneself does not; argument checks.
+ */
+#include "sdk_test_util.h"
+
+#define STACK_SZ	2048u
+#define DEPTH		1024u
+
+static int                 g_fail;
+static volatile int        g_touched;
+static volatile int        g_probe_self;
+static volatile int        g_probe_other;
+static volatile ulmk_tid_t g_root;
+
+#define CHECK(name, cond)					\
+	do {							\
+		if (!(cond)) {					\
+			sdk_puts("stack_watermark: " name " FAIL\n");	\
+			g_fail = 1;				\
+		}						\
+	} while (0)
+
+/* Write every byte of a DEPTH-byte frame so the paint below it goes. */
+static __attribute__((noinline)) uint8_t touch(uint32_t n)
+{
+	volatile uint8_t buf[DEPTH];
+	uint32_t         i;
+
+	for (i = 0u; i < n; i++)
+		buf[i] = (uint8_t)i;
+	return buf[n - 1u];
+}
+
+static void deep(void *arg)
+{
+	(void)arg;
+	(void)touch(DEPTH);
+	g_touched = 1;
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+static void sleeper(void *arg)
+{
+	(void)arg;
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+/* Driver thread without ULMK_CAP_STATS. */
+static void probe(void *arg)
+{
+	ulmk_stack_stats_t st;
+
+	(void)arg;
+	g_probe_self  = ulmk_thread_stack_stats(0u, &st);
+	g_probe_other = ulmk_thread_stack_stats(g_root, &st);
+	ulmk_thread_exit();
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_stack_stats_t st;
+	ulmk_stack_stats_t sl;
+	ulmk_tid_t         dp;
+	ulmk_tid_t         sp;
+
+	board_services_init(info);
+	sdk_puts("stack_watermark: begin\n");
+	g_root = ulmk_thread_self();
+
+	dp = sdk_spawn("deep", deep, NULL, 2u, STACK_SZ, 0u);
+	sp = sdk_spawn("sleep", sleeper, NULL, 2u, STACK_SZ, 0u);
+	CHECK("spawn", dp != ULMK_TID_INVALID && sp != ULMK_TID_INVALID);
+	(void)ulmk_sleep_ms(5u);
+	CHECK("touched", g_touched);
+
+	CHECK("deep", ulmk_thread_stack_stats(dp, &st) == ULMK_OK);
+	CHECK("deep_size", st.size == STACK_SZ);
+	CHECK("deep_used", st.used >= DEPTH && st.used < st.size);
+	CHECK("deep_kstack", st.kstack_used <= st.kstack_size);
+	CHECK("deep_overflow", st.overflow == 0u);
+	/* TriCore: a switched-out thread holds at least its two CSA frames. */
+	CHECK("deep_csa", st.csa_used == 0u || st.csa_used >= 2u);
+
+	CHECK("sleep", ulmk_thread_stack_stats(sp, &sl) == ULMK_OK);
+	CHECK("sleep_used", sl.used > 0u && sl.used < DEPTH);
+	CHECK("sleep_overflow", sl.overflow == 0u);
+
+	CHECK("self", ulmk_thread_stack_stats(0u, &st) == ULMK_OK);
+	CHECK("self_used", st.used > 0u && st.used < st.size);
+
+	/* Another thread's stack needs ULMK_CAP_STATS; one's own does not. */
+	CHECK("probe", sdk_spawn("probe", probe, NULL, 1u, STACK_SZ, 0u) !=
+		       ULMK_TID_INVALID);
+	(void)ulmk_sleep_ms(2u);
+	CHECK("probe_self", g_probe_self == ULMK_OK);
+	CHECK("probe_other", g_probe_other == ULMK_EPERM);
+
+	CHECK("null_out", ulmk_thread_stack_stats(0u, NULL) == ULMK_EINVAL);
+
+	/* Freeing a thread prints its "stack: tid=..." report line. */
+	CHECK("kill", ulmk_thread_kill(dp) == ULMK_OK);
+	(void)ulmk_thread_kill(sp);
+
+	sdk_puts(g_fail ? "stack_watermark: FAIL\n" : "stack_watermark: PASS\n");
+	ulmk_thread_exit();
+}
@@ -0,0 +1,148 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * thread_stats — per-thread run-time counters (ULMK_CONFIG_THREAD_STATS=1).
+ *
+ * Covers: IPC call/receive and notification signal/wake counts on both
+ * sides; a low-priority spinner is charged CPU and ready time and counted
+ * as preempted, a blocking server as switching voluntarily; reading
+ * another thread needs ULMK_CAP_STATS while reading oneself does not;
+ * argument checks.
+ */
+#include "sdk_test_util.h"
+
+#define N_CALLS		4u
+#define LABEL_PING	0x51u
+#define STACK_SZ	1024u
+
+static int                 g_fail;
+static ulmk_ep_t           g_ep;
+static ulmk_notif_t        g_notif;
+static volatile int        g_stop;
+static volatile int        g_probe_self;
+static volatile int        g_probe_other;
+static volatile ulmk_tid_t g_root;
+
+#define CHECK(name, cond)					\
+	do {							\
+		if (!(cond)) {					\
+			sdk_puts("thread_stats: " name " FAIL\n");	\
+			g_fail = 1;				\
+		}						\
+	} while (0)
+
+static void server(void *arg)
+{
+	ulmk_msg_t msg;
+	ulmk_tid_t sender;
+	uint32_t   i;
+
+	(void)arg;
+	for (i = 0u; i < N_CALLS; i++) {
+		if (ulmk_ep_recv(g_ep, &msg, &sender) != ULMK_OK)
+			break;
+		ulmk_ep_reply(sender, &msg);
+	}
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+static void waiter(void *arg)
+{
+	uint32_t bits = 0u;
+
+	(void)arg;
+	ulmk_notif_wait(g_notif, 1u, &bits);
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+static void spinner(void *arg)
+{
+	(void)arg;
+	while (!g_stop)
+		;
+	for (;;)
+		(void)ulmk_sleep_ms(1000u);
+}
+
+/* Driver thread without ULMK_CAP_STATS. */
+static void probe(void *arg)
+{
+	ulmk_thread_stats_t st;
+
+	(void)arg;
+	g_probe_self  = ulmk_thread_stats(0u, &st);
+	g_probe_other = ulmk_thread_stats(g_root, &st);
+	ulmk_thread_exit();
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_thread_stats_t st;
+	ulmk_msg_t          msg;
+	ulmk_tid_t          srv;
+	ulmk_tid_t          wt;
+	ulmk_tid_t          spin;
+	uint32_t            i;
+
+	board_services_init(info);
+	sdk_puts("thread_stats: begin\n");
+	g_root = ulmk_thread_self();
+
+	g_ep    = ulmk_ep_create();
+	g_notif = ulmk_notif_create();
+	CHECK("objs", g_ep != ULMK_EP_INVALID &&
+		      g_notif != ULMK_NOTIF_INVALID);
+
+	srv  = sdk_spawn("srv", server, NULL, 2u, STACK_SZ, 0u);
+	wt   = sdk_spawn("wait", waiter, NULL, 2u, STACK_SZ, 0u);
+	spin = sdk_spawn("spin", spinner, NULL, 10u, STACK_SZ, 0u);
+	CHECK("spawn", srv != ULMK_TID_INVALID && wt != ULMK_TID_INVALID &&
+		       spin != ULMK_TID_INVALID);
+
+	/* Server and waiter block; the spinner runs until the tick wakes us. */
+	(void)ulmk_sleep_ms(5u);
+
+	for (i = 0u; i < N_CALLS; i++) {
+		msg.label    = LABEL_PING;
+		msg.words[0] = i;
+		CHECK("call", ulmk_ep_call(g_ep, &msg) == ULMK_OK);
+	}
+	CHECK("signal", ulmk_notif_signal(g_notif, 1u) == ULMK_OK);
+	(void)ulmk_sleep_ms(5u);
+
+	CHECK("self", ulmk_thread_stats(0u, &st) == ULMK_OK);
+	CHECK("self_calls", st.ipc_calls == N_CALLS);
+	CHECK("self_signals", st.notif_signals == 1u);
+	CHECK("self_runs", st.runs > 0u && st.cycles > 0u);
+	CHECK("self_voluntary", st.voluntary > 0u);
+
+	CHECK("srv", ulmk_thread_stats(srv, &st) == ULMK_OK);
+	CHECK("srv_recvs", st.ipc_recvs == N_CALLS);
+	CHECK("srv_voluntary", st.voluntary >= N_CALLS);
+
+	CHECK("wait", ulmk_thread_stats(wt, &st) == ULMK_OK);
+	CHECK("wait_wakes", st.notif_wakes == 1u);
+
+	CHECK("spin", ulmk_thread_stats(spin, &st) == ULMK_OK);
+	CHECK("spin_cycles", st.cycles > 0u);
+	CHECK("spin_preempted", st.involuntary > 0u);
+	CHECK("spin_ready", st.ready_cycles > 0u);
+
+	/* Another thread's counters need ULMK_CAP_STATS; one's own do not. */
+	CHECK("probe", sdk_spawn("probe", probe, NULL, 1u, STACK_SZ, 0u) !=
+		       ULMK_TID_INVALID);
+	(void)ulmk_sleep_ms(2u);
+	CHECK("probe_self", g_probe_self == ULMK_OK);
+	CHECK("probe_other", g_probe_other == ULMK_EPERM);
+
+	CHECK("null_out", ulmk_thread_stats(0u, NULL) == ULMK_EINVAL);
+
+	g_stop = 1;
+	(void)ulmk_thread_kill(srv);
+	(void)ulmk_thread_kill(wt);
+	(void)ulmk_thread_kill(spin);
+
+	sdk_puts(g_fail ? "thread_stats: FAIL\n" : "thread_stats: PASS\n");
+	ulmk_thread_exit();
+}
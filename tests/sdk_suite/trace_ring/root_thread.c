@@ -0,0 +1,216 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * trace_ring — kernel event trace (ULMK_CONFIG_TRACE_ENTRIES=256).
+ *
+ * Covers: IPC call/recv/reply, notification signal/wake, run-queue and
+ * context-switch events, timer expiry and IRQ entry/exit all land in the
+ * ring of the CPU they ran on with increasing seq; the runtime mask stops
+ * recording; argument checks.  The records of the exercise are printed as
+ * "ulmk-trace:" lines for tools/trace_decode.py.  Trigger sources as in
+ * irq_sw.
+ */
+#include "sdk_test_util.h"
+#include <board_config.h>
+
+#define UL_IRQ_SRPN		12u
+#define IRQ_BIT			0u
+#define LABEL_PING		0x71u
+#define SRC_SETR_BIT		(1u << 26)
+#define READ_CHUNK		16u
+
+#define UL_NVIC_SRC(irq)	(0x8000u | ((uint32_t)(irq) & 0x7FFFu))
+
+#if defined(ULMK_BOARD_SRC_BASE)
+#define UL_IRQ_SRC_REG		(ULMK_BOARD_SRC_BASE + 0xC2u * 4u)
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_SRC_BASE
+#define UL_IRQ_MAP_SIZE		1024u
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+#define UL_IRQ_SRC_REG		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_BASE		ULMK_BOARD_CLINT_BASE
+#define UL_IRQ_MAP_SIZE		0x1000u
+#elif defined(__ARM_ARCH)
+#ifndef UL_IRQ_NVIC_LINE
+#define UL_IRQ_NVIC_LINE	3u
+#endif
+#define ARM_NVIC_STIR		0xE000EF00u
+#define UL_IRQ_SRC_REG		UL_NVIC_SRC(UL_IRQ_NVIC_LINE)
+#else
+#error "trace_ring: unsupported board"
+#endif
+
+static int          g_fail;
+static ulmk_ep_t    g_ep;
+static ulmk_notif_t g_notif;
+
+#define CHECK(name, cond)					\
+	do {							\
+		if (!(cond)) {					\
+			sdk_puts("trace_ring: " name " FAIL\n");	\
+			g_fail = 1;				\
+		}						\
+	} while (0)
+
+static void irq_sw_trigger(void)
+{
+#if defined(ULMK_BOARD_SRC_BASE)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG |= SRC_SETR_BIT;
+#elif defined(ULMK_BOARD_CLINT_BASE) && (ULMK_BOARD_CLINT_BASE != 0u)
+	*(volatile uint32_t *)(uintptr_t)UL_IRQ_SRC_REG = 1u;
+#elif defined(__ARM_ARCH)
+	*(volatile uint32_t *)(uintptr_t)ARM_NVIC_STIR = UL_IRQ_NVIC_LINE;
+#endif
+}
+
+static void server(void *arg)
+{
+	ulmk_msg_t msg;
+	ulmk_tid_t sender;
+
+	(void)arg;
+	if (ulmk_ep_recv(g_ep, &msg, &sender) == ULMK_OK)
+		ulmk_ep_reply(sender, &msg);
+	ulmk_thread_exit();
+}
+
+static void waiter(void *arg)
+{
+	uint32_t bits = 0u;
+
+	(void)arg;
+	ulmk_notif_wait(g_notif, 1u, &bits);
+	ulmk_thread_exit();
+}
+
+static void put_hex(const void *p, uint32_t len)
+{
+	static const char  hex[] = "0123456789abcdef";
+	const uint8_t     *b     = (const uint8_t *)p;
+	char               line[2u * sizeof(ulmk_trace_rec_t) + 1u];
+	uint32_t           i;
+
+	for (i = 0u; i < len; i++) {
+		line[2u * i]      = hex[b[i] >> 4];
+		line[2u * i + 1u] = hex[b[i] & 0xFu];
+	}
+	line[2u * len] = '\0';
+	sdk_puts(line);
+}
+
+/*
+ * Read everything recorded on @cpu since *@pos.  Returns the event ids
+ * seen as a ULMK_TRACE_BIT() set; @dump prints each record.
+ */
+static uint32_t drain(uint32_t cpu, uint32_t *pos, int dump, uint32_t *count)
+{
+	ulmk_trace_rec_t buf[READ_CHUNK];
+	uint32_t         seen = 0u;
+	uint32_t         last = 0u;
+	int              have_last = 0;
+	int              n;
+	int              i;
+
+	*count = 0u;
+	while ((n = ulmk_trace_read(cpu, pos, buf, READ_CHUNK)) > 0) {
+		for (i = 0; i < n; i++) {
+			if (have_last)
+				CHECK("seq_order", buf[i].seq > last);
+			CHECK("rec_cpu", buf[i].cpu == cpu);
+			last      = buf[i].seq;
+			have_last = 1;
+			if (buf[i].ev < 32u)
+				seen |= ULMK_TRACE_BIT(buf[i].ev);
+			if (dump) {
+				sdk_puts("ulmk-trace: ");
+				put_hex(&buf[i], sizeof(buf[i]));
+				sdk_puts("\n");
+			}
+		}
+		*count += (uint32_t)n;
+	}
+	CHECK("read_ok", n == 0);
+	return seen;
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	uint32_t   cpu;
+	uint32_t   pos = 0u;
+	uint32_t   seen;
+	uint32_t   count;
+	ulmk_msg_t msg;
+	ulmk_tid_t t;
+
+	board_services_init(info);
+	sdk_puts("trace_ring: begin\n");
+
+#if defined(UL_IRQ_MAP_BASE)
+	if (!sdk_map_ok(ulmk_mem_map((void *)(uintptr_t)UL_IRQ_MAP_BASE,
+				     UL_IRQ_MAP_SIZE,
+				     ULMK_PERM_READ | ULMK_PERM_WRITE,
+				     ULMK_MMAP_PERIPH))) {
+		sdk_puts("trace_ring: map FAIL\n");
+		ulmk_thread_exit();
+	}
+#endif
+
+	cpu = ulmk_cpu_id();
+	CHECK("boot_mask", ulmk_trace_mask(ULMK_TRACE_ALL) ==
+			   (int)ULMK_TRACE_ALL);
+	CHECK("bad_cpu", ulmk_trace_read(0xFFFFu, &pos, NULL, 1u) ==
+			 ULMK_EINVAL);
+	CHECK("null_pos", ulmk_trace_read(cpu, NULL, NULL, 1u) ==
+			  ULMK_EINVAL);
+
+	g_ep    = ulmk_ep_create();
+	g_notif = ulmk_notif_create();
+	CHECK("objs", g_ep != ULMK_EP_INVALID &&
+		      g_notif != ULMK_NOTIF_INVALID);
+	CHECK("bind", ulmk_irq_bind_hw(UL_IRQ_SRPN, g_notif, IRQ_BIT,
+				       (uintptr_t)UL_IRQ_SRC_REG) == ULMK_OK);
+	CHECK("enable", ulmk_irq_enable(UL_IRQ_SRPN) == ULMK_OK);
+
+	/* Skip boot history; only the exercise below is checked. */
+	(void)drain(cpu, &pos, 0, &count);
+
+	t = sdk_spawn("srv", server, NULL, 2u, 1024u, 0u);
+	CHECK("spawn_srv", t != ULMK_TID_INVALID);
+	t = sdk_spawn("wait", waiter, NULL, 2u, 1024u, 0u);
+	CHECK("spawn_wait", t != ULMK_TID_INVALID);
+	(void)ulmk_sleep_ms(2u);		/* both block; the wheel fires */
+
+	msg.label    = LABEL_PING;
+	msg.words[0] = 0u;
+	CHECK("call", ulmk_ep_call(g_ep, &msg) == ULMK_OK);
+	CHECK("signal", ulmk_notif_signal(g_notif, 1u) == ULMK_OK);
+	irq_sw_trigger();
+	(void)ulmk_sleep_ms(2u);
+	ulmk_irq_ack(UL_IRQ_SRPN);
+
+	seen = drain(cpu, &pos, 1, &count);
+	CHECK("recorded", count > 0u);
+	CHECK("ev_switch", seen & ULMK_TRACE_BIT(ULMK_TRACE_SWITCH));
+	CHECK("ev_enqueue", seen & ULMK_TRACE_BIT(ULMK_TRACE_ENQUEUE));
+	CHECK("ev_dequeue", seen & ULMK_TRACE_BIT(ULMK_TRACE_DEQUEUE));
+	CHECK("ev_call", seen & ULMK_TRACE_BIT(ULMK_TRACE_IPC_CALL));
+	CHECK("ev_recv", seen & ULMK_TRACE_BIT(ULMK_TRACE_IPC_RECV));
+	CHECK("ev_reply", seen & ULMK_TRACE_BIT(ULMK_TRACE_IPC_REPLY));
+	CHECK("ev_signal", seen & ULMK_TRACE_BIT(ULMK_TRACE_NOTIF_SIGNAL));
+	CHECK("ev_wake", seen & ULMK_TRACE_BIT(ULMK_TRACE_NOTIF_WAKE));
+	CHECK("ev_timer", seen & ULMK_TRACE_BIT(ULMK_TRACE_TIMER_EXPIRE));
+	CHECK("ev_irq", (seen & ULMK_TRACE_BIT(ULMK_TRACE_IRQ_ENTER)) &&
+			(seen & ULMK_TRACE_BIT(ULMK_TRACE_IRQ_EXIT)));
+
+	/* Masked: nothing new is recorded. */
+	CHECK("mask_off", ulmk_trace_mask(0u) == (int)ULMK_TRACE_ALL);
+	(void)ulmk_notif_signal(g_notif, 1u);
+	(void)ulmk_sleep_ms(2u);
+	(void)drain(cpu, &pos, 0, &count);
+	CHECK("mask_silent", count == 0u);
+	CHECK("mask_on", ulmk_trace_mask(ULMK_TRACE_ALL) == 0);
+
+	/* See irq_sw: do not exit with the line armed on ARM. */
+	ulmk_irq_disable(UL_IRQ_SRPN);
+
+	sdk_puts(g_fail ? "trace_ring: FAIL\n" : "trace_ring: PASS\n");
+	ulmk_thread_exit();
+}
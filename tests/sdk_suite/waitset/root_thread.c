@@ -0,0 +1,176 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * waitset — one server multiplexes several endpoints and a notification
+ * through ulmk_wait_any(); every source is reported exactly once.
+ */
+#include "sdk_test_util.h"
+
+#define NR_EPS		3
+#define BIT_GO		(1u << 0)
+#define BIT_DONE	(1u << 1)
+#define BIT_EVT		(1u << 2)
+
+static int g_pass;
+static int g_fail;
+static ulmk_ep_t g_ep[NR_EPS];
+static ulmk_notif_t g_evt;
+static ulmk_notif_t g_sync;
+static ulmk_waitset_t g_ws;
+static volatile uint32_t g_served[NR_EPS];
+static volatile uint32_t g_evt_bits;
+static volatile int g_srv_rc;
+
+static void check(const char *name, int ok)
+{
+	sdk_puts(ok ? ".ok " : ".FAIL ");
+	sdk_puts(name);
+	sdk_puts("\n");
+	if (ok)
+		g_pass++;
+	else
+		g_fail++;
+}
+
+#define CHECK(name, cond) check((name), (cond) ? 1 : 0)
+
+/* Serve NR_EPS calls plus one notification, then report. */
+static void server(void *arg)
+{
+	ulmk_waitset_event_t ev;
+	ulmk_msg_t m;
+	ulmk_tid_t sender;
+	int        left = NR_EPS + 1;
+	int        i;
+	int        rc;
+
+	(void)arg;
+	while (left > 0) {
+		rc = ulmk_wait_any(g_ws, &ev);
+		if (rc != ULMK_OK) {
+			g_srv_rc = rc;
+			break;
+		}
+		if (ev.kind == ULMK_WAITSET_NOTIF) {
+			g_evt_bits |= ev.bits;
+			left--;
+			continue;
+		}
+		for (i = 0; i < NR_EPS; i++) {
+			if (ev.handle != g_ep[i])
+				continue;
+			rc = ulmk_ep_recv(g_ep[i], &m, &sender);
+			if (rc == ULMK_OK && m.label == (uint32_t)i) {
+				g_served[i]++;
+				m.label = 0x100u + (uint32_t)i;
+				(void)ulmk_ep_reply(sender, &m);
+			}
+			left--;
+		}
+	}
+	ulmk_notif_signal(g_sync, BIT_DONE);
+	ulmk_thread_exit();
+}
+
+static void client(void *arg)
+{
+	uint32_t   idx = (uint32_t)(uintptr_t)arg;
+	uint32_t   bits = 0u;
+	ulmk_msg_t m;
+
+	ulmk_notif_wait(g_sync, BIT_GO, &bits);
+	m.label = idx;
+	(void)ulmk_ep_call(g_ep[idx], &m);
+	ulmk_thread_exit();
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_waitset_event_t ev;
+	ulmk_tid_t tid;
+	uint32_t   bits = 0u;
+	int        ok = 1;
+	int        i;
+
+	board_services_init(info);
+	sdk_puts("waitset: begin\n");
+	g_pass = 0;
+	g_fail = 0;
+	g_srv_rc = ULMK_OK;
+
+	g_sync = ulmk_notif_create();
+	g_evt  = ulmk_notif_create();
+	g_ws   = ulmk_waitset_create();
+	CHECK("objs", g_sync != ULMK_NOTIF_INVALID &&
+		      g_evt != ULMK_NOTIF_INVALID &&
+		      g_ws != ULMK_WAITSET_INVALID);
+
+	/* --- registration errors --- */
+	CHECK("add_notif", ulmk_waitset_add(g_ws, ULMK_WAITSET_NOTIF,
+					    g_evt, BIT_EVT) == ULMK_OK);
+	CHECK("add_twice", ulmk_waitset_add(g_ws, ULMK_WAITSET_NOTIF,
+					    g_evt, BIT_EVT) == ULMK_EINVAL);
+	CHECK("add_zero_mask", ulmk_waitset_add(g_ws, ULMK_WAITSET_NOTIF,
+						g_sync, 0u) == ULMK_EINVAL);
+
+	/* --- fast path: pending bits are returned without blocking --- */
+	(void)ulmk_notif_signal(g_evt, BIT_EVT);
+	CHECK("fast_notif", ulmk_wait_any(g_ws, &ev) == ULMK_OK &&
+			    ev.kind == ULMK_WAITSET_NOTIF &&
+			    ev.handle == g_evt && ev.bits == BIT_EVT);
+	CHECK("bits_consumed", ulmk_notif_poll(g_evt, BIT_EVT) == 0u);
+
+	/* --- one server, NR_EPS endpoints + the notification --- */
+	for (i = 0; i < NR_EPS; i++) {
+		g_ep[i] = ulmk_ep_create();
+		if (g_ep[i] == ULMK_EP_INVALID ||
+		    ulmk_waitset_add(g_ws, ULMK_WAITSET_EP, g_ep[i], 0u) != ULMK_OK)
+			ok = 0;
+	}
+	CHECK("add_eps", ok);
+
+	tid = sdk_spawn("ws_srv", server, NULL, 50u, 1024u, 0u);
+	CHECK("spawn_srv", tid != ULMK_TID_INVALID);
+	for (i = 0; i < NR_EPS; i++)
+		(void)ulmk_ep_grant(g_ep[i], tid);
+	for (i = 0; i < NR_EPS; i++) {
+		tid = sdk_spawn("ws_cli", client, (void *)(uintptr_t)i, 10u,
+				1024u, 0u);
+		if (tid == ULMK_TID_INVALID)
+			ok = 0;
+		(void)ulmk_ep_grant(g_ep[i], tid);
+	}
+	CHECK("spawn_cli", ok);
+
+	(void)ulmk_thread_priority_set(ulmk_thread_self(), 200u);
+	for (i = 0; i < 8; i++)
+		ulmk_thread_yield();
+	(void)ulmk_notif_broadcast(g_sync, BIT_GO);
+	(void)ulmk_notif_signal(g_evt, BIT_EVT);
+	ulmk_notif_wait(g_sync, BIT_DONE, &bits);
+
+	CHECK("srv_rc", g_srv_rc == ULMK_OK);
+	for (i = 0; i < NR_EPS; i++)
+		if (g_served[i] != 1u)
+			ok = 0;
+	CHECK("each_ep_once", ok);
+	CHECK("evt_seen", g_evt_bits == BIT_EVT);
+
+	/* --- destroy: member removal and set teardown --- */
+	CHECK("ep_destroy", ulmk_ep_destroy(g_ep[0]) == ULMK_OK);
+	CHECK("del_gone", ulmk_waitset_del(g_ws, ULMK_WAITSET_EP,
+					   g_ep[0]) == ULMK_EINVAL);
+	CHECK("del_ep", ulmk_waitset_del(g_ws, ULMK_WAITSET_EP,
+					 g_ep[1]) == ULMK_OK);
+	CHECK("ws_destroy", ulmk_waitset_destroy(g_ws) == ULMK_OK);
+	for (i = 1; i < NR_EPS; i++)
+		(void)ulmk_ep_destroy(g_ep[i]);
+	(void)ulmk_notif_destroy(g_evt);
+
+	sdk_puts("waitset: pass=");
+	sdk_put_u32((uint32_t)g_pass);
+	sdk_puts(" fail=");
+	sdk_put_u32((uint32_t)g_fail);
+	sdk_puts("\n");
+	sdk_puts(g_fail == 0 ? "waitset: PASS\n" : "waitset: FAIL\n");
+	ulmk_thread_exit();
+}
@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * wcet_stats — per-CPU syscall cycle histograms (ULMK_CONFIG_SYSCALL_WCET=1).
+ *
+ * Covers: N calls of one syscall add exactly N samples to that syscall's
+ * histogram on the caller's CPU, min <= max, the buckets sum to the count;
+ * an unassigned number below ULMK_SYS_MAX reads back empty; argument
+ * checks.  ulmk_cpu_id() is the probe: nothing else in the image calls it.
+ */
+#include "sdk_test_util.h"
+
+#define N_CALLS		32u
+
+static int g_fail;
+
+#define CHECK(name, cond)					\
+	do {							\
+		if (!(cond)) {					\
+			sdk_puts("wcet_stats: " name " FAIL\n");	\
+			g_fail = 1;				\
+		}						\
+	} while (0)
+
+static uint32_t hist_sum(const ulmk_wcet_stats_t *st)
+{
+	uint32_t n = 0u;
+	uint32_t i;
+
+	for (i = 0u; i < ULMK_SYSCALL_WCET_BUCKETS; i++)
+		n += st->hist[i];
+	return n;
+}
+
+void ulmk_root_thread(const ulmk_boot_info_t *info)
+{
+	ulmk_wcet_stats_t before;
+	ulmk_wcet_stats_t after;
+	uint32_t          cpu;
+	uint32_t          i;
+
+	board_services_init(info);
+	sdk_puts("wcet_stats: begin\n");
+
+	cpu = ulmk_cpu_id();
+	CHECK("before", ulmk_wcet_stats(cpu, ULMK_SYS_CPU_ID, &before) ==
+			ULMK_OK);
+	for (i = 0u; i < N_CALLS; i++)
+		(void)ulmk_cpu_id();
+	CHECK("after", ulmk_wcet_stats(cpu, ULMK_SYS_CPU_ID, &after) ==
+		       ULMK_OK);
+
+	CHECK("count", after.count - before.count == N_CALLS);
+	CHECK("min_max", after.min <= after.max);
+	CHECK("max_mono", after.max >= before.max);
+	CHECK("sum_mono", after.sum >= before.sum);
+	CHECK("hist", hist_sum(&after) == after.count);
+
+	sdk_puts("wcet_stats: cpu_id count=");
+	sdk_put_u32(after.count);
+	sdk_puts(" min=");
+	sdk_put_u32(after.min);
+	sdk_puts(" max=");
+	sdk_put_u32(after.max);
+	sdk_puts("\n");
+
+	CHECK("unassigned", ulmk_wcet_stats(cpu, ULMK_SYS_MAX - 1u, &after) ==
+			    ULMK_OK && after.count == 0u);
+	CHECK("bad_cpu", ulmk_wcet_stats(0xFFFFu, ULMK_SYS_CPU_ID, &after) ==
+			 ULMK_EINVAL);
+	CHECK("bad_nr", ulmk_wcet_stats(cpu, ULMK_SYS_MAX, &after) ==
+			ULMK_EINVAL);
+	CHECK("null_out", ulmk_wcet_stats(cpu, ULMK_SYS_CPU_ID, NULL) ==
+			  ULMK_EINVAL);
+
+	sdk_puts(g_fail ? "wcet_stats: FAIL\n" : "wcet_stats: PASS\n");
+	ulmk_thread_exit();
+}
@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 typedef enum {
 	ULMK_PRIV_USER   = 0,
@@ -14,10 +15,12 @@ typedef enum {
 typedef uintptr_t ulmk_tid_t;
 typedef int32_t ulmk_ep_t;
 typedef int32_t ulmk_notif_t;
+typedef uintptr_t ulmk_domain_t;
 
 #define ULMK_TID_INVALID   ((ulmk_tid_t)0)
 #define ULMK_EP_INVALID    ((ulmk_ep_t)-1)
 #define ULMK_NOTIF_INVALID ((ulmk_notif_t)-1)
+#define ULMK_DOMAIN_INVALID ((ulmk_domain_t)0)
 
 #define ULMK_OK		 0
 #define ULMK_EINVAL	-1
@@ -27,6 +30,7 @@ typedef int32_t ulmk_notif_t;
 #define ULMK_EDEADLK	-5
 #define ULMK_ESRCH	-6
 #define ULMK_ETIMEOUT	-7
+#define ULMK_ENOTSUP	-9
 
 /* Capabilities */
 #define ULMK_CAP_SPAWN		(1u << 0)
@@ -54,6 +58,21 @@ typedef struct {
 	int      is_notif;
 } ulmk_recv_or_notif_result_t;
 
+/* Per-CPU IRQ counters (embedded in struct ulmk_percpu) */
+typedef struct {
+	uint32_t dispatches;
+	uint32_t signals;
+	uint32_t lat_last;
+	uint32_t lat_max;
+	uint32_t lat_total;
+	uint32_t coal_events;
+	uint32_t coal_batches;
+	uint32_t ipis;
+} ulmk_irq_stats_t;
+
+/* Userspace IRQ attach callback (layout only; never called here) */
+typedef bool (*ulmk_irq_attach_fn_t)(void *data);
+
 typedef struct {
 	const char	*name;
 	void		(*entry)(void *arg);
@@ -63,6 +82,7 @@ typedef struct {
 	ulmk_privilege_t	 privilege;
 	size_t		 heap_size;
 	uint8_t		 cpu;
+	ulmk_domain_t	 domain;
 } ulmk_thread_attr_t;
 
 typedef struct {
@@ -70,4 +90,17 @@ typedef struct {
 	size_t    size;
 } ulmk_heap_info_t;
 
+/* Wait sets */
+typedef int32_t ulmk_waitset_t;
+#define ULMK_WAITSET_INVALID     ((ulmk_waitset_t)0)
+#define ULMK_WAITSET_MAX_SOURCES 16u
+#define ULMK_WAITSET_EP          1u
+#define ULMK_WAITSET_NOTIF       2u
+
+typedef struct ulmk_waitset_event {
+	uint32_t  kind;
+	uintptr_t handle;
+	uint32_t  bits;
+} ulmk_waitset_event_t;
+
 #endif /* ULMK_MICROKERNEL_H */
@@ -37,6 +37,13 @@
  *   20. self: no current thread — returns ULMK_TID_INVALID.
  *   21. yield: re-enqueues current and calls schedule.
  *   22. exit: marks thread DEAD and calls schedule.
+ *   23. mpu_compact: STACK dropped, adjacent same-perm regions merged.
+ *   24. mpu_compact: POW2 policy merges only aligned 2^n unions; perms and
+ *       PERIPH-ness must match.
+ *   25. mpu_compact: a bridging region folds its neighbours; @max caps out.
+ *   26. domain: members share one MPU view; refs track attach/detach.
+ *   27. domain: attach to a destroyed domain fails; last detach frees it.
+ *   28. domain: a stale mark forces one reprogram on the next switch.
  */
 
 #include <stdint.h>
@@ -53,7 +60,9 @@
 #include "../../kernel/include/ulmk_thread_internal.h"
 #include "../../kernel/include/ulmk_sched.h"
 #include "../../kernel/include/ulmk_mem_internal.h"
+#include "../../kernel/include/ulmk_domain_internal.h"
 #include "../../kernel/syscall/syscall_router.h"
+#include "../../kernel/include/ulmk_mpu_shadow.h"
 
 /* ── Mock state ────────────────────────────────────────────────────────────── */
 
@@ -63,6 +72,10 @@ static int		 g_dequeue_count;
 static int		 g_schedule_count;
 static int		 g_ctx_init_count;
 static ulmk_thread_t	*g_recv_removed;
+static int		 g_mpu_switch_count;
+static const ulmk_arch_region_t *g_mpu_regions;
+static void		*g_heap_freed;
+static int		 g_heap_free_count;
 
 /* ── Arch stubs ────────────────────────────────────────────────────────────── */
 
@@ -84,7 +97,7 @@ void ulmk_arch_ctx_init(ulmk_arch_ctx_t *ctx,
 
 void   ulmk_heap_init(uintptr_t base, size_t size) { (void)base; (void)size; }
 void  *ulmk_heap_alloc(size_t size)                { (void)size; return NULL; }
-void   ulmk_heap_free(void *ptr)                   { (void)ptr; }
+void   ulmk_heap_free(void *ptr)                   { g_heap_freed = ptr; g_heap_free_count++; }
 void  *ulmk_heap_aligned_alloc(size_t a, size_t s) { (void)a; (void)s; return NULL; }
 size_t ulmk_heap_free_bytes(void)                  { return 0u; }
 
@@ -93,7 +106,9 @@ size_t ulmk_heap_free_bytes(void)                  { return 0u; }
 void ulmk_arch_ctx_free(ulmk_arch_ctx_t *c)     { (void)c; }
 void ulmk_arch_mpu_switch(const ulmk_arch_region_t *r, uint8_t n, uint8_t p)
 {
-	(void)r; (void)n; (void)p;
+	(void)n; (void)p;
+	g_mpu_regions = r;
+	g_mpu_switch_count++;
 }
 
 /* ── Scheduler stubs ───────────────────────────────────────────────────────── */
@@ -136,6 +151,10 @@ void ulmk_sched_set_dead_for_cleanup(ulmk_thread_t *t) { (void)t; }
 
 void ulmk_ep_recv_queue_remove(ulmk_thread_t *t) { g_recv_removed = t; }
 
+/* ── IRQ stubs ─────────────────────────────────────────────────────────────── */
+
+void ulmk_irq_thread_release(ulmk_thread_t *t) { t->irq_bound = 0u; }
+
 typedef struct ulmk_notif_obj ulmk_notif_obj_t;
 ulmk_notif_obj_t *ulmk_notif_by_id(ulmk_notif_t id)
 {
@@ -163,6 +182,10 @@ static void mock_reset(void)
 	g_schedule_count = 0;
 	g_ctx_init_count = 0;
 	g_recv_removed  = NULL;
+	g_mpu_switch_count = 0;
+	g_mpu_regions   = NULL;
+	g_heap_freed    = NULL;
+	g_heap_free_count = 0;
 	/*
 	 * Do NOT reset s_tcb_idx: thread.c keeps a global registry linked list
 	 * (tcb_list) that still points to previously allocated TCBs.  Reusing
@@ -459,6 +482,185 @@ static void test_yield(void)
 	EXPECT(g_schedule_count == 1);
 }
 
+static void set_region(ulmk_arch_region_t *r, uintptr_t base, size_t size,
+		       uint32_t perms, uint8_t type)
+{
+	r->base  = base;
+	r->size  = size;
+	r->perms = perms;
+	r->type  = type;
+}
+
+static void test_mpu_compact_merge(void)
+{
+	ulmk_arch_region_t in[4];
+	ulmk_arch_region_t out[4];
+	uint32_t merged = 0u;
+	uint8_t  n;
+
+	set_region(&in[0], 0x1000u, 0x400u, 3u, ULMK_REGION_STACK);
+	set_region(&in[1], 0x2400u, 0x100u, 3u, ULMK_REGION_HEAP);
+	set_region(&in[2], 0x2000u, 0x400u, 3u, ULMK_REGION_SHARED);
+	set_region(&in[3], 0x3000u, 0u,     3u, ULMK_REGION_HEAP);
+
+	n = ulmk_mpu_compact(in, 4u, out, 4u, ULMK_MPU_MERGE_ANY, &merged);
+
+	EXPECT(n == 1u);
+	EXPECT(merged == 1u);
+	EXPECT(out[0].base == 0x2000u && out[0].size == 0x500u);
+}
+
+static void test_mpu_compact_pow2(void)
+{
+	ulmk_arch_region_t in[4];
+	ulmk_arch_region_t out[4];
+	uint8_t  n;
+
+	/* [0x2000,0x2400) + [0x2400,0x2800) would round up to 0x1000 — keep */
+	set_region(&in[0], 0x2400u, 0x400u, 3u, ULMK_REGION_HEAP);
+	set_region(&in[1], 0x2800u, 0x400u, 3u, ULMK_REGION_HEAP);
+	n = ulmk_mpu_compact(in, 2u, out, 4u, ULMK_MPU_MERGE_POW2, NULL);
+	EXPECT(n == 2u);
+
+	/* [0x2000,0x2800) is a naturally aligned 2 KiB block — merge */
+	set_region(&in[1], 0x2000u, 0x400u, 3u, ULMK_REGION_HEAP);
+	n = ulmk_mpu_compact(in, 2u, out, 4u, ULMK_MPU_MERGE_POW2, NULL);
+	EXPECT(n == 1u);
+	EXPECT(out[0].base == 0x2000u && out[0].size == 0x800u);
+
+	/* Same layout, different perms or memory type — never merge */
+	set_region(&in[1], 0x2000u, 0x400u, 1u, ULMK_REGION_HEAP);
+	n = ulmk_mpu_compact(in, 2u, out, 4u, ULMK_MPU_MERGE_ANY, NULL);
+	EXPECT(n == 2u);
+	set_region(&in[1], 0x2000u, 0x400u, 3u, ULMK_REGION_PERIPH);
+	n = ulmk_mpu_compact(in, 2u, out, 4u, ULMK_MPU_MERGE_ANY, NULL);
+	EXPECT(n == 2u);
+}
+
+static void test_mpu_compact_bridge(void)
+{
+	ulmk_arch_region_t in[4];
+	ulmk_arch_region_t out[4];
+	uint32_t merged = 0u;
+	uint8_t  n;
+
+	set_region(&in[0], 0x1000u, 0x100u, 3u, ULMK_REGION_HEAP);
+	set_region(&in[1], 0x1200u, 0x100u, 3u, ULMK_REGION_HEAP);
+	set_region(&in[2], 0x8000u, 0x100u, 3u, ULMK_REGION_HEAP);
+	set_region(&in[3], 0x1100u, 0x100u, 3u, ULMK_REGION_HEAP);
+
+	n = ulmk_mpu_compact(in, 4u, out, 4u, ULMK_MPU_MERGE_ANY, &merged);
+	EXPECT(n == 2u);
+	EXPECT(merged == 2u);
+	EXPECT(out[0].base == 0x1000u && out[0].size == 0x300u);
+	EXPECT(out[1].base == 0x8000u);
+
+	/*
+	 * In place, capped at one slot: entries that neither fit nor merge
+	 * when reached are dropped in table order (0x1200 and 0x8000 here).
+	 */
+	n = ulmk_mpu_compact(in, 4u, in, 1u, ULMK_MPU_MERGE_ANY, NULL);
+	EXPECT(n == 1u);
+	EXPECT(in[0].base == 0x1000u && in[0].size == 0x200u);
+}
+
+static void test_domain_shared_view(void)
+{
+	static ulmk_domain_obj_t d;
+	ulmk_domain_t id = (ulmk_domain_t)(uintptr_t)&d;
+	ulmk_thread_t *a = make_thread(5);
+	ulmk_thread_t *b = make_thread(5);
+
+	EXPECT(a != NULL && b != NULL);
+	EXPECT(a->domain == NULL);
+	EXPECT(ulmk_thread_mpu_regions(a) == a->regions);
+
+	ulmk_domain_obj_init(&d, id);
+	EXPECT(ulmk_domain_by_id(id) == &d);
+	EXPECT(ulmk_domain_attach(a, id) == ULMK_OK);
+	EXPECT(ulmk_domain_attach(b, id) == ULMK_OK);
+	EXPECT(d.refs == 2u);
+
+	set_region(&d.regions[0], 0x2000u, 0x100u, 3u, ULMK_REGION_SHARED);
+	d.region_count = 1u;
+	EXPECT(ulmk_thread_mpu_regions(a) == d.regions);
+	EXPECT(ulmk_thread_mpu_regions(b) == d.regions);
+	EXPECT(ulmk_thread_mpu_count(b) == 1u);
+
+	ulmk_domain_detach(b);
+	EXPECT(b->domain == NULL && d.refs == 1u);
+	EXPECT(ulmk_thread_mpu_regions(b) == b->regions);
+	ulmk_domain_detach(a);
+	EXPECT(d.refs == 0u);
+	EXPECT(g_heap_freed == NULL);	/* still active — not freed */
+}
+
+static void test_domain_destroy(void)
+{
+	static ulmk_domain_obj_t d;
+	ulmk_domain_t id = (ulmk_domain_t)(uintptr_t)&d;
+	ulmk_thread_t *a = make_thread(5);
+	ulmk_thread_t *b = make_thread(5);
+
+	EXPECT(a != NULL && b != NULL);
+	ulmk_domain_obj_init(&d, id);
+	EXPECT(ulmk_domain_attach(a, id) == ULMK_OK);
+
+	/* What ulmk_kern_domain_destroy() does with a live member. */
+	d.active = false;
+	EXPECT(ulmk_domain_by_id(id) == NULL);
+	EXPECT(ulmk_domain_attach(b, id) == ULMK_EINVAL);
+	EXPECT(b->domain == NULL);
+	EXPECT(ulmk_domain_by_id(ULMK_DOMAIN_INVALID) == NULL);
+
+	ulmk_domain_detach(a);
+	EXPECT(g_heap_freed == &d);
+}
+
+static void test_domain_stale_switch(void)
+{
+	static ulmk_domain_obj_t d;
+	ulmk_domain_t id = (ulmk_domain_t)(uintptr_t)&d;
+	ulmk_thread_t *a = make_thread(5);
+
+	EXPECT(a != NULL);
+	ulmk_domain_obj_init(&d, id);
+	EXPECT(ulmk_domain_attach(a, id) == ULMK_OK);
+
+	ulmk_thread_mpu_switch(a, 1u);
+	EXPECT(g_mpu_switch_count == 1);
+	EXPECT(g_mpu_regions == d.regions);
+
+	d.stale[0] = 1u;
+	ulmk_thread_mpu_switch(a, 1u);
+	EXPECT(g_mpu_switch_count == 3);	/* kernel layout, then the domain */
+	EXPECT(g_mpu_regions == d.regions);
+	EXPECT(d.stale[0] == 0u);
+
+	ulmk_domain_detach(a);
+}
+
+static void test_free_heap_regions(void)
+{
+	static uint8_t periph[64];
+	static uint8_t anon[64];
+	ulmk_thread_t *th = make_thread(5);
+	uint8_t n;
+
+	EXPECT(th != NULL);
+	n = th->region_count;
+	th->regions[n].base     = (uintptr_t)periph;
+	th->regions[n].type     = ULMK_REGION_PERIPH;
+	th->regions[n + 1].base = (uintptr_t)anon;
+	th->regions[n + 1].type = ULMK_REGION_HEAP;
+	th->region_count        = (uint8_t)(n + 2u);
+
+	/* A mapping never unmapped goes back to the heap with the thread. */
+	ulmk_thread_free(th);
+	EXPECT(g_heap_free_count == 1);
+	EXPECT(g_heap_freed == anon);
+}
+
 static void test_exit(void)
 {
 	ulmk_thread_t *th = make_thread(5);
@@ -503,6 +705,13 @@ int main(void)
 	RUN(test_self_current);
 	RUN(test_self_no_current);
 	RUN(test_yield);
+	RUN(test_mpu_compact_merge);
+	RUN(test_mpu_compact_pow2);
+	RUN(test_mpu_compact_bridge);
+	RUN(test_domain_shared_view);
+	RUN(test_domain_destroy);
+	RUN(test_domain_stale_switch);
+	RUN(test_free_heap_regions);
 	test_exit();
 
 	printf("\nResults: %d passed, %d failed\n", g_pass, g_fail);
@@ -12,4 +12,16 @@
 #define ULMK_ETIMEOUT	 -7
 #define ULMK_ECANCELED	 -8
 
+/* Per-CPU IRQ counters (embedded in struct ulmk_percpu) */
+typedef struct {
+	uint32_t dispatches;
+	uint32_t signals;
+	uint32_t lat_last;
+	uint32_t lat_max;
+	uint32_t lat_total;
+	uint32_t coal_events;
+	uint32_t coal_batches;
+	uint32_t ipis;
+} ulmk_irq_stats_t;
+
 #endif /* ULMK_MICROKERNEL_H */
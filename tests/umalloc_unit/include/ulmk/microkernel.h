@@ -0,0 +1,20 @@
+/* Minimal stub for umalloc_unit */
+#ifndef ULMK_MICROKERNEL_H
+#define ULMK_MICROKERNEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ULMK_OK		  0
+#define ULMK_ENOMEM	 -2
+
+typedef struct {
+	uintptr_t base;
+	size_t    size;
+} ulmk_heap_info_t;
+
+/* Provided by umalloc_unit_test.c over a static buffer. */
+int ulmk_get_thread_heap(ulmk_heap_info_t *info);
+int ulmk_heap_extend_info(size_t size, ulmk_heap_info_t *added);
+
+#endif /* ULMK_MICROKERNEL_H */
@@ -0,0 +1,127 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Host unit tests for the umalloc component.
+ *
+ * ulmk_get_thread_heap() and ulmk_heap_extend_info() are stubbed over
+ * static buffers: a 16 KiB thread heap and one 16 KiB extension block.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <ulmk/microkernel.h>
+#include <umalloc.h>
+
+static int tests_run;
+static int tests_failed;
+
+#define CHECK(cond, msg) \
+	do { \
+		tests_run++; \
+		if (!(cond)) { \
+			tests_failed++; \
+			printf("  FAIL [line %d] %s\n", __LINE__, (msg)); \
+		} else { \
+			printf("  PASS %s\n", (msg)); \
+		} \
+	} while (0)
+
+static uint8_t heap_buf[16384] __attribute__((aligned(8)));
+static uint8_t ext_buf[16384] __attribute__((aligned(8)));
+static int     ext_used;
+static int     ext_calls;
+static size_t  ext_last;
+
+int ulmk_get_thread_heap(ulmk_heap_info_t *info)
+{
+	info->base = (uintptr_t)heap_buf;
+	info->size = sizeof(heap_buf);
+	return ULMK_OK;
+}
+
+int ulmk_heap_extend_info(size_t size, ulmk_heap_info_t *added)
+{
+	ext_calls++;
+	ext_last = size;
+	if (ext_used || size > sizeof(ext_buf))
+		return ULMK_ENOMEM;
+	ext_used     = 1;
+	added->base = (uintptr_t)ext_buf;
+	added->size = sizeof(ext_buf);
+	return ULMK_OK;
+}
+
+static umalloc_arena_t *reset(uint32_t flags)
+{
+	memset(heap_buf, 0xCC, sizeof(heap_buf));
+	memset(ext_buf, 0xCC, sizeof(ext_buf));
+	ext_used  = 0;
+	ext_calls = 0;
+	ext_last  = 0u;
+	return umalloc_init(flags);
+}
+
+static void test_alloc_free(void)
+{
+	umalloc_arena_t *a = reset(0u);
+	umalloc_stats_t  st;
+	void            *p;
+	void            *q;
+
+	CHECK(a != NULL, "arena over the thread heap");
+	p = umalloc(a, 24u);
+	CHECK(p != NULL && ((uintptr_t)p & 7u) == 0u, "alloc 24 is 8-aligned");
+	memset(p, 0x5A, 24u);
+	ufree(a, p);
+	q = umalloc(a, 24u);
+	CHECK(q == p, "same-class realloc reuses the parked block");
+	umalloc_stats(a, &st);
+	CHECK(st.fast_hits == 1u && st.slow_allocs == 1u, "fast/slow counters");
+	CHECK(umalloc(a, 0u) == NULL, "size 0 returns NULL");
+}
+
+static void test_size_overflow(void)
+{
+	umalloc_arena_t *a = reset(UMALLOC_F_EXTEND);
+	umalloc_stats_t  st;
+
+	/* Rounding SIZE_MAX up to 8 bytes used to wrap to a tiny block. */
+	CHECK(umalloc(a, SIZE_MAX) == NULL, "SIZE_MAX rejected");
+	CHECK(umalloc(a, SIZE_MAX - 7u) == NULL, "SIZE_MAX - 7 rejected");
+	CHECK(umalloc(a, SIZE_MAX - 64u) == NULL, "SIZE_MAX - 64 fails");
+	umalloc_stats(a, &st);
+	CHECK(st.failures == 3u, "each one counts as a failure");
+	CHECK(st.slow_allocs == 0u && st.fast_hits == 0u, "nothing allocated");
+	CHECK(ext_calls <= 1 && (ext_calls == 0 || ext_last >= SIZE_MAX - 64u),
+	      "no wrapped extension request");
+}
+
+static void test_extend(void)
+{
+	umalloc_arena_t *a = reset(UMALLOC_F_EXTEND);
+	umalloc_stats_t  st;
+	void            *p;
+
+	p = umalloc(a, 12000u);
+	CHECK(p != NULL, "first large block from the thread heap");
+	p = umalloc(a, 8000u);
+	CHECK(p != NULL, "second large block after an extension");
+	CHECK(ext_calls == 1 && ext_last >= 8000u, "one extension, big enough");
+	umalloc_stats(a, &st);
+	CHECK(st.extends == 1u, "extends counter");
+	CHECK(umalloc(a, 20000u) == NULL, "no room left fails");
+	umalloc_stats(a, &st);
+	CHECK(st.failures == 1u, "failure counted");
+}
+
+int main(void)
+{
+	printf("umalloc_unit:\n");
+	test_alloc_free();
+	test_size_overflow();
+	test_extend();
+	printf("umalloc_unit: %d run, %d failed\n", tests_run, tests_failed);
+	return tests_failed ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""Compare ulmk benchmark results against a stored baseline.
+
+Input is the console log of tests/sdk_suite/bench or smp_bench, in which
+each case is a line
+
+  ulmk-bench: <case> n=<rounds> min=<cyc> avg=<cyc> max=<cyc>
+
+The baseline is a JSON file mapping a key (arch, board and SDK tag, e.g.
+"riscv_qemu_riscv_virt_cycles") to {case: avg cycles}.  A case regresses
+when its avg exceeds the baseline by more than --tolerance; the exit status
+is 1 if any case does, or if the baseline has no entry for the key at all,
+so an unrecorded board cannot pass unchecked.  A case missing from an
+existing entry is reported as new, not failed.  --update stores the log's
+results under the key instead of comparing.
+
+Cycle counts under QEMU depend on the host and on -icount, so baselines
+are only comparable on the machine (or CI image) that recorded them.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+LINE_RE = re.compile(r"ulmk-bench:\s+(\S+)\s+n=(\d+)\s+min=(\d+)\s+"
+                     r"avg=(\d+)\s+max=(\d+)")
+
+
+def parse(text):
+    """Return {case: {"n", "min", "avg", "max"}}; the last line wins."""
+    out = {}
+    for m in LINE_RE.finditer(text):
+        n, lo, avg, hi = (int(g) for g in m.groups()[1:])
+        out[m.group(1)] = {"n": n, "min": lo, "avg": avg, "max": hi}
+    return out
+
+
+def load(path):
+    if not os.path.exists(path):
+        return {}
+    with open(path) as f:
+        return json.load(f)
+
+
+def compare(results, base, tolerance):
+    """Print one row per case; return the number of regressions."""
+    bad = 0
+    print("%-14s %10s %10s %8s" % ("case", "baseline", "avg", "change"))
+    for case, r in results.items():
+        ref = base.get(case)
+        if not ref:
+            print("%-14s %10s %10d %8s" % (case, "-", r["avg"], "new"))
+            continue
+        change = (r["avg"] - ref) / float(ref)
+        flag = ""
+        if change > tolerance:
+            flag = "  REGRESSION"
+            bad += 1
+        print("%-14s %10d %10d %+7.1f%%%s"
+              % (case, ref, r["avg"], 100.0 * change, flag))
+    for case in sorted(set(base) - set(results)):
+        print("%-14s %10d %10s %8s" % (case, base[case], "-", "missing"))
+    return bad
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log", help="console log of the bench case")
+    ap.add_argument("--baseline", required=True, help="baseline JSON file")
+    ap.add_argument("--key", required=True,
+                    help="baseline entry, e.g. <arch>_<board><sdk tag>")
+    ap.add_argument("--tolerance", type=float, default=0.15,
+                    help="allowed avg increase, fraction (default 0.15)")
+    ap.add_argument("--update", action="store_true",
+                    help="store the results as the new baseline for --key")
+    args = ap.parse_args()
+
+    with open(args.log, "rb") as f:
+        results = parse(f.read().decode("latin-1"))
+    if not results:
+        sys.exit("bench_compare: no ulmk-bench lines in %s" % args.log)
+
+    base = load(args.baseline)
+    if args.update:
+        base[args.key] = {c: r["avg"] for c, r in results.items()}
+        with open(args.baseline, "w") as f:
+            json.dump(base, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("bench_compare: stored %d cases under %s in %s"
+              % (len(results), args.key, args.baseline))
+        return
+
+    bad = compare(results, base.get(args.key, {}), args.tolerance)
+    if args.key not in base:
+        sys.exit("bench_compare: no baseline for %s in %s; record one with "
+                 "--update" % (args.key, args.baseline))
+    if bad:
+        sys.exit("bench_compare: %d case(s) regressed more than %.0f%%"
+                 % (bad, 100.0 * args.tolerance))
+
+
+if __name__ == "__main__":
+    main()
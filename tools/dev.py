@@ -663,7 +663,8 @@ def _discover_tests(kind: str, arch: str | None = None,
     for d in sorted(TESTS_DIR.iterdir()):
         if not d.is_dir() or not (d / "Makefile").exists():
             continue
-        if d.name.endswith("_e2e") or d.name == "sdk_suite":
+        # host_bench: throughput numbers, run by hand (make -C tests/host_bench run).
+        if d.name.endswith("_e2e") or d.name in ("sdk_suite", "host_bench"):
             continue
         is_unit = d.name.endswith("_unit")
         if (kind == "unit") == is_unit:
@@ -694,9 +695,39 @@ def _sdk_cache_vars(arch: str, make_extra: str, test_name: str = "") -> str:
     base = test_name.rsplit("/", 1)[-1] if test_name else ""
     if base.startswith("smp_") or base.startswith("smp4_"):
         tag += "_smp"
-    # irq_attach needs ULMK_CONFIG_IRQ_ATTACH=1 (default off).
-    if base == "irq_attach":
+    # irq_attach / irq_plic_order need ULMK_CONFIG_IRQ_ATTACH=1 (default off).
+    if base in ("irq_attach", "irq_plic_order"):
         tag += "_irqattach"
+    # irq_stress raises ULMK_CONFIG_MAX_IRQ_BINDINGS to 40 (default 16).
+    if base == "irq_stress":
+        tag += "_irqb40"
+    # mem_lazy needs ULMK_CONFIG_MPU_LAZY_SLOTS=1 (default off).
+    if base == "mem_lazy":
+        tag += "_lazy1"
+    # trace_ring needs ULMK_CONFIG_TRACE_ENTRIES=256 (default off).
+    if base == "trace_ring":
+        tag += "_trace256"
+    # printk_ring needs ULMK_CONFIG_PRINTK_BUF_SIZE=1024 (default off).
+    if base == "printk_ring":
+        tag += "_pkbuf1024"
+    # thread_stats needs ULMK_CONFIG_THREAD_STATS=1 (default off).
+    if base == "thread_stats":
+        tag += "_tstats"
+    # sched_latency needs ULMK_CONFIG_SCHED_LATENCY=1 (default off).
+    if base == "sched_latency":
+        tag += "_schedlat"
+    # irqoff_profile needs ULMK_CONFIG_IRQOFF_STATS=1 (default off).
+    if base == "irqoff_profile":
+        tag += "_irqoff"
+    # bench / smp_bench need ULMK_CONFIG_USER_CYCLES=1 (default off).
+    if base in ("bench", "smp_bench"):
+        tag += "_cycles"
+    # stack_watermark needs ULMK_CONFIG_STACK_WATERMARK=1 (default off).
+    if base == "stack_watermark":
+        tag += "_stackwm"
+    # wcet_stats needs ULMK_CONFIG_SYSCALL_WCET=1 (default off).
+    if base == "wcet_stats":
+        tag += "_wcet"
     return f"SDK_CACHE=/workspace/tests/sdk_suite/_sdk_cache/{tag}"
 
 
@@ -26,21 +26,41 @@ import sys
 # Canonical kernel policy — the single place default sizing/policy is defined.
 # Only symbols actually read by the real (non-UL_UNIT_TEST) kernel belong here.
 KERNEL_DEFAULTS = {
-    "ULMK_CONFIG_MAX_IRQ_BINDINGS": 16,   # irq.c static binding table
+    "ULMK_CONFIG_MAX_IRQ_BINDINGS": 16,   # live irq.c bindings (heap objects)
     "ULMK_CONFIG_DEBUG_PRINTK":     1,    # ulmk_printk.c (0 = no-op)
-    "ULMK_CONFIG_SYSCALL_WCET":     0,    # kernel cycle slot around syscalls
+    "ULMK_CONFIG_SYSCALL_WCET":     0,    # cycle slot + per-syscall histograms
     "ULMK_CONFIG_ENABLE_SMP":       0,    # 1 = multi-CPU sched (needs NUM_CPU>1)
     "ULMK_CONFIG_TICK_HZ":          1000, # kernel timing-wheel tick rate
     "ULMK_CONFIG_IRQ_ATTACH":       0,    # 1 = DANGEROUS ISR userspace callbacks
+    "ULMK_CONFIG_IRQ_NESTING":      0,    # 1 = urgent IRQs preempt attach callbacks
+    "ULMK_CONFIG_MPU_LAZY_SLOTS":   0,    # >0 = fault-driven region loads
+    "ULMK_CONFIG_TRACE_ENTRIES":    0,    # per-CPU trace ring, 0 = compiled out
+    "ULMK_CONFIG_PRINTK_BUF_SIZE":  0,    # per-CPU printk ring, 0 = synchronous
+    "ULMK_CONFIG_THREAD_STATS":     0,    # 1 = per-thread run-time accounting
+    "ULMK_CONFIG_SCHED_LATENCY":    0,    # 1 = wake-up latency histograms
+    "ULMK_CONFIG_IRQOFF_STATS":     0,    # 1 = IRQ-off window + lock profiler
+    "ULMK_CONFIG_SPINLOCK_STATS":   0,    # 1 = per-lock contention counters
+    "ULMK_CONFIG_USER_CYCLES":      0,    # 1 = ulmk_cycle_read() for benchmarks
+    "ULMK_CONFIG_STACK_WATERMARK":  0,    # 1 = stack painting + high-water marks
 }
 
 # Inclusive range checks for numeric policy symbols.
 KERNEL_RANGES = {
-    "ULMK_CONFIG_MAX_IRQ_BINDINGS": (1, 256),
+    "ULMK_CONFIG_MAX_IRQ_BINDINGS": (1, 255),  # one per bindable SRPN
     "ULMK_CONFIG_SYSCALL_WCET":     (0, 1),
     "ULMK_CONFIG_ENABLE_SMP":       (0, 1),
     "ULMK_CONFIG_TICK_HZ":          (1, 10000),
     "ULMK_CONFIG_IRQ_ATTACH":       (0, 1),
+    "ULMK_CONFIG_IRQ_NESTING":      (0, 1),
+    "ULMK_CONFIG_MPU_LAZY_SLOTS":   (0, 16),
+    "ULMK_CONFIG_TRACE_ENTRIES":    (0, 8192),
+    "ULMK_CONFIG_PRINTK_BUF_SIZE":  (0, 65536),
+    "ULMK_CONFIG_THREAD_STATS":     (0, 1),
+    "ULMK_CONFIG_SCHED_LATENCY":    (0, 1),
+    "ULMK_CONFIG_IRQOFF_STATS":     (0, 1),
+    "ULMK_CONFIG_SPINLOCK_STATS":   (0, 1),
+    "ULMK_CONFIG_USER_CYCLES":      (0, 1),
+    "ULMK_CONFIG_STACK_WATERMARK":  (0, 1),
 }
 
 
@@ -64,6 +84,10 @@ def build_config(overrides):
         if not (lo <= cfg[name] <= hi):
             sys.exit("gen_config: %s=%d out of range [%d, %d]"
                      % (name, cfg[name], lo, hi))
+    for name in ("ULMK_CONFIG_TRACE_ENTRIES", "ULMK_CONFIG_PRINTK_BUF_SIZE"):
+        if cfg[name] & (cfg[name] - 1):
+            sys.exit("gen_config: %s=%d is not a power of two"
+                     % (name, cfg[name]))
     return cfg
 
 
@@ -23,7 +23,12 @@ set -euo pipefail
 usage() {
 	echo "usage: $0 --toolchain FILE --chip-dir DIR --arch ARCH \\" >&2
 	echo "          --board-name NAME --build-dir DIR --out-dir DIR \\" >&2
-	echo "          [--clean] [--optimize-size] [--enable-smp] [--enable-irq-attach]" >&2
+	echo "          [--clean] [--optimize-size] [--enable-smp] [--enable-irq-attach] \\" >&2
+	echo "          [--mpu-lazy-slots N] [--trace-entries N] [--irq-bindings N] \\" >&2
+	echo "          [--printk-buf-size N] [--enable-thread-stats] \\" >&2
+	echo "          [--enable-sched-latency] [--enable-irqoff-stats] \\" >&2
+	echo "          [--enable-spinlock-stats] [--enable-user-cycles] \\" >&2
+	echo "          [--enable-stack-watermark] [--enable-syscall-wcet]" >&2
 	exit 2
 }
 
@@ -37,6 +42,17 @@ CLEAN=0
 OPTIMIZE_SIZE=0
 ENABLE_SMP=0
 ENABLE_IRQ_ATTACH=0
+MPU_LAZY_SLOTS=0
+TRACE_ENTRIES=0
+IRQ_BINDINGS=0
+PRINTK_BUF_SIZE=0
+THREAD_STATS=0
+SCHED_LATENCY=0
+IRQOFF_STATS=0
+SPINLOCK_STATS=0
+USER_CYCLES=0
+STACK_WATERMARK=0
+SYSCALL_WCET=0
 
 while [ $# -gt 0 ]; do
 	case "$1" in
@@ -50,6 +66,17 @@ while [ $# -gt 0 ]; do
 	--optimize-size) OPTIMIZE_SIZE=1; shift;;
 	--enable-smp) ENABLE_SMP=1;   shift;;
 	--enable-irq-attach) ENABLE_IRQ_ATTACH=1; shift;;
+	--mpu-lazy-slots) MPU_LAZY_SLOTS="$2"; shift 2;;
+	--trace-entries) TRACE_ENTRIES="$2"; shift 2;;
+	--irq-bindings) IRQ_BINDINGS="$2"; shift 2;;
+	--printk-buf-size) PRINTK_BUF_SIZE="$2"; shift 2;;
+	--enable-thread-stats) THREAD_STATS=1; shift;;
+	--enable-sched-latency) SCHED_LATENCY=1; shift;;
+	--enable-irqoff-stats) IRQOFF_STATS=1; shift;;
+	--enable-spinlock-stats) SPINLOCK_STATS=1; shift;;
+	--enable-user-cycles) USER_CYCLES=1; shift;;
+	--enable-stack-watermark) STACK_WATERMARK=1; shift;;
+	--enable-syscall-wcet) SYSCALL_WCET=1; shift;;
 	*) echo "error: unknown argument '$1'" >&2; usage;;
 	esac
 done
@@ -69,6 +96,39 @@ fi
 if [ "$ENABLE_IRQ_ATTACH" -eq 1 ]; then
 	TAG="${TAG}_irqattach"
 fi
+if [ "$MPU_LAZY_SLOTS" -ne 0 ]; then
+	TAG="${TAG}_lazy${MPU_LAZY_SLOTS}"
+fi
+if [ "$TRACE_ENTRIES" -ne 0 ]; then
+	TAG="${TAG}_trace${TRACE_ENTRIES}"
+fi
+if [ "$IRQ_BINDINGS" -ne 0 ]; then
+	TAG="${TAG}_irqb${IRQ_BINDINGS}"
+fi
+if [ "$PRINTK_BUF_SIZE" -ne 0 ]; then
+	TAG="${TAG}_pkbuf${PRINTK_BUF_SIZE}"
+fi
+if [ "$THREAD_STATS" -eq 1 ]; then
+	TAG="${TAG}_tstats"
+fi
+if [ "$SCHED_LATENCY" -eq 1 ]; then
+	TAG="${TAG}_schedlat"
+fi
+if [ "$IRQOFF_STATS" -eq 1 ]; then
+	TAG="${TAG}_irqoff"
+fi
+if [ "$SPINLOCK_STATS" -eq 1 ]; then
+	TAG="${TAG}_spinstats"
+fi
+if [ "$USER_CYCLES" -eq 1 ]; then
+	TAG="${TAG}_cycles"
+fi
+if [ "$STACK_WATERMARK" -eq 1 ]; then
+	TAG="${TAG}_stackwm"
+fi
+if [ "$SYSCALL_WCET" -eq 1 ]; then
+	TAG="${TAG}_wcet"
+fi
 KERNEL_A="ulmk_kernel_${TAG}.a"
 BOARD_A="ulmk_board_${TAG}.a"
 LD="linker_${TAG}.ld"
@@ -91,6 +151,50 @@ IRQ_ATTACH_FLAG=""
 if [ "$ENABLE_IRQ_ATTACH" -eq 1 ]; then
 	IRQ_ATTACH_FLAG="-DULMK_CONFIG_IRQ_ATTACH=1"
 fi
+MPU_LAZY_FLAG=""
+if [ "$MPU_LAZY_SLOTS" -ne 0 ]; then
+	MPU_LAZY_FLAG="-DULMK_CONFIG_MPU_LAZY_SLOTS=${MPU_LAZY_SLOTS}"
+fi
+TRACE_FLAG=""
+if [ "$TRACE_ENTRIES" -ne 0 ]; then
+	TRACE_FLAG="-DULMK_CONFIG_TRACE_ENTRIES=${TRACE_ENTRIES}"
+fi
+IRQ_BINDINGS_FLAG=""
+if [ "$IRQ_BINDINGS" -ne 0 ]; then
+	IRQ_BINDINGS_FLAG="-DULMK_CONFIG_MAX_IRQ_BINDINGS=${IRQ_BINDINGS}"
+fi
+PRINTK_BUF_FLAG=""
+if [ "$PRINTK_BUF_SIZE" -ne 0 ]; then
+	PRINTK_BUF_FLAG="-DULMK_CONFIG_PRINTK_BUF_SIZE=${PRINTK_BUF_SIZE}"
+fi
+THREAD_STATS_FLAG=""
+if [ "$THREAD_STATS" -eq 1 ]; then
+	THREAD_STATS_FLAG="-DULMK_CONFIG_THREAD_STATS=1"
+fi
+SCHED_LATENCY_FLAG=""
+if [ "$SCHED_LATENCY" -eq 1 ]; then
+	SCHED_LATENCY_FLAG="-DULMK_CONFIG_SCHED_LATENCY=1"
+fi
+IRQOFF_STATS_FLAG=""
+if [ "$IRQOFF_STATS" -eq 1 ]; then
+	IRQOFF_STATS_FLAG="-DULMK_CONFIG_IRQOFF_STATS=1"
+fi
+SPINLOCK_STATS_FLAG=""
+if [ "$SPINLOCK_STATS" -eq 1 ]; then
+	SPINLOCK_STATS_FLAG="-DULMK_CONFIG_SPINLOCK_STATS=1"
+fi
+USER_CYCLES_FLAG=""
+if [ "$USER_CYCLES" -eq 1 ]; then
+	USER_CYCLES_FLAG="-DULMK_CONFIG_USER_CYCLES=1"
+fi
+STACK_WATERMARK_FLAG=""
+if [ "$STACK_WATERMARK" -eq 1 ]; then
+	STACK_WATERMARK_FLAG="-DULMK_CONFIG_STACK_WATERMARK=1"
+fi
+SYSCALL_WCET_FLAG=""
+if [ "$SYSCALL_WCET" -eq 1 ]; then
+	SYSCALL_WCET_FLAG="-DULMK_CONFIG_SYSCALL_WCET=1"
+fi
 cmake -S "$WORKSPACE" -B "$BUILD_DIR" \
 	-DCMAKE_TOOLCHAIN_FILE="$TOOLCHAIN" \
 	-DULMK_CHIP_DIR="$CHIP_DIR" \
@@ -98,6 +202,17 @@ cmake -S "$WORKSPACE" -B "$BUILD_DIR" \
 	${OPT_SIZE_FLAG} \
 	${SMP_FLAG} \
 	${IRQ_ATTACH_FLAG} \
+	${MPU_LAZY_FLAG} \
+	${TRACE_FLAG} \
+	${IRQ_BINDINGS_FLAG} \
+	${PRINTK_BUF_FLAG} \
+	${THREAD_STATS_FLAG} \
+	${SCHED_LATENCY_FLAG} \
+	${IRQOFF_STATS_FLAG} \
+	${SPINLOCK_STATS_FLAG} \
+	${USER_CYCLES_FLAG} \
+	${STACK_WATERMARK_FLAG} \
+	${SYSCALL_WCET_FLAG} \
 	-GNinja \
 	--no-warn-unused-cli
 
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""Decode ulmk kernel trace records into a Perfetto-loadable timeline.
+
+Input is either a raw dump of ulmk_trace_rec_t records (20 bytes each,
+little-endian, see include/ulmk/trace.h) or a console log in which each
+record is a line "ulmk-trace: <40 hex digits>" (tests/sdk_suite/trace_ring).
+Output is Chrome trace-event JSON, which ui.perfetto.dev and
+chrome://tracing open directly:
+
+  - one track per CPU;
+  - a slice per thread run, cut at each ULMK_TRACE_SWITCH;
+  - IRQ_ENTER / IRQ_EXIT as slices nested in the running thread;
+  - every other event as an instant with its arguments.
+
+Timestamps are per-CPU cycle counts; pass --cycle-hz to get real time.
+Counters of different CPUs are not synchronised by the kernel.
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+REC = struct.Struct("<IIHBBII")
+
+# Keep in sync with include/ulmk/trace.h.
+EVENTS = {
+    1: ("switch", "prev", "next"),
+    2: ("enqueue", "tid", "prio"),
+    3: ("dequeue", "tid", "prio"),
+    4: ("ipc_call", "ep", "server"),
+    5: ("ipc_recv", "ep", "caller"),
+    6: ("ipc_reply", "caller", None),
+    7: ("notif_signal", "notif", "bits"),
+    8: ("notif_wake", "tid", "bits"),
+    9: ("irq_enter", "srpn", None),
+    10: ("irq_exit", "srpn", None),
+    11: ("timer_expire", "timeout", "cb"),
+}
+EV_SWITCH = 1
+EV_IRQ_ENTER = 9
+EV_IRQ_EXIT = 10
+
+LINE_RE = re.compile(r"ulmk-trace:\s*([0-9a-fA-F]{40})")
+
+
+def parse(data):
+    """Return records as dicts from raw bytes or a text log."""
+    blobs = [bytes.fromhex(m.group(1))
+             for m in LINE_RE.finditer(data.decode("latin-1"))]
+    if not blobs:
+        if len(data) % REC.size:
+            sys.exit("trace_decode: %d bytes is not a whole number of "
+                     "%d-byte records" % (len(data), REC.size))
+        blobs = [data[i:i + REC.size] for i in range(0, len(data), REC.size)]
+
+    recs = []
+    for blob in blobs:
+        seq, ts, ev, cpu, _, a, b = REC.unpack(blob)
+        recs.append({"seq": seq, "ts": ts, "ev": ev, "cpu": cpu,
+                     "a": a, "b": b})
+    return recs
+
+
+def timeline(recs, cycle_hz):
+    """Build the trace-event list; one pass per CPU in record order."""
+    out = [{"ph": "M", "pid": 1, "name": "process_name",
+            "args": {"name": "ulmk"}}]
+    scale = 1e6 / cycle_hz
+    lost = 0
+
+    for cpu in sorted({r["cpu"] for r in recs}):
+        mine = sorted((r for r in recs if r["cpu"] == cpu),
+                      key=lambda r: r["seq"])
+        out.append({"ph": "M", "pid": 1, "tid": cpu, "name": "thread_name",
+                    "args": {"name": "CPU%d" % cpu}})
+        base = mine[0]["ts"]
+        prev_ts = base
+        wide = 0
+        running = None
+        irqs = 0
+        last_seq = None
+
+        for r in mine:
+            if last_seq is not None and r["seq"] != last_seq + 1:
+                lost += r["seq"] - last_seq - 1
+            last_seq = r["seq"]
+            # Unwrap the 32-bit counter; records of one CPU are in order.
+            wide += (r["ts"] - prev_ts) & 0xFFFFFFFF
+            prev_ts = r["ts"]
+            ts = wide * scale
+            ev = r["ev"]
+            common = {"pid": 1, "tid": cpu, "ts": ts}
+
+            if ev == EV_SWITCH:
+                while irqs:
+                    out.append(dict(common, ph="E"))
+                    irqs -= 1
+                if running is not None:
+                    out.append(dict(common, ph="E"))
+                running = r["b"]
+                out.append(dict(common, ph="B", name="tid 0x%08x" % running,
+                                cat="sched"))
+            elif ev == EV_IRQ_ENTER:
+                irqs += 1
+                out.append(dict(common, ph="B", name="irq %d" % r["a"],
+                                cat="irq"))
+            elif ev == EV_IRQ_EXIT:
+                if irqs:
+                    irqs -= 1
+                    out.append(dict(common, ph="E"))
+            else:
+                name, an, bn = EVENTS.get(ev, ("ev%d" % ev, "a", "b"))
+                args = {an: "0x%08x" % r["a"]}
+                if bn:
+                    args[bn] = "0x%08x" % r["b"]
+                out.append(dict(common, ph="i", s="t", name=name,
+                                cat="kernel", args=args))
+
+        end = {"pid": 1, "tid": cpu, "ts": wide * scale, "ph": "E"}
+        out.extend([end] * irqs)
+        if running is not None:
+            out.append(end)
+
+    if lost:
+        print("trace_decode: %d records lost to ring overwrite" % lost,
+              file=sys.stderr)
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", help="raw record dump or console log")
+    ap.add_argument("-o", "--output", default="-",
+                    help="JSON output file (default: stdout)")
+    ap.add_argument("--cycle-hz", type=float, default=1e6,
+                    help="cycle counter rate; default 1e6 shows cycles as us")
+    args = ap.parse_args()
+
+    with open(args.input, "rb") as f:
+        recs = parse(f.read())
+    if not recs:
+        sys.exit("trace_decode: no records in %s" % args.input)
+
+    doc = {"traceEvents": timeline(recs, args.cycle_hz),
+           "displayTimeUnit": "ns"}
+    if args.output == "-":
+        json.dump(doc, sys.stdout)
+        sys.stdout.write("\n")
+    else:
+        with open(args.output, "w") as f:
+            json.dump(doc, f)
+
+
+if __name__ == "__main__":
+    main()